@@ -37,6 +37,7 @@
 
 #include "Interp1_linear.h"
 #include "Interp1_cubic.h"
+#include "Interp1_batch.h"
 
 namespace Eigen
 {
@@ -0,0 +1,268 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __eigen_openma_interp1_batch_h
+#define __eigen_openma_interp1_batch_h
+
+#include "../Utils/sign.h"
+
+#include <Eigen/Core>
+
+#include <algorithm> // std::upper_bound
+#include <cmath> // std::floor, std::fabs
+
+namespace Eigen
+{
+  /**
+   * Batched 1D interpolation where the query grid is prepared once and applied to several columns (or several signals sharing the same abscissa).
+   *
+   * The method prepare() locates each query point @a xi in the knots @a x and stores the interval index and the basis weights.
+   * When the query points are sorted (the common case for resampling), the intervals are found by a single forward scan instead of a binary search per point.
+   * A second overload is proposed for uniform knots (e.g. samples of a time sequence) where the interval is computed directly.
+   * The method apply() evaluates then every column of @a y at the prepared points without any search.
+   *
+   * Two methods are available:
+   *  - Interp1Batch::Linear: same result than Interp1::linear()
+   *  - Interp1Batch::Cubic: same result than Interp1::cubic() (PCHIP). Only the slopes depend on the values and are computed for each column. At least three knots are required.
+   * Like Interp1, the points outside of the knots are extrapolated using the first or the last interval.
+   *
+   * WARNING: The value for the horizontal axis (variable x) MUST be monotone increasing
+   */
+  template <typename _Scalar>
+  class Interp1Batch
+  {
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    
+    enum Method {Linear, Cubic};
+    
+    Interp1Batch(Method method = Linear);
+    
+    Method method() const {return this->m_Method;};
+    Index knots() const {return this->m_Knots;};
+    Index rows() const {return this->m_Indices.rows();};
+    Index index(Index i) const {return this->m_Indices.coeff(i);};
+    Scalar weight(Index i) const {return this->m_Weights.coeff(i,0);};
+    
+    template <typename X, typename XI> void prepare(const DenseBase<X>& x, const DenseBase<XI>& xi);
+    template <typename XI> void prepare(Scalar x0, Scalar dx, Index num, const DenseBase<XI>& xi);
+    
+    template <typename Y, typename YI> void apply(YI* yi, const DenseBase<Y>& y) const;
+    
+  private:
+    void setweights(Index i, Index j, Scalar t, Scalar h);
+    template <typename Y> void setslopes(Matrix<Scalar,Dynamic,1>* dk, Matrix<Scalar,Dynamic,1>* mk, const Y& y) const;
+    
+    Method m_Method;
+    Index m_Knots;
+    Matrix<Index,Dynamic,1> m_Indices;
+    Matrix<Scalar,Dynamic,Dynamic> m_Weights; // Linear: fraction of the interval. Cubic: Hermite basis (h00, h*h10, h01, h*h11)
+    Matrix<Scalar,Dynamic,1> m_Steps; // Cubic only: length of each interval
+  };
+  
+  template <typename _Scalar>
+  Interp1Batch<_Scalar>::Interp1Batch(Method method)
+  : m_Method(method), m_Knots(0), m_Indices(), m_Weights(), m_Steps()
+  {};
+  
+  /**
+   * Locate the query points @a xi in the knots @a x.
+   * The knots must be monotone increasing. The query points can be in any order but a sorted grid is located in linear time.
+   */
+  template <typename _Scalar>
+  template <typename X, typename XI>
+  void Interp1Batch<_Scalar>::prepare(const DenseBase<X>& x, const DenseBase<XI>& xi)
+  {
+    const Index num = x.size(), m = xi.size();
+    eigen_assert((num >= ((this->m_Method == Cubic) ? 3 : 2)) && "Interp1Batch: not enough knots");
+    this->m_Knots = num;
+    this->m_Indices.resize(m);
+    this->m_Weights.resize(m, (this->m_Method == Cubic) ? 4 : 1);
+    if (this->m_Method == Cubic)
+    {
+      this->m_Steps.resize(num-1);
+      for (Index k = 0 ; k < num-1 ; ++k)
+        this->m_Steps.coeffRef(k) = x.coeff(k+1) - x.coeff(k);
+    }
+    Index j = 0;
+    for (Index i = 0 ; i < m ; ++i)
+    {
+      const Scalar v = xi.coeff(i);
+      if (v < x.coeff(j))
+      {
+        // Unsorted query: restart with a binary search
+        Index jl = 0, ju = num-1;
+        while (ju-jl > 1)
+        {
+          const Index jm = (ju + jl) >> 1;
+          if (v >= x.coeff(jm))
+            jl = jm;
+          else
+            ju = jm;
+        }
+        j = jl;
+      }
+      while ((j < num-2) && (v >= x.coeff(j+1)))
+        ++j;
+      const Scalar h = x.coeff(j+1) - x.coeff(j);
+      this->setweights(i, j, (h == Scalar(0)) ? Scalar(0) : (v - x.coeff(j)) / h, h);
+    }
+  };
+  
+  /**
+   * Locate the query points @a xi in @a num uniform knots starting at @a x0 and separated by @a dx.
+   */
+  template <typename _Scalar>
+  template <typename XI>
+  void Interp1Batch<_Scalar>::prepare(Scalar x0, Scalar dx, Index num, const DenseBase<XI>& xi)
+  {
+    const Index m = xi.size();
+    eigen_assert((num >= ((this->m_Method == Cubic) ? 3 : 2)) && (dx > Scalar(0)) && "Interp1Batch: not enough knots");
+    this->m_Knots = num;
+    this->m_Indices.resize(m);
+    this->m_Weights.resize(m, (this->m_Method == Cubic) ? 4 : 1);
+    if (this->m_Method == Cubic)
+      this->m_Steps.setConstant(num-1, dx);
+    for (Index i = 0 ; i < m ; ++i)
+    {
+      const Scalar pos = (xi.coeff(i) - x0) / dx;
+      Scalar j = std::floor(pos);
+      if (j < Scalar(0))
+        j = Scalar(0);
+      else if (j > static_cast<Scalar>(num-2))
+        j = static_cast<Scalar>(num-2);
+      this->setweights(i, static_cast<Index>(j), pos - j, dx);
+    }
+  };
+  
+  /**
+   * Interpolate each column of @a y (one row per knot) at the prepared points.
+   * The output @a yi is resized (if possible) to have as many rows as prepared points and the same number of columns than @a y.
+   */
+  template <typename _Scalar>
+  template <typename Y, typename YI>
+  void Interp1Batch<_Scalar>::apply(YI* yi, const DenseBase<Y>& y) const
+  {
+    eigen_assert((y.rows() == this->m_Knots) && "Interp1Batch: the number of rows does not correspond to the prepared knots");
+    const Index m = this->m_Indices.rows(), cols = y.cols();
+    yi->resize(m, cols);
+    const Index* idx = this->m_Indices.data();
+    if (this->m_Method == Linear)
+    {
+      const Scalar* w = this->m_Weights.data();
+      for (Index c = 0 ; c < cols ; ++c)
+      {
+        for (Index i = 0 ; i < m ; ++i)
+        {
+          const Scalar y0 = y.coeff(idx[i],c);
+          yi->coeffRef(i,c) = y0 + w[i] * (y.coeff(idx[i]+1,c) - y0);
+        }
+      }
+    }
+    else
+    {
+      const Scalar *h00 = this->m_Weights.data(), *h10 = h00 + m, *h01 = h10 + m, *h11 = h01 + m;
+      Matrix<Scalar,Dynamic,1> dk(this->m_Knots), mk(this->m_Knots-1);
+      for (Index c = 0 ; c < cols ; ++c)
+      {
+        this->setslopes(&dk, &mk, y.col(c));
+        for (Index i = 0 ; i < m ; ++i)
+        {
+          const Index j = idx[i];
+          yi->coeffRef(i,c) = y.coeff(j,c)*h00[i] + dk.coeff(j)*h10[i] + y.coeff(j+1,c)*h01[i] + dk.coeff(j+1)*h11[i];
+        }
+      }
+    }
+  };
+  
+  template <typename _Scalar>
+  void Interp1Batch<_Scalar>::setweights(Index i, Index j, Scalar t, Scalar h)
+  {
+    this->m_Indices.coeffRef(i) = j;
+    if (this->m_Method == Linear)
+      this->m_Weights.coeffRef(i,0) = t;
+    else
+    {
+      const Scalar c1 = Scalar(1), c2 = Scalar(2), c3 = Scalar(3);
+      this->m_Weights.coeffRef(i,0) = c2*t*t*t - c3*t*t + c1;
+      this->m_Weights.coeffRef(i,1) = h * (t*t*t - c2*t*t + t);
+      this->m_Weights.coeffRef(i,2) = -c2*t*t*t + c3*t*t;
+      this->m_Weights.coeffRef(i,3) = h * (t*t*t - t*t);
+    }
+  };
+  
+  // Same slopes than internal::Interp1Cubic::setinternals() (Matlab method)
+  template <typename _Scalar>
+  template <typename Y>
+  void Interp1Batch<_Scalar>::setslopes(Matrix<Scalar,Dynamic,1>* dk, Matrix<Scalar,Dynamic,1>* mk, const Y& y) const
+  {
+    const Index num = this->m_Knots;
+    const Scalar* hk = this->m_Steps.data();
+    for (Index k = 0 ; k < num-1 ; ++k)
+      mk->coeffRef(k) = (y.coeff(k+1) - y.coeff(k)) / hk[k];
+    for (Index k = 0 ; k < num-2 ; ++k)
+    {
+      const Scalar m0 = mk->coeff(k), m1 = mk->coeff(k+1);
+      if (sign(m0) * sign(m1) > 0)
+      {
+        const Scalar hs = hk[k+1] + hk[k];
+        const Scalar w1 = (hk[k] + hs) / (Scalar(3) * hs);
+        const Scalar w2 = (hk[k+1] + hs) / (Scalar(3) * hs);
+        const Scalar a0 = std::fabs(m0), a1 = std::fabs(m1);
+        const Scalar dmax = (a0 > a1) ? a0 : a1;
+        const Scalar dmin = (a0 < a1) ? a0 : a1;
+        dk->coeffRef(k+1) = dmin / ((w1 * m0 + w2 * m1) / dmax);
+      }
+      else
+        dk->coeffRef(k+1) = Scalar(0);
+    }
+    // dk(0)
+    Scalar d = ((Scalar(2)*hk[0]+hk[1])*mk->coeff(0) - hk[0]*mk->coeff(1)) / (hk[0]+hk[1]);
+    if (sign(d) != sign(mk->coeff(0)))
+      d = Scalar(0);
+    else if ((sign(mk->coeff(0)) != sign(mk->coeff(1))) && (std::fabs(d) > std::fabs(Scalar(3)*mk->coeff(0))))
+      d = Scalar(3)*mk->coeff(0);
+    dk->coeffRef(0) = d;
+    // dk(-1)
+    d = ((Scalar(2)*hk[num-2]+hk[num-3])*mk->coeff(num-2) - hk[num-2]*mk->coeff(num-3)) / (hk[num-2]+hk[num-3]);
+    if (sign(d) != sign(mk->coeff(num-2)))
+      d = Scalar(0);
+    else if ((sign(mk->coeff(num-2)) != sign(mk->coeff(num-3))) && (std::fabs(d) > std::fabs(Scalar(3)*mk->coeff(num-2))))
+      d = Scalar(3)*mk->coeff(num-2);
+    dk->coeffRef(num-1) = d;
+  };
+};
+
+#endif // __eigen_openma_interp1_batch_h
@@ -0,0 +1,225 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __eigen_openma_Resample_h
+#define __eigen_openma_Resample_h
+
+#include <Eigen/Core>
+
+#include <cmath>
+
+namespace Eigen
+{
+  /**
+   * Rational approximation of the given @a ratio such as @a ratio ~ @a p / @a q.
+   * The approximation is based on the continued fraction expansion of @a ratio and stops at the first convergent with a relative error lower than @a tol.
+   * Returns false if the ratio is not strictly positive or if no approximation with a numerator and a denominator lower than @a maxTerm was found.
+   *
+   * Inspired by the Matlab function rat.
+   */
+  template <typename Index>
+  bool rat(double ratio, Index* p, Index* q, double tol = 1e-7, Index maxTerm = 10000)
+  {
+    if (!(ratio > 0.0) || !std::isfinite(ratio))
+      return false;
+    // Convergents h(n)/k(n) of the continued fraction
+    double hm2 = 0.0, hm1 = 1.0, km2 = 1.0, km1 = 0.0;
+    double x = ratio;
+    for (int n = 0 ; n < 64 ; ++n)
+    {
+      const double a = std::floor(x);
+      const double h = a * hm1 + hm2, k = a * km1 + km2;
+      if ((h > static_cast<double>(maxTerm)) || (k > static_cast<double>(maxTerm)))
+        return false;
+      if ((h > 0.0) && (std::fabs(h / k - ratio) <= tol * ratio))
+      {
+        *p = static_cast<Index>(h);
+        *q = static_cast<Index>(k);
+        return true;
+      }
+      const double f = x - a;
+      if (f <= 0.0)
+        return false;
+      x = 1.0 / f;
+      hm2 = hm1; hm1 = h;
+      km2 = km1; km1 = k;
+    }
+    return false;
+  };
+  
+  /**
+   * Change the sampling rate of 1D signals by a rational factor @a up / @a down using a polyphase implementation.
+   *
+   * The anti-aliasing (and anti-imaging) filter is a Kaiser-windowed sinc low-pass FIR filter with a cutoff frequency set to the lowest of the two Nyquist frequencies.
+   * The filter has 2 * @a halfLength * max(@a up, @a down) + 1 coefficients and its delay is compensated: the output sample #m is aligned with the time m * @a down / @a up of the input.
+   * Only the samples kept in the output are computed: each of them uses one of the @a up phases of the filter (about 2 * @a halfLength * max(@a up, @a down) / @a up multiplications).
+   * Each phase is normalized to have a unity gain at DC, so that constant signals (e.g. offsets) are exactly preserved.
+   * The signal is extended at both ends with its first and last values to limit the edge effects.
+   *
+   * Inspired by the Matlab function resample and the function resample_poly provided in SciPy.
+   */
+  template <typename Scalar>
+  class PolyphaseResampler
+  {
+  public:
+    typedef DenseIndex Index;
+    
+    PolyphaseResampler(Index up, Index down, Index halfLength = 10, Scalar beta = Scalar(5));
+    
+    Index up() const {return this->m_Up;};
+    Index down() const {return this->m_Down;};
+    Index outputSize(Index inputSize) const;
+    
+    void resample(Scalar* y, const Scalar* x, Index n) const;
+    template <typename VectorType> VectorType resample(const VectorType& x) const;
+    
+  private:
+    static Scalar besselI0(Scalar x);
+    
+    Index m_Up;
+    Index m_Down;
+    Index m_Delay;
+    Matrix<Scalar, Dynamic, Dynamic> m_Phases; // Each column contains one phase of the filter
+  };
+  
+  template <typename Scalar>
+  PolyphaseResampler<Scalar>::PolyphaseResampler(Index up, Index down, Index halfLength, Scalar beta)
+  : m_Up(up), m_Down(down), m_Delay(0), m_Phases()
+  {
+    eigen_assert((up > 0) && (down > 0) && "The resampling factors must be strictly positive.");
+    eigen_assert((halfLength > 0) && "The half length of the filter must be strictly positive.");
+    const Scalar pi = Scalar(3.14159265358979323846);
+    const Index m = std::max(up, down);
+    const Index len = 2 * halfLength * m + 1;
+    const Index taps = (len + up - 1) / up;
+    const Scalar fc = Scalar(1) / static_cast<Scalar>(m); // Relative to the Nyquist frequency of the upsampled signal
+    const Scalar i0beta = besselI0(beta);
+    this->m_Delay = halfLength * m;
+    this->m_Phases.setZero(taps, up);
+    for (Index k = 0 ; k < len ; ++k)
+    {
+      const Scalar t = static_cast<Scalar>(k - this->m_Delay);
+      const Scalar sinc = (t == Scalar(0)) ? Scalar(1) : std::sin(pi * fc * t) / (pi * fc * t);
+      const Scalar r = t / static_cast<Scalar>(this->m_Delay);
+      const Scalar window = besselI0(beta * std::sqrt(std::max(Scalar(0), Scalar(1) - r * r))) / i0beta;
+      this->m_Phases.coeffRef(k / up, k % up) = sinc * window;
+    }
+    for (Index r = 0 ; r < up ; ++r)
+      this->m_Phases.col(r) /= this->m_Phases.col(r).sum();
+  };
+  
+  /**
+   * Returns the number of samples produced for an input signal with @a inputSize samples.
+   * This corresponds to all the output samples with a time included in the time range of the input signal.
+   */
+  template <typename Scalar>
+  typename PolyphaseResampler<Scalar>::Index PolyphaseResampler<Scalar>::outputSize(Index inputSize) const
+  {
+    return (inputSize <= 0) ? 0 : ((inputSize - 1) * this->m_Up) / this->m_Down + 1;
+  };
+  
+  /**
+   * Resample the @a n samples of @a x and store the result in @a y.
+   * The array @a y must be already allocated and contains at least outputSize(@a n) elements.
+   */
+  template <typename Scalar>
+  void PolyphaseResampler<Scalar>::resample(Scalar* y, const Scalar* x, Index n) const
+  {
+    const Index taps = this->m_Phases.rows();
+    const Index num = this->outputSize(n);
+    for (Index i = 0 ; i < num ; ++i)
+    {
+      // Position in the upsampled signal, including the delay of the filter
+      const Index t = i * this->m_Down + this->m_Delay;
+      const Scalar* h = this->m_Phases.col(t % this->m_Up).data();
+      const Index j = t / this->m_Up;
+      Scalar acc = Scalar(0);
+      if ((j < n) && (j - taps + 1 >= 0))
+      {
+        const Scalar* xj = x + j;
+        for (Index l = 0 ; l < taps ; ++l)
+          acc += h[l] * xj[-l];
+      }
+      else
+      {
+        for (Index l = 0 ; l < taps ; ++l)
+          acc += h[l] * x[std::min(std::max(j - l, Index(0)), n - 1)];
+      }
+      y[i] = acc;
+    }
+  };
+  
+  /**
+   * Convenient method to resample the vector @a x.
+   */
+  template <typename Scalar>
+  template <typename VectorType>
+  VectorType PolyphaseResampler<Scalar>::resample(const VectorType& x) const
+  {
+    eigen_assert(x.cols() == 1);
+    const Matrix<Scalar, Dynamic, 1> x_ = x; // Contiguous copy
+    VectorType y(this->outputSize(x_.rows()), 1);
+    this->resample(y.data(), x_.data(), x_.rows());
+    return y;
+  };
+  
+  /**
+   * Zeroth order modified Bessel function of the first kind (used by the Kaiser window).
+   */
+  template <typename Scalar>
+  Scalar PolyphaseResampler<Scalar>::besselI0(Scalar x)
+  {
+    const Scalar y = x * x / Scalar(4);
+    Scalar sum = Scalar(1), term = Scalar(1);
+    for (int k = 1 ; k < 500 ; ++k)
+    {
+      term *= y / static_cast<Scalar>(k * k);
+      sum += term;
+      if (term < NumTraits<Scalar>::epsilon() * sum)
+        break;
+    }
+    return sum;
+  };
+  
+  /**
+   * Convenient function to resample the vector @a x by the factor @a p / @a q.
+   */
+  template <typename VectorType>
+  VectorType resample(const VectorType& x, typename VectorType::Index p, typename VectorType::Index q)
+  {
+    const PolyphaseResampler<typename VectorType::Scalar> resampler(p, q);
+    return resampler.resample(x);
+  };
+};
+#endif // __eigen_openma_Resample_h
@@ -207,6 +207,74 @@ CXXTEST_SUITE(Interp1Test)
     for (int i = 0 ; i < yi_.rows() ; ++i)
       TS_ASSERT_DELTA(yi_.coeff(i), yi_.coeff(i), 1e-6);
   };
+  
+  CXXTEST_TEST(batchLinear)
+  {
+    Eigen::Matrix<double, Eigen::Dynamic, 1> x(4), xi(9), yi_;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> y(4,2), yi;
+    x << 3.0, 6.0, 7.0, 9.0;
+    y << 6.0, -1.0,
+         12.0, 2.0,
+         18.0, 0.5,
+         14.0, 4.0;
+    xi << 3.0, 4.0, 5.5, 6.0, 6.25, 8.0, 9.0, 3.5, 7.0;
+    Eigen::Interp1Batch<double> batch;
+    batch.prepare(x, xi);
+    batch.apply(&yi, y);
+    
+    TS_ASSERT_EQUALS(batch.rows(), 9);
+    TS_ASSERT_EQUALS(yi.rows(), 9);
+    TS_ASSERT_EQUALS(yi.cols(), 2);
+    for (int c = 0 ; c < 2 ; ++c)
+    {
+      Eigen::Matrix<double, Eigen::Dynamic, 1> yc = y.col(c);
+      Eigen::Interp1::linear(&yi_, x, yc, xi);
+      for (int i = 0 ; i < 9 ; ++i)
+        TS_ASSERT_DELTA(yi.coeff(i,c), yi_.coeff(i), 1e-15);
+    }
+  };
+  
+  CXXTEST_TEST(batchLinearUniform)
+  {
+    Eigen::Matrix<double, Eigen::Dynamic, 1> x(5), y(5), xi(6), yi, yi_;
+    x << 0.0, 0.5, 1.0, 1.5, 2.0;
+    y << 1.0, 3.0, 2.0, -4.0, 0.0;
+    xi << 0.0, 0.2, 0.75, 1.1, 1.9, 2.0;
+    Eigen::Interp1Batch<double> batch;
+    batch.prepare(0.0, 0.5, 5, xi);
+    batch.apply(&yi, y);
+    Eigen::Interp1::linear(&yi_, x, y, xi);
+    
+    TS_ASSERT_EQUALS(yi.rows(), 6);
+    TS_ASSERT_EQUALS(batch.index(0), 0);
+    TS_ASSERT_EQUALS(batch.index(5), 3);
+    TS_ASSERT_DELTA(batch.weight(5), 1.0, 1e-15);
+    for (int i = 0 ; i < 6 ; ++i)
+      TS_ASSERT_DELTA(yi.coeff(i), yi_.coeff(i), 1e-14);
+  };
+  
+  CXXTEST_TEST(batchCubic)
+  {
+    Eigen::Matrix<double, Eigen::Dynamic, 1> x(10), xi(27), yi_;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> y(10,2), yi;
+    x << 1.0, 2.0, 4.0, 5.0, 6.0, 7.0, 8.0, 10.0, 20.0, 25.0;
+    y.col(0) << -5.245373, -0.232714, -7.004030, 8.827446, 5.626890, -8.906643, -4.271316, -2.599281, 1.940986, 1.202701;
+    y.col(1) << 1.0, 2.0, 3.0, 5.0, 8.0, 8.0, 7.5, 2.0, 1.0, 0.0;
+    xi << 1.0, 25.0, 8.352387, 13.204208, 13.258518, 20.623065, 20.075954, 16.463635, 10.086625, 20.477931, 13.787814, 9.417450, 23.536037, 22.022627, 14.203752, 15.939402, 15.089073, 5.985815, 8.229912, 12.302160, 6.531716, 21.263411, 5.674343, 6.422123, 5.096993, 6.463943, 11.456768;
+    Eigen::Interp1Batch<double> batch(Eigen::Interp1Batch<double>::Cubic);
+    batch.prepare(x, xi);
+    batch.apply(&yi, y);
+    
+    TS_ASSERT_EQUALS(yi.rows(), 27);
+    TS_ASSERT_EQUALS(yi.cols(), 2);
+    for (int c = 0 ; c < 2 ; ++c)
+    {
+      Eigen::Matrix<double, Eigen::Dynamic, 1> yc = y.col(c);
+      Eigen::Interp1::cubic(&yi_, x, yc, xi);
+      for (int i = 0 ; i < 27 ; ++i)
+        TS_ASSERT_DELTA(yi.coeff(i,c), yi_.coeff(i), 1e-12);
+    }
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(Interp1Test)
@@ -217,3 +285,6 @@ CXXTEST_TEST_REGISTRATION(Interp1Test, cubicXdInternalsCondition)
 CXXTEST_TEST_REGISTRATION(Interp1Test, cubicXdInternals)
 CXXTEST_TEST_REGISTRATION(Interp1Test, cubicXd)
 CXXTEST_TEST_REGISTRATION(Interp1Test, cubicXdBis)
+CXXTEST_TEST_REGISTRATION(Interp1Test, batchLinear)
+CXXTEST_TEST_REGISTRATION(Interp1Test, batchLinearUniform)
+CXXTEST_TEST_REGISTRATION(Interp1Test, batchCubic)
@@ -0,0 +1,102 @@
+#include <cxxtest/TestDrive.h>
+
+#include <Eigen_openma/SignalProcessing/Resample.h>
+
+CXXTEST_SUITE(ResampleTest)
+{
+  CXXTEST_TEST(rationalApproximation)
+  {
+    int p = 0, q = 0;
+    TS_ASSERT_EQUALS(Eigen::rat(120.0 / 1000.0, &p, &q), true);
+    TS_ASSERT_EQUALS(p, 3);
+    TS_ASSERT_EQUALS(q, 25);
+    TS_ASSERT_EQUALS(Eigen::rat(0.5, &p, &q), true);
+    TS_ASSERT_EQUALS(p, 1);
+    TS_ASSERT_EQUALS(q, 2);
+    TS_ASSERT_EQUALS(Eigen::rat(2160.0 / 1000.0, &p, &q), true);
+    TS_ASSERT_EQUALS(p, 54);
+    TS_ASSERT_EQUALS(q, 25);
+    TS_ASSERT_EQUALS(Eigen::rat(static_cast<double>(119.88f) / 1000.0, &p, &q), true);
+    TS_ASSERT_DELTA(static_cast<double>(p) / static_cast<double>(q), static_cast<double>(119.88f) / 1000.0, 1e-7);
+    TS_ASSERT_EQUALS(Eigen::rat(0.0, &p, &q), false);
+    TS_ASSERT_EQUALS(Eigen::rat(-2.0, &p, &q), false);
+    TS_ASSERT_EQUALS(Eigen::rat(3.14159265358979, &p, &q, 1e-15, 100), false);
+  };
+  
+  CXXTEST_TEST(identity)
+  {
+    Eigen::Matrix<double,Eigen::Dynamic,1> x = Eigen::Matrix<double,Eigen::Dynamic,1>::Random(50);
+    Eigen::Matrix<double,Eigen::Dynamic,1> y = Eigen::resample(x, 1, 1);
+    TS_ASSERT_EQUALS(y.rows(), x.rows());
+    TS_ASSERT_EIGEN_DELTA(y, x, 1e-15);
+  };
+  
+  CXXTEST_TEST(outputSize)
+  {
+    Eigen::PolyphaseResampler<double> resampler(3, 25);
+    TS_ASSERT_EQUALS(resampler.outputSize(0), 0);
+    TS_ASSERT_EQUALS(resampler.outputSize(1), 1);
+    TS_ASSERT_EQUALS(resampler.outputSize(1000), 120);
+    TS_ASSERT_EQUALS(resampler.outputSize(1001), 121);
+    Eigen::PolyphaseResampler<double> resampler2(1, 2);
+    TS_ASSERT_EQUALS(resampler2.outputSize(22), 11);
+    TS_ASSERT_EQUALS(resampler2.outputSize(21), 11);
+  };
+  
+  CXXTEST_TEST(constantPreserved)
+  {
+    Eigen::Matrix<double,Eigen::Dynamic,1> x = Eigen::Matrix<double,Eigen::Dynamic,1>::Constant(1000, -35.56109);
+    Eigen::Matrix<double,Eigen::Dynamic,1> y = Eigen::resample(x, 3, 25);
+    TS_ASSERT_EQUALS(y.rows(), 120);
+    TS_ASSERT_EIGEN_DELTA(y.array(), -35.56109, 1e-12);
+  };
+  
+  CXXTEST_TEST(lowFrequencyPassed)
+  {
+    const double pi = 3.14159265358979323846;
+    const int n = 2000;
+    Eigen::Matrix<double,Eigen::Dynamic,1> x(n);
+    for (int i = 0 ; i < n ; ++i)
+      x(i) = std::sin(2.0 * pi * 2.0 * static_cast<double>(i) / 1000.0);
+    Eigen::Matrix<double,Eigen::Dynamic,1> y = Eigen::resample(x, 3, 25);
+    TS_ASSERT_EQUALS(y.rows(), 240);
+    // Edges are excluded due to the extension of the signal
+    for (int i = 10 ; i < y.rows() - 10 ; ++i)
+      TSM_ASSERT_DELTA("Sample #" + std::to_string(i), y(i), std::sin(2.0 * pi * 2.0 * static_cast<double>(i) / 120.0), 1e-3);
+  };
+  
+  CXXTEST_TEST(aliasingRejected)
+  {
+    // A 100 Hz signal sampled at 1000 Hz would be aliased at 20 Hz by a simple decimation to 120 Hz.
+    const double pi = 3.14159265358979323846;
+    const int n = 2000;
+    Eigen::Matrix<double,Eigen::Dynamic,1> x(n);
+    for (int i = 0 ; i < n ; ++i)
+      x(i) = std::sin(2.0 * pi * 100.0 * static_cast<double>(i) / 1000.0);
+    Eigen::Matrix<double,Eigen::Dynamic,1> y = Eigen::resample(x, 3, 25);
+    TS_ASSERT_LESS_THAN(y.segment(10, y.rows() - 20).cwiseAbs().maxCoeff(), 1e-2);
+  };
+  
+  CXXTEST_TEST(upsampling)
+  {
+    const double pi = 3.14159265358979323846;
+    const int n = 200;
+    Eigen::Matrix<double,Eigen::Dynamic,1> x(n);
+    for (int i = 0 ; i < n ; ++i)
+      x(i) = std::cos(2.0 * pi * 5.0 * static_cast<double>(i) / 100.0);
+    Eigen::Matrix<double,Eigen::Dynamic,1> y = Eigen::resample(x, 5, 2);
+    TS_ASSERT_EQUALS(y.rows(), 498);
+    // Edges are excluded due to the extension of the signal. The tolerance takes into account the ripple in the passband of the filter.
+    for (int i = 50 ; i < y.rows() - 50 ; ++i)
+      TSM_ASSERT_DELTA("Sample #" + std::to_string(i), y(i), std::cos(2.0 * pi * 5.0 * static_cast<double>(i) / 250.0), 5e-3);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ResampleTest)
+CXXTEST_TEST_REGISTRATION(ResampleTest, rationalApproximation)
+CXXTEST_TEST_REGISTRATION(ResampleTest, identity)
+CXXTEST_TEST_REGISTRATION(ResampleTest, outputSize)
+CXXTEST_TEST_REGISTRATION(ResampleTest, constantPreserved)
+CXXTEST_TEST_REGISTRATION(ResampleTest, lowFrequencyPassed)
+CXXTEST_TEST_REGISTRATION(ResampleTest, aliasingRejected)
+CXXTEST_TEST_REGISTRATION(ResampleTest, upsampling)
@@ -0,0 +1,51 @@
+# Simple CMake script to create the benchmarks of the OpenMA modules.
+# Each benchmark is an executable sharing the same command line interface
+# and output (see 'modules/base/test/benchmark/benchmark.h').
+# The custom target 'run_benchmarks' executes all of them and stores their
+# (JSON) results in the folder '${OPENMA_BINARY_DIR}/benchmarks'.
+
+SET(OPENMA_BENCHMARK_INCLUDES "${OPENMA_SOURCE_DIR}/modules/base/test/benchmark")
+SET(OPENMA_BENCHMARK_OUTPUT_PATH "${OPENMA_BINARY_DIR}/benchmarks")
+
+ADD_CUSTOM_TARGET(run_benchmarks)
+
+FUNCTION(ADD_OPENMA_BENCHMARK)
+  # Parse the arguments
+  SET(options )
+  SET(oneValueArgs NAME)
+  SET(multiValueArgs SOURCES INCLUDES LIBRARIES)
+  CMAKE_PARSE_ARGUMENTS(_BENCHMARK "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+  # Extra unparsed arguments?
+  LIST(LENGTH _BENCHMARK_UNPARSED_ARGUMENTS _BENCHMARK_NUM_UNPARSED_ARGUMENTS)
+  IF (${_BENCHMARK_NUM_UNPARSED_ARGUMENTS} GREATER 0)
+    IF (NOT _BENCHMARK_NAME)
+      LIST(GET _BENCHMARK_UNPARSED_ARGUMENTS 0 _BENCHMARK_NAME)
+    ENDIF()
+  ENDIF()
+  IF (${_BENCHMARK_NUM_UNPARSED_ARGUMENTS} GREATER 1)
+    IF (NOT _BENCHMARK_SOURCES)
+      LIST(GET _BENCHMARK_UNPARSED_ARGUMENTS 1 _BENCHMARK_SOURCES)
+    ENDIF()
+  ENDIF()
+  IF (${_BENCHMARK_NUM_UNPARSED_ARGUMENTS} GREATER 2)
+    IF (NOT _BENCHMARK_LIBRARIES)
+      LIST(GET _BENCHMARK_UNPARSED_ARGUMENTS 2 _BENCHMARK_LIBRARIES)
+    ENDIF()
+  ENDIF ()
+  # Create the benchmark and register it
+  ADD_EXECUTABLE(benchmark_${_BENCHMARK_NAME} ${_BENCHMARK_SOURCES})
+  SET_TARGET_PROPERTIES(benchmark_${_BENCHMARK_NAME} PROPERTIES COMPILE_DEFINITIONS "_USE_MATH_DEFINES")
+  TARGET_INCLUDE_DIRECTORIES(benchmark_${_BENCHMARK_NAME} PRIVATE ${OPENMA_BENCHMARK_INCLUDES})
+  IF(_BENCHMARK_INCLUDES)
+    TARGET_INCLUDE_DIRECTORIES(benchmark_${_BENCHMARK_NAME} PRIVATE ${_BENCHMARK_INCLUDES})
+  ENDIF()
+  IF(_BENCHMARK_LIBRARIES)
+    TARGET_LINK_LIBRARIES(benchmark_${_BENCHMARK_NAME} ${_BENCHMARK_LIBRARIES})
+  ENDIF()
+  ADD_CUSTOM_TARGET(run_benchmark_${_BENCHMARK_NAME}
+    COMMAND "${CMAKE_COMMAND}" -E make_directory "${OPENMA_BENCHMARK_OUTPUT_PATH}"
+    COMMAND benchmark_${_BENCHMARK_NAME} --format=json --output=${OPENMA_BENCHMARK_OUTPUT_PATH}/${_BENCHMARK_NAME}.json
+    DEPENDS benchmark_${_BENCHMARK_NAME}
+    COMMENT "Running the benchmark ${_BENCHMARK_NAME}")
+  ADD_DEPENDENCIES(run_benchmarks run_benchmark_${_BENCHMARK_NAME})
+ENDFUNCTION()
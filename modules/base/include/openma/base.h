@@ -43,7 +43,11 @@
 #include "openma/base/hardware.h"
 #include "openma/base/logger.h"
 #include "openma/base/node.h"
+#include "openma/base/nodefactory.h"
 #include "openma/base/object.h"
+#include "openma/base/parallel.h"
+#include "openma/base/pipeline.h"
+#include "openma/base/profiler.h"
 #include "openma/base/subject.h"
 #include "openma/base/timesequence.h"
 #include "openma/base/trial.h"
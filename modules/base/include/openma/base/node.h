@@ -46,12 +46,16 @@
 #include <string>
 #include <regex>
 #include <atomic>
+#include <memory> // std::shared_ptr
+#include <utility> // std::pair
+#include <vector>
 
 namespace ma
 {
   template <typename T, typename N> T node_cast(N* node) _OPENMA_NOEXCEPT;
   
   class NodePrivate;
+  class PropertySource;
   
   class OPENMA_BASE_EXPORT Node : public Object
   {
@@ -76,6 +80,10 @@ namespace ma
     void setProperty(const std::string& key, const Any& value);
     
     const std::unordered_map<std::string, Any>& dynamicProperties() const _OPENMA_NOEXCEPT;
+    std::vector<std::string> staticPropertyKeys(bool mutableOnly = false) const;
+    
+    const PropertySource* propertySource() const _OPENMA_NOEXCEPT;
+    void setPropertySource(std::shared_ptr<const PropertySource> source) _OPENMA_NOEXCEPT;
     
     template <typename U = Node*> U child(unsigned index) const _OPENMA_NOEXCEPT;
     const std::vector<Node*>& children() const _OPENMA_NOEXCEPT;
@@ -112,8 +120,8 @@ namespace ma
     
     virtual Node* allocateNew() const;
     virtual void copyContents(const Node* source) _OPENMA_NOEXCEPT;
-    Node* cloneContents(Node* parent, std::unordered_map<const Node*,Node*>& map) const;
-    void cloneChildren(Node* parent, std::unordered_map<const Node*,Node*>& map) const;
+    Node* cloneContents(Node* parent, std::vector<std::pair<const Node*,Node*>>& shared) const;
+    void cloneChildren(Node* parent, std::vector<std::pair<const Node*,Node*>>& shared) const;
     
   private:
     Node* findNode(typeid_t id, const std::string& name, std::unordered_map<std::string,Any>&& properties, bool recursiveSearch) const _OPENMA_NOEXCEPT;
@@ -50,10 +50,13 @@
 #include <unordered_map>
 #include <vector>
 #include <atomic>
+#include <memory> // std::shared_ptr
+#include <mutex>
 
 namespace ma
 {
   class Node;
+  class PropertySource;
   
   class OPENMA_BASE_EXPORT NodePrivate : public ObjectPrivate
   {
@@ -80,9 +83,17 @@ namespace ma
     bool attachChild(Node* node) _OPENMA_NOEXCEPT;
     bool detachChild(Node* node) _OPENMA_NOEXCEPT;
     
+    void resolvePropertySource() const;
+    void assignPropertySource(std::shared_ptr<const PropertySource> source) _OPENMA_NOEXCEPT;
+    
     std::string Name;
     std::string Description;
-    std::unordered_map<std::string,Any> DynamicProperties;
+    // Both members are mutable as the properties of the source are moved into the dynamic properties on demand.
+    // As long as LazyPending is set, they are only accessed under LazyMutex (const methods can run concurrently).
+    mutable std::unordered_map<std::string,Any> DynamicProperties;
+    mutable std::shared_ptr<const PropertySource> LazyProperties;
+    mutable std::atomic<bool> LazyPending;
+    mutable std::mutex LazyMutex;
     std::vector<Node*> Parents;
     std::vector<Node*> Children;
 #if defined(USE_REFCOUNT_MECHANISM)
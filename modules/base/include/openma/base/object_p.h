@@ -43,6 +43,8 @@
 #include "openma/base_export.h"
 #include "openma/base/macros.h" // _OPENMA_NOEXCEPT
 
+#include <atomic>
+
 namespace ma
 { 
   class OPENMA_BASE_EXPORT ObjectPrivate
@@ -56,7 +58,7 @@ namespace ma
     ObjectPrivate& operator=(const ObjectPrivate& ) = delete;
     ObjectPrivate& operator=(const ObjectPrivate&& ) _OPENMA_NOEXCEPT = delete;
     
-    unsigned long Timestamp;
+    std::atomic<unsigned long> Timestamp; // Atomic as a modification can be propagated to a node shared by several threads
   };
 };
 
@@ -0,0 +1,101 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_base_parallel_h
+#define __openma_base_parallel_h
+
+#include "openma/base_export.h"
+#include "openma/base/macros.h" // _OPENMA_NOEXCEPT
+#include "openma/base/profiler.h"
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ma
+{
+  OPENMA_BASE_EXPORT unsigned parallel_threads(unsigned requested = 0) _OPENMA_NOEXCEPT;
+  
+  template <typename Func> void parallel_for(size_t count, Func&& func, unsigned threads = 0);
+  
+  // ----------------------------------------------------------------------- //
+  
+  template <typename Func>
+  void parallel_for(size_t count, Func&& func, unsigned threads)
+  {
+    const size_t workers = std::min(static_cast<size_t>(parallel_threads(threads)), count);
+    if (workers <= 1)
+    {
+      for (size_t i = 0 ; i < count ; ++i)
+        func(i);
+      return;
+    }
+    std::atomic<size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex guard;
+    const void* context = Profiler::context();
+    auto work = [&]() {
+      Profiler::Attach attach(context);
+      size_t i = 0;
+      while ((i = next++) < count)
+      {
+        try
+        {
+          func(i);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(guard);
+          if (!failure)
+            failure = std::current_exception();
+          next = count;
+        }
+      }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t i = 1 ; i < workers ; ++i)
+      pool.emplace_back(work);
+    work();
+    for (auto& thread : pool)
+      thread.join();
+    if (failure)
+      std::rethrow_exception(failure);
+  };
+};
+
+#endif // __openma_base_parallel_h
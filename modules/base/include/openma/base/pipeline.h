@@ -0,0 +1,80 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_base_pipeline_h
+#define __openma_base_pipeline_h
+
+#include "openma/base_export.h"
+#include "openma/base/macros.h" // _OPENMA_NOEXCEPT
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ma
+{
+  class Node;
+  
+  class OPENMA_BASE_EXPORT Pipeline
+  {
+  public:
+    using Stage = std::function<bool(Node* output, const std::vector<Node*>& inputs, size_t session)>;
+    
+    Pipeline();
+    ~Pipeline() _OPENMA_NOEXCEPT;
+    
+    int addStage(const std::string& name, Stage stage, const std::vector<int>& dependencies = {});
+    int stages() const _OPENMA_NOEXCEPT;
+    const std::string& stageName(int index) const;
+    
+    unsigned threads() const _OPENMA_NOEXCEPT;
+    void setThreads(unsigned value) _OPENMA_NOEXCEPT;
+    size_t capacity() const _OPENMA_NOEXCEPT;
+    void setCapacity(size_t value) _OPENMA_NOEXCEPT;
+    
+    bool run(size_t sessions);
+    const std::vector<size_t>& failures() const _OPENMA_NOEXCEPT;
+    
+    Pipeline(const Pipeline& ) = delete;
+    Pipeline(Pipeline&& ) _OPENMA_NOEXCEPT = delete;
+    Pipeline& operator=(const Pipeline& ) = delete;
+    Pipeline& operator=(Pipeline&& ) _OPENMA_NOEXCEPT = delete;
+    
+  private:
+    struct Private;
+    Private* mp_Pimpl;
+  };
+};
+
+#endif // __openma_base_pipeline_h
@@ -0,0 +1,122 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_base_profiler_h
+#define __openma_base_profiler_h
+
+#include "openma/base_export.h"
+#include "openma/base/macros.h" // _OPENMA_NOEXCEPT
+
+#include <string>
+#include <cstdint> // uint64_t
+
+namespace ma
+{
+  class Node;
+  
+  class OPENMA_BASE_EXPORT Profiler
+  {
+  public:
+    class OPENMA_BASE_EXPORT Scope
+    {
+    public:
+      Scope(const char* name) _OPENMA_NOEXCEPT;
+      ~Scope() _OPENMA_NOEXCEPT;
+      
+      Scope(const Scope& ) = delete;
+      Scope(Scope&& ) _OPENMA_NOEXCEPT = delete;
+      Scope& operator=(const Scope& ) = delete;
+      Scope& operator=(Scope&& ) _OPENMA_NOEXCEPT = delete;
+      
+    private:
+      bool m_Active;
+    };
+    
+    class OPENMA_BASE_EXPORT Attach
+    {
+    public:
+      Attach(const void* context) _OPENMA_NOEXCEPT;
+      ~Attach() _OPENMA_NOEXCEPT;
+      
+      Attach(const Attach& ) = delete;
+      Attach(Attach&& ) _OPENMA_NOEXCEPT = delete;
+      Attach& operator=(const Attach& ) = delete;
+      Attach& operator=(Attach&& ) _OPENMA_NOEXCEPT = delete;
+      
+    private:
+      const void* mp_Previous;
+      bool m_Active;
+    };
+    
+    static bool isEnabled() _OPENMA_NOEXCEPT;
+    static void setEnabled(bool value) _OPENMA_NOEXCEPT;
+    static void reset() _OPENMA_NOEXCEPT;
+    
+    static void count(const char* name, uint64_t value = 1) _OPENMA_NOEXCEPT;
+    static const void* context() _OPENMA_NOEXCEPT;
+    
+    static Node* exportNode(Node* parent = nullptr);
+    static std::string exportJSON();
+    static std::string exportChromeTrace();
+    
+    ~Profiler() _OPENMA_NOEXCEPT;
+    
+    Profiler(const Profiler& ) = delete;
+    Profiler(Profiler&& ) _OPENMA_NOEXCEPT = delete;
+    Profiler& operator=(const Profiler& ) = delete;
+    Profiler& operator=(Profiler&& ) _OPENMA_NOEXCEPT = delete;
+    
+  private:
+    Profiler();
+    static Profiler& instance();
+    
+    struct Private;
+    Private* mp_Pimpl;
+  };
+};
+
+#define __OPENMA_PROFILE_CONCAT2(a,b) a##b
+#define __OPENMA_PROFILE_CONCAT(a,b) __OPENMA_PROFILE_CONCAT2(a,b)
+
+/**
+ * Macro to time the enclosing block under the given @a name (see Profiler::Scope).
+ */
+#define OPENMA_PROFILE_SCOPE(name) ma::Profiler::Scope __OPENMA_PROFILE_CONCAT(_openma_profile_scope_,__LINE__)(name)
+
+/**
+ * Macro to increment the counter @a name of the current scope by @a value (see Profiler::count()).
+ */
+#define OPENMA_PROFILE_COUNT(name,value) do {if (ma::Profiler::isEnabled()) ma::Profiler::count(name,static_cast<uint64_t>(value));} while (0)
+
+#endif // __openma_base_profiler_h
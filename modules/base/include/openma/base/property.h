@@ -40,9 +40,11 @@
 #include "openma/base/macros.h" // _OPENMA_CONSTEXPR, _OPENMA_NOEXCEPT
 
 #include <type_traits>
+#include <vector>
+#include <string>
 
 /**
- * Add a private StaticProperties structure and the methods staticProperty() and setStaticProperty().
+ * Add a private StaticProperties structure and the methods staticProperty(), setStaticProperty() and staticPropertyKeys().
  * For a class to use this macro it may need to derive from the class ma::Node (or any inheriting class) but its private implementation must be a based one.
  * @sa Property
  * @relates ma::Node
@@ -60,10 +62,14 @@
   { \
     return class##Private::StaticProperties::visit(this->pint(),key,value); \
   }; \
+  virtual void staticPropertyKeys(std::vector<std::string>* keys, bool mutableOnly) const \
+  { \
+    class##Private::StaticProperties::collect(keys,mutableOnly); \
+  }; \
   private:
 
 /**
- * Add a private StaticProperties structure and the methods staticProperty() and setStaticProperty().
+ * Add a private StaticProperties structure and the methods staticProperty(), setStaticProperty() and staticPropertyKeys().
  * Compared to the macro OPENMA_DECLARE_STATIC_PROPERTIES_BASE(), this one is for derived private implementation.
  * @sa Property
  * @relates ma::Node
@@ -82,6 +88,11 @@
   { \
     return (this->baseclass##Private::setStaticProperty(key,value) ? true : derivedclass##Private::StaticProperties::visit(this->pint(),key,value)); \
   }; \
+  virtual void staticPropertyKeys(std::vector<std::string>* keys, bool mutableOnly) const override \
+  { \
+    this->baseclass##Private::staticPropertyKeys(keys,mutableOnly); \
+    derivedclass##Private::StaticProperties::collect(keys,mutableOnly); \
+  }; \
   private:
 
 #define __OPENMA_STATIC_PROPERTIES(...) \
@@ -121,6 +132,11 @@ namespace ma
       else
         (obj->*M)(value);
     }
+    
+    bool isMutable() const _OPENMA_NOEXCEPT
+    {
+      return (M != nullptr);
+    }
   };
   
   /**
@@ -241,6 +257,11 @@ namespace ma
    * @fn void template <typename T, typename U> Property<T,U>::set(T* obj, U value) const _OPENMA_NOEXCEPT
    * Sets the given @a value to the given object @a obj using the mutator set in the 4rd template argument <c>void (T::*M)(U)</c>.
    */
+  
+  /**
+   * @fn bool template <typename T, typename U> Property<T,U>::isMutable() const _OPENMA_NOEXCEPT
+   * Returns true if a mutator was given to this property (i.e. its value can be restored with the method set()).
+   */
    
   namespace __details
   {   
@@ -253,6 +274,12 @@ namespace ma
         const auto& properties = Derived::make_properties();
         return search<0,std::tuple_size<typename std::decay<decltype(properties)>::type>::value-1>(properties,obj,key,val);
       };
+      
+      static inline void collect(std::vector<std::string>* keys, bool mutableOnly)
+      {
+        const auto& properties = Derived::make_properties();
+        gather<0,std::tuple_size<typename std::decay<decltype(properties)>::type>::value-1>(properties,keys,mutableOnly);
+      };
   
     private:
       
@@ -292,6 +319,21 @@ namespace ma
       {
         return accept(std::get<Size>(properties),obj,key,val);
       };
+      
+      template <size_t Index, size_t Size, typename Props>
+      static inline typename std::enable_if<Index != Size>::type gather(Props&& properties, std::vector<std::string>* keys, bool mutableOnly)
+      {
+        gather<Index,Index>(std::forward<Props>(properties),keys,mutableOnly);
+        gather<Index+1,Size>(std::forward<Props>(properties),keys,mutableOnly);
+      };
+      
+      template <size_t Index, size_t Size, typename Props>
+      static inline typename std::enable_if<Index == Size>::type gather(Props&& properties, std::vector<std::string>* keys, bool mutableOnly)
+      {
+        const auto& prop = std::get<Index>(properties);
+        if (!mutableOnly || prop.isMutable())
+          keys->emplace_back(prop.Label,prop.Size);
+      };
     };
 
     /**
@@ -312,6 +354,11 @@ namespace ma
      * Visit known static properties defined in @a Derived and if one of them corresponds to the @a key, then the assocated accessor and/or mutator is applied on the callable object @a obj combined with the value @a val.
      */
   
+    /**
+     * @fn template <typename Derived> static inline void _Properties<Derived>::collect(std::vector<std::string>* keys, bool mutableOnly)
+     * Append the label of the static properties defined in @a Derived to @a keys. If @a mutableOnly is set to true, only the properties with a mutator are appended.
+     */
+  
     /**
      * @fn template <typename Derived> template <typename Prop, typename Object, typename Value> static inline bool _Properties<Derived>::accept(Prop&& prop, Object* obj, const char* key, Value* val)
      * Check if the given @a label correspond to the name of the property. 
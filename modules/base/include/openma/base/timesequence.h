@@ -68,6 +68,31 @@ namespace ma
       Analog   = 0x1000,
       Other    = 0x10000
     } Type;
+    
+    enum class Storage : int {
+      Double = 0,
+      Float,
+      Int16
+    };
+    
+    class OPENMA_BASE_EXPORT Writer
+    {
+    public:
+      explicit Writer(TimeSequence* source);
+      ~Writer() _OPENMA_NOEXCEPT;
+      
+      Writer(const Writer& ) = delete;
+      Writer(Writer&& other) _OPENMA_NOEXCEPT;
+      Writer& operator=(const Writer& ) = delete;
+      Writer& operator=(Writer&& ) _OPENMA_NOEXCEPT = delete;
+      
+      double* data() const _OPENMA_NOEXCEPT;
+      void* rawData() const _OPENMA_NOEXCEPT;
+      
+    private:
+      TimeSequence* mp_Source;
+      bool m_Exposed;
+    };
 #if defined(_MSC_VER) && (_MSC_VER < 1900)
     static _OPENMA_CONSTEXPR std::array<double,2> InfinityRange;
 #else
@@ -113,21 +138,43 @@ namespace ma
     const std::array<double,2>& range() const _OPENMA_NOEXCEPT;
     void setRange(const std::array<double,2>& value) _OPENMA_NOEXCEPT;
     
+    Storage storage() const _OPENMA_NOEXCEPT;
+    void setStorage(Storage value);
+    size_t elementSize() const _OPENMA_NOEXCEPT;
+    
     const double* data() const _OPENMA_NOEXCEPT;
     double* data() _OPENMA_NOEXCEPT;
+    const void* rawData() const _OPENMA_NOEXCEPT;
+    void* rawData() _OPENMA_NOEXCEPT;
+    
+    void read(unsigned component, unsigned first, unsigned count, double* values) const _OPENMA_NOEXCEPT;
+    void write(unsigned component, unsigned first, unsigned count, const double* values);
     
     template <typename... Is> double data(unsigned sample, Is... indices) const _OPENMA_NOEXCEPT;
     template <typename... Is> double& data(unsigned sample, Is... indices) _OPENMA_NOEXCEPT;
     
     void resize(unsigned samples);
     
+    unsigned capacity() const _OPENMA_NOEXCEPT;
+    unsigned stride() const _OPENMA_NOEXCEPT;
+    void reserve(unsigned samples);
+    void shrinkToFit();
+    void append(const double* values, unsigned samples);
+    
+    void enableRingBuffer(unsigned capacity);
+    void disableRingBuffer();
+    bool isRingBuffer() const _OPENMA_NOEXCEPT;
+    bool isLinearized() const _OPENMA_NOEXCEPT;
+    void linearize();
+    
   protected:
     virtual Node* allocateNew() const override;
     virtual void copyContents(const Node* source) _OPENMA_NOEXCEPT override;
   
   private:
     TimeSequence(const std::string& name, Node* parent = nullptr);
-    double& data(unsigned sample, std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT;
+    double& data(unsigned sample, std::initializer_list<unsigned>&& indices) _OPENMA_NOEXCEPT;
+    double value(unsigned sample, std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT;
   };
   
   OPENMA_BASE_EXPORT bool compare_timesequences_properties(const std::vector<TimeSequence*>& tss, double& sampleRate, double& startTime, unsigned& samples);
@@ -140,7 +187,7 @@ namespace ma
   template <typename... Is>
   inline double TimeSequence::data(unsigned sample, Is... indices) const _OPENMA_NOEXCEPT
   {
-    return this->data(sample, {static_cast<unsigned>(indices)...});
+    return this->value(sample, {static_cast<unsigned>(indices)...});
   };
   
   template <typename... Is>
@@ -47,11 +47,25 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <initializer_list>
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex>
 
 namespace ma
 {
   class TimeSequence;
   
+  /*
+   * Control block of the buffer storing the elements of a time sequence.
+   * The buffer can be shared between copies of a time sequence. Its mutex serializes only the detachment of these copies (see TimeSequencePrivate::detach()).
+   */
+  struct TimeSequenceBuffer
+  {
+    TimeSequenceBuffer(size_t numbytes) : Elements(new char[numbytes]), Guard() {};
+    std::unique_ptr<char[]> Elements;
+    std::mutex Guard;
+  };
+  
   class TimeSequencePrivate : public NodePrivate
   {
     OPENMA_DECLARE_PINT_ACCESSOR(TimeSequence)
@@ -73,8 +87,24 @@ namespace ma
     TimeSequencePrivate(TimeSequence* pint, const std::string& name, const std::vector<unsigned>& dimensions, unsigned samples, double rate, double start, int type, const std::string& unit, double scale, double offset, const std::array<double,2>& range);
     ~TimeSequencePrivate() _OPENMA_NOEXCEPT;
     
+    void reallocate(unsigned capacity);
+    std::shared_ptr<TimeSequenceBuffer> duplicate() const;
+    void detach();
+    void expose();
+    bool isShared() const;
+    void rotate();
+    char* elements() const _OPENMA_NOEXCEPT;
+    size_t elementSize() const _OPENMA_NOEXCEPT;
+    size_t column(std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT;
+    size_t row(unsigned sample) const _OPENMA_NOEXCEPT;
+    void widen(const char* in, double* out, size_t num) const _OPENMA_NOEXCEPT;
+    void narrow(const double* in, char* out, size_t num) const _OPENMA_NOEXCEPT;
+    
     std::vector<unsigned> Dimensions, AccumulatedDimensions;
     unsigned Samples;
+    unsigned Capacity; // Number of samples allocated for each component (i.e. the stride between two components)
+    unsigned Head; // Index of the first sample in the storage (used only by the ring buffer)
+    bool RingBuffer;
     double SampleRate;
     double StartTime;
     int Type;
@@ -82,7 +112,9 @@ namespace ma
     double Scale;
     double Offset;
     std::array<double,2> Range;
-    double* Data;
+    TimeSequence::Storage Storage;
+    std::shared_ptr<TimeSequenceBuffer> Data; // Elements are stored using the type given by the member Storage. The buffer can be shared between copies until one of them modifies it (copy-on-write)
+    bool Exposed; // Set when a mutable pointer to the buffer was given. Such a buffer is never shared as the pointer could be used to modify it afterwards.
   };
 };
 
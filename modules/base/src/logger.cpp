@@ -38,6 +38,7 @@
 #include <cstdio> // vsnprintf
 #include <cstring> // strlen
 #include <cstdarg> // va_start, va_end
+#include <mutex>
 
 namespace ma
 {
@@ -53,6 +54,7 @@ namespace ma
     
     Device* Output;
     bool Quiet;
+    std::mutex Guard;
   };
   
   // ----------------------------------------------------------------------- //
@@ -206,6 +208,7 @@ namespace ma
    */
   void Logger::setDevice(Device* output) _OPENMA_NOEXCEPT
   {
+    std::lock_guard<std::mutex> lock(Logger::instance().mp_Pimpl->Guard);
     delete Logger::instance().mp_Pimpl->Output;
     Logger::instance().mp_Pimpl->Output = output;
   };
@@ -248,8 +251,6 @@ namespace ma
   {
     if (this->mp_Pimpl->Quiet)
       return;
-    if (this->mp_Pimpl->Output == nullptr)
-      this->mp_Pimpl->Output = new __details::Console;
     int n = strlen(msg)*2;
     char* str = new char[n];
     while (1)
@@ -283,7 +284,7 @@ namespace ma
         break;
 #endif
     }
-    this->mp_Pimpl->Output->write(category,str);
+    this->sendMessage(category,str);
     delete[] str;
   };
 
@@ -291,11 +292,13 @@ namespace ma
    * Send a message to the set device. If no device is set, a default one is created
    * and send info messages to the std::cout stream and warning and error messages to 
    * the std::cerr stream. You can set a device using the method Logger::setDevice().
+   * The messages are serialized. Thus, they can be sent from several threads.
    */
   void Logger::sendMessage(Message category, const char* msg)
   {
     if (this->mp_Pimpl->Quiet)
       return;
+    std::lock_guard<std::mutex> lock(this->mp_Pimpl->Guard);
     if (this->mp_Pimpl->Output == nullptr)
       this->mp_Pimpl->Output = new __details::Console;
     this->mp_Pimpl->Output->write(category,msg);
@@ -34,8 +34,11 @@
 
 #include "openma/base/node.h"
 #include "openma/base/node_p.h"
+#include "openma/base/propertysource.h"
 #include "openma/base/logger.h"
 
+#include <algorithm> // std::lower_bound
+
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
 // -------------------------------------------------------------------------- //
@@ -46,7 +49,7 @@ namespace ma
 {
   NodePrivate::NodePrivate(Node* pint, const std::string& name)
   : ObjectPrivate(),
-    Name(name), Description(), DynamicProperties(), Parents(), Children(),
+    Name(name), Description(), DynamicProperties(), LazyProperties(), LazyPending(false), LazyMutex(), Parents(), Children(),
 #if defined(USE_REFCOUNT_MECHANISM)
     ReferenceCounter(0),
 #endif
@@ -163,6 +166,33 @@ namespace ma
     }
     return false;
   };
+  
+  /*
+   * Moves the properties proposed by the property source (if any) into the dynamic properties and release the source.
+   * Properties already set in the dynamic properties have the priority over the ones of the source.
+   * This method is called by const methods and can then be run concurrently: the resolution is done under a lock and
+   * the flag LazyPending is cleared only once the dynamic properties are complete.
+   */
+  void NodePrivate::resolvePropertySource() const
+  {
+    if (!this->LazyPending.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> lock(this->LazyMutex);
+    if (!this->LazyProperties)
+      return;
+    std::unordered_map<std::string,Any> props;
+    this->LazyProperties->extract(&props);
+    this->LazyProperties.reset();
+    for (auto& prop : props)
+      this->DynamicProperties.emplace(prop.first, std::move(prop.second));
+    this->LazyPending.store(false, std::memory_order_release);
+  };
+  
+  void NodePrivate::assignPropertySource(std::shared_ptr<const PropertySource> source) _OPENMA_NOEXCEPT
+  {
+    this->LazyProperties = std::move(source);
+    this->LazyPending.store(this->LazyProperties != nullptr, std::memory_order_release);
+  };
 };
 
 #endif
@@ -384,9 +414,15 @@ namespace ma
     bool caught = optr->staticProperty(key.c_str(),&value);
     if (!caught)
     {
+      // The source could be resolved concurrently by another const method
+      std::unique_lock<std::mutex> lock(optr->LazyMutex, std::defer_lock);
+      if (optr->LazyPending.load(std::memory_order_acquire))
+        lock.lock();
       std::unordered_map<std::string,Any>::const_iterator it = optr->DynamicProperties.find(key);
       if (it != optr->DynamicProperties.end())
         value = it->second;
+      else if (optr->LazyProperties)
+        optr->LazyProperties->find(key,&value);
     }
     return value;
   };
@@ -402,6 +438,7 @@ namespace ma
     bool caught = optr->setStaticProperty(key.c_str(),&value);
     if (!caught)
     {
+      optr->resolvePropertySource();
       auto it = optr->DynamicProperties.find(key);
       // Existing property
       if (it != optr->DynamicProperties.end())
@@ -437,9 +474,47 @@ namespace ma
   const std::unordered_map<std::string, Any>& Node::dynamicProperties() const _OPENMA_NOEXCEPT
   {
     auto optr = this->pimpl();
+    optr->resolvePropertySource();
     return optr->DynamicProperties;
   };
   
+  /**
+   * Returns the source of dynamic properties which are not yet resolved, or null if there is none.
+   */
+  const PropertySource* Node::propertySource() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (!optr->LazyPending.load(std::memory_order_acquire))
+      return nullptr;
+    std::lock_guard<std::mutex> lock(optr->LazyMutex);
+    return optr->LazyProperties.get();
+  };
+  
+  /**
+   * Assigns a @a source of dynamic properties. Its properties are not copied: they are only looked up when the method property() is used with a key not found in the dynamic properties already set.
+   * The source is resolved (i.e. its properties are moved into the dynamic properties) the first time the method setProperty() or dynamicProperties() is used.
+   * This is useful for readers exposing a large number of metadata where only a few of them are usually accessed.
+   * The source can be shared between several nodes (e.g. cloned nodes) as it is never modified.
+   * @note The state of the node is not modified by this method.
+   */
+  void Node::setPropertySource(std::shared_ptr<const PropertySource> source) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    optr->assignPropertySource(std::move(source));
+  };
+  
+  /**
+   * Returns the keys of the static properties declared for this node (and the classes it inherits from).
+   * If @a mutableOnly is set to true, only the keys of the static properties which can be modified using the method setProperty() are returned.
+   */
+  std::vector<std::string> Node::staticPropertyKeys(bool mutableOnly) const
+  {
+    auto optr = this->pimpl();
+    std::vector<std::string> keys;
+    optr->staticPropertyKeys(&keys,mutableOnly);
+    return keys;
+  };
+  
   /**
    * @fn template <typename U = Node*> U Node::child(unsigned index) const _OPENMA_NOEXCEPT
    * Returns the node associated with the given @a index or null if out of range.
@@ -534,9 +609,10 @@ namespace ma
   void Node::clear() _OPENMA_NOEXCEPT
   {
     auto optr = this->pimpl();
-    if (optr->Parents.empty() && optr->Children.empty() && optr->DynamicProperties.empty())
+    if (optr->Parents.empty() && optr->Children.empty() && optr->DynamicProperties.empty() && !optr->LazyProperties)
       return;
     optr->DynamicProperties.clear();
+    optr->assignPropertySource(nullptr);
     for (auto it = optr->Children.begin() ; it != optr->Children.end() ; ++it)
     {
       (*it)->pimpl()->detachParent(this);
@@ -560,8 +636,8 @@ namespace ma
    */
   Node* Node::clone(Node* parent) const
   {
-    auto map = std::unordered_map<const Node*,Node*>();
-    return this->cloneContents(parent, map);
+    std::vector<std::pair<const Node*,Node*>> shared;
+    return this->cloneContents(parent, shared);
   };
   
   /**
@@ -581,8 +657,8 @@ namespace ma
       return;
     this->clear();
     this->copyContents(source);
-    auto map = std::unordered_map<const Node*,Node*>{{source, this}};
-    source->cloneChildren(this, map);
+    std::vector<std::pair<const Node*,Node*>> shared;
+    source->cloneChildren(this, shared);
   };
   
   /**
@@ -703,10 +779,15 @@ namespace ma
   {
     auto optr = this->pimpl();
     auto optr_src = source->pimpl();
-    optr->Timestamp = optr_src->Timestamp;
+    optr->Timestamp = optr_src->Timestamp.load();
     optr->Name = optr_src->Name;
     optr->Description = optr_src->Description;
+    // The source node could resolve its property source concurrently
+    std::unique_lock<std::mutex> lock(optr_src->LazyMutex, std::defer_lock);
+    if (optr_src->LazyPending.load(std::memory_order_acquire))
+      lock.lock();
     optr->DynamicProperties = optr_src->DynamicProperties;
+    optr->assignPropertySource(optr_src->LazyProperties);
   };
   
   /**
@@ -716,13 +797,18 @@ namespace ma
    *  2. Copy the member of the @c this object using copyContents()
    *  3. Clone the children using cloneChildren()
    *  4. Add @a parent to the cloned object as one parent.
-   * The use of @a map is necessary to determine children nodes shared inside the tree. 
+   * The index @a shared is necessary to determine children nodes shared inside the tree.
+   * Only the nodes with several parents are recorded in this index (sorted by address). The other ones can be reached only once during the traversal of the tree and are cloned directly.
    */
-  Node* Node::cloneContents(Node* parent, std::unordered_map<const Node*,Node*>& map) const
+  Node* Node::cloneContents(Node* parent, std::vector<std::pair<const Node*,Node*>>& shared) const
   {
     auto dest = this->allocateNew();
-    map.emplace(this,dest);
-    this->cloneChildren(dest, map);
+    if (this->pimpl()->Parents.size() > 1)
+    {
+      auto it = std::lower_bound(shared.begin(), shared.end(), this, [](const std::pair<const Node*,Node*>& lhs, const Node* rhs){return lhs.first < rhs;});
+      shared.emplace(it, this, dest);
+    }
+    this->cloneChildren(dest, shared);
     dest->copyContents(this);
     dest->addParent(parent);
     return dest;
@@ -731,16 +817,21 @@ namespace ma
   /**
    * Clone children by managing shared children in the tree
    */
-  void Node::cloneChildren(Node* parent, std::unordered_map<const Node*,Node*>& map) const
+  void Node::cloneChildren(Node* parent, std::vector<std::pair<const Node*,Node*>>& shared) const
   {
     auto optr = this->pimpl();
     for (const auto& child : optr->Children)
     {
-      auto it = map.find(child);
-      if (it == map.cend())
-        child->cloneContents(parent, map);
-      else
-        it->second->addParent(parent);
+      if (child->pimpl()->Parents.size() > 1)
+      {
+        auto it = std::lower_bound(shared.cbegin(), shared.cend(), child, [](const std::pair<const Node*,Node*>& lhs, const Node* rhs){return lhs.first < rhs;});
+        if ((it != shared.cend()) && (it->first == child))
+        {
+          it->second->addParent(parent);
+          continue;
+        }
+      }
+      child->cloneContents(parent, shared);
     }
   };
   
@@ -919,4 +1010,28 @@ namespace ma
    * @important The generated nodes are allocated on the heap. This is the responsability of the developer to delete these objects if no parent was set in the given arguments.
    * @ingroup openma_base
    */
+  
+  // ----------------------------------------------------------------------- //
+  
+  /**
+   * @class PropertySource openma/base/propertysource.h
+   * @brief Interface to expose dynamic properties of a node on demand.
+   * A property source is assigned to a node using Node::setPropertySource(). The method find() is used to look up a single property when it is requested, while the method extract() must provide all the properties when the node needs to resolve them.
+   * @ingroup openma_base
+   */
+  
+  /**
+   * @fn virtual bool PropertySource::find(const std::string& key, Any* value) const = 0
+   * Sets @a value with the property associated with the given @a key. Returns false if the key is not known by the source.
+   */
+  
+  /**
+   * @fn virtual void PropertySource::extract(std::unordered_map<std::string,Any>* properties) const = 0
+   * Inserts all the properties known by the source into @a properties.
+   */
+  
+  /**
+   * Destructor (default)
+   */
+  PropertySource::~PropertySource() _OPENMA_NOEXCEPT = default;
 };
\ No newline at end of file
@@ -0,0 +1,158 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/base/nodefactory.h"
+#include "openma/base/node.h"
+
+#include <mutex>
+#include <vector>
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+  struct _NodeType_registry
+  {
+    std::mutex Guard;
+    std::vector<NodeType> Types;
+  };
+  
+  static _NodeType_registry& _node_type_registry()
+  {
+    static _NodeType_registry registry;
+    return registry;
+  };
+};
+
+#endif
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+namespace ma
+{
+  /**
+   * @struct NodeType openma/base/nodefactory.h
+   * @brief Description of a node type which can be instanced from its tag.
+   * Serialization formats storing a hierarchy of nodes (e.g. OMA) write the tag of each node and use the registered factory to instance it back.
+   * The member @a Restore is optional and is called once the whole hierarchy is rebuilt (e.g. to bind internal pointers to children nodes).
+   * An invalid node type (returned when no registered type is found) has a null @a Create member.
+   * @ingroup openma_base
+   */
+  
+  /**
+   * Register the node type @a id under the given @a tag. The function @a create is used to instance a new node while @a restore (optional) is called after the hierarchy containing the node is rebuilt.
+   * Return false if the tag is empty, if the function @a create is null, or if the tag is already registered.
+   * @note When several registered types can represent a node (see find_node_type(const Node*)), the last registered is used. Thus a base type has to be registered before its derived types.
+   * @relates NodeType
+   * @ingroup openma_base
+   */
+  bool register_node_type(const std::string& tag, typeid_t id, Node* (*create)(const std::string& name, Node* parent), void (*restore)(Node* node))
+  {
+    if (tag.empty() || (create == nullptr))
+      return false;
+    auto& registry = _node_type_registry();
+    std::lock_guard<std::mutex> lock(registry.Guard);
+    for (const auto& type : registry.Types)
+    {
+      if (type.Tag == tag)
+        return false;
+    }
+    registry.Types.push_back(NodeType{tag,id,create,restore});
+    return true;
+  };
+  
+  /**
+   * Remove the node type registered under the given @a tag.
+   * Return false if no node type was registered with this tag.
+   * @relates NodeType
+   * @ingroup openma_base
+   */
+  bool unregister_node_type(const std::string& tag)
+  {
+    auto& registry = _node_type_registry();
+    std::lock_guard<std::mutex> lock(registry.Guard);
+    for (auto it = registry.Types.begin() ; it != registry.Types.end() ; ++it)
+    {
+      if (it->Tag == tag)
+      {
+        registry.Types.erase(it);
+        return true;
+      }
+    }
+    return false;
+  };
+  
+  /**
+   * Return the node type registered under the given @a tag. If no type is found, the returned object has a null @a Create member.
+   * @relates NodeType
+   * @ingroup openma_base
+   */
+  NodeType find_node_type(const std::string& tag)
+  {
+    auto& registry = _node_type_registry();
+    std::lock_guard<std::mutex> lock(registry.Guard);
+    for (const auto& type : registry.Types)
+    {
+      if (type.Tag == tag)
+        return type;
+    }
+    return NodeType{std::string(),typeid_t(),nullptr,nullptr};
+  };
+  
+  /**
+   * Return the last registered node type which @a node can be casted to. If no type is found, the returned object has a null @a Create member.
+   * @relates NodeType
+   * @ingroup openma_base
+   */
+  NodeType find_node_type(const Node* node)
+  {
+    if (node != nullptr)
+    {
+      auto& registry = _node_type_registry();
+      std::lock_guard<std::mutex> lock(registry.Guard);
+      for (auto it = registry.Types.rbegin() ; it != registry.Types.rend() ; ++it)
+      {
+        if (node->isCastable(it->Id))
+          return *it;
+      }
+    }
+    return NodeType{std::string(),typeid_t(),nullptr,nullptr};
+  };
+};
@@ -0,0 +1,68 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/base/parallel.h"
+
+namespace ma
+{
+  /**
+   * Returns the number of threads to use for a parallel task given the @a requested one.
+   * A @a requested value set to 0 means that the number of hardware threads is used (or 1 if this number cannot be determined).
+   * @ingroup openma_base
+   */
+  unsigned parallel_threads(unsigned requested) _OPENMA_NOEXCEPT
+  {
+    if (requested != 0)
+      return requested;
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return (hardware != 0) ? hardware : 1;
+  };
+  
+  /**
+   * @fn template <typename Func> void parallel_for(size_t count, Func&& func, unsigned threads = 0)
+   * Calls @a func for each index in the range [0, @a count) by distributing the indices over several threads.
+   * The number of @a threads follows the rules of the function parallel_threads(). When only one thread is available (or if @a count is lower than 2), the indices are processed sequentially in the calling thread.
+   * The calling thread participates to the work and the function returns only when all the indices were processed.
+   * In case @a func throws an exception, the remaining indices are not processed and the first exception caught is rethrown in the calling thread.
+   * The scopes profiled in the worker threads are attached to the scope open in the calling thread (see Profiler::Attach).
+   *
+   * @code{.unparsed}
+   * std::vector<double> out(in.size());
+   * ma::parallel_for(in.size(), [&](size_t i) {out[i] = in[i] * in[i];});
+   * @endcode
+   *
+   * @important The function @a func must be safe to call concurrently. In particular, the tree of nodes is not protected against concurrent modifications (e.g. creation of children, modification of properties). Only read-only accesses are safe to be done concurrently.
+   * @ingroup openma_base
+   */
+};
@@ -0,0 +1,532 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/base/pipeline.h"
+#include "openma/base/logger.h"
+#include "openma/base/node.h"
+#include "openma/base/parallel.h" // parallel_threads
+#include "openma/base/profiler.h"
+
+#include <algorithm> // std::sort
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility> // std::pair
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+  struct _Pipeline_stage
+  {
+    std::string Name;
+    Pipeline::Stage Function;
+    std::vector<int> Dependencies;
+    std::vector<int> Dependents;
+  };
+  
+  // State of a session in flight. The counters are protected by the guard of the session.
+  struct _Pipeline_session
+  {
+    _Pipeline_session(size_t index, const std::vector<_Pipeline_stage>& stages)
+    : Index(index), Guard(), Waiting(stages.size()), Consumers(stages.size()), Outputs(stages.size(), nullptr), Scheduled(stages.size(), 0), Left(stages.size()), Failed(false)
+    {
+      for (size_t i = 0 ; i < stages.size() ; ++i)
+      {
+        this->Waiting[i] = stages[i].Dependencies.size();
+        this->Consumers[i] = stages[i].Dependents.size();
+        this->Scheduled[i] = this->Waiting[i] == 0 ? 1 : 0;
+      }
+    };
+    
+    size_t Index;
+    std::mutex Guard;
+    std::vector<size_t> Waiting; // Number of dependencies not yet finished
+    std::vector<size_t> Consumers; // Number of dependents not yet finished (the output is released when it reaches 0)
+    std::vector<Node*> Outputs;
+    std::vector<char> Scheduled;
+    size_t Left; // Number of stages not yet finished or skipped
+    bool Failed;
+  };
+  
+  using _Pipeline_task = std::pair<_Pipeline_session*,int>;
+  
+  // Each worker owns a deque of tasks. The owner pops the last task (depth first: the stages of a session are chained before to start another session) while the other workers steal the first one.
+  struct _Pipeline_worker
+  {
+    std::mutex Guard;
+    std::deque<_Pipeline_task> Tasks;
+  };
+  
+  class _Pipeline_scheduler
+  {
+  public:
+    _Pipeline_scheduler(const std::vector<_Pipeline_stage>& stages, size_t workers, size_t sessions, size_t capacity)
+    : m_Stages(stages), m_Workers(), m_Queued(0), m_Guard(), m_Wakeup(), m_Sessions(sessions), m_Admitted(0), m_Done(0), m_Failures()
+    {
+      for (size_t i = 0 ; i < workers ; ++i)
+        this->m_Workers.emplace_back(new _Pipeline_worker);
+      // Backpressure: no more than 'capacity' sessions are in flight
+      for (size_t i = 0 ; (i < capacity) && (i < sessions) ; ++i)
+        this->admit(i % workers, this->m_Admitted++);
+    };
+    
+    void work(size_t idx)
+    {
+      _Pipeline_task task;
+      for (;;)
+      {
+        if (this->pop(idx, &task))
+        {
+          this->execute(idx, task);
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(this->m_Guard);
+        this->m_Wakeup.wait(lock, [this]() {return (this->m_Queued.load() > 0) || (this->m_Done == this->m_Sessions);});
+        if ((this->m_Queued.load() == 0) && (this->m_Done == this->m_Sessions))
+          break;
+      }
+    };
+    
+    std::vector<size_t>& failures() _OPENMA_NOEXCEPT {return this->m_Failures;};
+    
+  private:
+    void admit(size_t idx, size_t index)
+    {
+      auto session = new _Pipeline_session(index, this->m_Stages);
+      OPENMA_PROFILE_COUNT("sessions", 1);
+      for (size_t i = 0 ; i < this->m_Stages.size() ; ++i)
+      {
+        if (this->m_Stages[i].Dependencies.empty())
+          this->push(idx, _Pipeline_task(session, static_cast<int>(i)));
+      }
+    };
+    
+    void push(size_t idx, _Pipeline_task task)
+    {
+      auto worker = this->m_Workers[idx].get();
+      ++this->m_Queued;
+      {
+        std::lock_guard<std::mutex> lock(worker->Guard);
+        worker->Tasks.push_back(task);
+      }
+      // Lock/unlock the guard to not miss a worker checking the predicate
+      {
+        std::lock_guard<std::mutex> lock(this->m_Guard);
+      }
+      this->m_Wakeup.notify_one();
+    };
+    
+    bool pop(size_t idx, _Pipeline_task* task)
+    {
+      if (this->m_Queued.load() == 0)
+        return false;
+      const size_t num = this->m_Workers.size();
+      for (size_t i = 0 ; i < num ; ++i)
+      {
+        auto worker = this->m_Workers[(idx + i) % num].get();
+        std::lock_guard<std::mutex> lock(worker->Guard);
+        if (worker->Tasks.empty())
+          continue;
+        if (i == 0)
+        {
+          *task = worker->Tasks.back();
+          worker->Tasks.pop_back();
+        }
+        else
+        {
+          *task = worker->Tasks.front();
+          worker->Tasks.pop_front();
+          OPENMA_PROFILE_COUNT("steals", 1);
+        }
+        --this->m_Queued;
+        return true;
+      }
+      return false;
+    };
+    
+    void execute(size_t idx, const _Pipeline_task& task)
+    {
+      auto session = task.first;
+      const int current = task.second;
+      const auto& stage = this->m_Stages[current];
+      bool skipped = false;
+      {
+        // Another stage of the session could have failed since this one was scheduled
+        std::lock_guard<std::mutex> lock(session->Guard);
+        skipped = session->Failed;
+      }
+      Node* output = nullptr;
+      bool succeeded = false;
+      if (!skipped)
+      {
+        std::vector<Node*> inputs;
+        inputs.reserve(stage.Dependencies.size());
+        for (const auto& dep : stage.Dependencies)
+          inputs.push_back(session->Outputs[dep]);
+        output = new Node(stage.Name);
+        OPENMA_PROFILE_SCOPE(stage.Name.c_str());
+        try
+        {
+          if (!(succeeded = stage.Function(output, inputs, session->Index)))
+            error("Pipeline - Stage '%s' failed for the session #%zu. The next stages of this session are skipped.", stage.Name.c_str(), session->Index);
+        }
+        catch (std::exception& e)
+        {
+          error("Pipeline - Stage '%s' threw an exception for the session #%zu: %s. The next stages of this session are skipped.", stage.Name.c_str(), session->Index, e.what());
+        }
+        catch (...)
+        {
+          error("Pipeline - Stage '%s' threw an unknown exception for the session #%zu. The next stages of this session are skipped.", stage.Name.c_str(), session->Index);
+        }
+      }
+      std::vector<int> ready;
+      std::vector<Node*> released;
+      bool finished = false;
+      {
+        std::lock_guard<std::mutex> lock(session->Guard);
+        if (!succeeded)
+        {
+          if (output != nullptr)
+            released.push_back(output);
+          if (!session->Failed)
+          {
+            session->Failed = true;
+            // The stages not yet scheduled are skipped
+            for (auto& scheduled : session->Scheduled)
+            {
+              if (scheduled == 0)
+              {
+                scheduled = 1;
+                --session->Left;
+              }
+            }
+          }
+        }
+        else if (stage.Dependents.empty())
+          released.push_back(output);
+        else
+        {
+          session->Outputs[current] = output;
+          for (const auto& dep : stage.Dependents)
+          {
+            if ((--session->Waiting[dep] == 0) && (session->Scheduled[dep] == 0))
+            {
+              session->Scheduled[dep] = 1;
+              ready.push_back(dep);
+            }
+          }
+        }
+        // Intermediate outputs are released as soon as all their consumers are finished
+        for (const auto& dep : stage.Dependencies)
+        {
+          if (--session->Consumers[dep] == 0)
+          {
+            released.push_back(session->Outputs[dep]);
+            session->Outputs[dep] = nullptr;
+          }
+        }
+        if ((finished = (--session->Left == 0)))
+        {
+          // Remaining outputs of a failed session
+          for (auto& out : session->Outputs)
+          {
+            if (out != nullptr)
+              released.push_back(out);
+            out = nullptr;
+          }
+        }
+      }
+      for (auto node : released)
+        delete node;
+      for (auto it = ready.rbegin() ; it != ready.rend() ; ++it)
+        this->push(idx, _Pipeline_task(session, *it));
+      if (!finished)
+        return;
+      const bool failed = session->Failed;
+      const size_t index = session->Index;
+      delete session;
+      // The next session is admitted only when another one is finished (backpressure)
+      bool admission = false, done = false;
+      size_t next = 0;
+      {
+        std::lock_guard<std::mutex> lock(this->m_Guard);
+        if (failed)
+          this->m_Failures.push_back(index);
+        ++this->m_Done;
+        if ((admission = (this->m_Admitted < this->m_Sessions)))
+          next = this->m_Admitted++;
+        done = (this->m_Done == this->m_Sessions);
+      }
+      if (admission)
+        this->admit(idx, next);
+      else if (done)
+        this->m_Wakeup.notify_all();
+    };
+    
+    const std::vector<_Pipeline_stage>& m_Stages;
+    std::vector<std::unique_ptr<_Pipeline_worker>> m_Workers;
+    std::atomic<size_t> m_Queued;
+    std::mutex m_Guard;
+    std::condition_variable m_Wakeup;
+    const size_t m_Sessions;
+    size_t m_Admitted;
+    size_t m_Done;
+    std::vector<size_t> m_Failures;
+  };
+  
+  struct Pipeline::Private
+  {
+    Private() : Stages(), Threads(0), Capacity(0), Failures() {};
+    
+    std::vector<_Pipeline_stage> Stages;
+    unsigned Threads;
+    size_t Capacity;
+    std::vector<size_t> Failures;
+  };
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+namespace ma
+{
+  /**
+   * @class Pipeline openma/base/pipeline.h
+   * @brief Run a graph of processing stages over many sessions concurrently.
+   *
+   * A pipeline is a directed acyclic graph of stages (see addStage()) executed for each session (e.g. each trial of a batch).
+   * Each stage receives a new node (named after the stage) to store its results, and the outputs of the stages it depends on.
+   * A stage can reuse the content of its inputs (e.g. by adding a child of an input to its output with Node::addParent()).
+   * However, stages sharing the same input are executed concurrently and must not modify it.
+   *
+   * The sessions are processed by a pool of threads (see setThreads()) with a work stealing strategy:
+   * each thread chains the stages of its sessions and steals the pending stages of the other threads when it has nothing to do.
+   * The number of sessions in flight is limited (see setCapacity()). A new session starts only when another one is finished.
+   * The output of a stage is released as soon as all its dependents are finished (the output of a stage without dependent is released just after it).
+   * Thus, the peak memory depends on the capacity and not on the number of sessions.
+   *
+   * A stage reports a failure by returning false (or by throwing an exception).
+   * In this case, the next stages of the session are skipped, while the other sessions continue (see failures()).
+   *
+   * @code{.unparsed}
+   * // Batch of static and dynamic trials (one static and one dynamic file per session)
+   * ma::Pipeline pipeline;
+   * auto read = pipeline.addStage("read", [&](ma::Node* output, const std::vector<ma::Node*>& , size_t session) {
+   *   return ma::io::read(output, statics[session]) && ma::io::read(output, dynamics[session]);
+   * });
+   * auto filter = pipeline.addStage("filter", [](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t ) {
+   *   for (auto trial : inputs[0]->findChildren<ma::Trial*>({},{},false))
+   *   {
+   *     trial->addParent(output);
+   *     ma::processing::filter_butterworth_zero_lag(trial->timeSequences()->findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Marker}}), ma::processing::Response::LowPass, 6.0, 4);
+   *   }
+   *   return true;
+   * }, {read});
+   * auto model = pipeline.addStage("reconstruct", [&](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t session) {
+   *   ma::body::PluginGait helper(ma::body::Region::Lower, ma::body::Side::Both);
+   *   // Set the properties of the subject ...
+   *   auto trials = inputs[0]->findChildren<ma::Trial*>({},{},false);
+   *   ma::Node statics("statics"), dynamics("dynamics");
+   *   trials[0]->addParent(&statics);
+   *   trials[1]->addParent(&dynamics);
+   *   return ma::body::calibrate(&helper, &statics, nullptr) && ma::body::reconstruct(output, &helper, &dynamics);
+   * }, {filter});
+   * auto describe = pipeline.addStage("describe", [](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t ) {
+   *   return ma::body::extract_joint_kinematics(output, inputs[0]) && ma::body::extract_joint_kinetics(output, inputs[0]);
+   * }, {model});
+   * pipeline.addStage("write", [&](ma::Node* , const std::vector<ma::Node*>& inputs, size_t session) {
+   *   return ma::io::write(inputs[0], outputs[session]);
+   * }, {describe});
+   * if (!pipeline.run(statics.size()))
+   *   // See pipeline.failures()
+   * @endcode
+   *
+   * @note Each session being processed by one thread at a time (except for independent branches of the graph), the functions used by the stages should not use their own threads (e.g. use the default number of threads for ma::body::reconstruct()).
+   *
+   * @ingroup openma_base
+   */
+  
+  /**
+   * Constructor. The pipeline has no stage and uses all the hardware threads.
+   */
+  Pipeline::Pipeline()
+  : mp_Pimpl(new Pipeline::Private)
+  {};
+  
+  /**
+   * Destructor
+   */
+  Pipeline::~Pipeline() _OPENMA_NOEXCEPT
+  {
+    delete this->mp_Pimpl;
+  };
+  
+  /**
+   * Append a stage to the pipeline and return its index. The @a dependencies are the indices of the stages which must be finished before to run this @a stage.
+   * Their outputs are given to the @a stage in the same order.
+   * Because a stage can only depend on the stages previously added, the graph cannot contain a cycle.
+   * In case of an invalid dependency (or an invalid function), an error is logged, the stage is not added and -1 is returned.
+   */
+  int Pipeline::addStage(const std::string& name, Stage stage, const std::vector<int>& dependencies)
+  {
+    auto optr = this->mp_Pimpl;
+    if (!stage)
+    {
+      error("Pipeline - Stage '%s' has no function. Stage not added.", name.c_str());
+      return -1;
+    }
+    const int index = static_cast<int>(optr->Stages.size());
+    for (const auto& dep : dependencies)
+    {
+      if ((dep < 0) || (dep >= index))
+      {
+        error("Pipeline - Stage '%s' depends on an unknown stage (#%i). Stage not added.", name.c_str(), dep);
+        return -1;
+      }
+    }
+    for (const auto& dep : dependencies)
+      optr->Stages[dep].Dependents.push_back(index);
+    optr->Stages.push_back(_Pipeline_stage{name, std::move(stage), dependencies, {}});
+    return index;
+  };
+  
+  /**
+   * Returns the number of stages.
+   */
+  int Pipeline::stages() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    return static_cast<int>(optr->Stages.size());
+  };
+  
+  /**
+   * Returns the name of the stage at the given @a index.
+   * @warning The index must be valid.
+   */
+  const std::string& Pipeline::stageName(int index) const
+  {
+    auto optr = this->mp_Pimpl;
+    return optr->Stages[index].Name;
+  };
+  
+  /**
+   * Returns the number of threads used to run the sessions. A value of 0 means that all the hardware threads are used.
+   */
+  unsigned Pipeline::threads() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    return optr->Threads;
+  };
+  
+  /**
+   * Sets the number of threads used to run the sessions.
+   * @sa threads()
+   */
+  void Pipeline::setThreads(unsigned value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    optr->Threads = value;
+  };
+  
+  /**
+   * Returns the maximum number of sessions in flight. A value of 0 means twice the number of threads.
+   */
+  size_t Pipeline::capacity() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    return optr->Capacity;
+  };
+  
+  /**
+   * Sets the maximum number of sessions in flight.
+   * @sa capacity()
+   */
+  void Pipeline::setCapacity(size_t value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    optr->Capacity = value;
+  };
+  
+  /**
+   * Run all the stages for the sessions 0 to @a sessions - 1. The sessions start in ascending order, but can finish in any order.
+   * Returns true if all the stages succeeded for all the sessions. Otherwise, the failed sessions are listed by failures().
+   */
+  bool Pipeline::run(size_t sessions)
+  {
+    OPENMA_PROFILE_SCOPE("Pipeline::run");
+    auto optr = this->mp_Pimpl;
+    optr->Failures.clear();
+    if (optr->Stages.empty() || (sessions == 0))
+      return true;
+    const size_t workers = std::min(static_cast<size_t>(parallel_threads(optr->Threads)), sessions);
+    const size_t capacity = (optr->Capacity == 0) ? 2 * workers : optr->Capacity;
+    _Pipeline_scheduler scheduler(optr->Stages, workers, sessions, capacity);
+    const void* context = Profiler::context();
+    auto work = [&](size_t idx) {
+      Profiler::Attach attach(context);
+      scheduler.work(idx);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t i = 1 ; i < workers ; ++i)
+      pool.emplace_back(work, i);
+    work(0);
+    for (auto& thread : pool)
+      thread.join();
+    optr->Failures.swap(scheduler.failures());
+    std::sort(optr->Failures.begin(), optr->Failures.end());
+    return optr->Failures.empty();
+  };
+  
+  /**
+   * Returns the index of the sessions which failed during the last run (sorted in ascending order).
+   */
+  const std::vector<size_t>& Pipeline::failures() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->mp_Pimpl;
+    return optr->Failures;
+  };
+};
@@ -0,0 +1,692 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/base/profiler.h"
+#include "openma/base/node.h"
+#include "openma/base/logger.h"
+
+#include <algorithm> // std::min, std::max, std::move
+#include <atomic>
+#include <chrono>
+#include <cstdio> // snprintf
+#include <cstring> // strcmp
+#include <iterator> // std::back_inserter
+#include <limits>
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <utility> // std::pair
+#include <vector>
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+  using _Profiler_clock = std::chrono::steady_clock;
+  using _Profiler_counters = std::vector<std::pair<const char*,uint64_t>>;
+  
+  static inline void _profiler_accumulate(_Profiler_counters* counters, const char* name, uint64_t value)
+  {
+    for (auto& counter : *counters)
+    {
+      if (strcmp(counter.first,name) == 0)
+      {
+        counter.second += value;
+        return;
+      }
+    }
+    counters->emplace_back(name,value);
+  };
+  
+  // Aggregated statistics of all the scopes sharing the same name under the same parent
+  struct _Profiler_entry
+  {
+    _Profiler_entry(const std::string& name, _Profiler_entry* parent)
+    : Name(name), Parent(parent), Children(), Calls(0), Total(0), Min(std::numeric_limits<int64_t>::max()), Max(0), Counters()
+    {};
+    
+    _Profiler_entry* child(const char* name)
+    {
+      for (auto& child : this->Children)
+      {
+        if (child->Name == name)
+          return child.get();
+      }
+      this->Children.emplace_back(new _Profiler_entry(name,this));
+      return this->Children.back().get();
+    };
+    
+    void clear()
+    {
+      this->Children.clear();
+      this->reset();
+    };
+    
+    // Statistics are cleared but the entries are kept as they can be referenced by the open scopes and the contexts
+    void reset()
+    {
+      for (auto& child : this->Children)
+        child->reset();
+      this->Calls = 0;
+      this->Total = 0;
+      this->Min = std::numeric_limits<int64_t>::max();
+      this->Max = 0;
+      this->Counters.clear();
+    };
+    
+    bool empty() const
+    {
+      if ((this->Calls != 0) || !this->Counters.empty())
+        return false;
+      for (const auto& child : this->Children)
+      {
+        if (!child->empty())
+          return false;
+      }
+      return true;
+    };
+    
+    // Only the entries with recorded data are merged
+    void merge(const _Profiler_entry* other)
+    {
+      this->Calls += other->Calls;
+      this->Total += other->Total;
+      this->Min = std::min(this->Min, other->Min);
+      this->Max = std::max(this->Max, other->Max);
+      for (const auto& counter : other->Counters)
+        _profiler_accumulate(&(this->Counters), counter.first, counter.second);
+      for (const auto& child : other->Children)
+      {
+        if (!child->empty())
+          this->child(child->Name.c_str())->merge(child.get());
+      }
+    };
+    
+    std::string Name;
+    _Profiler_entry* Parent;
+    std::vector<std::unique_ptr<_Profiler_entry>> Children;
+    uint64_t Calls;
+    int64_t Total; // ns
+    int64_t Min; // ns
+    int64_t Max; // ns
+    _Profiler_counters Counters;
+  };
+  
+  // Scope currently open in a thread
+  struct _Profiler_frame
+  {
+    _Profiler_entry* Entry;
+    const char* Name;
+    _Profiler_clock::time_point Start;
+    _Profiler_counters Counters;
+  };
+  
+  // Single execution of a scope (used by the Chrome trace)
+  struct _Profiler_event
+  {
+    const char* Name;
+    unsigned Thread;
+    int64_t Begin; // ns
+    int64_t Duration; // ns
+    _Profiler_counters Counters;
+  };
+  
+  // Data recorded by a thread. Only the owner thread records into it, the lock is contended only by the exports and reset().
+  struct _Profiler_buffer
+  {
+    _Profiler_buffer(unsigned index)
+    : Guard(), Index(index), Root("Profiler",nullptr), Base(nullptr), Stack(), Events()
+    {};
+    
+    _Profiler_entry* current()
+    {
+      if (!this->Stack.empty())
+        return this->Stack.back().Entry;
+      return (this->Base != nullptr) ? this->Base : &(this->Root);
+    };
+    
+    std::mutex Guard;
+    unsigned Index; // Slot of the thread (reused once the thread exits), used as thread id by the Chrome trace
+    _Profiler_entry Root;
+    _Profiler_entry* Base; // Entry used when no scope is open (see Profiler::Attach)
+    std::vector<_Profiler_frame> Stack;
+    std::vector<_Profiler_event> Events;
+  };
+  
+  struct Profiler::Private
+  {
+    // Maximum number of events kept for the Chrome trace. Scopes closed after that are only aggregated.
+    static _OPENMA_CONSTEXPR size_t MaxEvents = 1u << 20;
+    
+    // Give back the buffer of a thread when it exits
+    struct Local
+    {
+      Local() : Owner(nullptr), Buffer(nullptr) {};
+      ~Local() _OPENMA_NOEXCEPT
+      {
+        if (this->Buffer != nullptr)
+          this->Owner->release(this->Buffer);
+      };
+      Private* Owner;
+      _Profiler_buffer* Buffer;
+    };
+    
+    Private()
+    : Enabled(false), Attached(0), Recorded(0), Dropped(0), Origin(_Profiler_clock::now().time_since_epoch().count()), Guard(), Buffers(), Retired("Profiler",nullptr), RetiredEvents()
+    {};
+    ~Private() _OPENMA_NOEXCEPT
+    {
+      for (auto buffer : this->Buffers)
+        delete buffer;
+    };
+    
+    Private(const Private& ) = delete;
+    Private(Private&& ) _OPENMA_NOEXCEPT = delete;
+    Private& operator=(const Private& ) = delete;
+    Private& operator=(Private&& ) _OPENMA_NOEXCEPT = delete;
+    
+    // The global lock is only taken the first time a thread records something
+    _Profiler_buffer& buffer()
+    {
+      static thread_local Local local;
+      if (local.Buffer == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(this->Guard);
+        size_t slot = 0;
+        while ((slot < this->Buffers.size()) && (this->Buffers[slot] != nullptr))
+          ++slot;
+        auto buffer = new _Profiler_buffer(static_cast<unsigned>(slot));
+        if (slot == this->Buffers.size())
+          this->Buffers.push_back(buffer);
+        else
+          this->Buffers[slot] = buffer;
+        local.Owner = this;
+        local.Buffer = buffer;
+      }
+      return *(local.Buffer);
+    };
+    
+    // The data of the exiting thread are kept and its slot can be reused by another thread
+    void release(_Profiler_buffer* buffer)
+    {
+      std::lock_guard<std::mutex> lock(this->Guard);
+      this->Retired.merge(&(buffer->Root));
+      std::move(buffer->Events.begin(), buffer->Events.end(), std::back_inserter(this->RetiredEvents));
+      this->Buffers[buffer->Index] = nullptr;
+      delete buffer;
+    };
+    
+    // Must be called with the global lock
+    void merge(_Profiler_entry* root)
+    {
+      root->merge(&(this->Retired));
+      for (auto buffer : this->Buffers)
+      {
+        if (buffer == nullptr)
+          continue;
+        std::lock_guard<std::mutex> lock(buffer->Guard);
+        root->merge(&(buffer->Root));
+      }
+    };
+    
+    int64_t elapsed(const _Profiler_clock::time_point& tp) const
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch() - _Profiler_clock::duration(this->Origin.load(std::memory_order_relaxed))).count();
+    };
+    
+    std::atomic<bool> Enabled;
+    std::atomic<unsigned> Attached;
+    std::atomic<size_t> Recorded;
+    std::atomic<size_t> Dropped;
+    std::atomic<_Profiler_clock::rep> Origin;
+    std::mutex Guard; // Protects the following members
+    std::vector<_Profiler_buffer*> Buffers;
+    _Profiler_entry Retired;
+    std::vector<_Profiler_event> RetiredEvents;
+  };
+  
+  _OPENMA_CONSTEXPR size_t Profiler::Private::MaxEvents;
+  
+  static inline std::string _profiler_escape(const std::string& str)
+  {
+    std::string out;
+    out.reserve(str.size());
+    for (const char c : str)
+    {
+      if ((c == '"') || (c == '\\'))
+      {
+        out += '\\';
+        out += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+      {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+        out += buf;
+      }
+      else
+        out += c;
+    }
+    return out;
+  };
+  
+  static inline std::string _profiler_number(double value)
+  {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.6f", value);
+    return buf;
+  };
+  
+  static void _profiler_counters_json(std::string* out, const _Profiler_counters& counters)
+  {
+    *out += "{";
+    for (size_t i = 0 ; i < counters.size() ; ++i)
+      *out += (i ? "," : "") + std::string("\"") + _profiler_escape(counters[i].first) + "\":" + std::to_string(counters[i].second);
+    *out += "}";
+  };
+  
+  static void _profiler_entry_json(std::string* out, const _Profiler_entry* entry)
+  {
+    const double total = static_cast<double>(entry->Total) * 1.0e-6;
+    *out += "{\"name\":\"" + _profiler_escape(entry->Name) + "\"";
+    *out += ",\"calls\":" + std::to_string(entry->Calls);
+    *out += ",\"total_ms\":" + _profiler_number(total);
+    *out += ",\"mean_ms\":" + _profiler_number((entry->Calls != 0) ? total / static_cast<double>(entry->Calls) : 0.0);
+    *out += ",\"min_ms\":" + _profiler_number((entry->Calls != 0) ? static_cast<double>(entry->Min) * 1.0e-6 : 0.0);
+    *out += ",\"max_ms\":" + _profiler_number(static_cast<double>(entry->Max) * 1.0e-6);
+    *out += ",\"counters\":";
+    _profiler_counters_json(out, entry->Counters);
+    *out += ",\"children\":[";
+    for (size_t i = 0 ; i < entry->Children.size() ; ++i)
+    {
+      if (i != 0)
+        *out += ",";
+      _profiler_entry_json(out, entry->Children[i].get());
+    }
+    *out += "]}";
+  };
+  
+  static void _profiler_entry_node(Node* parent, const _Profiler_entry* entry)
+  {
+    auto node = new Node(entry->Name, parent);
+    node->setProperty("calls", static_cast<unsigned long long>(entry->Calls));
+    node->setProperty("total", static_cast<double>(entry->Total) * 1.0e-9);
+    node->setProperty("mean", (entry->Calls != 0) ? static_cast<double>(entry->Total) * 1.0e-9 / static_cast<double>(entry->Calls) : 0.0);
+    node->setProperty("min", (entry->Calls != 0) ? static_cast<double>(entry->Min) * 1.0e-9 : 0.0);
+    node->setProperty("max", static_cast<double>(entry->Max) * 1.0e-9);
+    for (const auto& counter : entry->Counters)
+      node->setProperty(counter.first, static_cast<unsigned long long>(counter.second));
+    for (const auto& child : entry->Children)
+      _profiler_entry_node(node, child.get());
+  };
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+namespace ma
+{
+  /**
+   * @class Profiler::Scope openma/base/profiler.h
+   * @brief Time the execution of a block of code.
+   *
+   * The timer starts with the construction of the object and stops with its destruction.
+   * The execution time is aggregated (number of calls, total, minimum and maximum) in the tree of the profiler under the scope currently open in the same thread.
+   * Thus, nested scopes create nested entries.
+   * If the profiler is disabled, the constructor only checks the state of the profiler and nothing is recorded.
+   *
+   * The macro OPENMA_PROFILE_SCOPE() can be used to create an anonymous scope.
+   *
+   * @code{.unparsed}
+   * bool Foo::run(Node* inout)
+   * {
+   *   OPENMA_PROFILE_SCOPE("Foo::run");
+   *   // ...
+   * };
+   * @endcode
+   *
+   * @note The given name must have a static storage duration (e.g. a string literal).
+   */
+  
+  /**
+   * Start the timer if the profiler is enabled.
+   */
+  Profiler::Scope::Scope(const char* name) _OPENMA_NOEXCEPT
+  : m_Active(false)
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    if (!optr->Enabled.load(std::memory_order_relaxed))
+      return;
+    auto& buffer = optr->buffer();
+    std::lock_guard<std::mutex> lock(buffer.Guard);
+    auto entry = buffer.current()->child(name);
+    buffer.Stack.push_back(_Profiler_frame{entry, name, _Profiler_clock::now(), {}});
+    this->m_Active = true;
+  };
+  
+  /**
+   * Stop the timer and record the elapsed time (as well as the counters incremented during the scope).
+   */
+  Profiler::Scope::~Scope() _OPENMA_NOEXCEPT
+  {
+    if (!this->m_Active)
+      return;
+    const auto end = _Profiler_clock::now();
+    auto optr = Profiler::instance().mp_Pimpl;
+    auto& buffer = optr->buffer();
+    std::lock_guard<std::mutex> lock(buffer.Guard);
+    if (buffer.Stack.empty()) // The profiler was reset during the scope
+      return;
+    _Profiler_frame frame = std::move(buffer.Stack.back());
+    buffer.Stack.pop_back();
+    const int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - frame.Start).count();
+    auto entry = frame.Entry;
+    entry->Calls += 1;
+    entry->Total += duration;
+    entry->Min = std::min(entry->Min, duration);
+    entry->Max = std::max(entry->Max, duration);
+    for (const auto& counter : frame.Counters)
+      _profiler_accumulate(&(entry->Counters), counter.first, counter.second);
+    if (optr->Recorded.fetch_add(1, std::memory_order_relaxed) < Profiler::Private::MaxEvents)
+      buffer.Events.push_back(_Profiler_event{frame.Name, buffer.Index, optr->elapsed(frame.Start), duration, std::move(frame.Counters)});
+    else
+      optr->Dropped.fetch_add(1, std::memory_order_relaxed);
+  };
+  
+  /**
+   * @class Profiler::Attach openma/base/profiler.h
+   * @brief Attach the scopes opened in a thread to a scope opened in another thread.
+   *
+   * Without this object, the scopes opened in a worker thread would be recorded at the root of the profiler tree.
+   * The @a context must be retrieved in the parent thread with Profiler::context(). The function parallel_for() uses it to keep the tree coherent.
+   * As each thread records into its own buffer, the path of the context is reproduced in the buffer of the current thread. The buffers are merged when the data are exported.
+   */
+  
+  /**
+   * Use the given @a context as the parent of the scopes opened in the current thread (while no other scope is open).
+   */
+  Profiler::Attach::Attach(const void* context) _OPENMA_NOEXCEPT
+  : mp_Previous(nullptr), m_Active(false)
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    if ((context == nullptr) || !optr->Enabled.load(std::memory_order_relaxed))
+      return;
+    optr->Attached.fetch_add(1);
+    // Names and parents of the entries are never modified: the path can be read while the other thread records.
+    std::vector<const char*> path;
+    for (auto entry = static_cast<const _Profiler_entry*>(context) ; entry->Parent != nullptr ; entry = entry->Parent)
+      path.push_back(entry->Name.c_str());
+    auto& buffer = optr->buffer();
+    std::lock_guard<std::mutex> lock(buffer.Guard);
+    this->mp_Previous = buffer.Base;
+    _Profiler_entry* base = &(buffer.Root);
+    for (auto it = path.crbegin() ; it != path.crend() ; ++it)
+      base = base->child(*it);
+    buffer.Base = base;
+    this->m_Active = true;
+  };
+  
+  /**
+   * Restore the previous context.
+   */
+  Profiler::Attach::~Attach() _OPENMA_NOEXCEPT
+  {
+    if (!this->m_Active)
+      return;
+    auto optr = Profiler::instance().mp_Pimpl;
+    auto& buffer = optr->buffer();
+    {
+      std::lock_guard<std::mutex> lock(buffer.Guard);
+      buffer.Base = const_cast<_Profiler_entry*>(static_cast<const _Profiler_entry*>(this->mp_Previous));
+    }
+    optr->Attached.fetch_sub(1);
+  };
+  
+  /**
+   * @class Profiler openma/base/profiler.h
+   * @brief Lightweight instrumentation of the hot paths (scoped timers and counters).
+   *
+   * The profiler aggregates the execution time of the scopes (see Profiler::Scope) and the value of counters (see Profiler::count()) in a tree.
+   * Each entry of the tree corresponds to a scope name under a given parent scope. The instrumentation is compiled in the library but disabled by default.
+   * When disabled, each scope and counter costs only the check of an atomic flag.
+   * When enabled, each thread records into its own buffer (its lock is only contended by the exports). The buffers are merged when the data are exported and the buffer of a thread is merged into the global data when the thread exits.
+   *
+   * The main processing functions are instrumented (e.g. HandlerReader::read(), SkeletonHelper::reconstruct(), PoseEstimator::run(), ForcePlate::wrench()).
+   * The collected data can be exported as a tree of nodes (exportNode()), as a JSON document (exportJSON()) or as a Chrome trace (exportChromeTrace()) to visualize the timeline of each thread (e.g. with chrome://tracing).
+   *
+   * @code{.unparsed}
+   * ma::Profiler::setEnabled(true);
+   * ma::body::reconstruct(&root, &helper, &trials);
+   * std::ofstream("trace.json") << ma::Profiler::exportChromeTrace();
+   * @endcode
+   *
+   * @ingroup openma_base
+   */
+  
+  /**
+   * Returns true if the profiler records the scopes and counters.
+   */
+  bool Profiler::isEnabled() _OPENMA_NOEXCEPT
+  {
+    return Profiler::instance().mp_Pimpl->Enabled.load(std::memory_order_relaxed);
+  };
+  
+  /**
+   * Enable/disable the profiler. The recorded data are kept when the profiler is disabled (see reset()).
+   */
+  void Profiler::setEnabled(bool value) _OPENMA_NOEXCEPT
+  {
+    Profiler::instance().mp_Pimpl->Enabled.store(value);
+  };
+  
+  /**
+   * Remove all the recorded data and reset the origin of the time used by the Chrome trace.
+   * The reset is refused while a context is attached in a thread (see Profiler::Attach), for example during the execution of parallel_for().
+   * @important This method must not be called while scopes are opened in other threads.
+   */
+  void Profiler::reset() _OPENMA_NOEXCEPT
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    std::lock_guard<std::mutex> lock(optr->Guard);
+    if (optr->Attached.load() != 0)
+    {
+      warning("The profiler cannot be reset while scopes are attached to another thread. The recorded data are kept.");
+      return;
+    }
+    optr->Retired.clear();
+    optr->RetiredEvents.clear();
+    for (auto buffer : optr->Buffers)
+    {
+      if (buffer == nullptr)
+        continue;
+      std::lock_guard<std::mutex> guard(buffer->Guard);
+      buffer->Root.reset();
+      buffer->Stack.clear();
+      buffer->Events.clear();
+    }
+    optr->Recorded.store(0);
+    optr->Dropped.store(0);
+    optr->Origin.store(_Profiler_clock::now().time_since_epoch().count());
+  };
+  
+  /**
+   * Increment the counter @a name of the scope currently open in the calling thread by @a value (e.g. number of samples processed, number of bytes decoded).
+   * If no scope is open, the counter is associated with the root of the profiler.
+   * The counter is aggregated when the scope is closed.
+   *
+   * The macro OPENMA_PROFILE_COUNT() can be used to check the state of the profiler before the call.
+   * @note The given name must have a static storage duration (e.g. a string literal).
+   */
+  void Profiler::count(const char* name, uint64_t value) _OPENMA_NOEXCEPT
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    if (!optr->Enabled.load(std::memory_order_relaxed))
+      return;
+    auto& buffer = optr->buffer();
+    std::lock_guard<std::mutex> lock(buffer.Guard);
+    if (!buffer.Stack.empty())
+      _profiler_accumulate(&(buffer.Stack.back().Counters), name, value);
+    else
+      _profiler_accumulate(&(buffer.current()->Counters), name, value);
+  };
+  
+  /**
+   * Returns an opaque pointer to the scope currently open in the calling thread (or null if the profiler is disabled).
+   * @sa Profiler::Attach
+   */
+  const void* Profiler::context() _OPENMA_NOEXCEPT
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    if (!optr->Enabled.load(std::memory_order_relaxed))
+      return nullptr;
+    auto& buffer = optr->buffer();
+    std::lock_guard<std::mutex> lock(buffer.Guard);
+    return buffer.current();
+  };
+  
+  /**
+   * Create a tree of nodes representing the aggregated data.
+   * The root node is named "Profiler" and is parented to @a parent. Each scope is exported as a node with the following properties:
+   *  - calls: number of executions
+   *  - total, mean, min, max: execution times (in seconds)
+   *  - one property for each counter
+   */
+  Node* Profiler::exportNode(Node* parent)
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    _Profiler_entry merged("Profiler",nullptr);
+    {
+      std::lock_guard<std::mutex> lock(optr->Guard);
+      optr->merge(&merged);
+    }
+    auto root = new Node(merged.Name, parent);
+    for (const auto& counter : merged.Counters)
+      root->setProperty(counter.first, static_cast<unsigned long long>(counter.second));
+    for (const auto& child : merged.Children)
+      _profiler_entry_node(root, child.get());
+    return root;
+  };
+  
+  /**
+   * Export the aggregated data as a JSON document. Times are given in milliseconds.
+   */
+  std::string Profiler::exportJSON()
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    _Profiler_entry merged("Profiler",nullptr);
+    {
+      std::lock_guard<std::mutex> lock(optr->Guard);
+      optr->merge(&merged);
+    }
+    std::string out = "{\"counters\":";
+    _profiler_counters_json(&out, merged.Counters);
+    out += ",\"scopes\":[";
+    for (size_t i = 0 ; i < merged.Children.size() ; ++i)
+    {
+      if (i != 0)
+        out += ",";
+      _profiler_entry_json(&out, merged.Children[i].get());
+    }
+    out += "]}";
+    return out;
+  };
+  
+  /**
+   * Export each execution of the scopes in the Chrome trace event format (complete events).
+   * The counters incremented during a scope are given as arguments of the event.
+   * Only the first million of executions are kept, the number of discarded events is given in the metadata of the trace.
+   */
+  std::string Profiler::exportChromeTrace()
+  {
+    auto optr = Profiler::instance().mp_Pimpl;
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    auto append = [&out, &first](const std::vector<_Profiler_event>& events) {
+      for (const auto& event : events)
+      {
+        if (!first)
+          out += ",";
+        first = false;
+        out += "{\"name\":\"" + _profiler_escape(event.Name) + "\",\"cat\":\"openma\",\"ph\":\"X\"";
+        out += ",\"ts\":" + _profiler_number(static_cast<double>(event.Begin) * 1.0e-3);
+        out += ",\"dur\":" + _profiler_number(static_cast<double>(event.Duration) * 1.0e-3);
+        out += ",\"pid\":0,\"tid\":" + std::to_string(event.Thread);
+        out += ",\"args\":";
+        _profiler_counters_json(&out, event.Counters);
+        out += "}";
+      }
+    };
+    std::lock_guard<std::mutex> lock(optr->Guard);
+    append(optr->RetiredEvents);
+    for (auto buffer : optr->Buffers)
+    {
+      if (buffer == nullptr)
+        continue;
+      std::lock_guard<std::mutex> guard(buffer->Guard);
+      append(buffer->Events);
+    }
+    out += "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":" + std::to_string(optr->Dropped.load()) + "}}";
+    return out;
+  };
+  
+  /**
+   * Destructor
+   */
+  Profiler::~Profiler() _OPENMA_NOEXCEPT
+  {
+    delete this->mp_Pimpl;
+  };
+  
+  /*
+   * Singleton
+   */
+  Profiler& Profiler::instance()
+  {
+    static Profiler singleton;
+    return singleton;
+  };
+  
+  /*
+   * Constructor
+   */
+  Profiler::Profiler()
+  : mp_Pimpl(new Profiler::Private)
+  {};
+};
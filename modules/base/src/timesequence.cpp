@@ -34,10 +34,16 @@
 
 #include "openma/base/timesequence.h"
 #include "openma/base/timesequence_p.h"
+#include "openma/base/logger.h"
+#include "openma/base/profiler.h"
 
 #include <cassert>
 #include <algorithm> // std::copy_n
+#include <atomic> // std::atomic_thread_fence
 #include <cmath>
+#include <cstdint> // int16_t
+#include <limits>
+#include <mutex>
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -47,14 +53,24 @@
 
 namespace ma
 {
+  // Allocate the memory used to store the samples (the allocations are reported to the profiler)
+  static inline std::shared_ptr<TimeSequenceBuffer> _timesequence_allocate(size_t numbytes)
+  {
+    if (numbytes == 0)
+      return std::shared_ptr<TimeSequenceBuffer>();
+    OPENMA_PROFILE_COUNT("allocations",1);
+    OPENMA_PROFILE_COUNT("allocated_bytes",numbytes);
+    return std::make_shared<TimeSequenceBuffer>(numbytes);
+  };
+  
   TimeSequencePrivate::TimeSequencePrivate(TimeSequence* pint, const std::string& name)
   : NodePrivate(pint,name),
-    Dimensions(), AccumulatedDimensions(), Samples(0), SampleRate(0.0), StartTime(0.0), Type(0), Unit(), Scale(1.0), Offset(0.0), Range(), Data(nullptr)
+    Dimensions(), AccumulatedDimensions(), Samples(0), Capacity(0), Head(0), RingBuffer(false), SampleRate(0.0), StartTime(0.0), Type(0), Unit(), Scale(1.0), Offset(0.0), Range(), Storage(TimeSequence::Storage::Double), Data(nullptr), Exposed(false)
   {};
   
   TimeSequencePrivate::TimeSequencePrivate(TimeSequence* pint, const std::string& name, const std::vector<unsigned>& dimensions, unsigned samples, double rate, double start, int type, const std::string& unit, double scale, double offset, const std::array<double,2>& range)
   : NodePrivate(pint,name),
-    Dimensions(dimensions), AccumulatedDimensions(), Samples(samples), SampleRate(rate), StartTime(start), Type(type), Unit(unit), Scale(scale), Offset(offset), Range(range), Data(nullptr)
+    Dimensions(dimensions), AccumulatedDimensions(), Samples(samples), Capacity(samples), Head(0), RingBuffer(false), SampleRate(rate), StartTime(start), Type(type), Unit(unit), Scale(scale), Offset(offset), Range(range), Storage(TimeSequence::Storage::Double), Data(nullptr), Exposed(false)
   {
     assert(!dimensions.empty());
     // Allocate data memory;
@@ -64,7 +80,7 @@ namespace ma
       for(const unsigned& cpt: dimensions)
         num *= cpt;
       assert(num != 0);
-      this->Data = new double[samples * num];
+      this->Data = _timesequence_allocate(samples * num * sizeof(double));
     }
     // Compute accumulated dimensions (used for the method data(sample, indices))
     this->AccumulatedDimensions.resize(dimensions.size()-1,dimensions[0]);
@@ -72,9 +88,230 @@ namespace ma
       this->AccumulatedDimensions[i-1] = this->AccumulatedDimensions[i] * this->Dimensions[this->AccumulatedDimensions.size()-i];
   };
   
-  TimeSequencePrivate::~TimeSequencePrivate() _OPENMA_NOEXCEPT
+  TimeSequencePrivate::~TimeSequencePrivate() _OPENMA_NOEXCEPT = default;
+  
+  /*
+   * Move the stored samples into a new buffer able to store @a capacity samples for each component.
+   * The samples of a ring buffer are linearized (i.e. the head is set to 0) during the copy.
+   * If the new capacity is lower than the number of samples, the last ones are discarded.
+   */
+  void TimeSequencePrivate::reallocate(unsigned capacity)
+  {
+    size_t num = 1;
+    for(const unsigned& cpt: this->Dimensions)
+      num *= cpt;
+    const size_t esize = this->elementSize();
+    auto data = _timesequence_allocate(capacity * num * esize);
+    const unsigned samples = std::min(this->Samples, capacity);
+    const unsigned first = std::min(samples, this->Capacity - this->Head);
+    for (size_t i = 0 ; i < num ; ++i)
+    {
+      const char* src = this->elements() + i * this->Capacity * esize;
+      char* dst = data->Elements.get() + i * capacity * esize;
+      std::copy_n(src + this->Head * esize, first * esize, dst);
+      std::copy_n(src, (samples - first) * esize, dst + first * esize);
+    }
+    this->Data = std::move(data);
+    this->Exposed = false; // Pointers to the previous buffer are invalidated
+    this->Samples = samples;
+    this->Capacity = capacity;
+    this->Head = 0;
+  };
+  
+  /*
+   * Copy of the buffer.
+   */
+  std::shared_ptr<TimeSequenceBuffer> TimeSequencePrivate::duplicate() const
+  {
+    size_t num = 1;
+    for(const unsigned& cpt: this->Dimensions)
+      num *= cpt;
+    const size_t numbytes = this->Capacity * num * this->elementSize();
+    auto data = _timesequence_allocate(numbytes);
+    std::copy_n(this->elements(), numbytes, data->Elements.get());
+    return data;
+  };
+  
+  /*
+   * Give to this time sequence its own copy of the buffer if it is shared with other time sequences.
+   * This method must be called before any modification of the stored elements.
+   * Time sequences sharing the same buffer can be detached concurrently: the check of the owners and the release of the shared buffer are done under the lock of this buffer. Time sequences using different buffers do not wait for each other.
+   */
+  void TimeSequencePrivate::detach()
+  {
+    if (!this->Data || this->Exposed)
+      return;
+    // The local owner keeps the buffer (and its mutex) alive until the lock is released
+    const auto buffer = this->Data;
+    std::lock_guard<std::mutex> lock(buffer->Guard);
+    if (buffer.use_count() == 2)
+    {
+      // The other owners could have released the buffer without the lock (e.g. destruction)
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return;
+    }
+    this->Data = this->duplicate();
+  };
+  
+  /*
+   * Detach the buffer before giving a mutable pointer to it. The buffer is then copied by the next copies (see TimeSequence::copyContents()).
+   */
+  void TimeSequencePrivate::expose()
+  {
+    this->detach();
+    this->Exposed = true;
+  };
+  
+  /*
+   * Returns true if the buffer is shared with other time sequences.
+   */
+  bool TimeSequencePrivate::isShared() const
+  {
+    if (!this->Data || this->Exposed)
+      return false;
+    const auto buffer = this->Data;
+    std::lock_guard<std::mutex> lock(buffer->Guard);
+    if (buffer.use_count() > 2)
+      return true;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return false;
+  };
+  
+  /*
+   * Rotate in place each component of the buffer to set the head of the ring buffer to 0.
+   * A shared buffer is not modified, a linearized copy is created instead.
+   */
+  void TimeSequencePrivate::rotate()
+  {
+    if (this->Head == 0)
+      return;
+    if (this->isShared())
+    {
+      this->reallocate(this->Capacity);
+      return;
+    }
+    size_t num = 1;
+    for(const unsigned& cpt: this->Dimensions)
+      num *= cpt;
+    const size_t esize = this->elementSize();
+    for (size_t i = 0 ; i < num ; ++i)
+    {
+      char* col = this->elements() + i * this->Capacity * esize;
+      std::rotate(col, col + this->Head * esize, col + this->Capacity * esize);
+    }
+    this->Head = 0;
+  };
+  
+  /*
+   * Pointer to the stored elements (null if no buffer is allocated).
+   */
+  char* TimeSequencePrivate::elements() const _OPENMA_NOEXCEPT
+  {
+    return this->Data ? this->Data->Elements.get() : nullptr;
+  };
+  
+  /*
+   * Number of bytes used to store one element.
+   */
+  size_t TimeSequencePrivate::elementSize() const _OPENMA_NOEXCEPT
   {
-    delete[] this->Data;
+    switch (this->Storage)
+    {
+    case TimeSequence::Storage::Float:
+      return sizeof(float);
+    case TimeSequence::Storage::Int16:
+      return sizeof(int16_t);
+    default:
+      return sizeof(double);
+    }
+  };
+  
+  /*
+   * Index of the component associated with the given dimensions @a indices.
+   */
+  size_t TimeSequencePrivate::column(std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT
+  {
+    assert(indices.size() <= this->Dimensions.size());
+    auto it = indices.begin();
+    std::advance(it,indices.size()-1);
+    size_t col = (indices.size() == 0) ? 0 : *it;
+    it = indices.begin();
+    for (size_t i = 0, len = std::min(indices.size(),this->AccumulatedDimensions.size()) ; i < len ; ++i)
+    {
+      col += this->AccumulatedDimensions[i] * *it;
+      ++it;
+    }
+    return col;
+  };
+  
+  /*
+   * Index in the storage of the given @a sample (the head of a ring buffer is taken into account).
+   */
+  size_t TimeSequencePrivate::row(unsigned sample) const _OPENMA_NOEXCEPT
+  {
+    assert(sample < this->Samples);
+    size_t row = this->Head + sample;
+    if (row >= this->Capacity)
+      row -= this->Capacity;
+    return row;
+  };
+  
+  /*
+   * Convert @a num stored elements into double values.
+   * Integer elements are converted using the formula (raw - offset) * scale. A null scale is considered as 1 (see narrow()).
+   */
+  void TimeSequencePrivate::widen(const char* in, double* out, size_t num) const _OPENMA_NOEXCEPT
+  {
+    switch (this->Storage)
+    {
+    case TimeSequence::Storage::Float:
+      {
+      const float* values = reinterpret_cast<const float*>(in);
+      for (size_t i = 0 ; i < num ; ++i)
+        out[i] = static_cast<double>(values[i]);
+      break;
+      }
+    case TimeSequence::Storage::Int16:
+      {
+      const int16_t* values = reinterpret_cast<const int16_t*>(in);
+      const double scale = (this->Scale != 0.0) ? this->Scale : 1.0;
+      for (size_t i = 0 ; i < num ; ++i)
+        out[i] = (static_cast<double>(values[i]) - this->Offset) * scale;
+      break;
+      }
+    default:
+      std::copy_n(reinterpret_cast<const double*>(in), num, out);
+    }
+  };
+  
+  /*
+   * Convert @a num double values into the type used to store the elements.
+   * Integer elements are computed using the formula value / scale + offset. The result is rounded and saturated to the limits of the integer type.
+   * A null scale is considered as 1, otherwise the stored elements would be lost.
+   */
+  void TimeSequencePrivate::narrow(const double* in, char* out, size_t num) const _OPENMA_NOEXCEPT
+  {
+    switch (this->Storage)
+    {
+    case TimeSequence::Storage::Float:
+      {
+      float* values = reinterpret_cast<float*>(out);
+      for (size_t i = 0 ; i < num ; ++i)
+        values[i] = static_cast<float>(in[i]);
+      break;
+      }
+    case TimeSequence::Storage::Int16:
+      {
+      int16_t* values = reinterpret_cast<int16_t*>(out);
+      const double lower = static_cast<double>(std::numeric_limits<int16_t>::min()), upper = static_cast<double>(std::numeric_limits<int16_t>::max());
+      const double scale = (this->Scale != 0.0) ? this->Scale : 1.0;
+      for (size_t i = 0 ; i < num ; ++i)
+        values[i] = static_cast<int16_t>(std::max(lower, std::min(upper, std::round(in[i] / scale + this->Offset))));
+      break;
+      }
+    default:
+      std::copy_n(in, num, reinterpret_cast<double*>(out));
+    }
   };
 };
 
@@ -209,13 +446,13 @@ namespace ma
   std::string unit;
   /**
    * This property holds the scale of a TimeSequence. By default, this property is set to 1.0.
-   * @note The modification of this property does not influence the data. This is only for information purpose
+   * @note When the elements are stored as 16-bit integers (see setStorage()), this property is used to convert the stored elements and its modification changes the values read. Otherwise, this is only for information purpose
    * @sa scale() setScale()
    */
   double scale;
   /**
    * This property holds the offset of a TimeSequence. By default, this property is set to 0.
-   * @note The modification of this property does not influence the data. This is only for information purpose
+   * @note When the elements are stored as 16-bit integers (see setStorage()), this property is used to convert the stored elements and its modification changes the values read. Otherwise, this is only for information purpose
    * @sa offset() setOffset()
    */
   double offset;
@@ -417,7 +654,8 @@ namespace ma
   };
 
  /**
-  * Returns the scaling factor used to record the signal and possibly transform it from raw data to stored measurement
+  * Returns the scaling factor used to record the signal and possibly transform it from raw data to stored measurement.
+  * When the elements are stored as 16-bit integers (see setStorage()), the read values are computed as (raw - offset()) * scale(). A null scale is then considered as 1.
   */
   double TimeSequence::scale() const _OPENMA_NOEXCEPT
   {
@@ -426,7 +664,8 @@ namespace ma
   };
   
   /**
-   * Sets the scaling factor that was possibly used to transform raw data to stored measurement
+   * Sets the scaling factor that was possibly used to transform raw data to stored measurement.
+   * @note The stored elements are not converted. Thus, if they are stored as 16-bit integers, the values read afterwards are modified.
    */
   void TimeSequence::setScale(double value) _OPENMA_NOEXCEPT
   {
@@ -447,7 +686,8 @@ namespace ma
   };
   
   /**
-   * Sets the offset value that was possibly used to transform raw data to stored measurement
+   * Sets the offset value that was possibly used to transform raw data to stored measurement.
+   * @note The stored elements are not converted. Thus, if they are stored as 16-bit integers, the values read afterwards are modified.
    */
   void TimeSequence::setOffset(double value) _OPENMA_NOEXCEPT
   {
@@ -480,24 +720,133 @@ namespace ma
   };
   
   /**
-   * Return the pointer storing the internal data
+   * Returns the type used to store the elements. By default, the elements are stored as double.
+   */
+  TimeSequence::Storage TimeSequence::storage() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Storage;
+  };
+  
+  /**
+   * Sets the type used to store the elements. The stored samples are converted to the new type.
+   * Compact types reduce the memory footprint (and the memory bandwidth) of large recordings:
+   *  - Storage::Float: single precision floating point values (2 times smaller).
+   *  - Storage::Int16: raw 16-bit integer values (4 times smaller). The stored value is computed as value / scale() + offset() and the read value as (raw - offset()) * scale() (a null scale is considered as 1). This storage is meant for data acquired by an analog-to-digital converter (e.g. analog channels) where the scale and offset correspond to the ADC parameters.
+   * @warning The method data() returns a null pointer if the storage is not Storage::Double. Use the methods read() and write() to access the data whatever the storage, or rawData() to access the stored elements directly.
+   */
+  void TimeSequence::setStorage(Storage value)
+  {
+    auto optr = this->pimpl();
+    if (optr->Storage == value)
+      return;
+    optr->rotate();
+    const size_t num = static_cast<size_t>(optr->Capacity) * this->components();
+    std::vector<double> values(num);
+    optr->widen(optr->elements(), values.data(), num);
+    optr->Storage = value;
+    optr->Data = _timesequence_allocate(num * optr->elementSize());
+    optr->Exposed = false;
+    optr->narrow(values.data(), optr->elements(), num);
+    this->modified();
+  };
+  
+  /**
+   * Returns the number of bytes used to store one element.
+   */
+  size_t TimeSequence::elementSize() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->elementSize();
+  };
+  
+  /**
+   * Return the pointer storing the internal data.
+   * The components are separated by stride() values. By default the stride is equal to the number of samples, but this is not the case anymore if extra memory was reserved (see reserve() and append()).
+   * In case of a ring buffer, the first sample of each component is not necessarily stored at the beginning of the component. Use linearize() before accessing directly to the data.
+   * @note If the elements are not stored as double (see setStorage()), this method returns a null pointer.
    */
   const double* TimeSequence::data() const _OPENMA_NOEXCEPT
   {
     auto optr = this->pimpl();
-    return optr->Data;
+    return (optr->Storage == Storage::Double) ? reinterpret_cast<const double*>(optr->elements()) : nullptr;
   };
   
   /**
-   * Return the pointer storing the internal data. These data are stored by column.
+   * Return the pointer storing the internal data. These data are stored by column. Each column is separated by stride() values (see the const version of this method for details).
+   * The buffer of a copied (or cloned) time sequence is shared with its source until one of them is modified. Thus, this method gives first to the time sequence its own copy of the buffer if necessary. Use the const version of this method to only read the data.
    * @warning You should used this method very carefully. It is recommended to call the method modified() manually if you apply modifications on the data.
+   * @note As the returned pointer could be used to modify the data later, the next copies of the time sequence get their own buffer. Use a TimeSequence::Writer to limit the mutable access to a scope.
    */
   double* TimeSequence::data() _OPENMA_NOEXCEPT
   {
     auto optr = this->pimpl();
-    return optr->Data;
+    if (optr->Storage != Storage::Double)
+      return nullptr;
+    optr->expose();
+    return reinterpret_cast<double*>(optr->elements());
+  };
+  
+  /**
+   * Return the pointer storing the elements whatever the storage type (see storage() and elementSize()).
+   * The layout is the same than for the method data().
+   */
+  const void* TimeSequence::rawData() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->elements();
+  };
+  
+  /**
+   * Return the pointer storing the elements whatever the storage type (see storage() and elementSize()).
+   * As for data(), a shared buffer is first copied and the next copies get their own buffer.
+   * @warning It is recommended to call the method modified() manually if you apply modifications on the data.
+   */
+  void* TimeSequence::rawData() _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    optr->expose();
+    return optr->elements();
+  };
+  
+  /**
+   * Copy @a count samples of the given @a component starting at the sample @a first into @a values. The elements are converted to double if necessary.
+   * This method takes into account the stride and the head of a ring buffer. It is the recommended way to process by blocks a time sequence with a compact storage.
+   */
+  void TimeSequence::read(unsigned component, unsigned first, unsigned count, double* values) const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (count == 0)
+      return;
+    assert(component < this->components());
+    assert(first + count <= optr->Samples);
+    const size_t esize = optr->elementSize();
+    const char* col = optr->elements() + static_cast<size_t>(component) * optr->Capacity * esize;
+    const size_t start = optr->row(first);
+    const size_t num = std::min(static_cast<size_t>(count), optr->Capacity - start);
+    optr->widen(col + start * esize, values, num);
+    optr->widen(col, values + num, count - num);
   };
   
+  /**
+   * Copy @a count @a values into the given @a component starting at the sample @a first. The values are converted to the storage type if necessary.
+   */
+  void TimeSequence::write(unsigned component, unsigned first, unsigned count, const double* values)
+  {
+    auto optr = this->pimpl();
+    if (count == 0)
+      return;
+    assert(component < this->components());
+    assert(first + count <= optr->Samples);
+    const size_t esize = optr->elementSize();
+    optr->detach();
+    char* col = optr->elements() + static_cast<size_t>(component) * optr->Capacity * esize;
+    const size_t start = optr->row(first);
+    const size_t num = std::min(static_cast<size_t>(count), optr->Capacity - start);
+    optr->narrow(values, col + start * esize, num);
+    optr->narrow(values + num, col, count - num);
+    this->modified();
+  };
  
   /**
    * @fn template <typename... Is> double TimeSequence::data(unsigned sample, Is... indices) const _OPENMA_NOEXCEPT
@@ -507,47 +856,236 @@ namespace ma
   /**
    * @fn template <typename... Is> double& TimeSequence::data(unsigned sample, Is... indices) _OPENMA_NOEXCEPT
    * Extract a reference to a read-only element of the time sequence for the given @a sample index and dimensions @a indices. In case the number of @a indices is not consistent with the number of dimensions, ths missing ones are set to 0. If the data are modified by this method, it is adviced to call modified() manually
+   * @note This method can only be used if the elements are stored as double (see setStorage()). Otherwise, an error is reported and the modification of the returned value is discarded. Use the method write() instead.
    */
   
   /**
    * Resize the data to fit the number of @a samples.
-   * Internally a new buffer is created and previous data are copied. Afterwards, the method deletes the previous data.
+   * By default, a new buffer is created with the exact number of samples and previous data are copied. Afterwards, the method deletes the previous data. Thus, the data are contiguous in memory (the stride is equal to the number of samples).
+   * If extra memory was reserved (see reserve()), the buffer is only reallocated when the new number of samples is greater than the capacity. In this case, the capacity grows geometrically.
+   * In case of a ring buffer, its capacity is increased if the new number of samples exceeds it.
    */
   void TimeSequence::resize(unsigned samples)
   {
     auto optr = this->pimpl();
     if (optr->Samples == samples)
       return;
-    double* oldData = optr->Data;
-    unsigned num = this->components();
-    assert(num != 0);
-    optr->Data = new double[num * samples];
-    unsigned s = std::min(optr->Samples,samples);
-    for (unsigned i = 0 ; i < num ; ++i)
-      std::copy_n(oldData + i*optr->Samples, s, optr->Data + i*samples);
+    assert(this->components() != 0);
+    if (optr->RingBuffer)
+    {
+      optr->rotate();
+      if (samples > optr->Capacity)
+        optr->reallocate(samples);
+    }
+    else if (optr->Capacity == optr->Samples)
+    {
+      // Compact storage
+      optr->reallocate(samples);
+    }
+    else if (samples > optr->Capacity)
+      optr->reallocate(std::max(samples, 2 * optr->Capacity));
     optr->Samples = samples;
-    delete oldData;
     this->modified();
   };
+  
+  /**
+   * Returns the number of samples that can be stored for each component without reallocating the internal buffer.
+   */
+  unsigned TimeSequence::capacity() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Capacity;
+  };
+  
+  /**
+   * Returns the number of values between the first sample of two consecutive components in the buffer returned by data().
+   * The stride is equal to samples() unless extra memory was reserved (see reserve(), append(), enableRingBuffer()).
+   */
+  unsigned TimeSequence::stride() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Capacity;
+  };
+  
+  /**
+   * Reserve memory to store at least @a samples for each component.
+   * If the given number is lower or equal to the current capacity, nothing is done.
+   * @note Once some memory is reserved, the stride between components is not equal to the number of samples anymore. Use shrinkToFit() to retrieve contiguous data.
+   */
+  void TimeSequence::reserve(unsigned samples)
+  {
+    auto optr = this->pimpl();
+    if (samples <= optr->Capacity)
+      return;
+    optr->reallocate(samples);
+  };
+  
+  /**
+   * Release the unused memory. Afterwards, the stride is equal to the number of samples and data are contiguous.
+   */
+  void TimeSequence::shrinkToFit()
+  {
+    auto optr = this->pimpl();
+    if ((optr->Capacity == optr->Samples) && (optr->Head == 0))
+      return;
+    optr->reallocate(optr->Samples);
+  };
+  
+  /**
+   * Append @a samples to the end of the time sequence.
+   * The given @a values are organized by component (i.e. column-major order) with @a samples rows and components() columns.
+   * If the capacity is not sufficient, the buffer grows geometrically. Thus, successive calls to this method have an amortized constant cost by sample.
+   * In case of a ring buffer, the capacity never changes. The oldest samples are discarded and the start time is shifted accordingly.
+   */
+  void TimeSequence::append(const double* values, unsigned samples)
+  {
+    auto optr = this->pimpl();
+    if (samples == 0)
+      return;
+    assert(values != nullptr);
+    const unsigned num = this->components();
+    const size_t esize = optr->elementSize();
+    if (optr->RingBuffer)
+    {
+      optr->detach();
+      const unsigned cap = optr->Capacity;
+      unsigned dropped = 0;
+      if (samples >= cap)
+      {
+        // Only the last samples are kept
+        const unsigned skip = samples - cap;
+        for (unsigned i = 0 ; i < num ; ++i)
+          optr->narrow(values + i * samples + skip, optr->elements() + i * cap * esize, cap);
+        dropped = optr->Samples + skip;
+        optr->Head = 0;
+        optr->Samples = cap;
+      }
+      else
+      {
+        const unsigned total = optr->Samples + samples;
+        dropped = (total > cap) ? total - cap : 0;
+        const unsigned pos = (optr->Head + optr->Samples) % cap;
+        const unsigned first = std::min(samples, cap - pos);
+        for (unsigned i = 0 ; i < num ; ++i)
+        {
+          optr->narrow(values + i * samples, optr->elements() + (i * cap + pos) * esize, first);
+          optr->narrow(values + i * samples + first, optr->elements() + i * cap * esize, samples - first);
+        }
+        optr->Head = (optr->Head + dropped) % cap;
+        optr->Samples = total - dropped;
+      }
+      if ((dropped != 0) && (optr->SampleRate > 0.0))
+        optr->StartTime += static_cast<double>(dropped) / optr->SampleRate;
+    }
+    else
+    {
+      if (optr->Samples + samples > optr->Capacity)
+        optr->reallocate(std::max(optr->Samples + samples, 2 * optr->Capacity));
+      else
+        optr->detach();
+      for (unsigned i = 0 ; i < num ; ++i)
+        optr->narrow(values + i * samples, optr->elements() + (static_cast<size_t>(i) * optr->Capacity + optr->Samples) * esize, samples);
+      optr->Samples += samples;
+    }
+    this->modified();
+  };
+  
+  /**
+   * Convert the time sequence into a ring buffer able to store @a capacity samples for each component.
+   * If the time sequence has more samples than the given capacity, only the last ones are kept and the start time is shifted accordingly.
+   * Once enabled, the method append() overwrites the oldest samples when the capacity is reached. This is useful to keep a sliding window of live data with a bounded memory.
+   */
+  void TimeSequence::enableRingBuffer(unsigned capacity)
+  {
+    auto optr = this->pimpl();
+    if (capacity == 0)
+    {
+      error("TimeSequence - The capacity of a ring buffer cannot be null.");
+      return;
+    }
+    if (optr->Samples > capacity)
+    {
+      const unsigned dropped = optr->Samples - capacity;
+      optr->Head = (optr->Head + dropped) % optr->Capacity;
+      optr->Samples = capacity;
+      if (optr->SampleRate > 0.0)
+        optr->StartTime += static_cast<double>(dropped) / optr->SampleRate;
+      this->modified();
+    }
+    if ((optr->Capacity != capacity) || (optr->Head != 0))
+      optr->reallocate(capacity);
+    optr->RingBuffer = true;
+  };
+  
+  /**
+   * Convert back a ring buffer to a linear time sequence. The stored samples are kept.
+   */
+  void TimeSequence::disableRingBuffer()
+  {
+    auto optr = this->pimpl();
+    optr->rotate();
+    optr->RingBuffer = false;
+  };
+  
+  /**
+   * Returns true if the time sequence is used as a ring buffer.
+   */
+  bool TimeSequence::isRingBuffer() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->RingBuffer;
+  };
+  
+  /**
+   * Returns true if the first sample of each component is stored at the beginning of the component.
+   * This is always the case for a linear time sequence. For a ring buffer, the method linearize() can be used to reorganize the data.
+   */
+  bool TimeSequence::isLinearized() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return (optr->Head == 0);
+  };
+  
+  /**
+   * Reorganize the data of a ring buffer so that the first sample of each component is stored at the beginning of the component.
+   * Afterwards, the data can be accessed directly with data() and stride(). This method does nothing for a linear time sequence.
+   */
+  void TimeSequence::linearize()
+  {
+    auto optr = this->pimpl();
+    optr->rotate();
+  };
 
   /**
-   * Internal method to extract an element based on the given @a sample index and dimensions @a indices
+   * Internal method to extract an element based on the given @a sample index and dimensions @a indices.
+   * If the elements are not stored as double, an error is reported and the returned reference points to a value which is not part of the time sequence (its modification is discarded).
    */
-  double& TimeSequence::data(unsigned sample, std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT
+  double& TimeSequence::data(unsigned sample, std::initializer_list<unsigned>&& indices) _OPENMA_NOEXCEPT
   {
     auto optr = this->pimpl();
-    assert(sample < optr->Samples);
-    assert(indices.size() <= optr->Dimensions.size());
-    auto it = indices.begin();
-    std::advance(it,indices.size()-1);
-    size_t col = (indices.size() == 0) ? 0 : *it;
-    it = indices.begin();
-    for (size_t i = 0, len = std::min(indices.size(),optr->AccumulatedDimensions.size()) ; i < len ; ++i)
+    if (optr->Storage != Storage::Double)
     {
-      col += optr->AccumulatedDimensions[i] * *it;
-      ++it;
+      error("TimeSequence - The elements of '%s' are not stored as double. Use the methods read() and write() to access them.", optr->Name.c_str());
+      static thread_local double discarded;
+      discarded = std::numeric_limits<double>::quiet_NaN();
+      return discarded;
     }
-    return optr->Data[col*optr->Samples+sample];
+    optr->expose();
+    const size_t col = optr->column(std::move(indices));
+    return reinterpret_cast<double*>(optr->elements())[col*optr->Capacity+optr->row(sample)];
+  };
+  
+  /**
+   * Internal method to extract the value of an element based on the given @a sample index and dimensions @a indices. The element is converted to double if necessary.
+   */
+  double TimeSequence::value(unsigned sample, std::initializer_list<unsigned>&& indices) const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    const size_t col = optr->column(std::move(indices));
+    const size_t esize = optr->elementSize();
+    double value = 0.0;
+    optr->widen(optr->elements() + (col*optr->Capacity+optr->row(sample)) * esize, &value, 1);
+    return value;
   };
   
   /**
@@ -572,6 +1110,9 @@ namespace ma
     optr->Dimensions = optr_src->Dimensions;
     optr->AccumulatedDimensions = optr_src->AccumulatedDimensions;
     optr->Samples = optr_src->Samples;
+    optr->Capacity = optr_src->Capacity;
+    optr->Head = optr_src->Head;
+    optr->RingBuffer = optr_src->RingBuffer;
     optr->SampleRate = optr_src->SampleRate;
     optr->StartTime = optr_src->StartTime;
     optr->Type = optr_src->Type;
@@ -579,10 +1120,83 @@ namespace ma
     optr->Scale = optr_src->Scale;
     optr->Offset = optr_src->Offset;
     optr->Range = optr_src->Range;
-    delete optr->Data;
-    size_t numelts = src->elements();
-    optr->Data = new double[numelts];
-    std::copy_n(optr_src->Data, numelts, optr->Data);
+    optr->Storage = optr_src->Storage;
+    // The buffer is shared until one of the time sequences is modified (see TimeSequencePrivate::detach()).
+    // A buffer accessible through a mutable pointer is copied as the pointer could still be used to modify the source.
+    optr->Data = optr_src->Exposed ? optr_src->duplicate() : optr_src->Data;
+    optr->Exposed = false;
+  };
+  
+  // ----------------------------------------------------------------------- //
+  
+  /**
+   * @class TimeSequence::Writer openma/base/timesequence.h
+   * @brief Scoped mutable access to the elements of a time sequence.
+   *
+   * A mutable pointer given by TimeSequence::data() or TimeSequence::rawData() could be used at any time to modify the elements. Thus, the buffer of such a time sequence is copied by the next copies instead of being shared (copy-on-write).
+   * A writer limits this mutable access to its lifetime. When the writer is destroyed, the time sequence is again allowed to share its buffer with its copies. This is the recommended way to fill a time sequence by pointers (e.g. file readers):
+   * @code{.unparsed}
+   * {
+   *   ma::TimeSequence::Writer writer(ts);
+   *   double* data = writer.data();
+   *   // Fill the elements...
+   * }
+   * // Clones of 'ts' share its buffer
+   * @endcode
+   * @warning The pointers given during the lifetime of the writer (including the ones given by TimeSequence::data()) must not be used after its destruction.
+   * @ingroup openma_base
+   */
+  
+  /**
+   * Give to the time sequence @a source its own buffer (if shared) and prevent it to be shared during the lifetime of the writer.
+   */
+  TimeSequence::Writer::Writer(TimeSequence* source)
+  : mp_Source(source), m_Exposed(false)
+  {
+    if (this->mp_Source == nullptr)
+      return;
+    auto optr = this->mp_Source->pimpl();
+    this->m_Exposed = optr->Exposed;
+    optr->expose();
+  };
+  
+  /**
+   * Move constructor. The mutable access is transferred to the new writer.
+   */
+  TimeSequence::Writer::Writer(Writer&& other) _OPENMA_NOEXCEPT
+  : mp_Source(other.mp_Source), m_Exposed(other.m_Exposed)
+  {
+    other.mp_Source = nullptr;
+  };
+  
+  /**
+   * Restore the sharing of the buffer (unless a mutable pointer was already given before the creation of the writer) and notify the time sequence of its modification.
+   */
+  TimeSequence::Writer::~Writer() _OPENMA_NOEXCEPT
+  {
+    if (this->mp_Source == nullptr)
+      return;
+    auto optr = this->mp_Source->pimpl();
+    optr->Exposed = this->m_Exposed;
+    this->mp_Source->modified();
+  };
+  
+  /**
+   * Returns a mutable pointer to the elements stored as double (see TimeSequence::data()). A null pointer is returned if the elements use a compact storage.
+   */
+  double* TimeSequence::Writer::data() const _OPENMA_NOEXCEPT
+  {
+    if ((this->mp_Source == nullptr) || (this->mp_Source->storage() != Storage::Double))
+      return nullptr;
+    return reinterpret_cast<double*>(this->mp_Source->pimpl()->elements());
+  };
+  
+  /**
+   * Returns a mutable pointer to the stored elements whatever the storage type (see TimeSequence::rawData()).
+   */
+  void* TimeSequence::Writer::rawData() const _OPENMA_NOEXCEPT
+  {
+    return (this->mp_Source != nullptr) ? this->mp_Source->pimpl()->elements() : nullptr;
   };
   
   // ----------------------------------------------------------------------- //
@@ -57,6 +57,12 @@ namespace ma
     };
     };
     
+    enum class Storage : int {
+      Double = 0,
+      Float,
+      Int16
+    };
+    
     static const std::array<double,2> InfinityRange;
     TimeSequence(const std::string& name, unsigned components, unsigned samples, double rate, double start, int type, const std::string& unit, double scale, double offset, const std::array<double,2>& range, Node* parent = nullptr);
     TimeSequence(const std::string& name, unsigned components, unsigned samples, double rate, double start, int type, const std::string& unit, Node* parent = nullptr);
@@ -82,6 +88,9 @@ namespace ma
     void setOffset(double value);
     const std::array<double,2>& range() const;
     void setRange(const std::array<double,2>& value);
+    Storage storage() const;
+    void setStorage(Storage value);
+    size_t elementSize() const;
     /*
     const double* data() const;
     double* data();
@@ -96,6 +105,15 @@ namespace ma
     };
     
     void resize(unsigned samples);
+    unsigned capacity() const;
+    unsigned stride() const;
+    void reserve(unsigned samples);
+    void shrinkToFit();
+    void enableRingBuffer(unsigned capacity);
+    void disableRingBuffer();
+    bool isRingBuffer() const;
+    bool isLinearized() const;
+    void linearize();
   };
   %clearnodefaultctor;
 };
\ No newline at end of file
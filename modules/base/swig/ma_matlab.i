@@ -302,7 +302,9 @@ mxArray* ma_TimeSequence_data(const ma::TimeSequence* self)
   dims.insert(dims.end(), self->dimensions().cbegin(), self->dimensions().cend());
   mxArray* out = mxCreateNumericArray(static_cast<mwSize>(dims.size()), dims.data(), mxDOUBLE_CLASS, mxREAL);
   double* dataout = mxGetPr(out);
-  memcpy(dataout, self->data(), self->elements()*sizeof(double));
+  // NOTE: The method read() takes care of the storage type, the stride, and the ring buffer
+  for (unsigned i = 0, cpts = self->components(), samples = self->samples() ; i < cpts ; ++i)
+    self->read(i, 0, samples, dataout + i*samples);
   return out;
 };
   
@@ -323,7 +325,9 @@ void ma_TimeSequence_setData(ma::TimeSequence* self, const mxArray* data)
     if (dimsin[i+1] != dimsout[i])
       mexErrMsgIdAndTxt("SWIG:TimeSequence:setData","Incompatible dimension value");
   }
-  memcpy(self->data(), (double*)mxGetData(data), numeltsin*sizeof(double));
+  const double* datain = (double*)mxGetData(data);
+  for (unsigned i = 0, cpts = self->components(), samples = self->samples() ; i < cpts ; ++i)
+    self->write(i, 0, samples, datain + i*samples);
   self->modified();
 };
   
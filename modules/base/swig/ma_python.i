@@ -349,11 +349,16 @@ PyObject* ma_TimeSequence_data(const ma::TimeSequence* self)
   if (out != NULL)
   {
     // NOTE: OpenMA uses the Fortran storage order while NumPy uses the C  order
-    const double* source = self->data();
+    // NOTE: The method read() takes care of the storage type, the stride, and the ring buffer
+    const unsigned cpts = self->components(), samples = self->samples();
+    std::vector<double> source(samples);
     double* dest = (double*)PyArray_DATA(out);
-    for (unsigned i = 0, cpts = self->components() ; i < cpts ; ++i)
-      for (unsigned j = 0, samples = self->samples() ; j < samples ; ++j)
-        dest[i+j*cpts] = source[j+i*samples];
+    for (unsigned i = 0 ; i < cpts ; ++i)
+    {
+      self->read(i, 0, samples, source.data());
+      for (unsigned j = 0 ; j < samples ; ++j)
+        dest[i+j*cpts] = source[j];
+    }
   }
   else
     PyErr_SetString(PyExc_RuntimeError, "Impossible to create a multidimensional array. Please, report this error");
@@ -390,10 +395,14 @@ void ma_TimeSequence_setData(ma::TimeSequence* self, const PyObject* data)
   }
   // NOTE: OpenMA uses the Fortran storage order while NumPy uses the C  order
   const double* source = (const double*)PyArray_DATA(data);
-  double* dest = self->data();
-  for (unsigned i = 0, cpts = self->components() ; i < cpts ; ++i)
-    for (unsigned j = 0, samples = self->samples() ; j < samples ; ++j)
-      dest[j+i*samples] = source[i+j*cpts];
+  const unsigned cpts = self->components(), samples = self->samples();
+  std::vector<double> dest(samples);
+  for (unsigned i = 0 ; i < cpts ; ++i)
+  {
+    for (unsigned j = 0 ; j < samples ; ++j)
+      dest[j] = source[i+j*cpts];
+    self->write(i, 0, samples, dest.data());
+  }
   self->modified();
 };
   
@@ -0,0 +1,119 @@
+#include "benchmark.h"
+
+#include <openma/base/node.h>
+#include <openma/base/any.h>
+#include <openma/base/event.h>
+#include <openma/base/parallel.h>
+#include <openma/base/pipeline.h>
+
+#include <regex>
+
+// Benchmarks of the base module:
+//  - Lookup of nodes (by name, by type and properties, by regular expression) in a trial with many time sequences
+//  - Deep copy (clone) of a long trial
+//  - Construction of Any objects and conversion of their value
+//  - Pipeline of three stages (clone, scale, reduce) over many sessions with one thread and with all the hardware threads
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("base", argc, argv);
+  const unsigned samples = bench.samples();
+
+  // Trial with 100 markers (100 Hz), 64 analog channels (1000 Hz) and 200 events
+  ma::Node root("root");
+  auto trial = new ma::Trial("trial", &root);
+  const auto markers = ma::benchmark::generate_markers(trial, 100, samples);
+  const auto analogs = ma::benchmark::generate_analogs(trial, 64, samples * 10);
+  for (unsigned i = 0 ; i < 200 ; ++i)
+    new ma::Event("Foot Strike", static_cast<double>(i) * 0.5, (i % 2) ? "Left" : "Right", "Subject", trial->events());
+  const unsigned nodes = static_cast<unsigned>(root.findChildren().size());
+
+  // Node
+  const unsigned lookups = 1000;
+  bench.run("node.findChild.name", lookups, [&]() {
+    for (unsigned i = 0 ; i < lookups ; ++i)
+      ma::benchmark::do_not_optimize(root.findChild<ma::TimeSequence*>("A" + std::to_string(i % 64)));
+  });
+  bench.run("node.findChildren.type", nodes, [&]() {
+    ma::benchmark::do_not_optimize(root.findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Analog}}));
+  });
+  bench.run("node.findChildren.regex", nodes, [&]() {
+    ma::benchmark::do_not_optimize(root.findChildren<ma::TimeSequence*>(std::regex("M[0-9]*5")));
+  });
+  ma::Node* clone = nullptr;
+  bench.run("node.clone.trial", nodes, [&]() {delete clone; clone = nullptr;}, [&]() {
+    clone = root.clone();
+  });
+  delete clone;
+
+  // Any
+  const unsigned conversions = 100000;
+  bench.run("any.construct.double", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(ma::Any(static_cast<double>(i)));
+  });
+  bench.run("any.construct.string", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(ma::Any(std::string("LASI")));
+  });
+  const std::vector<double> values(12, 1.5);
+  bench.run("any.construct.vector", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(ma::Any(values, std::vector<unsigned>{3,4}));
+  });
+  const ma::Any number(1.5), text(std::string("1.5")), array(values, std::vector<unsigned>{3,4});
+  bench.run("any.cast.double_to_int", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(number.cast<int>());
+  });
+  bench.run("any.cast.string_to_double", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(text.cast<double>());
+  });
+  bench.run("any.cast.vector", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+      ma::benchmark::do_not_optimize(array.cast<std::vector<float>>());
+  });
+  bench.run("node.property.set_get", conversions, [&]() {
+    for (unsigned i = 0 ; i < conversions ; ++i)
+    {
+      trial->setProperty("c3d_pointmaxinterpgap", static_cast<int>(i));
+      ma::benchmark::do_not_optimize(trial->property("c3d_pointmaxinterpgap").cast<int>());
+    }
+  });
+
+  // Pipeline
+  const unsigned sessions = 64;
+  ma::Pipeline pipeline;
+  auto copy = pipeline.addStage("clone", [trial](ma::Node* output, const std::vector<ma::Node*>& , size_t ) {
+    trial->clone(output);
+    return true;
+  });
+  auto scale = pipeline.addStage("scale", [](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t ) {
+    for (auto ts : inputs[0]->findChildren<ma::TimeSequence*>())
+    {
+      double* data = ts->data();
+      for (unsigned i = 0 ; i < ts->elements() ; ++i)
+        data[i] *= 1.5;
+      ts->addParent(output);
+    }
+    return true;
+  }, {copy});
+  pipeline.addStage("reduce", [](ma::Node* , const std::vector<ma::Node*>& inputs, size_t ) {
+    double sum = 0.0;
+    for (auto ts : inputs[0]->findChildren<const ma::TimeSequence*>())
+    {
+      const double* data = ts->data();
+      for (unsigned i = 0 ; i < ts->elements() ; ++i)
+        sum += data[i];
+    }
+    ma::benchmark::do_not_optimize(sum);
+    return true;
+  }, {scale});
+  pipeline.setThreads(1);
+  bench.run("pipeline.sessions.threads1", sessions, [&]() {pipeline.run(sessions);});
+  pipeline.setThreads(0);
+  bench.run("pipeline.sessions.threads" + std::to_string(ma::parallel_threads()), sessions, [&]() {pipeline.run(sessions);});
+
+  return bench.report();
+};
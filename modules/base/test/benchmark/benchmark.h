@@ -0,0 +1,307 @@
+#ifndef openma_benchmark_h
+#define openma_benchmark_h
+
+#include <openma/config.h> // _OPENMA_VERSION_STRING
+#include <openma/base/profiler.h>
+#include <openma/base/trial.h>
+#include <openma/base/timesequence.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath> // M_PI
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Common harness for the benchmarks of the OpenMA modules.
+//
+// Each benchmark executable accepts the following options:
+//  --samples=N      Number of samples (frames) of the synthetic trials (default: 10000, i.e. 100 s at 100 Hz)
+//  --repetitions=N  Number of timed repetitions of each task (default: 11)
+//  --filter=TEXT    Only run the tasks which contain TEXT in their name
+//  --format=F       Output format: json (default), csv or text
+//  --output=PATH    Write the results in PATH instead of the standard output
+//  --profile=PATH   Enable the profiler of OpenMA during the tasks and write the Chrome trace in PATH (the timings include the instrumentation)
+//
+// The results (median, minimum, maximum and mean durations and the processed items per second) are machine readable
+// to be compared across releases. The synthetic data are generated with a fixed seed to be reproducible.
+
+namespace ma
+{
+namespace benchmark
+{
+  // Prevent the compiler to optimize away the computation of a value
+  template <typename T>
+  inline void do_not_optimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  };
+
+  class Harness
+  {
+  public:
+    Harness(const std::string& module, int argc, char* argv[]);
+
+    unsigned samples() const {return this->m_Samples;};
+    unsigned repetitions() const {return this->m_Repetitions;};
+    bool enabled(const std::string& name) const {return this->m_Filter.empty() || (name.find(this->m_Filter) != std::string::npos);};
+
+    template <typename F> void run(const std::string& name, double items, F&& task);
+    template <typename S, typename F> void run(const std::string& name, double items, S&& setup, F&& task);
+
+    int report() const;
+
+  private:
+    struct Result
+    {
+      std::string Name;
+      double Items;
+      double Median;
+      double Minimum;
+      double Maximum;
+      double Mean;
+    };
+
+    std::string m_Module;
+    unsigned m_Samples;
+    unsigned m_Repetitions;
+    std::string m_Filter;
+    std::string m_Format;
+    std::string m_Output;
+    std::string m_Profile;
+    std::vector<Result> m_Results;
+  };
+
+  inline Harness::Harness(const std::string& module, int argc, char* argv[])
+  : m_Module(module), m_Samples(10000), m_Repetitions(11), m_Filter(), m_Format("json"), m_Output(), m_Profile(), m_Results()
+  {
+    auto value = [](const char* arg, const char* option) -> const char* {
+      const size_t len = strlen(option);
+      return (strncmp(arg, option, len) == 0) ? arg + len : nullptr;
+    };
+    for (int i = 1 ; i < argc ; ++i)
+    {
+      const char* v = nullptr;
+      if ((v = value(argv[i], "--samples=")) != nullptr)
+        this->m_Samples = static_cast<unsigned>(std::max(1l, strtol(v, nullptr, 10)));
+      else if ((v = value(argv[i], "--repetitions=")) != nullptr)
+        this->m_Repetitions = static_cast<unsigned>(std::max(1l, strtol(v, nullptr, 10)));
+      else if ((v = value(argv[i], "--filter=")) != nullptr)
+        this->m_Filter = v;
+      else if ((v = value(argv[i], "--output=")) != nullptr)
+        this->m_Output = v;
+      else if ((v = value(argv[i], "--profile=")) != nullptr)
+        this->m_Profile = v;
+      else if (((v = value(argv[i], "--format=")) != nullptr) && ((strcmp(v, "json") == 0) || (strcmp(v, "csv") == 0) || (strcmp(v, "text") == 0)))
+        this->m_Format = v;
+      else
+      {
+        std::fprintf(stderr, "Usage: %s [--samples=N] [--repetitions=N] [--filter=TEXT] [--format=json|csv|text] [--output=PATH] [--profile=PATH]\n", argv[0]);
+        std::exit(strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+      }
+    }
+  };
+
+  /*
+   * Time the given @a task which process @a items (e.g. the number of samples).
+   * The task is run once before the timed repetitions to warm up the caches.
+   */
+  template <typename F>
+  inline void Harness::run(const std::string& name, double items, F&& task)
+  {
+    this->run(name, items, [](){}, std::forward<F>(task));
+  };
+
+  /*
+   * Similar to the other run() method but the @a setup is called (and not timed) before each execution of the @a task.
+   * This is useful to reset the state modified by the task (e.g. to invalidate a cache or remove the created nodes).
+   */
+  template <typename S, typename F>
+  inline void Harness::run(const std::string& name, double items, S&& setup, F&& task)
+  {
+    if (!this->enabled(name))
+      return;
+    setup();
+    task();
+    ma::Profiler::setEnabled(!this->m_Profile.empty());
+    std::vector<double> durations;
+    durations.reserve(this->m_Repetitions);
+    for (unsigned r = 0 ; r < this->m_Repetitions ; ++r)
+    {
+      setup();
+      const auto start = std::chrono::steady_clock::now();
+      task();
+      const auto end = std::chrono::steady_clock::now();
+      durations.push_back(std::chrono::duration<double,std::milli>(end - start).count());
+    }
+    ma::Profiler::setEnabled(false);
+    std::sort(durations.begin(), durations.end());
+    double mean = 0.;
+    for (const auto& d : durations)
+      mean += d;
+    mean /= static_cast<double>(durations.size());
+    this->m_Results.push_back(Result{name, items, durations[durations.size() / 2], durations.front(), durations.back(), mean});
+    if (this->m_Format != "text")
+      std::fprintf(stderr, "%s: %.3f ms\n", name.c_str(), this->m_Results.back().Median);
+  };
+
+  /*
+   * Write the results in the requested format.
+   * Return EXIT_SUCCESS if the results were written, EXIT_FAILURE otherwise.
+   */
+  inline int Harness::report() const
+  {
+    if (!this->m_Profile.empty())
+    {
+      std::ofstream trace(this->m_Profile);
+      trace << ma::Profiler::exportChromeTrace();
+      if (!trace)
+        std::fprintf(stderr, "Impossible to write the profile in '%s'\n", this->m_Profile.c_str());
+    }
+    auto rate = [](const Result& r) {return (r.Median > 0.) ? (1000. * r.Items / r.Median) : 0.;};
+    std::ostringstream oss;
+    oss.precision(6);
+    if (this->m_Format == "json")
+    {
+      oss << "{\n"
+          << "  \"module\": \"" << this->m_Module << "\",\n"
+          << "  \"version\": \"" << _OPENMA_VERSION_STRING << "\",\n"
+          << "  \"samples\": " << this->m_Samples << ",\n"
+          << "  \"repetitions\": " << this->m_Repetitions << ",\n"
+          << "  \"benchmarks\": [";
+      for (size_t i = 0 ; i < this->m_Results.size() ; ++i)
+      {
+        const auto& r = this->m_Results[i];
+        oss << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": \"" << r.Name << "\", \"items\": " << r.Items
+            << ", \"median_ms\": " << r.Median << ", \"min_ms\": " << r.Minimum << ", \"max_ms\": " << r.Maximum << ", \"mean_ms\": " << r.Mean
+            << ", \"items_per_second\": " << rate(r) << "}";
+      }
+      oss << "\n  ]\n}\n";
+    }
+    else if (this->m_Format == "csv")
+    {
+      oss << "module,name,samples,repetitions,items,median_ms,min_ms,max_ms,mean_ms,items_per_second\n";
+      for (const auto& r : this->m_Results)
+        oss << this->m_Module << "," << r.Name << "," << this->m_Samples << "," << this->m_Repetitions << "," << r.Items << ","
+            << r.Median << "," << r.Minimum << "," << r.Maximum << "," << r.Mean << "," << rate(r) << "\n";
+    }
+    else
+    {
+      char line[256];
+      snprintf(line, sizeof(line), "%-40s %12s %12s %12s %16s\n", "benchmark", "median (ms)", "min (ms)", "max (ms)", "items/s");
+      oss << line;
+      for (const auto& r : this->m_Results)
+      {
+        snprintf(line, sizeof(line), "%-40s %12.3f %12.3f %12.3f %16.4g\n", r.Name.c_str(), r.Median, r.Minimum, r.Maximum, rate(r));
+        oss << line;
+      }
+    }
+    if (this->m_Output.empty())
+    {
+      std::cout << oss.str();
+      return EXIT_SUCCESS;
+    }
+    std::ofstream ofs(this->m_Output);
+    ofs << oss.str();
+    return ofs.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+  };
+
+  // ------------------------------------------------------------------------- //
+  //                          SYNTHETIC DATA GENERATORS                          //
+  // ------------------------------------------------------------------------- //
+
+  // Small linear congruential generator to have the same data on every platform (the distributions of the standard library are implementation defined)
+  class Random
+  {
+  public:
+    Random(unsigned seed = 42u) : m_State(seed) {};
+    double operator()() {this->m_State = this->m_State * 1664525u + 1013904223u; return static_cast<double>(this->m_State >> 8) / 16777216.0;}; // [0,1)
+    double operator()(double lower, double upper) {return lower + (upper - lower) * (*this)();};
+  private:
+    uint32_t m_State;
+  };
+
+  /*
+   * Generate a walking motion of a rigid set of markers.
+   * The @a positions (3 coordinates per marker) describe the static configuration of the markers. They are moved along the X axis (1.2 m/s),
+   * rotated around the vertical axis (Z) and oscillate vertically to have non trivial trajectories. A small noise is added to each coordinate.
+   * The markers are added to the trial @a trial as TimeSequence objects (position type, 4 components, unit mm).
+   */
+  inline std::vector<TimeSequence*> generate_markers(Trial* trial, const std::vector<std::string>& labels, const std::vector<double>& positions, unsigned samples, double rate = 100.0, double noise = 0.1)
+  {
+    Random rnd;
+    std::vector<TimeSequence*> markers(labels.size(), nullptr);
+    for (size_t m = 0 ; m < labels.size() ; ++m)
+    {
+      markers[m] = new TimeSequence(labels[m], 4, samples, rate, 0.0, TimeSequence::Position, "mm", trial->timeSequences());
+      double* data = markers[m]->data();
+      const double x = positions[3*m], y = positions[3*m+1], z = positions[3*m+2];
+      for (unsigned i = 0 ; i < samples ; ++i)
+      {
+        const double t = static_cast<double>(i) / rate;
+        const double a = 0.15 * std::sin(2.0 * M_PI * 0.5 * t);
+        const double c = std::cos(a), s = std::sin(a);
+        data[i]             = c * x - s * y + 1200.0 * t + rnd(-noise, noise);
+        data[i + samples]   = s * x + c * y + rnd(-noise, noise);
+        data[i + 2*samples] = z + 20.0 * std::sin(2.0 * M_PI * t) + rnd(-noise, noise);
+        data[i + 3*samples] = 0.0;
+      }
+    }
+    return markers;
+  };
+
+  /*
+   * Generate a set of markers randomly positioned in a box of 2000 x 1000 x 2000 mm (see the other generate_markers() function for the motion).
+   * The markers are labelled with the given @a prefix and their index (e.g. "M0", "M1", ...).
+   */
+  inline std::vector<TimeSequence*> generate_markers(Trial* trial, unsigned count, unsigned samples, double rate = 100.0, const std::string& prefix = "M")
+  {
+    Random rnd(7u);
+    std::vector<std::string> labels(count);
+    std::vector<double> positions(3 * count);
+    for (unsigned m = 0 ; m < count ; ++m)
+    {
+      labels[m] = prefix + std::to_string(m);
+      positions[3*m]   = rnd(-1000.0, 1000.0);
+      positions[3*m+1] = rnd(-500.0, 500.0);
+      positions[3*m+2] = rnd(0.0, 2000.0);
+    }
+    return generate_markers(trial, labels, positions, samples, rate);
+  };
+
+  /*
+   * Generate @a count analog channels (analog type, 1 component, unit V, range +/- 10 V) added to the trial @a trial.
+   * Each channel is the sum of two sinusoids and a noise. The channels are labelled with the given @a prefix and their index.
+   */
+  inline std::vector<TimeSequence*> generate_analogs(Trial* trial, unsigned count, unsigned samples, double rate = 1000.0, const std::string& prefix = "A")
+  {
+    Random rnd(13u);
+    std::vector<TimeSequence*> analogs(count, nullptr);
+    for (unsigned c = 0 ; c < count ; ++c)
+    {
+      analogs[c] = new TimeSequence(prefix + std::to_string(c), 1, samples, rate, 0.0, TimeSequence::Analog, "V", 1.0, 0.0, {{-10.0,10.0}}, trial->timeSequences());
+      double* data = analogs[c]->data();
+      for (unsigned i = 0 ; i < samples ; ++i)
+      {
+        const double t = static_cast<double>(i) / rate;
+        data[i] = 2.0 * std::sin(2.0 * M_PI * (1.0 + c) * t) + 0.5 * std::sin(2.0 * M_PI * 45.0 * t + c) + rnd(-0.05, 0.05);
+      }
+    }
+    return analogs;
+  };
+};
+};
+
+#endif // openma_benchmark_h
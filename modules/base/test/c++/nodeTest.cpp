@@ -1,6 +1,13 @@
 #include <cxxtest/TestDrive.h>
 
 #include "nodeTest_def.h"
+#include <openma/base/timesequence.h>
+#include <openma/base/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread> // std::this_thread::yield
+#include <memory> // std::make_shared
 
 CXXTEST_SUITE(NodeTest)
 {
@@ -119,6 +126,84 @@ CXXTEST_SUITE(NodeTest)
     TS_ASSERT_EQUALS(bar->property("version").cast<int>(),1);
   };
   
+  CXXTEST_TEST(staticPropertyKeys)
+  {
+    ma::Node node("foo");
+    auto keys = node.staticPropertyKeys();
+    TS_ASSERT_EQUALS(keys.size(),2ul);
+    TS_ASSERT_EQUALS(keys[0],"name");
+    TS_ASSERT_EQUALS(keys[1],"description");
+    TestNode test("bar");
+    keys = test.staticPropertyKeys();
+    TS_ASSERT_EQUALS(keys.size(),3ul);
+    TS_ASSERT_EQUALS(keys[2],"version");
+    ma::TimeSequence ts("ts",4,10,100.0,0.0,ma::TimeSequence::Position,"mm");
+    keys = ts.staticPropertyKeys();
+    TS_ASSERT_EQUALS(std::find(keys.cbegin(),keys.cend(),"samples") != keys.cend(), true);
+    keys = ts.staticPropertyKeys(true);
+    TS_ASSERT_EQUALS(std::find(keys.cbegin(),keys.cend(),"samples") == keys.cend(), true);
+    TS_ASSERT_EQUALS(std::find(keys.cbegin(),keys.cend(),"sampleRate") != keys.cend(), true);
+  };
+  
+  CXXTEST_TEST(propertySource)
+  {
+    ma::Node node("foo");
+    auto source = std::make_shared<TestPropertySource>();
+    node.setProperty("POINT:RATE", 50.0);
+    unsigned long ts = node.timestamp();
+    node.setPropertySource(source);
+    TS_ASSERT_EQUALS(node.timestamp(), ts);
+    TS_ASSERT_EQUALS(node.propertySource(), source.get());
+    // Properties already set have the priority
+    TS_ASSERT_EQUALS(node.property("POINT:RATE").cast<double>(), 50.0);
+    TS_ASSERT_EQUALS(source->Lookups, 0);
+    TS_ASSERT_EQUALS(node.property("POINT:USED").cast<int>(), 12);
+    TS_ASSERT_EQUALS(node.property("POINT:UNKNOWN").isValid(), false);
+    TS_ASSERT_EQUALS(source->Lookups, 2);
+    // The source is shared by the clone
+    ma::Node* clone = node.clone();
+    TS_ASSERT_EQUALS(clone->propertySource(), source.get());
+    TS_ASSERT_EQUALS(clone->property("POINT:USED").cast<int>(), 12);
+    // Setting a property resolves the source
+    node.setProperty("POINT:USED", ma::Any());
+    TS_ASSERT_EQUALS(node.propertySource(), nullptr);
+    TS_ASSERT_EQUALS(node.property("POINT:USED").isValid(), false);
+    TS_ASSERT_EQUALS(node.property("POINT:RATE").cast<double>(), 50.0);
+    TS_ASSERT_EQUALS(node.dynamicProperties().size(), 1ul);
+    // Accessing all the dynamic properties resolves the source too
+    TS_ASSERT_EQUALS(clone->dynamicProperties().size(), 2ul);
+    TS_ASSERT_EQUALS(clone->propertySource(), nullptr);
+    TS_ASSERT_EQUALS(clone->property("POINT:RATE").cast<double>(), 50.0);
+    delete clone;
+  };
+  
+  CXXTEST_TEST(propertySourceConcurrentResolution)
+  {
+    ma::Node node("foo");
+    node.setPropertySource(std::make_shared<TestPropertySource>());
+    const ma::Node* shared = &node;
+    std::vector<int> used(64, 0);
+    std::vector<size_t> sizes(64, 0);
+    std::atomic<int> ready{0};
+    // Const methods looking up and resolving the source at the same time
+    ma::parallel_for(used.size(), [&](size_t i) {
+      // Each thread processes one of the first indices: they wait for each other so that they really start together
+      if (i < 4)
+      {
+        ++ready;
+        while (ready.load() < 4)
+          std::this_thread::yield();
+      }
+      if (i % 2)
+        sizes[i] = shared->dynamicProperties().size();
+      used[i] = shared->property("POINT:USED").cast<int>();
+    }, 4);
+    TS_ASSERT_EQUALS(std::count(used.cbegin(), used.cend(), 12), 64);
+    for (size_t i = 1 ; i < sizes.size() ; i += 2)
+      TS_ASSERT_EQUALS(sizes[i], 2ul);
+    TS_ASSERT_EQUALS(node.propertySource(), nullptr);
+  };
+  
   CXXTEST_TEST(childrenStack)
   {
     TestNode root("root");
@@ -577,6 +662,9 @@ CXXTEST_TEST_REGISTRATION(NodeTest, modified)
 CXXTEST_TEST_REGISTRATION(NodeTest, staticProperty)
 CXXTEST_TEST_REGISTRATION(NodeTest, dynamicProperty)
 CXXTEST_TEST_REGISTRATION(NodeTest, inheritingClassWithStaticProperty)
+CXXTEST_TEST_REGISTRATION(NodeTest, staticPropertyKeys)
+CXXTEST_TEST_REGISTRATION(NodeTest, propertySource)
+  CXXTEST_TEST_REGISTRATION(NodeTest, propertySourceConcurrentResolution)
 CXXTEST_TEST_REGISTRATION(NodeTest, childrenStack)
 CXXTEST_TEST_REGISTRATION(NodeTest, childrenHeap)
 CXXTEST_TEST_REGISTRATION(NodeTest, childMethod)
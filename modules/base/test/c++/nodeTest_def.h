@@ -4,6 +4,7 @@
 #include <openma/base/node.h>
 #include <openma/base/node_p.h>
 #include <openma/base/property.h>
+#include <openma/base/propertysource.h>
 
 class TestNodePrivate;
 
@@ -246,4 +247,32 @@ void TestNode3::copyContents(const ma::Node* source) _OPENMA_NOEXCEPT
     optr->Shortcut = this->findChild(optr_src->Shortcut->name());
 };
 
+// ------------------------------------------------------------------------- //
+
+class TestPropertySource : public ma::PropertySource
+{
+public:
+  TestPropertySource() : ma::PropertySource(), Lookups(0) {};
+  
+  virtual bool find(const std::string& key, ma::Any* value) const override
+  {
+    ++this->Lookups;
+    if (key == "POINT:RATE")
+      *value = 100.0;
+    else if (key == "POINT:USED")
+      *value = 12;
+    else
+      return false;
+    return true;
+  };
+  
+  virtual void extract(std::unordered_map<std::string,ma::Any>* properties) const override
+  {
+    (*properties)["POINT:RATE"] = 100.0;
+    (*properties)["POINT:USED"] = 12;
+  };
+  
+  mutable int Lookups;
+};
+
 #endif // nodeTest_def_h
\ No newline at end of file
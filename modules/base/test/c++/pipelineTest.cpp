@@ -0,0 +1,215 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/base/pipeline.h>
+#include <openma/base/node.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+// Node used to know when the output of a stage is released
+class TrackedNode : public ma::Node
+{
+public:
+  static std::atomic<int> Alive;
+  TrackedNode(const std::string& name, std::atomic<bool>* released, ma::Node* parent)
+  : ma::Node(name, parent), mp_Released(released)
+  {
+    ++Alive;
+  };
+  ~TrackedNode()
+  {
+    if (this->mp_Released != nullptr)
+      *this->mp_Released = true;
+    --Alive;
+  };
+private:
+  std::atomic<bool>* mp_Released;
+};
+
+std::atomic<int> TrackedNode::Alive{0};
+
+CXXTEST_SUITE(PipelineTest)
+{
+  CXXTEST_TEST(addStage)
+  {
+    ma::Pipeline pipeline;
+    TS_ASSERT_EQUALS(pipeline.stages(), 0);
+    TS_ASSERT_EQUALS(pipeline.run(10), true);
+    auto noop = [](ma::Node* , const std::vector<ma::Node*>& , size_t ) {return true;};
+    TS_ASSERT_EQUALS(pipeline.addStage("foo", noop), 0);
+    TS_ASSERT_EQUALS(pipeline.addStage("bar", noop, {0}), 1);
+    TS_ASSERT_EQUALS(pipeline.addStage("toto", noop, {2}), -1);
+    TS_ASSERT_EQUALS(pipeline.addStage("toto", noop, {-1}), -1);
+    TS_ASSERT_EQUALS(pipeline.addStage("toto", nullptr), -1);
+    TS_ASSERT_EQUALS(pipeline.stages(), 2);
+    TS_ASSERT_EQUALS(pipeline.stageName(1), "bar");
+    TS_ASSERT_EQUALS(pipeline.threads(), 0u);
+    TS_ASSERT_EQUALS(pipeline.capacity(), 0u);
+    pipeline.setThreads(2);
+    pipeline.setCapacity(3);
+    TS_ASSERT_EQUALS(pipeline.threads(), 2u);
+    TS_ASSERT_EQUALS(pipeline.capacity(), 3u);
+    TS_ASSERT_EQUALS(pipeline.run(0), true);
+    TS_ASSERT_EQUALS(pipeline.run(20), true);
+    TS_ASSERT_EQUALS(pipeline.failures().empty(), true);
+  };
+  
+  CXXTEST_TEST(chain)
+  {
+    const size_t num = 100;
+    std::vector<int> results(num, 0);
+    // The stages are run by worker threads: the checks are counted and asserted afterwards
+    std::atomic<int> invalids{0};
+    ma::Pipeline pipeline;
+    pipeline.setThreads(4);
+    auto source = pipeline.addStage("source", [&invalids](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t session) {
+      if (!inputs.empty())
+        ++invalids;
+      auto value = new ma::Node("value", output);
+      value->setProperty("value", static_cast<int>(session));
+      return true;
+    });
+    auto twice = pipeline.addStage("twice", [&invalids](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t ) {
+      if ((inputs.size() != 1u) || (inputs[0]->name() != "source"))
+      {
+        ++invalids;
+        return false;
+      }
+      // The input is modified in place and kept by this stage
+      auto value = inputs[0]->child(0);
+      value->setProperty("value", 2 * value->property("value").cast<int>());
+      value->addParent(output);
+      return true;
+    }, {source});
+    pipeline.addStage("sink", [&results](ma::Node* , const std::vector<ma::Node*>& inputs, size_t session) {
+      results[session] = inputs[0]->child(0)->property("value").cast<int>();
+      return true;
+    }, {twice});
+    TS_ASSERT_EQUALS(pipeline.run(num), true);
+    TS_ASSERT_EQUALS(invalids.load(), 0);
+    for (size_t i = 0 ; i < num ; ++i)
+      TS_ASSERT_EQUALS(results[i], 2 * static_cast<int>(i));
+  };
+  
+  CXXTEST_TEST(diamond)
+  {
+    const size_t num = 50;
+    std::vector<std::atomic<bool>> released(num);
+    for (auto& r : released)
+      r = false;
+    std::atomic<int> checked{0}, invalids{0};
+    ma::Pipeline pipeline;
+    pipeline.setThreads(4);
+    auto a = pipeline.addStage("A", [&released](ma::Node* output, const std::vector<ma::Node*>& , size_t session) {
+      new TrackedNode("data", &released[session], output);
+      return true;
+    });
+    auto branch = [&invalids](ma::Node* output, const std::vector<ma::Node*>& inputs, size_t ) {
+      if (inputs[0]->child(0)->name() != "data")
+        ++invalids;
+      new TrackedNode(output->name() + "_data", nullptr, output);
+      return true;
+    };
+    auto b = pipeline.addStage("B", branch, {a});
+    auto c = pipeline.addStage("C", branch, {a});
+    pipeline.addStage("D", [&](ma::Node* , const std::vector<ma::Node*>& inputs, size_t session) {
+      if ((inputs.size() != 2u) || (inputs[0]->child(0)->name() != "B_data") || (inputs[1]->child(0)->name() != "C_data"))
+        ++invalids;
+      // The output of A is released as soon as B and C are finished
+      else if (released[session].load())
+        ++checked;
+      return true;
+    }, {b, c});
+    TS_ASSERT_EQUALS(pipeline.run(num), true);
+    TS_ASSERT_EQUALS(invalids.load(), 0);
+    TS_ASSERT_EQUALS(checked.load(), static_cast<int>(num));
+    TS_ASSERT_EQUALS(TrackedNode::Alive.load(), 0);
+  };
+  
+  CXXTEST_TEST(backpressure)
+  {
+    std::atomic<int> inflight{0}, peak{0}, done{0};
+    ma::Pipeline pipeline;
+    pipeline.setThreads(4);
+    pipeline.setCapacity(3);
+    auto source = pipeline.addStage("source", [&](ma::Node* output, const std::vector<ma::Node*>& , size_t ) {
+      const int current = ++inflight;
+      int previous = peak.load();
+      while ((current > previous) && !peak.compare_exchange_weak(previous, current));
+      new TrackedNode("data", nullptr, output);
+      return true;
+    });
+    auto middle = pipeline.addStage("middle", [](ma::Node* , const std::vector<ma::Node*>& inputs, size_t ) {
+      return inputs[0]->hasChildren();
+    }, {source});
+    pipeline.addStage("sink", [&](ma::Node* , const std::vector<ma::Node*>& , size_t ) {
+      --inflight;
+      ++done;
+      return true;
+    }, {middle});
+    TS_ASSERT_EQUALS(pipeline.run(200), true);
+    TS_ASSERT_EQUALS(done.load(), 200);
+    TS_ASSERT(peak.load() <= 3);
+    TS_ASSERT(peak.load() >= 1);
+    TS_ASSERT_EQUALS(TrackedNode::Alive.load(), 0);
+  };
+  
+  CXXTEST_TEST(failures)
+  {
+    std::atomic<int> calls{0};
+    ma::Pipeline pipeline;
+    pipeline.setThreads(3);
+    auto source = pipeline.addStage("source", [](ma::Node* output, const std::vector<ma::Node*>& , size_t ) {
+      new TrackedNode("data", nullptr, output);
+      return true;
+    });
+    auto check = pipeline.addStage("check", [](ma::Node* output, const std::vector<ma::Node*>& , size_t session) {
+      new TrackedNode("data", nullptr, output);
+      if (session == 11)
+        throw std::runtime_error("Corrupted session");
+      return (session != 3) && (session != 7);
+    }, {source});
+    pipeline.addStage("sink", [&calls](ma::Node* , const std::vector<ma::Node*>& , size_t ) {
+      ++calls;
+      return true;
+    }, {source, check});
+    TS_ASSERT_EQUALS(pipeline.run(20), false);
+    TS_ASSERT_EQUALS(calls.load(), 17);
+    TS_ASSERT_EQUALS(pipeline.failures().size(), 3u);
+    TS_ASSERT_EQUALS(pipeline.failures()[0], 3u);
+    TS_ASSERT_EQUALS(pipeline.failures()[1], 7u);
+    TS_ASSERT_EQUALS(pipeline.failures()[2], 11u);
+    TS_ASSERT_EQUALS(TrackedNode::Alive.load(), 0);
+    // The failures are reset for each run
+    TS_ASSERT_EQUALS(pipeline.run(3), true);
+    TS_ASSERT_EQUALS(pipeline.failures().empty(), true);
+  };
+  
+  CXXTEST_TEST(scheduledAfterFailure)
+  {
+    const size_t num = 10;
+    std::atomic<int> calls{0};
+    ma::Pipeline pipeline;
+    // With one thread, both branches are scheduled once the source is finished but only the first one is run
+    pipeline.setThreads(1);
+    auto source = pipeline.addStage("source", [](ma::Node* , const std::vector<ma::Node*>& , size_t ) {return true;});
+    auto branch = [&calls](ma::Node* , const std::vector<ma::Node*>& , size_t ) {
+      ++calls;
+      return false;
+    };
+    pipeline.addStage("B", branch, {source});
+    pipeline.addStage("C", branch, {source});
+    TS_ASSERT_EQUALS(pipeline.run(num), false);
+    TS_ASSERT_EQUALS(calls.load(), static_cast<int>(num));
+    TS_ASSERT_EQUALS(pipeline.failures().size(), num);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(PipelineTest)
+CXXTEST_TEST_REGISTRATION(PipelineTest, addStage)
+CXXTEST_TEST_REGISTRATION(PipelineTest, chain)
+CXXTEST_TEST_REGISTRATION(PipelineTest, diamond)
+CXXTEST_TEST_REGISTRATION(PipelineTest, backpressure)
+CXXTEST_TEST_REGISTRATION(PipelineTest, failures)
+CXXTEST_TEST_REGISTRATION(PipelineTest, scheduledAfterFailure)
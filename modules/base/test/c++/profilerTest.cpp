@@ -0,0 +1,178 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/base/profiler.h>
+#include <openma/base/node.h>
+#include <openma/base/parallel.h>
+#include <openma/base/timesequence.h>
+
+#include <algorithm> // std::max
+#include <string> // std::stoul
+
+CXXTEST_SUITE(ProfilerTest)
+{
+  CXXTEST_TEST(disabled)
+  {
+    ma::Profiler::reset();
+    TS_ASSERT_EQUALS(ma::Profiler::isEnabled(),false);
+    {
+      OPENMA_PROFILE_SCOPE("foo");
+      OPENMA_PROFILE_COUNT("bar",10);
+    }
+    TS_ASSERT_EQUALS(ma::Profiler::context(),nullptr);
+    ma::Node root("root");
+    auto profiler = ma::Profiler::exportNode(&root);
+    TS_ASSERT_EQUALS(profiler->name(),"Profiler");
+    TS_ASSERT_EQUALS(profiler->hasChildren(),false);
+    TS_ASSERT_EQUALS(ma::Profiler::exportJSON(),"{\"counters\":{},\"scopes\":[]}");
+  };
+  
+  CXXTEST_TEST(nestedScopes)
+  {
+    ma::Profiler::reset();
+    ma::Profiler::setEnabled(true);
+    for (int i = 0 ; i < 3 ; ++i)
+    {
+      OPENMA_PROFILE_SCOPE("outer");
+      OPENMA_PROFILE_COUNT("samples",100);
+      {
+        OPENMA_PROFILE_SCOPE("inner");
+        OPENMA_PROFILE_COUNT("bytes",8);
+        OPENMA_PROFILE_COUNT("bytes",2);
+      }
+    }
+    OPENMA_PROFILE_COUNT("orphan",1);
+    ma::Profiler::setEnabled(false);
+    ma::Node root("root");
+    auto profiler = ma::Profiler::exportNode(&root);
+    TS_ASSERT_EQUALS(profiler->property("orphan").cast<int>(),1);
+    TS_ASSERT_EQUALS(profiler->children().size(),1ul);
+    auto outer = profiler->child(0);
+    TS_ASSERT_EQUALS(outer->name(),"outer");
+    TS_ASSERT_EQUALS(outer->property("calls").cast<int>(),3);
+    TS_ASSERT_EQUALS(outer->property("samples").cast<int>(),300);
+    TS_ASSERT_EQUALS(outer->children().size(),1ul);
+    auto inner = outer->child(0);
+    TS_ASSERT_EQUALS(inner->name(),"inner");
+    TS_ASSERT_EQUALS(inner->property("calls").cast<int>(),3);
+    TS_ASSERT_EQUALS(inner->property("bytes").cast<int>(),30);
+    TS_ASSERT_EQUALS(outer->property("bytes").isValid(),false);
+    TS_ASSERT(outer->property("total").cast<double>() >= inner->property("total").cast<double>());
+    TS_ASSERT(inner->property("min").cast<double>() <= inner->property("max").cast<double>());
+    const std::string json = ma::Profiler::exportJSON();
+    TS_ASSERT_DIFFERS(json.find("\"name\":\"outer\",\"calls\":3"),std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"counters\":{\"bytes\":30}"),std::string::npos);
+    const std::string trace = ma::Profiler::exportChromeTrace();
+    TS_ASSERT_EQUALS(trace.find("{\"traceEvents\":["),0ul);
+    size_t events = 0, pos = 0;
+    while ((pos = trace.find("\"ph\":\"X\"",pos)) != std::string::npos)
+    {
+      ++events;
+      ++pos;
+    }
+    TS_ASSERT_EQUALS(events,6ul);
+    TS_ASSERT_DIFFERS(trace.find("\"args\":{\"bytes\":10}"),std::string::npos);
+    ma::Profiler::reset();
+    TS_ASSERT_EQUALS(ma::Profiler::exportJSON(),"{\"counters\":{},\"scopes\":[]}");
+  };
+  
+  CXXTEST_TEST(parallelFor)
+  {
+    ma::Profiler::reset();
+    ma::Profiler::setEnabled(true);
+    {
+      OPENMA_PROFILE_SCOPE("batch");
+      ma::parallel_for(16, [](size_t ) {
+        OPENMA_PROFILE_SCOPE("task");
+        OPENMA_PROFILE_COUNT("items",1);
+      }, 4);
+    }
+    ma::Profiler::setEnabled(false);
+    ma::Node root("root");
+    auto profiler = ma::Profiler::exportNode(&root);
+    TS_ASSERT_EQUALS(profiler->children().size(),1ul);
+    auto batch = profiler->child(0);
+    TS_ASSERT_EQUALS(batch->name(),"batch");
+    TS_ASSERT_EQUALS(batch->children().size(),1ul);
+    auto task = batch->child(0);
+    TS_ASSERT_EQUALS(task->name(),"task");
+    TS_ASSERT_EQUALS(task->property("calls").cast<int>(),16);
+    TS_ASSERT_EQUALS(task->property("items").cast<int>(),16);
+    ma::Profiler::reset();
+  };
+  
+  CXXTEST_TEST(threadSlots)
+  {
+    ma::Profiler::reset();
+    ma::Profiler::setEnabled(true);
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+      OPENMA_PROFILE_SCOPE("batch");
+      ma::parallel_for(16, [](size_t ) {
+        OPENMA_PROFILE_SCOPE("task");
+      }, 4);
+    }
+    ma::Profiler::setEnabled(false);
+    // The slots of the exited worker threads are reused
+    const std::string trace = ma::Profiler::exportChromeTrace();
+    unsigned tid = 0;
+    size_t pos = 0;
+    while ((pos = trace.find("\"tid\":",pos)) != std::string::npos)
+    {
+      pos += 6;
+      tid = std::max(tid, static_cast<unsigned>(std::stoul(trace.substr(pos))));
+    }
+    TS_ASSERT(tid < 4u);
+    ma::Node root("root");
+    auto task = ma::Profiler::exportNode(&root)->child(0)->child(0);
+    TS_ASSERT_EQUALS(task->name(),"task");
+    TS_ASSERT_EQUALS(task->property("calls").cast<int>(),160);
+    ma::Profiler::reset();
+  };
+  
+  CXXTEST_TEST(resetWhileAttached)
+  {
+    ma::Profiler::reset();
+    ma::Profiler::setEnabled(true);
+    {
+      OPENMA_PROFILE_SCOPE("batch");
+      ma::parallel_for(2, [](size_t ) {
+        OPENMA_PROFILE_SCOPE("task");
+        // Refused as the worker threads are attached to the scope of the calling thread
+        ma::Profiler::reset();
+      }, 2);
+    }
+    ma::Profiler::setEnabled(false);
+    ma::Node root("root");
+    auto profiler = ma::Profiler::exportNode(&root);
+    TS_ASSERT_EQUALS(profiler->children().size(),1ul);
+    TS_ASSERT_EQUALS(profiler->child(0)->property("calls").cast<int>(),1);
+    TS_ASSERT_EQUALS(profiler->child(0)->child(0)->property("calls").cast<int>(),2);
+    ma::Profiler::reset();
+    TS_ASSERT_EQUALS(ma::Profiler::exportJSON(),"{\"counters\":{},\"scopes\":[]}");
+  };
+  
+  CXXTEST_TEST(allocations)
+  {
+    ma::Profiler::reset();
+    ma::Profiler::setEnabled(true);
+    {
+      OPENMA_PROFILE_SCOPE("allocate");
+      ma::TimeSequence ts("ts",4,100,100.0,0.0,ma::TimeSequence::Position,"mm");
+      ma::TimeSequence empty("empty",4,0,100.0,0.0,ma::TimeSequence::Position,"mm");
+    }
+    ma::Profiler::setEnabled(false);
+    ma::Node root("root");
+    auto allocate = ma::Profiler::exportNode(&root)->child(0);
+    TS_ASSERT_EQUALS(allocate->property("allocations").cast<int>(),1);
+    TS_ASSERT_EQUALS(allocate->property("allocated_bytes").cast<int>(),3200);
+    ma::Profiler::reset();
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ProfilerTest)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, disabled)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, nestedScopes)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, parallelFor)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, threadSlots)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, resetWhileAttached)
+CXXTEST_TEST_REGISTRATION(ProfilerTest, allocations)
@@ -1,6 +1,13 @@
 #include <cxxtest/TestDrive.h>
 
 #include <openma/base/timesequence.h>
+#include <openma/base/parallel.h>
+
+#include <algorithm> // std::count
+#include <atomic>
+#include <memory> // std::unique_ptr
+#include <thread> // std::this_thread::yield
+#include <vector>
 
 CXXTEST_SUITE(TimeSequenceTest)
 {
@@ -175,6 +182,294 @@ CXXTEST_SUITE(TimeSequenceTest)
     TS_ASSERT_EQUALS(startTime, 1.0);
     TS_ASSERT_EQUALS(samples, 5u);
   };
+  
+  CXXTEST_TEST(resizeCompact)
+  {
+    ma::TimeSequence foo("foo",2,3,100.0,0.0,ma::TimeSequence::Analog,"V");
+    for (unsigned i = 0 ; i < 6 ; ++i)
+      foo.data()[i] = double(i);
+    foo.resize(5);
+    TS_ASSERT_EQUALS(foo.samples(), 5u);
+    TS_ASSERT_EQUALS(foo.capacity(), 5u);
+    TS_ASSERT_EQUALS(foo.stride(), 5u);
+    TS_ASSERT_EQUALS(foo.data(2,0), 2.0);
+    TS_ASSERT_EQUALS(foo.data(0,1), 3.0);
+    TS_ASSERT_EQUALS(foo.data()[5], 3.0);
+  };
+  
+  CXXTEST_TEST(reserveAndAppend)
+  {
+    ma::TimeSequence foo("foo",2,0,100.0,0.0,ma::TimeSequence::Analog,"V");
+    foo.reserve(4);
+    TS_ASSERT_EQUALS(foo.samples(), 0u);
+    TS_ASSERT_EQUALS(foo.capacity(), 4u);
+    const double values[6] = {1.0, 2.0, 3.0, -1.0, -2.0, -3.0};
+    const double* ptr = nullptr;
+    foo.append(values, 3);
+    ptr = foo.data();
+    TS_ASSERT_EQUALS(foo.samples(), 3u);
+    TS_ASSERT_EQUALS(foo.stride(), 4u);
+    TS_ASSERT_EQUALS(foo.data(2,0), 3.0);
+    TS_ASSERT_EQUALS(foo.data(0,1), -1.0);
+    TS_ASSERT_EQUALS(foo.data()[4], -1.0);
+    // Geometric growth
+    foo.append(values, 3);
+    TS_ASSERT_DIFFERS(foo.data(), ptr);
+    TS_ASSERT_EQUALS(foo.samples(), 6u);
+    TS_ASSERT_EQUALS(foo.capacity(), 8u);
+    const double expected[6] = {1.0, 2.0, 3.0, 1.0, 2.0, 3.0};
+    for (unsigned i = 0 ; i < 6 ; ++i)
+    {
+      TS_ASSERT_EQUALS(foo.data(i,0), expected[i]);
+      TS_ASSERT_EQUALS(foo.data(i,1), -expected[i]);
+    }
+    // Resize inside the capacity does not reallocate
+    ptr = foo.data();
+    foo.resize(7);
+    TS_ASSERT_EQUALS(foo.data(), ptr);
+    foo.resize(5);
+    TS_ASSERT_EQUALS(foo.data(), ptr);
+    TS_ASSERT_EQUALS(foo.capacity(), 8u);
+    TS_ASSERT_EQUALS(foo.data(4,1), -2.0);
+    foo.shrinkToFit();
+    TS_ASSERT_EQUALS(foo.capacity(), 5u);
+    TS_ASSERT_EQUALS(foo.data()[5], -1.0);
+  };
+  
+  CXXTEST_TEST(ringBuffer)
+  {
+    ma::TimeSequence foo("foo",2,0,10.0,0.0,ma::TimeSequence::Analog,"V");
+    foo.enableRingBuffer(4);
+    TS_ASSERT_EQUALS(foo.isRingBuffer(), true);
+    TS_ASSERT_EQUALS(foo.capacity(), 4u);
+    const double values[6] = {1.0, 2.0, 3.0, -1.0, -2.0, -3.0};
+    foo.append(values, 3);
+    TS_ASSERT_EQUALS(foo.samples(), 3u);
+    TS_ASSERT_EQUALS(foo.startTime(), 0.0);
+    foo.append(values, 3);
+    TS_ASSERT_EQUALS(foo.samples(), 4u);
+    TS_ASSERT_EQUALS(foo.capacity(), 4u);
+    TS_ASSERT_DELTA(foo.startTime(), 0.2, 1e-15);
+    const double expected[4] = {3.0, 1.0, 2.0, 3.0};
+    for (unsigned i = 0 ; i < 4 ; ++i)
+    {
+      TS_ASSERT_EQUALS(foo.data(i,0), expected[i]);
+      TS_ASSERT_EQUALS(foo.data(i,1), -expected[i]);
+    }
+    TS_ASSERT_EQUALS(foo.isLinearized(), false);
+    auto bar = static_cast<ma::TimeSequence*>(foo.clone());
+    foo.linearize();
+    TS_ASSERT_EQUALS(foo.isLinearized(), true);
+    for (unsigned i = 0 ; i < 4 ; ++i)
+    {
+      TS_ASSERT_EQUALS(foo.data()[i], expected[i]);
+      TS_ASSERT_EQUALS(foo.data()[i+4], -expected[i]);
+      TS_ASSERT_EQUALS(bar->data(i,0), expected[i]);
+    }
+    TS_ASSERT_EQUALS(bar->isRingBuffer(), true);
+    // More samples than the capacity
+    const double values2[12] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, -1.0, -2.0, -3.0, -4.0, -5.0, -6.0};
+    bar->append(values2, 6);
+    TS_ASSERT_EQUALS(bar->samples(), 4u);
+    TS_ASSERT_DELTA(bar->startTime(), 0.8, 1e-15);
+    for (unsigned i = 0 ; i < 4 ; ++i)
+      TS_ASSERT_EQUALS(bar->data(i,1), -values2[i+2]);
+    delete bar;
+    foo.disableRingBuffer();
+    foo.append(values, 1);
+    TS_ASSERT_EQUALS(foo.samples(), 5u);
+    TS_ASSERT_EQUALS(foo.data(4,0), 1.0);
+    TS_ASSERT_EQUALS(foo.data(0,0), 3.0);
+  };
+  
+  CXXTEST_TEST(storageFloat)
+  {
+    ma::TimeSequence foo("foo",2,3,100.0,0.0,ma::TimeSequence::Analog,"V");
+    TS_ASSERT_EQUALS(foo.storage(), ma::TimeSequence::Storage::Double);
+    TS_ASSERT_EQUALS(foo.elementSize(), sizeof(double));
+    const double values[6] = {0.1, 0.2, 0.3, -1.5, -2.5, -3.5};
+    std::copy_n(values, 6, foo.data());
+    foo.setStorage(ma::TimeSequence::Storage::Float);
+    TS_ASSERT_EQUALS(foo.elementSize(), sizeof(float));
+    TS_ASSERT_EQUALS(foo.data(), nullptr);
+    TS_ASSERT_DIFFERS(foo.rawData(), nullptr);
+    TS_ASSERT_EQUALS(static_cast<const float*>(foo.rawData())[1], 0.2f);
+    const ma::TimeSequence* bar = &foo;
+    TS_ASSERT_DELTA(bar->data(2,1), -3.5, 1e-7);
+    double out[3];
+    foo.read(0, 0, 3, out);
+    for (unsigned i = 0 ; i < 3 ; ++i)
+      TS_ASSERT_DELTA(out[i], values[i], 1e-7);
+    foo.append(values, 3);
+    TS_ASSERT_EQUALS(foo.samples(), 6u);
+    TS_ASSERT_DELTA(bar->data(5,0), 0.3, 1e-7);
+    TS_ASSERT_DELTA(bar->data(3,1), -1.5, 1e-7);
+    // The modifiable elements are only available for the storage Double
+    const std::vector<float> before(static_cast<const float*>(foo.rawData()), static_cast<const float*>(foo.rawData()) + foo.capacity() * foo.components());
+    foo.data(5,1) = 123.0;
+    foo.data(1000,3) = 456.0;
+    TS_ASSERT(std::equal(before.begin(), before.end(), static_cast<const float*>(foo.rawData())));
+    TS_ASSERT_DELTA(bar->data(5,1), -3.5, 1e-7);
+    auto baz = static_cast<ma::TimeSequence*>(foo.clone());
+    TS_ASSERT_EQUALS(baz->storage(), ma::TimeSequence::Storage::Float);
+    baz->setStorage(ma::TimeSequence::Storage::Double);
+    TS_ASSERT_DIFFERS(baz->data(), nullptr);
+    TS_ASSERT_DELTA(baz->data(4,0), 0.2, 1e-7);
+    delete baz;
+  };
+  
+  CXXTEST_TEST(storageInt16)
+  {
+    ma::TimeSequence foo("foo",1,4,1000.0,0.0,ma::TimeSequence::Analog,"V",0.5,2.0,{-10.0,10.0});
+    const double values[4] = {1.0, -3.0, 20000.0, -20000.0};
+    std::copy_n(values, 4, foo.data());
+    foo.setStorage(ma::TimeSequence::Storage::Int16);
+    TS_ASSERT_EQUALS(foo.elementSize(), sizeof(int16_t));
+    const int16_t* raw = static_cast<const int16_t*>(foo.rawData());
+    TS_ASSERT_EQUALS(raw[0], 4);
+    TS_ASSERT_EQUALS(raw[1], -4);
+    TS_ASSERT_EQUALS(raw[2], 32767); // Saturated
+    TS_ASSERT_EQUALS(raw[3], -32768); // Saturated
+    double out[4];
+    foo.read(0, 0, 4, out);
+    TS_ASSERT_EQUALS(out[0], 1.0);
+    TS_ASSERT_EQUALS(out[1], -3.0);
+    const double in[2] = {0.5, 1.5};
+    foo.write(0, 2, 2, in);
+    TS_ASSERT_EQUALS(raw[2], 3);
+    TS_ASSERT_EQUALS(raw[3], 5);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence&>(foo).data(3,0), 1.5);
+    // The stored elements are kept but the read values depend on the scale and offset
+    foo.setScale(1.0);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence&>(foo).data(3,0), 3.0);
+    // A null scale is considered as 1 in both directions
+    foo.setScale(0.0);
+    const double three = 3.0;
+    foo.write(0, 0, 1, &three);
+    TS_ASSERT_EQUALS(raw[0], 5);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence&>(foo).data(0,0), 3.0);
+  };
+  
+  CXXTEST_TEST(copyOnWrite)
+  {
+    ma::Node root("root");
+    ma::TimeSequence foo("foo",2,5,100.0,0.0,ma::TimeSequence::Analog,"V",&root);
+    const double init[10] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+    foo.write(0, 0, 5, init);
+    foo.write(1, 0, 5, init + 5);
+    const ma::TimeSequence* cfoo = &foo;
+    auto rootcloned = root.clone();
+    const ma::TimeSequence* cbar = rootcloned->child<ma::TimeSequence*>(0);
+    auto bar = rootcloned->child<ma::TimeSequence*>(0);
+    // The buffer is shared until a mutable access
+    TS_ASSERT_EQUALS(cbar->data(), cfoo->data());
+    TS_ASSERT_EQUALS(cbar->rawData(), cfoo->rawData());
+    TS_ASSERT_EQUALS(cbar->data(3,1), 8.0);
+    bar->data()[0] = -1.0;
+    TS_ASSERT_DIFFERS(cbar->data(), cfoo->data());
+    TS_ASSERT_EQUALS(cfoo->data()[0], 0.0);
+    TS_ASSERT_EQUALS(cbar->data()[0], -1.0);
+    for (unsigned i = 1 ; i < 10 ; ++i)
+      TS_ASSERT_EQUALS(cbar->data()[i], cfoo->data()[i]);
+    // The buffer is not copied again once detached
+    const double* detached = cbar->data();
+    bar->data(4,1) = 42.0;
+    TS_ASSERT_EQUALS(cbar->data(), detached);
+    TS_ASSERT_EQUALS(cfoo->data(4,1), 9.0);
+    // Same for the source
+    ma::TimeSequence baz("baz",1,1,100.0,0.0,ma::TimeSequence::Analog,"V");
+    baz.copy(&foo);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence&>(baz).data(), cfoo->data());
+    const double values[2] = {-5.0, -6.0};
+    foo.write(1, 0, 2, values);
+    TS_ASSERT_EQUALS(cfoo->data(1,1), -6.0);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence&>(baz).data(1,1), 6.0);
+    // Appending to a shared buffer with spare capacity
+    foo.reserve(10);
+    auto qux = static_cast<ma::TimeSequence*>(foo.clone());
+    const double more[2] = {10.0, 20.0};
+    foo.append(more, 1);
+    TS_ASSERT_EQUALS(foo.samples(), 6u);
+    TS_ASSERT_EQUALS(qux->samples(), 5u);
+    TS_ASSERT_EQUALS(cfoo->data(5,1), 20.0);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence*>(qux)->data(1,1), -6.0);
+    // A mutable pointer taken before a copy does not modify the copy
+    double* ptr = foo.data();
+    auto quux = static_cast<ma::TimeSequence*>(foo.clone());
+    TS_ASSERT_DIFFERS(static_cast<const ma::TimeSequence*>(quux)->data(), cfoo->data());
+    ptr[0] = 100.0;
+    TS_ASSERT_EQUALS(cfoo->data()[0], 100.0);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence*>(quux)->data()[0], 0.0);
+    delete quux;
+    delete qux;
+    delete rootcloned;
+  };
+  
+  CXXTEST_TEST(copyOnWriteWriter)
+  {
+    ma::TimeSequence foo("foo",1,5,100.0,0.0,ma::TimeSequence::Analog,"V");
+    const ma::TimeSequence* cfoo = &foo;
+    {
+      ma::TimeSequence::Writer writer(&foo);
+      for (unsigned i = 0 ; i < 5 ; ++i)
+        writer.data()[i] = static_cast<double>(i);
+      // The buffer is not shared during the lifetime of the writer
+      std::unique_ptr<ma::TimeSequence> bar(static_cast<ma::TimeSequence*>(foo.clone()));
+      TS_ASSERT_DIFFERS(static_cast<const ma::TimeSequence*>(bar.get())->data(), cfoo->data());
+    }
+    // Once the writer destroyed, the buffer is shared again
+    std::unique_ptr<ma::TimeSequence> baz(static_cast<ma::TimeSequence*>(foo.clone()));
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence*>(baz.get())->data(), cfoo->data());
+    TS_ASSERT_EQUALS(cfoo->data(4), 4.0);
+    // Unless a mutable pointer was given before the writer
+    foo.data()[0] = 10.0;
+    {
+      ma::TimeSequence::Writer writer(&foo);
+      writer.data()[1] = 11.0;
+    }
+    std::unique_ptr<ma::TimeSequence> qux(static_cast<ma::TimeSequence*>(foo.clone()));
+    TS_ASSERT_DIFFERS(static_cast<const ma::TimeSequence*>(qux.get())->data(), cfoo->data());
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence*>(qux.get())->data(1), 11.0);
+    TS_ASSERT_EQUALS(static_cast<const ma::TimeSequence*>(baz.get())->data(1), 1.0);
+    // No access to compact elements as double
+    foo.setStorage(ma::TimeSequence::Storage::Float);
+    ma::TimeSequence::Writer writer(&foo);
+    TS_ASSERT_EQUALS(writer.data(), nullptr);
+    TS_ASSERT_DIFFERS(writer.rawData(), nullptr);
+  };
+  
+  CXXTEST_TEST(copyOnWriteConcurrentDetach)
+  {
+    ma::TimeSequence foo("foo",1,100,100.0,0.0,ma::TimeSequence::Analog,"V");
+    const std::vector<double> ones(100, 1.0);
+    foo.write(0, 0, 100, ones.data());
+    std::vector<std::unique_ptr<ma::TimeSequence>> copies;
+    for (unsigned i = 0 ; i < 7 ; ++i)
+      copies.emplace_back(static_cast<ma::TimeSequence*>(foo.clone()));
+    std::vector<ma::TimeSequence*> sequences{&foo};
+    for (const auto& copy : copies)
+      sequences.push_back(copy.get());
+    std::atomic<int> ready{0};
+    // The time sequences sharing the same buffer are detached at the same time
+    ma::parallel_for(sequences.size(), [&](size_t i) {
+      if (i < 4)
+      {
+        ++ready;
+        while (ready.load() < 4)
+          std::this_thread::yield();
+      }
+      double* data = sequences[i]->data();
+      for (unsigned j = 0 ; j < 100 ; ++j)
+        data[j] += static_cast<double>(i);
+    }, 4);
+    for (size_t i = 0 ; i < sequences.size() ; ++i)
+    {
+      const double* data = static_cast<const ma::TimeSequence*>(sequences[i])->data();
+      TS_ASSERT_EQUALS(std::count(data, data + 100, 1.0 + static_cast<double>(i)), 100);
+      for (size_t j = 0 ; j < i ; ++j)
+        TS_ASSERT_DIFFERS(static_cast<const ma::TimeSequence*>(sequences[j])->data(), data);
+    }
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(TimeSequenceTest)
@@ -182,4 +477,11 @@ CXXTEST_TEST_REGISTRATION(TimeSequenceTest, accessor)
 CXXTEST_TEST_REGISTRATION(TimeSequenceTest, findWithType)
 CXXTEST_TEST_REGISTRATION(TimeSequenceTest, clone)
 CXXTEST_TEST_REGISTRATION(TimeSequenceTest, copy)
-CXXTEST_TEST_REGISTRATION(TimeSequenceTest, checkCommonProperties)
\ No newline at end of file
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, checkCommonProperties)CXXTEST_TEST_REGISTRATION(TimeSequenceTest, resizeCompact)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, reserveAndAppend)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, ringBuffer)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, storageFloat)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, storageInt16)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, copyOnWrite)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, copyOnWriteWriter)
+CXXTEST_TEST_REGISTRATION(TimeSequenceTest, copyOnWriteConcurrentDetach)
\ No newline at end of file
@@ -48,6 +48,7 @@
 #include "openma/body/inertialparameters.h"
 #include "openma/body/inertialparametersestimator.h"
 #include "openma/body/inversedynamicsmatrix.h"
+#include "openma/body/inversedynamicsnewtoneuler.h"
 #include "openma/body/inversedynamicsprocessor.h"
 #include "openma/body/joint.h"
 #include "openma/body/landmarksregistrar.h"
@@ -71,12 +72,13 @@ namespace body
 {
   OPENMA_BODY_EXPORT bool calibrate(SkeletonHelper* helper, Node* trials, Subject* subject = nullptr);
   OPENMA_BODY_EXPORT bool register_marker_cluster(SkeletonHelper* helper, Node* trials);
-  OPENMA_BODY_EXPORT bool reconstruct(Node* root, SkeletonHelper* helper, Node* trials);
-  OPENMA_BODY_EXPORT Node* reconstruct(SkeletonHelper* helper, Node* trials);
-  OPENMA_BODY_EXPORT bool extract_joint_kinematics(Node* output, Node* input, bool sideAdaptation = true);
-  OPENMA_BODY_EXPORT Node* extract_joint_kinematics(Node* input, bool sideAdaptation = true);
-  OPENMA_BODY_EXPORT bool extract_joint_kinetics(Node* output, Node* input, bool sideAdaptation = true, bool massNormalization = true, RepresentationFrame frame = RepresentationFrame::Distal);
-  OPENMA_BODY_EXPORT Node* extract_joint_kinetics(Node* input, bool sideAdaptation = true, bool massNormalization = true, RepresentationFrame frame = RepresentationFrame::Distal);
+  OPENMA_BODY_EXPORT bool reconstruct(Node* root, SkeletonHelper* helper, Node* trials, unsigned threads = 1);
+  OPENMA_BODY_EXPORT Node* reconstruct(SkeletonHelper* helper, Node* trials, unsigned threads = 1);
+  OPENMA_BODY_EXPORT bool extract_joint_kinematics(Node* output, Node* input, bool sideAdaptation = true, unsigned threads = 1);
+  OPENMA_BODY_EXPORT Node* extract_joint_kinematics(Node* input, bool sideAdaptation = true, unsigned threads = 1);
+  OPENMA_BODY_EXPORT bool extract_joint_kinetics(Node* output, Node* input, bool sideAdaptation = true, bool massNormalization = true, RepresentationFrame frame = RepresentationFrame::Distal, unsigned threads = 1);
+  OPENMA_BODY_EXPORT Node* extract_joint_kinetics(Node* input, bool sideAdaptation = true, bool massNormalization = true, RepresentationFrame frame = RepresentationFrame::Distal, unsigned threads = 1);
+  OPENMA_BODY_EXPORT bool register_node_types();
 };
 };
 
@@ -40,6 +40,8 @@
 #include "openma/base/any.h"
 #include "openma/base/macros.h" // _OPENMA_NOEXCEPT
 
+#include <vector>
+
 namespace ma
 {
 namespace body
@@ -61,6 +63,7 @@ namespace body
     Descriptor& operator=(Descriptor&& ) _OPENMA_NOEXCEPT = delete;
     
     bool evaluate(Node* output, const Node* input, const std::unordered_map<std::string, Any>& options = std::unordered_map<std::string, Any>{});
+    static bool evaluate(Node* output, const std::vector<Descriptor*>& descriptors, const std::vector<const Node*>& inputs, const std::unordered_map<std::string, Any>& options = std::unordered_map<std::string, Any>{}, unsigned threads = 1);
     
     virtual void copy(const Node* source) _OPENMA_NOEXCEPT override;
     
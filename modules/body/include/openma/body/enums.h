@@ -104,6 +104,22 @@ namespace body
     Part& operator=(const Part& ) = delete;
     Part& operator=(Part&& ) _OPENMA_NOEXCEPT = delete;
   };
+  
+  struct InverseDynamicMethod
+  {
+    enum: short
+    {
+      Matrix = 1,
+      NewtonEuler
+    };
+    
+    InverseDynamicMethod() = delete;
+    ~InverseDynamicMethod() _OPENMA_NOEXCEPT = delete;
+    InverseDynamicMethod(const InverseDynamicMethod& ) = delete;
+    InverseDynamicMethod(InverseDynamicMethod&& ) _OPENMA_NOEXCEPT = delete;
+    InverseDynamicMethod& operator=(const InverseDynamicMethod& ) = delete;
+    InverseDynamicMethod& operator=(InverseDynamicMethod&& ) _OPENMA_NOEXCEPT = delete;
+  };
 #endif
   
   enum class RepresentationFrame: char
@@ -230,6 +246,21 @@ namespace body
    * Custom segment defined by the developer.
    */
   
+  /**
+   * @enum InverseDynamicMethod
+   * Predefined values to select the algorithm used to compute joint kinetics.
+   * @relates SkeletonHelper
+   * @ingroup openma_body
+   */
+  /**
+   * @var InverseDynamicMethod InverseDynamicMethod::Matrix
+   * Homogeneous matrix approach (see InverseDynamicMatrix).
+   */
+  /**
+   * @var InverseDynamicMethod InverseDynamicMethod::NewtonEuler
+   * Recursive Newton-Euler approach computed frame by frame (see InverseDynamicNewtonEuler).
+   */
+  
 #endif
 };
 };
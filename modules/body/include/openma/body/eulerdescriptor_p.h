@@ -46,6 +46,7 @@
 #include <array>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace ma
 {
@@ -61,9 +62,23 @@ namespace body
     EulerDescriptorPrivate(EulerDescriptor* pint, const std::string& name, const std::array<int,3>& sequence, const std::array<double,3>& scale, const std::array<double,3>& offset);
     ~EulerDescriptorPrivate();
     
+    struct Options
+    {
+      std::string Suffix;
+      std::string SuffixProximal;
+      std::string SuffixDistal;
+      bool EnableDegreeConversion;
+      bool AdaptForInterpretation;
+    };
+    
+    static Options parseOptions(const std::unordered_map<std::string, Any>& options);
+    
     std::array<int,3> Sequence;
     std::array<double,3> Scale;
     std::array<double,3> Offset;
+    Options Settings;
+    const TimeSequence* ProximalTimeSequence;
+    const TimeSequence* DistalTimeSequence;
     math::Pose BufferData;
     math::Vector OutputData;
     double OutputSampleRate;
@@ -58,6 +58,9 @@ namespace body
     InverseDynamicMatrix& operator=(const InverseDynamicMatrix& ) = delete;
     InverseDynamicMatrix& operator=(InverseDynamicMatrix&& ) _OPENMA_NOEXCEPT = delete;
     
+    unsigned threads() const _OPENMA_NOEXCEPT;
+    void setThreads(unsigned value) _OPENMA_NOEXCEPT;
+    
     virtual bool run(Node* inout) final;
     
     virtual InverseDynamicMatrix* clone(Node* parent = nullptr) const final;
@@ -58,6 +58,8 @@ namespace body
     JointPrivate(Joint* pint, const std::string& name, Segment* ps, Anchor* pa, Segment* ds, Anchor* da);
     ~JointPrivate();
     
+    static void restore(Node* node);
+    
     Segment* ProximalSegment;
     Anchor* ProximalAnchor;
     Segment* DistalSegment;
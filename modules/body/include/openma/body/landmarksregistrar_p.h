@@ -42,11 +42,16 @@
 
 #include "openma/base/node_p.h"
 
+#include <mutex>
+
 namespace ma
 {
+  class TimeSequence;
+  
 namespace body
 {
   class LandmarksRegistrar;
+  class LandmarksTranslator;
   
   class LandmarksRegistrarPrivate : public NodePrivate
   {
@@ -56,7 +61,23 @@ namespace body
     LandmarksRegistrarPrivate(LandmarksRegistrar* pint, const std::string& name, const std::vector<std::string>& labels);
     ~LandmarksRegistrarPrivate();
     
+    // Labels resolved for a given layout of children (i.e. the name of each child) and a given translator.
+    // Any node sharing the same layout reuses the resolved indices.
+    struct Binding
+    {
+      bool Valid = false;
+      const LandmarksTranslator* Translator = nullptr;
+      unsigned long TranslatorTimestamp = 0ul;
+      std::vector<std::string> Layout;
+      std::vector<unsigned> Indices;
+    };
+    
+    bool isBindingValid(const LandmarksTranslator* lt, const Node* node) const _OPENMA_NOEXCEPT;
+    void bind(const LandmarksTranslator* lt, const Node* node) const;
+    
     std::vector<std::string> Labels;
+    mutable Binding LandmarksBinding;
+    mutable std::mutex BindingMutex;
   };
 };
 };
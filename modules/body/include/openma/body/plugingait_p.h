@@ -100,8 +100,20 @@ namespace body
     PluginGaitPrivate(PluginGait* pint, const std::string& name, int region, int side);
     ~PluginGaitPrivate() _OPENMA_NOEXCEPT;
     
+    // Results of the calibration of one lower limb. They are computed without modifying the helper (see calibrateLowerLimb()) and applied afterwards.
+    struct LowerLimbCalibration
+    {
+      double ThighLength = 0.0;
+      double ShankLength = 0.0;
+      double FootLength = 0.0;
+      double StaticPlantarFlexionOffset = 0.0;
+      double StaticRotationOffset = 0.0;
+    };
+    
     void computeHipJointCenter(double* HJC, double S, double C, double xdis) const _OPENMA_NOEXCEPT;
-    bool calibrateLowerLimb(int side, const math::Position* HJC, TaggedMappedPositions* landmarks) _OPENMA_NOEXCEPT;
+    bool calibrateLowerLimb(int side, const math::Position* HJC, const TaggedMappedPositions* landmarks, LowerLimbCalibration* output) const _OPENMA_NOEXCEPT;
+    void applyLowerLimbCalibration(int side, const LowerLimbCalibration* input) _OPENMA_NOEXCEPT;
+    bool calibrateHead(const TaggedMappedPositions* landmarks, double* offset) const _OPENMA_NOEXCEPT;
     bool reconstructUpperLimb(Model* model, Trial* trial, int side, const math::Vector* u_torso, const math::Vector* o_torso, TaggedMappedPositions* landmarks, double sampleRate, double startTime) const _OPENMA_NOEXCEPT;
     bool reconstructLowerLimb(Model* model, Trial* trial, int side, const math::Vector* HJC, TaggedMappedPositions* landmarks, double sampleRate, double startTime) const _OPENMA_NOEXCEPT;
     
@@ -77,8 +77,14 @@ namespace body
     void setGravity(const std::array<double,3>& g);
     const std::array<double,3>& gravity() const _OPENMA_NOEXCEPT;
     
+    int inverseDynamicMethod() const _OPENMA_NOEXCEPT;
+    void setInverseDynamicMethod(int value) _OPENMA_NOEXCEPT;
+    
+    unsigned threads() const _OPENMA_NOEXCEPT;
+    void setThreads(unsigned value) _OPENMA_NOEXCEPT;
+    
     virtual bool calibrate(Node* trials, Subject* subject) = 0;
-    bool reconstruct(Node* output, Node* trials);
+    bool reconstruct(Node* output, Node* trials, unsigned threads = 1);
     
     virtual LandmarksTranslator* defaultLandmarksTranslator() = 0;
     virtual PoseEstimator* defaultPoseEstimator() = 0;
@@ -52,14 +52,16 @@ namespace body
   class SkeletonHelper;
   
   using TaggedPositions = std::unordered_map<std::string,math::Position>;
-  using TaggedMappedPositions = std::unordered_map<std::string,math::Map<math::Position>>;
+  using TaggedMappedPositions = std::unordered_map<std::string,math::Map<const math::Position>>;
   
   class SkeletonHelperPrivate : public NodePrivate
   {
     OPENMA_DECLARE_PINT_ACCESSOR(SkeletonHelper)
     
     OPENMA_DECLARE_STATIC_PROPERTIES_DERIVED(SkeletonHelper, Node,
-      Property<SkeletonHelper, const std::array<double,3>&, &SkeletonHelper::gravity, &SkeletonHelper::setGravity>{"gravity"}
+      Property<SkeletonHelper, const std::array<double,3>&, &SkeletonHelper::gravity, &SkeletonHelper::setGravity>{"gravity"},
+      Property<SkeletonHelper, int, &SkeletonHelper::inverseDynamicMethod, &SkeletonHelper::setInverseDynamicMethod>{"inverseDynamicMethod"},
+      Property<SkeletonHelper, unsigned, &SkeletonHelper::threads, &SkeletonHelper::setThreads>{"threads"}
     )
     
   public:
@@ -70,6 +72,8 @@ namespace body
     
     int Region;
     int Side;
+    int InverseDynamicMethod;
+    unsigned Threads;
     std::array<double,3> Gravity;
   };
 };
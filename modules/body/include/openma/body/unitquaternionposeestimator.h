@@ -41,8 +41,11 @@ namespace ma
 {
 namespace body
 {
+  class UnitQuaternionPoseEstimatorPrivate;
+  
   class OPENMA_BODY_EXPORT UnitQuaternionPoseEstimator : public PoseEstimator
   {
+    OPENMA_DECLARE_PIMPL_ACCESSOR(UnitQuaternionPoseEstimator)
     OPENMA_DECLARE_NODEID(UnitQuaternionPoseEstimator, PoseEstimator)
     
   public:
@@ -0,0 +1,87 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT  HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_body_unitquaternionposeestimator_p_h
+#define __openma_body_unitquaternionposeestimator_p_h
+
+/*
+ * WARNING: This file and its content are not included in the public API and 
+ * can change drastically from one release to another.
+ */
+
+#include "openma/body/poseestimator_p.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
+namespace ma
+{
+  class TimeSequence;
+  
+namespace body
+{
+  class UnitQuaternionPoseEstimator;
+  class Point;
+  class ReferenceFrame;
+  
+  class UnitQuaternionPoseEstimatorPrivate : public PoseEstimatorPrivate
+  {
+    OPENMA_DECLARE_PINT_ACCESSOR(UnitQuaternionPoseEstimator)
+    
+  public:
+    UnitQuaternionPoseEstimatorPrivate(UnitQuaternionPoseEstimator* pint, const std::string& name);
+    ~UnitQuaternionPoseEstimatorPrivate();
+    
+    // Local markers (and relative SCS) of one segment, found in the node "MarkerClusterRegistration".
+    // The binding is reused while the registration node is not modified and the landmarks have the same names.
+    struct ClusterBinding
+    {
+      const Node* Registration = nullptr;
+      unsigned long RegistrationTimestamp = 0ul;
+      std::vector<std::string> Landmarks;
+      std::vector<Point*> Points;
+      ReferenceFrame* Frame = nullptr;
+    };
+    
+    const ClusterBinding& bindCluster(const std::string& segment, const Node* mcr, const std::vector<TimeSequence*>& landmarks);
+    
+    std::unordered_map<std::string,ClusterBinding> ClusterBindings;
+    std::mutex BindingMutex;
+  };
+};
+};
+
+#endif // __openma_body_unitquaternionposeestimator_p_h
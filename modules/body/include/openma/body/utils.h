@@ -58,8 +58,10 @@ namespace body
   class Segment;
   class SkeletonHelper;
   
-  OPENMA_BODY_EXPORT std::unordered_map<std::string,math::Map<math::Vector>> extract_landmark_positions(SkeletonHelper* helper, Trial* trial, double* rate = nullptr, double* start = nullptr, bool* ok = nullptr) _OPENMA_NOEXCEPT;
-  OPENMA_BODY_EXPORT std::unordered_map<std::string,math::Map<math::Vector>> extract_landmark_positions(LandmarksTranslator* lt, const std::vector<TimeSequence*>& tss, double* rate = nullptr, double* start = nullptr, bool* ok = nullptr) _OPENMA_NOEXCEPT;
+  OPENMA_BODY_EXPORT std::unordered_map<std::string,math::Map<const math::Vector>> extract_landmark_positions(SkeletonHelper* helper, Trial* trial, double* rate = nullptr, double* start = nullptr, bool* ok = nullptr) _OPENMA_NOEXCEPT;
+  OPENMA_BODY_EXPORT std::unordered_map<std::string,math::Map<const math::Vector>> extract_landmark_positions(LandmarksTranslator* lt, const std::vector<TimeSequence*>& tss, double* rate = nullptr, double* start = nullptr, bool* ok = nullptr) _OPENMA_NOEXCEPT;
+  
+  OPENMA_BODY_EXPORT bool find_common_sampling(const std::vector<TimeSequence*>& tss, double* rate = nullptr, double* start = nullptr) _OPENMA_NOEXCEPT;
   
   OPENMA_BODY_EXPORT TimeSequence* average_marker(const TimeSequence* marker, Node* parent = nullptr);
   
@@ -38,8 +38,11 @@
 #include "openma/base/subject.h"
 #include "openma/base/logger.h"
 
+#include "openma/body/joint_p.h"
+
 #include "openma/base/logger.h"
 #include "openma/base/node.h"
+#include "openma/base/nodefactory.h"
 #include "openma/base/subject.h"
 #include "openma/base/trial.h"
 
@@ -140,7 +143,7 @@ namespace body
         error("Less than 3 valid markers was found for the segment '%s'. Impossible to compute the TCS. Registration aborted.", segment->name().c_str());
         return false;
       }
-      auto segpose = segment->pose();
+      const TimeSequence* segpose = segment->pose();
       const auto& scs = math::to_pose(segpose);
       if (!scs.isValid())
       {
@@ -200,26 +203,27 @@ namespace body
   /**
    * Convenient function to create Model nodes and reconstrust their movement based on the @a helper and the @a trials.
    * For each trial, a model is created and added to the @a output.
+   * The trials can be reconstructed concurrently by setting the number of @a threads to use (0 means all the hardware threads). See SkeletonHelper::reconstruct() for details.
    * @note The @a helper might need to be calibrated before the use of the reconstruct() function.
    */
-  bool reconstruct(Node* root, SkeletonHelper* helper, Node* trials)
+  bool reconstruct(Node* root, SkeletonHelper* helper, Node* trials, unsigned threads)
   {
     if (helper == nullptr)
     {
       error("A null pointer to a SkeletonHelper object was passed. Reconstruction aborted.");
       return false;
     }
-    return helper->reconstruct(root, trials);
+    return helper->reconstruct(root, trials, threads);
   };
   
   /**
    * Similar to the other reconstruct method but the models are added to the returned node.
    * @warning The returned node is allocated on the heap. The developer must care of the deletion of the object using the @c delete keyword.
    */
-  Node* reconstruct(SkeletonHelper* helper, Node* trials)
+  Node* reconstruct(SkeletonHelper* helper, Node* trials, unsigned threads)
   {
     Node* root = new Node("root");
-    if (!reconstruct(root, helper, trials))
+    if (!reconstruct(root, helper, trials, threads))
     {
       delete root;
       root = nullptr;
@@ -237,8 +241,9 @@ namespace body
    *  - adaptForInterpretation is set to the value passed in @a sideAdaptation
    * The use of these options means that computed Euler angles are expressed in degrees. The TimeSequence associated with each Segment will use both the corresponding segments' name concatenated with the suffix ".SCS". They are adapted or not depending of the value in @a sideAdaptation.
    * The adaptation of the angles depends of the setting of each descriptor. You should refer to the model's definition (or helper) to know the descriptor used. For example with the PluginGait helper, the adaptation is used to be able to compare directly the left/right sides.
+   * The descriptors of each model are evaluated as a batch (see Descriptor::evaluate()) where the computation is dispatched over the given number of @a threads (0 meaning all the hardware threads). The outputs are added to the model's node in the order of the joints.
    */
-  bool extract_joint_kinematics(Node* output, Node* input, bool sideAdaptation)
+  bool extract_joint_kinematics(Node* output, Node* input, bool sideAdaptation, unsigned threads)
   {
     if (output == nullptr)
     {
@@ -255,15 +260,18 @@ namespace body
     for (auto& model: models)
     {
       auto analysis = new Node(model->name() + "_JointKinematics", output);
+      std::vector<Descriptor*> descriptors;
+      std::vector<const Node*> inputs;
       auto joints = model->joints()->findChildren<Joint*>({},{},false);
       for (auto& joint: joints)
       {
-        auto descriptors = joint->findChildren<EulerDescriptor*>({},{},false);
-        for (auto& descriptor: descriptors)
+        for (auto& descriptor: joint->findChildren<EulerDescriptor*>({},{},false))
         {
-          descriptor->evaluate(analysis, joint, options);
+          descriptors.push_back(descriptor);
+          inputs.push_back(joint);
         }
       }
+      Descriptor::evaluate(analysis, descriptors, inputs, options, threads);
     }
     return true;
   };
@@ -272,10 +280,10 @@ namespace body
    * Similar to the other extract_joint_kinematics() method but the computed joint kinematics are added to a returned node.
    * @warning The returned node is allocated on the heap. The developer must care of the deletion of the object using the @c delete keyword.
    */
-  Node* extract_joint_kinematics(Node* input, bool sideAdaptation)
+  Node* extract_joint_kinematics(Node* input, bool sideAdaptation, unsigned threads)
   {
     Node* root = new Node("root");
-    if (!extract_joint_kinematics(root, input, sideAdaptation))
+    if (!extract_joint_kinematics(root, input, sideAdaptation, threads))
     {
       delete root;
       root = nullptr;
@@ -292,8 +300,9 @@ namespace body
    *  - representationFrame is set to the value passed in @a frame
    *  - representationFrameSuffix is set to ".SCS"
    * The default values passed to these options means that computed joint forces and moment are expressed int the reference frame associated with the distal segment and normalized by subject's mass. They are also adapted to interpret values for the left and right side.
+   * As for extract_joint_kinematics(), the descriptors of each model are evaluated as a batch dispatched over the given number of @a threads.
    */
-  bool extract_joint_kinetics(Node* output, Node* input, bool sideAdaptation, bool massNormalization, RepresentationFrame frame)
+  bool extract_joint_kinetics(Node* output, Node* input, bool sideAdaptation, bool massNormalization, RepresentationFrame frame, unsigned threads)
   {
     if (output == nullptr)
     {
@@ -301,13 +310,14 @@ namespace body
       return false;
     }
     auto models = input->findChildren<Model*>({},{},false);
-    std::unordered_map<std::string, Any> options{
+    const std::unordered_map<std::string, Any> commonOptions{
       {"representationFrame", frame},
       {"representationFrameSuffix", ".SCS"},
       {"adaptForInterpretation", sideAdaptation}
     };
     for (auto& model: models)
     {
+      auto options = commonOptions;
       auto analysis = new Node(model->name() + "_JointKinetics", output);
       if ( std::fabs(model->gravity()[0]) <= std::numeric_limits<double>::epsilon()
         && std::fabs(model->gravity()[1]) <= std::numeric_limits<double>::epsilon()
@@ -322,15 +332,18 @@ namespace body
         else
           warning("The model '%s' has no property 'mass' or is set to a non positive value or a not a number (NaN). It is not possible to normalize the data.", model->name().c_str());
       }
+      std::vector<Descriptor*> descriptors;
+      std::vector<const Node*> inputs;
       auto joints = model->joints()->findChildren<Joint*>({},{},false);
       for (auto& joint: joints)
       {
-        auto descriptors = joint->findChildren<DynamicDescriptor*>({},{},false);
-        for (auto& descriptor: descriptors)
+        for (auto& descriptor: joint->findChildren<DynamicDescriptor*>({},{},false))
         {
-          descriptor->evaluate(analysis, joint, options);
+          descriptors.push_back(descriptor);
+          inputs.push_back(joint);
         }
       }
+      Descriptor::evaluate(analysis, descriptors, inputs, options, threads);
     }
     return true;
   };
@@ -339,15 +352,32 @@ namespace body
    * Similar to the other extract_joint_kinetics() method but the computed joint kinetics are added to a returned node.
    * @important The returned node is allocated on the heap. The developer must care of the deletion of the object using the @c delete keyword.
    */
-  Node* extract_joint_kinetics(Node* input, bool sideAdaptation, bool massNormalization, RepresentationFrame frame)
+  Node* extract_joint_kinetics(Node* input, bool sideAdaptation, bool massNormalization, RepresentationFrame frame, unsigned threads)
   {
     Node* root = new Node("root");
-    if (!extract_joint_kinetics(root, input, sideAdaptation, massNormalization, frame))
+    if (!extract_joint_kinetics(root, input, sideAdaptation, massNormalization, frame, threads))
     {
       delete root;
       root = nullptr;
     }
     return root;
   };
+  
+  /**
+   * Register the nodes of this module which can be rebuilt from their name, properties and children (see register_node_type()).
+   * This concerns the classes Model, Segment, Joint and Anchor. Thus, a tree of models can be stored in a file (e.g. OMA format) and read back with its original types.
+   * Anchors are rebuilt as the origin of the segment attached to the same side of their joint. The classes Point, ReferenceFrame, InertialParameters and Chain are not registered as their content is not available as properties.
+   * Return false if one of the types is already registered.
+   * @ingroup openma_body
+   */
+  bool register_node_types()
+  {
+    bool registered = true;
+    registered &= register_node_type("Model", static_typeid<Model>(), [](const std::string& name, Node* parent) -> Node* {return new Model(name, parent);});
+    registered &= register_node_type("Segment", static_typeid<Segment>(), [](const std::string& name, Node* parent) -> Node* {return new Segment(name, 0, 0, parent);});
+    registered &= register_node_type("Joint", static_typeid<Joint>(), [](const std::string& name, Node* parent) -> Node* {return new Joint(name, nullptr, nullptr, nullptr, nullptr, parent);}, &JointPrivate::restore);
+    registered &= register_node_type("Anchor", static_typeid<Anchor>(), [](const std::string& name, Node* parent) -> Node* {auto anchor = Anchor::origin(static_cast<Segment*>(nullptr)); anchor->setName(name); anchor->addParent(parent); return anchor;});
+    return registered;
+  };
+};
 };
-};
\ No newline at end of file
@@ -103,7 +103,7 @@ namespace body
       error("No relative point '%s' found within the segment '%s'. Impossible to compute anchor's position", this->Relative.c_str(), this->Source->name().c_str());
       return nullptr;
     }
-    auto ts = this->Source->pose();
+    const TimeSequence* ts = this->Source->pose();
     if (ts == nullptr)
     {
       error("No time sequence attached to the source '%s'.", this->Source->name().c_str());
@@ -144,7 +144,7 @@ namespace body
   TimeSequence* AnchorOriginPrivate::computePosition()
   {
     // TODO Implement the cache mechanism
-    auto ts = this->Source->pose();
+    const TimeSequence* ts = this->Source->pose();
     math::Position pos;
     if (!this->Relative.empty())
     {
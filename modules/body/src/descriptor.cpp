@@ -34,6 +34,9 @@
 
 #include "openma/body/descriptor.h"
 #include "openma/body/descriptor_p.h"
+#include "openma/base/logger.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -102,7 +105,39 @@ namespace body
    */
   bool Descriptor::evaluate(Node* output, const Node* input, const std::unordered_map<std::string, Any>& options)
   {
-    return (!this->prepare(input, options) || !this->process(options) || !this->finalize(output, options));
+    OPENMA_PROFILE_SCOPE("Descriptor::evaluate");
+    return (this->prepare(input, options) && this->process(options) && this->finalize(output, options));
+  };
+  
+  /**
+   * Evaluate a batch of @a descriptors, each one describing the input at the same index in @a inputs, and export the results into the @a output.
+   * The evaluation is split in three stages:
+   *  1. prepare() is called serially for each descriptor as it can look up (and possibly create) nodes in the hierarchy of the inputs.
+   *  2. process() is dispatched over @a threads threads (0 meaning all the hardware threads). Each descriptor works only on its own internal buffers.
+   *  3. finalize() is called serially, in the order of the descriptors, to merge the results into the @a output.
+   * The same @a options are passed to each descriptor.
+   * A descriptor failing at one stage is not exported but does not prevent the others to be evaluated. In that case, the method returns false.
+   */
+  bool Descriptor::evaluate(Node* output, const std::vector<Descriptor*>& descriptors, const std::vector<const Node*>& inputs, const std::unordered_map<std::string, Any>& options, unsigned threads)
+  {
+    OPENMA_PROFILE_SCOPE("Descriptor::evaluate");
+    OPENMA_PROFILE_COUNT("descriptors",descriptors.size());
+    if (descriptors.size() != inputs.size())
+    {
+      error("The number of descriptors and inputs is not the same. Evaluation aborted.");
+      return false;
+    }
+    std::vector<char> valid(descriptors.size(), 0);
+    for (size_t i = 0 ; i < descriptors.size() ; ++i)
+      valid[i] = (descriptors[i] != nullptr) && descriptors[i]->prepare(inputs[i], options);
+    parallel_for(descriptors.size(), [&](size_t i) {
+      if (valid[i])
+        valid[i] = descriptors[i]->process(options);
+    }, threads);
+    bool success = true;
+    for (size_t i = 0 ; i < descriptors.size() ; ++i)
+      success &= valid[i] && descriptors[i]->finalize(output, options);
+    return success;
   };
   
   /**
@@ -125,6 +160,7 @@ namespace body
   /**
    * @fn virtual bool Descriptor::process(const std::unordered_map<std::string, Any>& options) = 0;
    * Transform the stored input into the requested description of the input used by prepare().
+   * @note This method can be called concurrently for different descriptors (see the static evaluate() method). It must only modify the internal buffers of the descriptor and only read the nodes retrieved by prepare().
    */
   
   /**
@@ -58,10 +58,21 @@ namespace body
     DynamicDescriptorPrivate(DynamicDescriptor* pint, const std::string& name, const std::array<unsigned,9>& order, const std::array<double,9>& scale);
     ~DynamicDescriptorPrivate();
     
+    struct Options
+    {
+      RepresentationFrame Frame;
+      std::string FrameSuffix;
+      bool AdaptForInterpretation;
+      double MassNormalization;
+    };
+    
+    static Options parseOptions(const std::unordered_map<std::string, Any>& options);
+    
     TimeSequence* extractSegmentAngularVelocity(Segment* seg, const std::string& referenceSuffix) const;
     
     std::array<unsigned,9> Order;
     std::array<double,9> Scale;
+    Options Settings;
     const TimeSequence* RepresentationFrameTimeSequence;
     std::string OutputSuffix;
     const TimeSequence* ForceTimeSequence;
@@ -78,7 +89,7 @@ namespace body
   
   DynamicDescriptorPrivate::DynamicDescriptorPrivate(DynamicDescriptor* pint, const std::string& name, const std::array<unsigned,9>& order, const std::array<double,9>& scale)
   : DescriptorPrivate(pint,name),
-    Order(order), Scale(scale),
+    Order(order), Scale(scale), Settings(parseOptions({})),
     RepresentationFrameTimeSequence(nullptr),
     OutputSuffix(),
     ForceTimeSequence(nullptr), OutputForceData(), OutputForceUnit("N"),
@@ -88,6 +99,21 @@ namespace body
   
   DynamicDescriptorPrivate::~DynamicDescriptorPrivate() = default;
   
+  auto DynamicDescriptorPrivate::parseOptions(const std::unordered_map<std::string, Any>& options) -> Options
+  {
+    Options settings{RepresentationFrame::Global,{},false,0.};
+    auto it = options.cend();
+    if ((it = options.find("representationFrame")) != options.cend())
+      settings.Frame = it->second.cast<RepresentationFrame>();
+    if ((it = options.find("representationFrameSuffix")) != options.cend())
+      settings.FrameSuffix = it->second.cast<std::string>();
+    if ((it = options.find("adaptForInterpretation")) != options.cend())
+      settings.AdaptForInterpretation = it->second.cast<bool>();
+    if ((it = options.find("massNormalization")) != options.cend())
+      settings.MassNormalization = it->second.cast<double>();
+    return settings;
+  };
+  
   TimeSequence* DynamicDescriptorPrivate::extractSegmentAngularVelocity(Segment* seg, const std::string& referenceSuffix) const
   {
     auto w = seg->findChild<TimeSequence*>(seg->name()+referenceSuffix+".Omega", { {"type", TimeSequence::Angle | TimeSequence::Velocity | TimeSequence::Reconstructed}, {"components", 4} });
@@ -194,22 +220,19 @@ namespace body
   bool DynamicDescriptor::prepare(const Node* input, const std::unordered_map<std::string, Any>& options)
   {
     auto optr = this->pimpl();
+    optr->Settings = DynamicDescriptorPrivate::parseOptions(options);
+    optr->RepresentationFrameTimeSequence = nullptr;
+    optr->ProximalAngularVelocityTimeSequence = nullptr;
+    optr->DistalAngularVelocityTimeSequence = nullptr;
+    optr->OutputForceUnit = "N";
+    optr->OutputMomentUnit = "Nmm";
+    optr->OutputPowerUnit = "W";
     const Joint* joint = nullptr;
     if ((joint = node_cast<const Joint*>(input)) != nullptr)
     {
-      RepresentationFrame reference = RepresentationFrame::Global;
-      std::string referenceSuffix;
-      auto it = options.cend();
-      if ((it = options.find("representationFrame")) != options.cend())
-      {
-        reference = it->second.cast<RepresentationFrame>();
-      }
-      if ((it = options.find("representationFrameSuffix")) != options.cend())
-      {
-        referenceSuffix = it->second.cast<std::string>();
-      }
+      const auto& referenceSuffix = optr->Settings.FrameSuffix;
       Segment* seg = nullptr;
-      switch (reference)
+      switch (optr->Settings.Frame)
       {
       case RepresentationFrame::Global:
         optr->OutputSuffix = ".Global";
@@ -252,16 +275,16 @@ namespace body
         optr->ProximalAngularVelocityTimeSequence = optr->extractSegmentAngularVelocity(joint->proximalSegment(), referenceSuffix);
         optr->DistalAngularVelocityTimeSequence = optr->extractSegmentAngularVelocity(joint->distalSegment(), referenceSuffix);
         if ((optr->ProximalAngularVelocityTimeSequence == nullptr) || (optr->DistalAngularVelocityTimeSequence == nullptr))
-          warning("Null proximal/distal angular velocity found for the joint '%s'. Impossible to compute the associated power.");
+          warning("Null proximal/distal angular velocity found for the joint '%s'. Impossible to compute the associated power.", joint->name().c_str());
       }
       else
-        warning("Null proximal/distal segment found for the joint '%s'. Impossible to compute the associated power.");
+        warning("Null proximal/distal segment found for the joint '%s'. Impossible to compute the associated power.", joint->name().c_str());
       if ((optr->ForceTimeSequence == nullptr) || (optr->MomentTimeSequence == nullptr))
       {
         error("Force or moment data was not found. Impossible to describe the dynamic of the joint %s", joint->name().c_str());
         return false;
       }
-      if (((it = options.find("adaptForInterpretation")) != options.cend()) && (it->second.cast<bool>()))
+      if (optr->Settings.AdaptForInterpretation)
       {
         for (size_t i = 0 ; i < 9 ; ++i)
         {
@@ -283,38 +306,35 @@ namespace body
   
   /**
    * Transform orientations into Dynamic angles. By default, the unit used is the radian and no adaptation scale is used.
-   * To modify this behaviour, you can use the options:
+   * To modify this behaviour, you can use the options (parsed by prepare()):
    *  - massNormalization: double value > 0
    *  - adaptForInterpretation: boolean value
    */
   bool DynamicDescriptor::process(const std::unordered_map<std::string, Any>& options)
   {
+    OPENMA_UNUSED(options);
     auto optr = this->pimpl();
     
     std::array<double,9> scale{{1.,1.,1.,1.,1.,1.,1.,1.,1.}}; // unit conversion 
-    auto it = options.cend();
     // Option massNormalization activated?
-    if ((it = options.find("massNormalization")) != options.cend())
+    const double massNormalization = optr->Settings.MassNormalization;
+    if ( massNormalization > 0.)
     {
-      double massNormalization = it->second.cast<double>();
-      if ( massNormalization > 0.)
-      {
-        scale[0] /= massNormalization;
-        scale[1] /= massNormalization;
-        scale[2] /= massNormalization;
-        scale[3] /= massNormalization;
-        scale[4] /= massNormalization;
-        scale[5] /= massNormalization;
-        scale[6] /= massNormalization;
-        scale[7] /= massNormalization;
-        scale[8] /= massNormalization;
-        optr->OutputForceUnit += "/kg";
-        optr->OutputMomentUnit += "/kg";
-        optr->OutputPowerUnit += "/kg";
-      }
+      scale[0] /= massNormalization;
+      scale[1] /= massNormalization;
+      scale[2] /= massNormalization;
+      scale[3] /= massNormalization;
+      scale[4] /= massNormalization;
+      scale[5] /= massNormalization;
+      scale[6] /= massNormalization;
+      scale[7] /= massNormalization;
+      scale[8] /= massNormalization;
+      optr->OutputForceUnit += "/kg";
+      optr->OutputMomentUnit += "/kg";
+      optr->OutputPowerUnit += "/kg";
     }
     // Option adaptForInterpretation activated?
-    if (((it = options.find("adaptForInterpretation")) != options.cend()) && (it->second.cast<bool>()))
+    if (optr->Settings.AdaptForInterpretation)
     {
       scale[0] *= optr->Scale[0];
       scale[1] *= optr->Scale[1];
@@ -51,10 +51,27 @@ namespace ma
 namespace body
 {
   EulerDescriptorPrivate::EulerDescriptorPrivate(EulerDescriptor* pint, const std::string& name, const std::array<int,3>& sequence, const std::array<double,3>& scale, const std::array<double,3>& offset)
-  : DescriptorPrivate(pint,name), Sequence(sequence), Scale(scale), Offset(offset), BufferData(), OutputData(), OutputSampleRate(0.0), OutputStartTime(0.0), OutputUnit()
+  : DescriptorPrivate(pint,name), Sequence(sequence), Scale(scale), Offset(offset), Settings(parseOptions({})), ProximalTimeSequence(nullptr), DistalTimeSequence(nullptr), BufferData(), OutputData(), OutputSampleRate(0.0), OutputStartTime(0.0), OutputUnit()
   {};
   
   EulerDescriptorPrivate::~EulerDescriptorPrivate() = default;
+  
+  auto EulerDescriptorPrivate::parseOptions(const std::unordered_map<std::string, Any>& options) -> Options
+  {
+    Options settings{{},{},{},false,false};
+    auto it = options.cend();
+    if ((it = options.find("suffix")) != options.cend())
+      settings.Suffix = it->second.cast<std::string>();
+    if ((it = options.find("suffixProximal")) != options.cend())
+      settings.SuffixProximal = it->second.cast<std::string>();
+    if ((it = options.find("suffixDistal")) != options.cend())
+      settings.SuffixDistal = it->second.cast<std::string>();
+    if ((it = options.find("enableDegreeConversion")) != options.cend())
+      settings.EnableDegreeConversion = it->second.cast<bool>();
+    if ((it = options.find("adaptForInterpretation")) != options.cend())
+      settings.AdaptForInterpretation = it->second.cast<bool>();
+    return settings;
+  };
 };
 };
 
@@ -241,10 +258,11 @@ namespace body
    *  - In case of a Joint
    *    - Get proximal and distal Segment
    *    - For each segment, look for a TimeSequence (type Pose) child node (see below for the rules to choose TimeSequence nodes)
-   *    - Compute the transformation pose that express the pose of the distal segment into the proximal segment. If this is a global joint (i.e. proximal segment is null), the content of the distal TimeSequence is directly copied.
+   *    - Store the TimeSequence nodes. The pose of the distal segment expressed into the proximal segment is computed by process(). If this is a global joint (i.e. proximal segment is null), only the distal TimeSequence is stored.
    *  - In case of a Segment
    *    - Look for a TimeSequence child node (type Pose) 
-   *    - Copy its content
+   *    - Store it
+   * The options are parsed once by this method and reused by process().
    *
    * @par Rules to choose associated time sequence
    * - Extracted TimeSequence is found in the children of a Segment. The Segment can be directly the input or a child of the input (i.e. in case the input is a Joint)
@@ -282,10 +300,15 @@ namespace body
    *  - suffix: string (for Segment input only)
    *  - suffixProximal: string (for Joint input only)
    *  - suffixDistal: string (for Joint input only)
+   *  - enableDegreeConversion: boolean value (used by process())
+   *  - adaptForInterpretation: boolean value (used by process())
    */
   bool EulerDescriptor::prepare(const Node* input, const std::unordered_map<std::string, Any>& options)
   {
     auto optr = this->pimpl();
+    optr->Settings = EulerDescriptorPrivate::parseOptions(options);
+    optr->ProximalTimeSequence = nullptr;
+    optr->DistalTimeSequence = nullptr;
     if ((optr->Sequence[0] == optr->Sequence[1]) || (optr->Sequence[1] == optr->Sequence[2]))
     {
       error("The requested sequence does not exist. Impossible to describe the movement of the input %s", input->name().c_str());
@@ -295,16 +318,8 @@ namespace body
     const Segment* segment = nullptr;
     if ((joint = node_cast<const Joint*>(input)) != nullptr)
     {
-      std::string suffixProximal, suffixDistal;
-      auto it = options.cend();
-      if ((it = options.find("suffixProximal")) != options.cend())
-      {
-        suffixProximal = it->second.cast<std::string>();
-      }
-      if ((it = options.find("suffixDistal")) != options.cend())
-      {
-        suffixDistal = it->second.cast<std::string>();
-      }
+      const auto& suffixProximal = optr->Settings.SuffixProximal;
+      const auto& suffixDistal = optr->Settings.SuffixDistal;
       Segment *proximal = joint->proximalSegment(), *distal = joint->distalSegment();
       if ((proximal != nullptr) && (distal != nullptr))
       {
@@ -332,9 +347,8 @@ namespace body
           error("The start time of used time sequences is not the same. Impossible to describe the movement of the joint %s", joint->name().c_str());
           return false;
         }
-        auto proximalPose = math::to_pose(proximalTimeSequence);
-        auto distalPose = math::to_pose(distalTimeSequence);
-        optr->BufferData = proximalPose.inverse().transform(distalPose);
+        optr->ProximalTimeSequence = proximalTimeSequence;
+        optr->DistalTimeSequence = distalTimeSequence;
       }
       else if ((proximal == nullptr) && (distal != nullptr))
       {
@@ -346,7 +360,7 @@ namespace body
         }
         optr->OutputSampleRate = distalTimeSequence->sampleRate();
         optr->OutputStartTime = distalTimeSequence->startTime();
-        optr->BufferData = math::to_pose(distalTimeSequence);
+        optr->DistalTimeSequence = distalTimeSequence;
       }
       else if ((proximal != nullptr) && (distal == nullptr))
       {
@@ -361,13 +375,7 @@ namespace body
     }
     else if ((segment = node_cast<const Segment*>(input)) != nullptr)
     {
-      std::string suffix;
-      auto it = options.cend();
-      if ((it = options.find("suffix")) != options.cend())
-      {
-        suffix = it->second.cast<std::string>();
-      }
-      auto ts = segment->findChild<const TimeSequence*>(segment->name() + suffix);
+      auto ts = segment->findChild<const TimeSequence*>(segment->name() + optr->Settings.Suffix);
       if (ts == nullptr)
       {
         error("Impossible to find the time sequence associated with the segment. Impossible to describe the movement of the segment %s", segment->name().c_str());
@@ -375,7 +383,7 @@ namespace body
       }
       optr->OutputSampleRate = ts->sampleRate();
       optr->OutputStartTime = ts->startTime();
-      optr->BufferData = math::to_pose(ts);
+      optr->DistalTimeSequence = ts;
     }
     else
     {
@@ -387,19 +395,26 @@ namespace body
   
   /**
    * Transform orientations into Euler angles. By default, the unit used is the radian and no adaptation scale is used.
-   * To modify this behaviour, you can use the options:
+   * To modify this behaviour, you can use the options (parsed by prepare()):
    *  - enableDegreeConversion: boolean value
    *  - adaptForInterpretation: boolean value
    */
   bool EulerDescriptor::process(const std::unordered_map<std::string, Any>& options)
   {
+    OPENMA_UNUSED(options);
     auto optr = this->pimpl();
+    if (optr->DistalTimeSequence == nullptr)
+      return false;
+    // Pose to describe
+    if (optr->ProximalTimeSequence != nullptr)
+      optr->BufferData = math::to_pose(optr->ProximalTimeSequence).inverse().transform(math::to_pose(optr->DistalTimeSequence));
+    else
+      optr->BufferData = math::to_pose(optr->DistalTimeSequence);
     
     std::array<double,3> scale{{1.0,1.0,1.0}}; // unit conversion 
     auto offset = optr->Offset;
-    auto it = options.cend();
     // Option enableDegreeConversion activated?
-    if (((it = options.find("enableDegreeConversion")) != options.cend()) && (it->second.cast<bool>()))
+    if (optr->Settings.EnableDegreeConversion)
     {
       _OPENMA_CONSTEXPR double rad2deg = 180.0 / M_PI;
       scale[0] *= rad2deg;
@@ -415,20 +430,14 @@ namespace body
       optr->OutputUnit = "rad";
     }
     // Option adaptForInterpretation activated?
-    if (((it = options.find("adaptForInterpretation")) != options.cend()) && (it->second.cast<bool>()))
+    if (optr->Settings.AdaptForInterpretation)
     {
       scale[0] *= optr->Scale[0];
       scale[1] *= optr->Scale[1];
       scale[2] *= optr->Scale[2];
     }
-    // Let's compute the output
-    optr->OutputData = optr->BufferData.eulerAngles(optr->Sequence[0], optr->Sequence[1], optr->Sequence[2]);
-    optr->OutputData.values().col(0) *= scale[0];
-    optr->OutputData.values().col(0) += offset[0];
-    optr->OutputData.values().col(1) *= scale[1];
-    optr->OutputData.values().col(1) += offset[1];
-    optr->OutputData.values().col(2) *= scale[2];
-    optr->OutputData.values().col(2) += offset[2];
+    // Let's compute the output (scale and offset are applied in the same pass)
+    optr->OutputData = optr->BufferData.eulerAngles(optr->Sequence[0], optr->Sequence[1], optr->Sequence[2], scale, offset);
     return true;
   };
   
@@ -45,6 +45,9 @@
 #include "openma/base/trial.h"
 #include "openma/instrument/forceplate.h"
 #include "openma/math.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
+#include "openma/base/property.h"
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -59,17 +62,60 @@ namespace body
   class InverseDynamicMatrixPrivate : public InverseDynamicProcessorPrivate
   {
     OPENMA_DECLARE_PINT_ACCESSOR(InverseDynamicMatrix)
+    
+    OPENMA_DECLARE_STATIC_PROPERTIES_DERIVED(InverseDynamicMatrix, InverseDynamicProcessor,
+      Property<InverseDynamicMatrix,unsigned,&InverseDynamicMatrix::threads,&InverseDynamicMatrix::setThreads>{"threads"}
+    )
       
   public:
     InverseDynamicMatrixPrivate(InverseDynamicMatrix* pint);
     ~InverseDynamicMatrixPrivate();
+    
+    unsigned Threads;
   };
   
   InverseDynamicMatrixPrivate::InverseDynamicMatrixPrivate(InverseDynamicMatrix* pint)
-  : InverseDynamicProcessorPrivate(pint,"InverseDynamicMatrix")
+  : InverseDynamicProcessorPrivate(pint,"InverseDynamicMatrix"),
+    Threads(1u)
   {};
   
   InverseDynamicMatrixPrivate::~InverseDynamicMatrixPrivate() = default;
+  
+  // Number of frames processed by each task during the recursion along a chain
+  static _OPENMA_CONSTEXPR unsigned _ma_idm_block_frames = 256u;
+  
+  struct _ma_idm_joint
+  {
+    // Gathered sequentially (the computation of an anchor's position modifies the tree)
+    Joint* Jnt;
+    Segment* Seg;
+    InertialParameters* Bsip;
+    const TimeSequence* Pose;
+    std::vector<const TimeSequence*> Externals;
+    math::Position Pp;
+    // Computed independently for each joint
+    math::Vector Omega, Fext, Mext, Fwei, Mwei, Fdyn, Mdyn;
+    // Computed by frame blocks along the chain
+    math::Vector Fp, Mp;
+  };
+  
+  struct _ma_idm_chain
+  {
+    Model* Mdl;
+    Chain* Chn;
+    double Rate;
+    double Start;
+    unsigned Samples;
+    std::vector<_ma_idm_joint> Joints; // Ordered from the distal to the proximal joint
+  };
+  
+  static inline math::Vector _ma_idm_rows(const math::Vector& x, unsigned row, unsigned num)
+  {
+    math::Vector out(num);
+    out.values() = x.values().middleRows(row,num);
+    out.residuals() = x.residuals().middleRows(row,num);
+    return out;
+  };
 };
 };
 
@@ -91,6 +137,9 @@ namespace body
    * 
    * @TODO Explain in details the required element to use this algorithm (model configure, external wrench, etc.).
    *
+   * The computation can be distributed over several threads (see setThreads()). In this case, the joints of all the chains (and models) are processed concurrently, 
+   * as well as blocks of frames during the recursion along each chain. The results are identical to the sequential computation.
+   *
    * @ingroup openma_body
    */
   
@@ -106,6 +155,29 @@ namespace body
    */
   InverseDynamicMatrix::~InverseDynamicMatrix() _OPENMA_NOEXCEPT = default;
   
+  /**
+   * Returns the number of threads used to compute the joint kinetics. A value of 0 means that all the hardware threads are used.
+   * By default, the computation is sequential (i.e. 1 thread).
+   */
+  unsigned InverseDynamicMatrix::threads() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Threads;
+  };
+  
+  /**
+   * Sets the number of threads used to compute the joint kinetics.
+   * @sa threads()
+   */
+  void InverseDynamicMatrix::setThreads(unsigned value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (optr->Threads == value)
+      return;
+    optr->Threads = value;
+    this->modified();
+  };
+  
   /**
    * Internally this method is a combination of two algorithms published in the litterature [1,2].
    * Both of these algorithms are known to be less sensitive to noise [3]. The reason to use this is only to reduce computation time.
@@ -121,10 +193,13 @@ namespace body
    */
   bool InverseDynamicMatrix::run(Node* inout)
   {
+    OPENMA_PROFILE_SCOPE("InverseDynamicMatrix::run");
 #if !defined(_MSC_VER)
 #warning WE NEED TO MANAGE UNITS FOR FORCES AND MOMENTS
 #endif
     
+    // 1. Sequential gathering of the inputs (the tree is modified by the anchors)
+    std::vector<_ma_idm_chain> tasks;
     auto models = inout->findChildren<Model*>({},{},false);
     for (auto& model : models)
     {
@@ -142,108 +217,167 @@ namespace body
         unsigned inc = 0;
         for (const auto& joint : joints)
           tss[inc++] = joint->distalSegment()->pose();
-        double rate = 0.0, start = 0.0;
-        unsigned samples = 0;
-        if (!compare_timesequences_properties(tss, rate, start, samples))
+        _ma_idm_chain task;
+        task.Mdl = model;
+        task.Chn = chain;
+        task.Rate = 0.0; task.Start = 0.0; task.Samples = 0;
+        if (!compare_timesequences_properties(tss, task.Rate, task.Start, task.Samples))
         {
           error("At least one segment's pose does not have the same sample rate, start time or number of samples in the chain '%s'.", chain->name().c_str());
           continue;
         }
-        assert(rate > 0.);
-        double dt = 1. / rate;
-        double gres = 0.;
-        math::Vector Fd, Md, pd;
-        math::Vector g = math::Map<const math::Vector>(1, model->gravity(), &gres).replicate(samples);
-        // Iteration computation of joint kinetics
+        assert(task.Rate > 0.);
         for (auto itJ = joints.rbegin() ; itJ != joints.rend() ; ++itJ)
         {
-          auto jnt = *itJ;
-          auto seg = jnt->distalSegment();
-          auto bsip = seg->findChild<InertialParameters*>();
-          if (bsip == nullptr)
+          _ma_idm_joint jnt;
+          jnt.Jnt = *itJ;
+          jnt.Seg = jnt.Jnt->distalSegment();
+          jnt.Bsip = jnt.Seg->findChild<InertialParameters*>();
+          if (jnt.Bsip == nullptr)
           {
-            error("The segment '%s' does not have body segment inertial parameters. Inverse dynamics for the chain '%s' aborted.", seg->name().c_str(), chain->name().c_str());
+            error("The segment '%s' does not have body segment inertial parameters. Inverse dynamics for the chain '%s' aborted.", jnt.Seg->name().c_str(), chain->name().c_str());
             break;
           }
-          
-          // Internal variables used
-          // -----------------------
-          
-          // - Pose of the segment
-          auto spts = seg->pose();
-          auto pose = math::to_pose(spts);
-          // - Rotation component of the pose in the Inertial Coordinate System (ICS)
-          auto R = pose.block<9>(0);
-          // - Tensor of inertia expressed in the ICS
-          math::Array<9> I = transform_relative_inertia(bsip, seg, pose);
-          // - Centre of mass expressed in the ICS
-          math::Position com = transform_relative_com(bsip, seg, pose);
-          // - Mass of the segment
-          double m = bsip->mass();
-          // - Proximal end point of the segment
-          auto pp = math::to_position(jnt->proximalAnchor()->position());
+          jnt.Pose = jnt.Seg->pose();
+          const TimeSequence* ppts = jnt.Jnt->proximalAnchor()->position();
+          auto pp = math::to_position(ppts);
           if (!pp.isValid())
           {
-            error("Unexpected error in the computation of proximal anchor position for the joint '%s'. Inverse dynamics for the chain '%s' aborted.", jnt->name().c_str(), chain->name().c_str());
+            error("Unexpected error in the computation of proximal anchor position for the joint '%s'. Inverse dynamics for the chain '%s' aborted.", jnt.Jnt->name().c_str(), chain->name().c_str());
             break;
           }
-          // - Lever arm between the proximal end point and the centre of mass
-          math::Position c = com - pp;
-          
-          // Derivatives computation
-          // -----------------------
-          // TODO Would it be possible to reduce the computation time by compute the angular velocity for the lower triangle only (same for the angular acceleration)
-                    
-          // - Angular velocity of the segment in the ICS
-          math::Vector omega = R.derivative<1>(dt).transform(R.transpose()).skewRedux();
-          // - Angular acceleration of the segment in the ICS
-          math::Vector alpha = R.derivative<2>(dt).transform(R.transpose()).skewRedux();
-          // - Linear acceleration of the CoM in the ICS
-          auto a = com.derivative<2>(dt);
-          
-          // Forces and moments computed at the proximal end point
-          // -----------------------------------------------------
-          
-          // - External contact (ground, etc.)
-          math::Vector Fext(samples); Fext.values().setZero(); Fext.residuals().setZero();
-          math::Vector Mext(samples); Mext.values().setZero(); Mext.residuals().setZero();
-          auto externals = seg->findChildren<const TimeSequence*>({}, {{"type", TimeSequence::Wrench}});
+          jnt.Pp = pp;
+          auto externals = jnt.Seg->findChildren<const TimeSequence*>({}, {{"type", TimeSequence::Wrench}});
           for (const auto& external : externals)
           {
-            auto wrench = math::to_wrench(external);
-            if (!wrench.isValid())
+            if (!math::to_wrench(external).isValid())
             {
               warning("The external wrench '%s' is not valid or does not have the same sample rate, start time or number of sample than the rest of the chain '%s'.", external->name().c_str(), chain->name().c_str());
               continue;
             }
-            Fext += wrench.block<3>(0);
-            Mext += wrench.block<3>(3) + (wrench.block<3>(6) - pp).cross(wrench.block<3>(0));
+            jnt.Externals.push_back(external);
           }
-          // - Add the forces and moments of distal joint (if any)
-          // NOTE: The opposite sign (-=) is because of the use of the action forces and moments computed for the previous segment. In the current segment, they represent reaction forces and moments.
-          if (pd.isValid())
-          {
-            Fext -= Fd;
-            Mext -= Md + (pd - pp).cross(Fd);
-          }
-          // - Weight
-          math::Vector Fwei = m * g / 1000.0;
-          auto Mwei = c.cross(Fwei);
-          // - Dynamics
-          math::Vector Fdyn = m * a / 1000.0;
-          auto Mdyn = (I.transform(alpha) + omega.cross(I.transform(omega))) / 1000.0 + c.cross(Fdyn);
-          // - Proximal joint (result)
-          math::Vector Fp = Fdyn - Fwei - Fext;
-          math::Vector Mp = Mdyn - Mwei - Mext;
-          math::to_timesequence(Fp, jnt->name() + ".Force", rate, start, TimeSequence::Force, "N", jnt);
-          math::to_timesequence(Mp, jnt->name() + ".Moment", rate, start, TimeSequence::Moment, "Nmm" , jnt);
-          math::to_timesequence(omega, spts->name() + ".Omega", rate, start, TimeSequence::Angle | TimeSequence::Velocity | TimeSequence::Reconstructed, "rad/s" , seg);
-          
-          // Set the next (reaction) distal joint variables
-          Fd = Fp;
-          Md = Mp;
-          pd = pp;
+          task.Joints.push_back(std::move(jnt));
+        }
+        if (!task.Joints.empty())
+          tasks.push_back(std::move(task));
+      }
+    }
+    
+    // 2. Terms independent of the other joints (all the joints of all the chains are processed concurrently)
+    std::vector<std::pair<_ma_idm_chain*,_ma_idm_joint*>> items;
+    for (auto& task : tasks)
+      for (auto& jnt : task.Joints)
+        items.emplace_back(&task, &jnt);
+    parallel_for(items.size(), [&items](size_t idx) {
+      const auto task = items[idx].first;
+      auto& jnt = *(items[idx].second);
+      const double dt = 1. / task->Rate;
+      const unsigned samples = task->Samples;
+      double gres = 0.;
+      math::Vector g = math::Map<const math::Vector>(1, task->Mdl->gravity(), &gres).replicate(samples);
+      
+      // Internal variables used
+      // -----------------------
+      
+      // - Pose of the segment
+      auto pose = math::to_pose(jnt.Pose);
+      // - Rotation component of the pose in the Inertial Coordinate System (ICS)
+      auto R = pose.block<9>(0);
+      // - Tensor of inertia expressed in the ICS
+      math::Array<9> I = transform_relative_inertia(jnt.Bsip, jnt.Seg, pose);
+      // - Centre of mass expressed in the ICS
+      math::Position com = transform_relative_com(jnt.Bsip, jnt.Seg, pose);
+      // - Mass of the segment
+      double m = jnt.Bsip->mass();
+      // - Proximal end point of the segment
+      const auto& pp = jnt.Pp;
+      // - Lever arm between the proximal end point and the centre of mass
+      math::Position c = com - pp;
+      
+      // Derivatives computation
+      // -----------------------
+      // TODO Would it be possible to reduce the computation time by compute the angular velocity for the lower triangle only (same for the angular acceleration)
+      
+      // - Angular velocity of the segment in the ICS
+      jnt.Omega = R.derivative<1>(dt).transform(R.transpose()).skewRedux();
+      const auto& omega = jnt.Omega;
+      // - Angular acceleration of the segment in the ICS
+      math::Vector alpha = R.derivative<2>(dt).transform(R.transpose()).skewRedux();
+      // - Linear acceleration of the CoM in the ICS
+      auto a = com.derivative<2>(dt);
+      
+      // Forces and moments computed at the proximal end point
+      // -----------------------------------------------------
+      
+      // - External contact (ground, etc.)
+      jnt.Fext.resize(samples); jnt.Fext.values().setZero(); jnt.Fext.residuals().setZero();
+      jnt.Mext.resize(samples); jnt.Mext.values().setZero(); jnt.Mext.residuals().setZero();
+      for (const auto& external : jnt.Externals)
+      {
+        auto wrench = math::to_wrench(external);
+        jnt.Fext += wrench.block<3>(0);
+        jnt.Mext += wrench.block<3>(3) + (wrench.block<3>(6) - pp).cross(wrench.block<3>(0));
+      }
+      // - Weight
+      jnt.Fwei = m * g / 1000.0;
+      jnt.Mwei = c.cross(jnt.Fwei);
+      // - Dynamics
+      jnt.Fdyn = m * a / 1000.0;
+      jnt.Mdyn = (I.transform(alpha) + omega.cross(I.transform(omega))) / 1000.0 + c.cross(jnt.Fdyn);
+    }, this->threads());
+    
+    // 3. Recursion from the distal to the proximal joint. Each frame is independent, thus the chains are split in blocks of frames
+    std::vector<std::pair<_ma_idm_chain*,unsigned>> blocks;
+    for (auto& task : tasks)
+    {
+      for (auto& jnt : task.Joints)
+      {
+        jnt.Fp.resize(task.Samples);
+        jnt.Mp.resize(task.Samples);
+      }
+      for (unsigned row = 0 ; row < task.Samples ; row += _ma_idm_block_frames)
+        blocks.emplace_back(&task, row);
+    }
+    parallel_for(blocks.size(), [&blocks](size_t idx) {
+      auto task = blocks[idx].first;
+      const unsigned row = blocks[idx].second;
+      const unsigned num = std::min(_ma_idm_block_frames, task->Samples - row);
+      math::Vector Fd, Md, pd;
+      for (auto& jnt : task->Joints)
+      {
+        math::Vector pp = _ma_idm_rows(jnt.Pp, row, num);
+        math::Vector Fext = _ma_idm_rows(jnt.Fext, row, num);
+        math::Vector Mext = _ma_idm_rows(jnt.Mext, row, num);
+        // - Add the forces and moments of distal joint (if any)
+        // NOTE: The opposite sign (-=) is because of the use of the action forces and moments computed for the previous segment. In the current segment, they represent reaction forces and moments.
+        if (pd.isValid())
+        {
+          Fext -= Fd;
+          Mext -= Md + (pd - pp).cross(Fd);
         }
+        // - Proximal joint (result)
+        math::Vector Fp = _ma_idm_rows(jnt.Fdyn, row, num) - _ma_idm_rows(jnt.Fwei, row, num) - Fext;
+        math::Vector Mp = _ma_idm_rows(jnt.Mdyn, row, num) - _ma_idm_rows(jnt.Mwei, row, num) - Mext;
+        jnt.Fp.values().middleRows(row,num) = Fp.values();
+        jnt.Fp.residuals().middleRows(row,num) = Fp.residuals();
+        jnt.Mp.values().middleRows(row,num) = Mp.values();
+        jnt.Mp.residuals().middleRows(row,num) = Mp.residuals();
+        // Set the next (reaction) distal joint variables
+        Fd = Fp;
+        Md = Mp;
+        pd = pp;
+      }
+    }, this->threads());
+    
+    // 4. Sequential export of the results
+    for (const auto& task : tasks)
+    {
+      for (const auto& jnt : task.Joints)
+      {
+        math::to_timesequence(jnt.Fp, jnt.Jnt->name() + ".Force", task.Rate, task.Start, TimeSequence::Force, "N", jnt.Jnt);
+        math::to_timesequence(jnt.Mp, jnt.Jnt->name() + ".Moment", task.Rate, task.Start, TimeSequence::Moment, "Nmm" , jnt.Jnt);
+        math::to_timesequence(jnt.Omega, jnt.Pose->name() + ".Omega", task.Rate, task.Start, TimeSequence::Angle | TimeSequence::Velocity | TimeSequence::Reconstructed, "rad/s" , jnt.Seg);
       }
     }
     return true;
@@ -268,7 +402,10 @@ namespace body
     auto src = node_cast<const InverseDynamicMatrix*>(source);
     if (src == nullptr)
       return;
+    auto optr = this->pimpl();
+    auto optr_src = src->pimpl();
     this->InverseDynamicProcessor::copy(src);
+    optr->Threads = optr_src->Threads;
   };
 
  };
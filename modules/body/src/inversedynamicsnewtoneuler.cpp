@@ -0,0 +1,472 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/body/inversedynamicsnewtoneuler.h"
+#include "openma/body/inversedynamicsprocessor_p.h"
+
+#include "openma/body/anchor.h"
+#include "openma/body/chain.h"
+#include "openma/body/inertialparameters.h"
+#include "openma/body/joint.h"
+#include "openma/body/model.h"
+#include "openma/body/segment.h"
+#include "openma/body/utils.h"
+#include "openma/base/profiler.h"
+#include "openma/base/trial.h"
+#include "openma/math.h"
+
+#include <array>
+#include <memory> // std::shared_ptr
+#include <vector>
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+namespace body
+{
+  class InverseDynamicNewtonEulerPrivate : public InverseDynamicProcessorPrivate
+  {
+    OPENMA_DECLARE_PINT_ACCESSOR(InverseDynamicNewtonEuler)
+      
+  public:
+    InverseDynamicNewtonEulerPrivate(InverseDynamicNewtonEuler* pint);
+    ~InverseDynamicNewtonEulerPrivate();
+  };
+  
+  InverseDynamicNewtonEulerPrivate::InverseDynamicNewtonEulerPrivate(InverseDynamicNewtonEuler* pint)
+  : InverseDynamicProcessorPrivate(pint,"InverseDynamicNewtonEuler")
+  {};
+  
+  InverseDynamicNewtonEulerPrivate::~InverseDynamicNewtonEulerPrivate() = default;
+  
+  // Components stored for each joint in the structure-of-arrays buffer of a chain (one contiguous row of samples per component)
+  enum : unsigned
+  {
+    _ma_idne_Fl = 0,   // Dynamic force minus the weight (3 components)
+    _ma_idne_Ml = 3,   // Dynamic moment minus the moment of the weight, at the proximal end point (3 components)
+    _ma_idne_Fe = 6,   // External forces (3 components)
+    _ma_idne_Me = 9,   // External moments at the proximal end point (3 components)
+    _ma_idne_P = 12,   // Proximal end point (3 components)
+    _ma_idne_O = 15,   // Angular velocity (3 components)
+    _ma_idne_VO = 18,  // Validity of the angular velocity (1 if valid, 0 otherwise)
+    _ma_idne_V = 19,   // Validity of the local terms (1 if valid, 0 otherwise)
+    _ma_idne_Fields = 20
+  };
+  
+  /*
+   * Finite difference (see the class Eigen::internal::DerivativeOpValues) of the @a n rows stored in @a in for each registered @a windows.
+   * The results are stored in @a out and the rows outside of the windows are set to 0.
+   */
+  template <unsigned Order>
+  static void _ma_idne_derivative(double* out, const double* in, unsigned n, const std::vector<std::array<unsigned,2>>& windows, double h)
+  {
+    using Column = Eigen::Map<const Eigen::Array<double,Eigen::Dynamic,1>>;
+    const Column input(in, n);
+    Eigen::Map<Eigen::Array<double,Eigen::Dynamic,1>> output(out, n);
+    Eigen::internal::DerivativeOpValues<Column,Order>(input, windows, h).evalTo(output);
+  };
+  
+  /*
+   * Register the windows of successive valid samples with at least @a mwlen samples.
+   * The rows inside these windows are flagged in @a valid.
+   */
+  static void _ma_idne_windows(std::vector<std::array<unsigned,2>>& windows, std::vector<char>& valid, const double* residuals, unsigned n, unsigned mwlen)
+  {
+    Eigen::Array<double,Eigen::Dynamic,1> temp;
+    windows.clear();
+    math::prepare_window_processing(temp, windows, Eigen::Map<const Eigen::Array<double,Eigen::Dynamic,1>>(residuals,n), mwlen);
+    valid.resize(n);
+    for (unsigned i = 0 ; i < n ; ++i)
+      valid[i] = (temp.coeff(i) >= 0.) ? 1 : 0;
+  };
+  
+  // Vector operations on the 3 components of a SoA field (stride equals to the number of samples)
+  
+  static inline void _ma_idne_cross(double* r, double ax, double ay, double az, double bx, double by, double bz)
+  {
+    r[0] = (ay * bz) - (az * by);
+    r[1] = (az * bx) - (ax * bz);
+    r[2] = (ax * by) - (ay * bx);
+  };
+  
+  // Column-major data of a time sequence mapped by the math module, the distance between two of its columns and the object keeping the data alive when they were widened (see math::Map::owner())
+  struct _ma_idne_input
+  {
+    const double* Data;
+    unsigned Stride;
+    std::shared_ptr<const void> Owner;
+  };
+  
+  // The residuals of the mapped time sequences are stored after the last column (see math::to_arraybase_derived())
+  template <typename T>
+  static inline _ma_idne_input _ma_idne_map(const math::Map<const T>& map)
+  {
+    assert(map.residuals().data() == map.values().data() + map.values().cols() * map.values().outerStride());
+    return {map.values().data(), static_cast<unsigned>(map.values().outerStride()), map.owner()};
+  };
+  
+  /*
+   * Compute the terms of the joint which does not depend of the other joints of the chain.
+   * All the inputs were already checked and all the buffers have the right size.
+   * The inputs @a pose, @a pp and @a externals are read using their own stride while the buffer @a buf uses @a n as stride.
+   */
+  static void _ma_idne_prepare_joint(double* buf, unsigned n, double dt, const _ma_idne_input& pose_, const _ma_idne_input& pp_, const std::vector<_ma_idne_input>& externals, const double* is, const double* cs, double m, const double* g, std::vector<double>& scratch)
+  {
+    const double* pose = pose_.Data;
+    const unsigned ps = pose_.Stride;
+    const double* pp = pp_.Data;
+    const unsigned pps = pp_.Stride;
+    std::vector<std::array<unsigned,2>> w1, w2;
+    std::vector<char> v1, v2;
+    _ma_idne_windows(w1, v1, pose + 12 * ps, n, Eigen::internal::FiniteDifferenceCoefficents<1>::minimum_window_length());
+    _ma_idne_windows(w2, v2, pose + 12 * ps, n, Eigen::internal::FiniteDifferenceCoefficents<2>::minimum_window_length());
+    // Scratch: first and second derivatives of the rotation (9+9 rows), centre of mass (3 rows) and its acceleration (3 rows)
+    scratch.resize(24 * n);
+    double* dR = scratch.data();
+    double* ddR = dR + 9 * n;
+    double* com = ddR + 9 * n;
+    double* acc = com + 3 * n;
+    for (unsigned k = 0 ; k < 9 ; ++k)
+    {
+      _ma_idne_derivative<1>(dR + k * n, pose + k * ps, n, w1, dt);
+      _ma_idne_derivative<2>(ddR + k * n, pose + k * ps, n, w2, dt);
+    }
+    for (unsigned i = 0 ; i < n ; ++i)
+    {
+      for (unsigned r = 0 ; r < 3 ; ++r)
+        com[r*n+i] = pose[r*ps+i] * cs[0] + pose[(3+r)*ps+i] * cs[1] + pose[(6+r)*ps+i] * cs[2] + pose[(9+r)*ps+i];
+    }
+    for (unsigned r = 0 ; r < 3 ; ++r)
+      _ma_idne_derivative<2>(acc + r * n, com + r * n, n, w2, dt);
+    // Sweep along the samples
+    double* Fl = buf + _ma_idne_Fl * n;
+    double* Ml = buf + _ma_idne_Ml * n;
+    double* Fe = buf + _ma_idne_Fe * n;
+    double* Me = buf + _ma_idne_Me * n;
+    double* P = buf + _ma_idne_P * n;
+    double* O = buf + _ma_idne_O * n;
+    double* VO = buf + _ma_idne_VO * n;
+    double* V = buf + _ma_idne_V * n;
+    for (unsigned i = 0 ; i < n ; ++i)
+    {
+      // Rotation R(r,c), its first and second derivatives
+      const double* R[9]; const double* R1[9]; const double* R2[9];
+      for (unsigned k = 0 ; k < 9 ; ++k)
+      {
+        R[k] = pose + k * ps + i;
+        R1[k] = dR + k * n + i;
+        R2[k] = ddR + k * n + i;
+      }
+      // - Angular velocity and acceleration: unique elements of the skew symmetric matrices dR * R^T and ddR * R^T
+      double omega[3], alpha[3];
+      omega[0] =  (*R1[2] * *R[1] + *R1[5] * *R[4] + *R1[8] * *R[7]);
+      omega[1] = -(*R1[2] * *R[0] + *R1[5] * *R[3] + *R1[8] * *R[6]);
+      omega[2] =  (*R1[1] * *R[0] + *R1[4] * *R[3] + *R1[7] * *R[6]);
+      alpha[0] =  (*R2[2] * *R[1] + *R2[5] * *R[4] + *R2[8] * *R[7]);
+      alpha[1] = -(*R2[2] * *R[0] + *R2[5] * *R[3] + *R2[8] * *R[6]);
+      alpha[2] =  (*R2[1] * *R[0] + *R2[4] * *R[3] + *R2[7] * *R[6]);
+      // - Tensor of inertia expressed in the ICS applied to a vector: R * Is * R^T * x
+      auto inertia = [&R,is](double* y, const double* x) {
+        double t[3], u[3];
+        for (unsigned r = 0 ; r < 3 ; ++r)
+          t[r] = *R[r*3] * x[0] + *R[r*3+1] * x[1] + *R[r*3+2] * x[2];
+        for (unsigned r = 0 ; r < 3 ; ++r)
+          u[r] = is[r] * t[0] + is[3+r] * t[1] + is[6+r] * t[2];
+        for (unsigned r = 0 ; r < 3 ; ++r)
+          y[r] = *R[r] * u[0] + *R[3+r] * u[1] + *R[6+r] * u[2];
+      };
+      double Ia[3], Io[3], oIo[3];
+      inertia(Ia, alpha);
+      inertia(Io, omega);
+      _ma_idne_cross(oIo, omega[0], omega[1], omega[2], Io[0], Io[1], Io[2]);
+      // - Lever arm between the proximal end point and the centre of mass
+      const double c[3] = {com[i] - pp[i], com[n+i] - pp[pps+i], com[2*n+i] - pp[2*pps+i]};
+      // - Weight and dynamics
+      const double Fwei[3] = {m * g[0] / 1000.0, m * g[1] / 1000.0, m * g[2] / 1000.0};
+      const double Fdyn[3] = {m * acc[i] / 1000.0, m * acc[n+i] / 1000.0, m * acc[2*n+i] / 1000.0};
+      double Mwei[3], cFdyn[3];
+      _ma_idne_cross(Mwei, c[0], c[1], c[2], Fwei[0], Fwei[1], Fwei[2]);
+      _ma_idne_cross(cFdyn, c[0], c[1], c[2], Fdyn[0], Fdyn[1], Fdyn[2]);
+      // - External contacts
+      double Fext[3] = {0., 0., 0.}, Mext[3] = {0., 0., 0.};
+      bool valid = (v2[i] != 0) && (pp[3*pps+i] >= 0.);
+      for (const auto& external : externals)
+      {
+        const double* w = external.Data;
+        const unsigned ws = external.Stride;
+        valid &= (w[9*ws+i] >= 0.);
+        const double f[3] = {w[i], w[ws+i], w[2*ws+i]};
+        double r[3];
+        _ma_idne_cross(r, w[6*ws+i] - pp[i], w[7*ws+i] - pp[pps+i], w[8*ws+i] - pp[2*pps+i], f[0], f[1], f[2]);
+        for (unsigned k = 0 ; k < 3 ; ++k)
+        {
+          Fext[k] += f[k];
+          Mext[k] += w[(3+k)*ws+i] + r[k];
+        }
+      }
+      for (unsigned k = 0 ; k < 3 ; ++k)
+      {
+        Fl[k*n+i] = Fdyn[k] - Fwei[k];
+        Ml[k*n+i] = ((Ia[k] + oIo[k]) / 1000.0 + cFdyn[k]) - Mwei[k];
+        Fe[k*n+i] = Fext[k];
+        Me[k*n+i] = Mext[k];
+        P[k*n+i] = pp[k*pps+i];
+        O[k*n+i] = (v1[i] != 0) ? omega[k] : 0.;
+      }
+      VO[i] = (v1[i] != 0) ? 1. : 0.;
+      V[i] = valid ? 1. : 0.;
+    }
+  };
+  
+  struct _ma_idne_joint
+  {
+    Joint* Jnt;
+    Segment* Seg;
+    const TimeSequence* Pose;
+    TimeSequence* Force;
+    TimeSequence* Moment;
+    TimeSequence* Omega;
+    double* F; // Data of the output Force (stride Stride)
+    double* M; // Data of the output Moment (stride Stride)
+    double* O; // Data of the output Omega (stride Stride)
+    unsigned Stride;
+  };
+};
+};
+
+#endif
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+OPENMA_INSTANCE_STATIC_TYPEID(ma::body::InverseDynamicNewtonEuler);
+
+namespace ma
+{
+namespace body
+{
+  /**
+   * @class InverseDynamicNewtonEuler openma/body/inversedynamicsnewtoneuler.h
+   * @brief Recursive Newton-Euler algorithm to compute joint kinetics expressed in the global frame
+   *
+   * This processor gives the same results than InverseDynamicMatrix (up to the rounding errors) but its memory layout is different.
+   * For each chain, the terms which only depend of a segment (inertia, centre of mass, derivatives, external wrenches) are precomputed in a contiguous structure-of-arrays buffer.
+   * Then, the chain is swept from its distal to its proximal joint, sample by sample, without any temporary allocation.
+   *
+   * This processor can be selected by a SkeletonHelper object using the property 'inverseDynamicMethod' set to InverseDynamicMethod::NewtonEuler.
+   *
+   * @ingroup openma_body
+   */
+  
+  /**
+   * Constructor
+   */
+  InverseDynamicNewtonEuler::InverseDynamicNewtonEuler(Node* parent)
+  : InverseDynamicProcessor(*new InverseDynamicNewtonEulerPrivate(this), parent)
+  {};
+  
+  /**
+   * Destructor
+   */
+  InverseDynamicNewtonEuler::~InverseDynamicNewtonEuler() _OPENMA_NOEXCEPT = default;
+  
+  /**
+   * For each chain of each model found in @a inout, compute the force and moment of each joint as well as the angular velocity of each segment.
+   * The results are stored in the time sequences "<joint>.Force", "<joint>.Moment", and "<segment pose>.Omega" (same as InverseDynamicMatrix).
+   * The angular velocity and acceleration are computed from the derivatives of the rotation matrices, like the algorithm used by InverseDynamicMatrix.
+   */
+  bool InverseDynamicNewtonEuler::run(Node* inout)
+  {
+    OPENMA_PROFILE_SCOPE("InverseDynamicNewtonEuler::run");
+    std::vector<double> buffer, scratch;
+    std::vector<_ma_idne_joint> items;
+    std::vector<_ma_idne_input> externals;
+    const double id[12] = {1.,0.,0., 0.,1.,0., 0.,0.,1., 0.,0.,0.};
+    const double idres[1] = {0.};
+    auto models = inout->findChildren<Model*>({},{},false);
+    for (auto& model : models)
+    {
+      auto chains = model->chains()->findChildren<Chain*>({},{},false);
+      for (auto& chain : chains)
+      {
+        auto joints = chain->findChildren<Joint*>({},{},false);
+        if (joints.empty())
+        {
+          warning("No joint found in the chain '%s'. Inverse dynamics for this chain aborted.", chain->name().c_str());
+          continue;
+        }
+        // Properties check
+        std::vector<TimeSequence*> tss(joints.size());
+        unsigned inc = 0;
+        for (const auto& joint : joints)
+          tss[inc++] = joint->distalSegment()->pose();
+        double rate = 0.0, start = 0.0;
+        unsigned samples = 0;
+        if (!compare_timesequences_properties(tss, rate, start, samples))
+        {
+          error("At least one segment's pose does not have the same sample rate, start time or number of samples in the chain '%s'.", chain->name().c_str());
+          continue;
+        }
+        assert(rate > 0.);
+        const double dt = 1. / rate;
+        const double* g = model->gravity();
+        const unsigned n = samples;
+        // Precomputation of the terms local to each joint (from the distal to the proximal joint)
+        items.clear();
+        buffer.resize(static_cast<size_t>(joints.size()) * _ma_idne_Fields * n);
+        for (auto itJ = joints.rbegin() ; itJ != joints.rend() ; ++itJ)
+        {
+          _ma_idne_joint item;
+          item.Jnt = *itJ;
+          item.Seg = item.Jnt->distalSegment();
+          auto bsip = item.Seg->findChild<InertialParameters*>();
+          if (bsip == nullptr)
+          {
+            error("The segment '%s' does not have body segment inertial parameters. Inverse dynamics for the chain '%s' aborted.", item.Seg->name().c_str(), chain->name().c_str());
+            break;
+          }
+          const TimeSequence* ppts = item.Jnt->proximalAnchor()->position();
+          const auto ppmap = math::to_position(ppts);
+          if ((ppts == nullptr) || (ppts->samples() != n) || !ppmap.isValid())
+          {
+            error("Unexpected error in the computation of proximal anchor position for the joint '%s'. Inverse dynamics for the chain '%s' aborted.", item.Jnt->name().c_str(), chain->name().c_str());
+            break;
+          }
+          externals.clear();
+          auto wrenches = item.Seg->findChildren<const TimeSequence*>({}, {{"type", TimeSequence::Wrench}});
+          for (const auto& wrench : wrenches)
+          {
+            const auto wrenchmap = math::to_wrench(wrench);
+            if (!wrenchmap.isValid() || (wrench->samples() != n))
+            {
+              warning("The external wrench '%s' is not valid or does not have the same sample rate, start time or number of sample than the rest of the chain '%s'.", wrench->name().c_str(), chain->name().c_str());
+              continue;
+            }
+            externals.push_back(_ma_idne_map(wrenchmap));
+          }
+          // Inertia and centre of mass expressed in the segment frame (constant)
+          const math::Pose identity = math::Map<const math::Pose>(1,id,idres);
+          const math::Array<9> is = transform_relative_inertia(bsip, item.Seg, identity);
+          const math::Position cs = transform_relative_com(bsip, item.Seg, identity);
+          item.Pose = item.Seg->pose();
+          const auto posemap = math::to_pose(item.Pose);
+          if (!posemap.isValid())
+          {
+            error("The pose of the segment '%s' is not valid. Inverse dynamics for the chain '%s' aborted.", item.Seg->name().c_str(), chain->name().c_str());
+            break;
+          }
+          const _ma_idne_input pose = _ma_idne_map(posemap);
+          const _ma_idne_input pp = _ma_idne_map(ppmap);
+          _ma_idne_prepare_joint(buffer.data() + items.size() * _ma_idne_Fields * n, n, dt, pose, pp, externals, is.values().data(), cs.values().data(), bsip->mass(), g, scratch);
+          item.Force = math::to_timesequence(4, n, nullptr, nullptr, item.Jnt->name() + ".Force", rate, start, TimeSequence::Force, "N", item.Jnt);
+          item.Moment = math::to_timesequence(4, n, nullptr, nullptr, item.Jnt->name() + ".Moment", rate, start, TimeSequence::Moment, "Nmm", item.Jnt);
+          item.Omega = math::to_timesequence(4, n, nullptr, nullptr, item.Pose->name() + ".Omega", rate, start, TimeSequence::Angle | TimeSequence::Velocity | TimeSequence::Reconstructed, "rad/s", item.Seg);
+          // The outputs are new time sequences with the same number of samples and then the same stride
+          item.F = item.Force->data();
+          item.M = item.Moment->data();
+          item.O = item.Omega->data();
+          item.Stride = item.Force->stride();
+          assert((item.Moment->stride() == item.Stride) && (item.Omega->stride() == item.Stride));
+          items.push_back(item);
+        }
+        // Recursion from the distal to the proximal joint, sample by sample
+        // NOTE: The opposite sign is because of the use of the action forces and moments computed for the previous segment. In the current segment, they represent reaction forces and moments.
+        const size_t num = items.size();
+        for (unsigned i = 0 ; i < n ; ++i)
+        {
+          double Fd[3] = {0.,0.,0.}, Md[3] = {0.,0.,0.}, pd[3] = {0.,0.,0.};
+          bool valid = true;
+          for (size_t j = 0 ; j < num ; ++j)
+          {
+            const double* buf = buffer.data() + j * _ma_idne_Fields * n;
+            const double* P = buf + _ma_idne_P * n;
+            double* F = items[j].F;
+            double* M = items[j].M;
+            double* O = items[j].O;
+            const unsigned os = items[j].Stride;
+            valid &= (buf[_ma_idne_V * n + i] != 0.);
+            double r[3] = {0.,0.,0.};
+            if (j != 0)
+              _ma_idne_cross(r, pd[0] - P[i], pd[1] - P[n+i], pd[2] - P[2*n+i], Fd[0], Fd[1], Fd[2]);
+            for (unsigned k = 0 ; k < 3 ; ++k)
+            {
+              const double f = buf[(_ma_idne_Fl+k)*n+i] - (buf[(_ma_idne_Fe+k)*n+i] - Fd[k]);
+              const double mo = buf[(_ma_idne_Ml+k)*n+i] - (buf[(_ma_idne_Me+k)*n+i] - (Md[k] + r[k]));
+              F[k*os+i] = valid ? f : 0.;
+              M[k*os+i] = valid ? mo : 0.;
+              O[k*os+i] = buf[(_ma_idne_O+k)*n+i];
+              // Set the next (reaction) distal joint variables
+              Fd[k] = f;
+              Md[k] = mo;
+              pd[k] = P[k*n+i];
+            }
+            F[3*os+i] = valid ? 0. : -1.;
+            M[3*os+i] = valid ? 0. : -1.;
+            O[3*os+i] = (buf[_ma_idne_VO * n + i] != 0.) ? 0. : -1.;
+          }
+        }
+      }
+    }
+    return true;
+  };
+  
+  /**
+   * Create a deep copy of the object and return it as another object.
+   */
+  InverseDynamicNewtonEuler* InverseDynamicNewtonEuler::clone(Node* parent) const
+  {
+    auto dest = new InverseDynamicNewtonEuler;
+    dest->copy(this);
+    dest->addParent(parent);
+    return dest;
+  };
+  
+  /**
+   * Do a deep copy of the the given @a source. The previous content is replaced.
+   */
+  void InverseDynamicNewtonEuler::copy(const Node* source) _OPENMA_NOEXCEPT
+  {
+    auto src = node_cast<const InverseDynamicNewtonEuler*>(source);
+    if (src == nullptr)
+      return;
+    this->InverseDynamicProcessor::copy(src);
+  };
+};
+};
@@ -54,6 +54,40 @@ namespace body
   {};
   
   JointPrivate::~JointPrivate() = default;
+  
+  // Rebind the segments and anchors of a joint rebuilt from its children (e.g. read from a file).
+  // The children are expected in the order used by the constructor: proximal segment and anchor, then distal segment and anchor.
+  void JointPrivate::restore(Node* node)
+  {
+    auto joint = node_cast<Joint*>(node);
+    if (joint == nullptr)
+      return;
+    auto optr = joint->pimpl();
+    const std::string proximal = joint->name() + ".Anchor.Proximal", distal = joint->name() + ".Anchor.Distal";
+    for (auto child : joint->children())
+    {
+      Segment* segment = nullptr;
+      Anchor* anchor = nullptr;
+      if ((segment = node_cast<Segment*>(child)) != nullptr)
+      {
+        if (optr->ProximalSegment == nullptr)
+          optr->ProximalSegment = segment;
+        else if (optr->DistalSegment == nullptr)
+          optr->DistalSegment = segment;
+      }
+      else if ((anchor = node_cast<Anchor*>(child)) != nullptr)
+      {
+        if (anchor->name() == proximal)
+          optr->ProximalAnchor = anchor;
+        else if (anchor->name() == distal)
+          optr->DistalAnchor = anchor;
+      }
+    }
+    if ((optr->ProximalAnchor != nullptr) && (optr->ProximalAnchor->source() == nullptr))
+      optr->ProximalAnchor->setSource(optr->ProximalSegment);
+    if ((optr->DistalAnchor != nullptr) && (optr->DistalAnchor->source() == nullptr))
+      optr->DistalAnchor->setSource(optr->DistalSegment);
+  };
 };
 };
 
@@ -53,6 +53,57 @@ namespace body
   {};
   
   LandmarksRegistrarPrivate::~LandmarksRegistrarPrivate() = default;
+  
+  /*
+   * Check if the children of @a node have the same names (and order) than the ones used to resolve the labels with the translator @a lt.
+   * Only string comparisons are done (no allocation).
+   */
+  bool LandmarksRegistrarPrivate::isBindingValid(const LandmarksTranslator* lt, const Node* node) const _OPENMA_NOEXCEPT
+  {
+    const auto& binding = this->LandmarksBinding;
+    if (!binding.Valid || (binding.Translator != lt) || ((lt != nullptr) && (binding.TranslatorTimestamp != lt->timestamp())))
+      return false;
+    const auto& children = node->children();
+    if (children.size() != binding.Layout.size())
+      return false;
+    for (size_t i = 0 ; i < children.size() ; ++i)
+    {
+      if (children[i]->name() != binding.Layout[i])
+        return false;
+    }
+    return true;
+  };
+  
+  /*
+   * Resolve each label (converted with the translator @a lt if any) into the index of the first child of @a node with the same name and being a TimeSequence.
+   */
+  void LandmarksRegistrarPrivate::bind(const LandmarksTranslator* lt, const Node* node) const
+  {
+    auto& binding = this->LandmarksBinding;
+    const auto& children = node->children();
+    binding.Translator = lt;
+    binding.TranslatorTimestamp = (lt != nullptr) ? lt->timestamp() : 0ul;
+    binding.Layout.resize(children.size());
+    for (size_t i = 0 ; i < children.size() ; ++i)
+      binding.Layout[i] = children[i]->name();
+    binding.Indices.clear();
+    binding.Indices.reserve(this->Labels.size());
+    for (const auto& label : this->Labels)
+    {
+      const std::string name = (lt == nullptr) ? label : lt->convertReverseIfExists(label);
+      if (name.empty())
+        continue;
+      for (size_t i = 0 ; i < children.size() ; ++i)
+      {
+        if ((binding.Layout[i] == name) && (node_cast<TimeSequence*>(children[i]) != nullptr))
+        {
+          binding.Indices.push_back(static_cast<unsigned>(i));
+          break;
+        }
+      }
+    }
+    binding.Valid = true;
+  };
 };
 };
 
@@ -106,35 +157,41 @@ namespace body
     if (optr->Labels == value)
       return;
     optr->Labels = value;
+    std::lock_guard<std::mutex> lock(optr->BindingMutex);
+    optr->LandmarksBinding.Valid = false;
     this->modified();
   };
   
   /**
+   * Returns the time sequences children of @a node corresponding to the stored labels.
+   * If a translator @a lt is given, the labels are converted to their external name before the research. The labels not found are ignored.
    *
+   * The resolution of the labels is cached by the registrar. The next calls with a node having children with the same names (e.g. another trial acquired with the same protocol) and the same translator only copy the pointers of the children.
    */
   std::vector<TimeSequence*> LandmarksRegistrar::retrieveLandmarks(LandmarksTranslator* lt, Node* node) const
   {
     auto optr = this->pimpl();
     std::vector<TimeSequence*> landmarks;
-    landmarks.reserve(optr->Labels.size());
-    if (lt == nullptr)
-    {
-      for (auto it = optr->Labels.cbegin() ; it != optr->Labels.cend() ; ++it)
-      {
-        auto lmk = node->findChild<TimeSequence*>(*it,{},false);
-        if (lmk != nullptr)
-          landmarks.push_back(lmk);
-      }
-    }
-    else
+    if (node == nullptr)
+      return landmarks;
+    std::lock_guard<std::mutex> lock(optr->BindingMutex);
+    if (!optr->isBindingValid(lt, node))
+      optr->bind(lt, node);
+    const auto& children = node->children();
+    landmarks.reserve(optr->LandmarksBinding.Indices.size());
+    for (const auto& idx : optr->LandmarksBinding.Indices)
     {
-      for (auto it = optr->Labels.cbegin() ; it != optr->Labels.cend() ; ++it)
+      auto lmk = node_cast<TimeSequence*>(children[idx]);
+      // The type of a child changed but not its name: resolve again the labels
+      if (lmk == nullptr)
       {
-        TimeSequence* lmk = nullptr;
-        std::string name = lt->convertReverseIfExists(*it);
-        if (!name.empty() && ((lmk = node->findChild<TimeSequence*>(name,{},false))) != nullptr)
-          landmarks.push_back(lmk);
+        optr->bind(lt, node);
+        landmarks.clear();
+        for (const auto& idx_ : optr->LandmarksBinding.Indices)
+          landmarks.push_back(static_cast<TimeSequence*>(children[idx_]));
+        break;
       }
+      landmarks.push_back(lmk);
     }
     return landmarks;
   };
@@ -159,6 +216,8 @@ namespace body
     auto optr_src = src->pimpl();
     this->Node::copyContents(src);
     optr->Labels = optr_src->Labels;
+    std::lock_guard<std::mutex> lock(optr->BindingMutex);
+    optr->LandmarksBinding.Valid = false;
   };
 };
 };
\ No newline at end of file
@@ -42,6 +42,7 @@
 #include "openma/body/enums.h"
 #include "openma/body/eulerdescriptor.h"
 #include "openma/body/inversedynamicsmatrix.h"
+#include "openma/body/inversedynamicsnewtoneuler.h"
 #include "openma/body/joint.h"
 #include "openma/body/landmarksregistrar.h"
 #include "openma/body/landmarkstranslator.h"
@@ -52,10 +53,14 @@
 #include "openma/body/skeletonhelperposeestimator.h"
 #include "openma/body/utils.h"
 #include "openma/base/enums.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
 #include "openma/base/subject.h"
 #include "openma/base/trial.h"
 #include "openma/math.h"
 
+#include <vector>
+
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
 // -------------------------------------------------------------------------- //
@@ -599,10 +604,12 @@ namespace body
  
   /**
    * Calibrate this helper based on the first Trial object found in @a trials. If @a subject is not a null pointer, its dynamic properties are copied to this object.
+   * The landmarks are first averaged over the frames of the static trial. This averaging can be done concurrently (see the property threads and parallel_for()). The calibration is then computed on these mean positions.
    * @todo Explain how to set custom hip joint centre
    */
   bool LyonWholeBodyModel::calibrate(Node* trials, Subject* subject)
   {
+    OPENMA_PROFILE_SCOPE("LyonWholeBodyModel::calibrate");
     if (trials == nullptr)
     {
       error("LyonWholeBodyModel - Null trials passed. Calibration aborted.");
@@ -644,9 +651,15 @@ namespace body
     }
     
     // Average the data
-    std::unordered_map<std::string,math::Vector> landmarks;
+    std::vector<const TaggedMappedPositions::value_type*> items;
+    items.reserve(lmks.size());
     for (const auto& pos : lmks)
-      landmarks.emplace(pos.first, pos.second.mean());
+      items.push_back(&pos);
+    std::vector<math::Vector> means(items.size());
+    parallel_for(items.size(), [&items,&means](size_t idx) {means[idx] = items[idx]->second.mean();}, this->threads());
+    std::unordered_map<std::string,math::Vector> landmarks;
+    for (size_t i = 0 ; i < items.size() ; ++i)
+      landmarks.emplace(items[i]->first, std::move(means[i]));
     
     // Calibrate the helper
     math::Position LJC(1); // Joint center used by the lower and upper parts
@@ -1119,10 +1132,12 @@ namespace body
   };
   
   /**
-   * Returns a InverseDynamicMatrix node
+   * Returns a InverseDynamicNewtonEuler node if the property InverseDynamicMethod is set to InverseDynamicMethod::NewtonEuler. Otherwise, returns a InverseDynamicMatrix node.
    */
   InverseDynamicProcessor* LyonWholeBodyModel::defaultInverseDynamicProcessor()
   {
+    if (this->inverseDynamicMethod() == InverseDynamicMethod::NewtonEuler)
+      return new InverseDynamicNewtonEuler(this);
     return new InverseDynamicMatrix(this);
   };
   
@@ -48,14 +48,19 @@
 #include "openma/body/segment.h"
 #include "openma/body/utils.h"
 #include "openma/body/inversedynamicsmatrix.h"
+#include "openma/body/inversedynamicsnewtoneuler.h"
 #include "openma/body/skeletonhelperposeestimator.h"
 #include "openma/base/logger.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
 #include "openma/base/subject.h"
 #include "openma/base/trial.h"
 
 #include "Eigen_openma/Utils/sign.h"
 
-#include <algorithm> // std::copy_n
+#include <algorithm> // std::copy_n, std::find
+#include <functional>
+#include <vector>
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -100,12 +105,23 @@ namespace body
     
   PluginGaitPrivate::~PluginGaitPrivate() _OPENMA_NOEXCEPT = default;
   
-  bool PluginGaitPrivate::calibrateLowerLimb(int side, const math::Position* HJC, TaggedMappedPositions* landmarks) _OPENMA_NOEXCEPT
+  // Thread-safe lookup (the operator[] of an unordered_map can insert a missing key)
+  static inline const math::Map<const math::Position>& _ma_pig_landmark(const TaggedMappedPositions* landmarks, const std::string& name)
+  {
+    static const math::Map<const math::Position> null;
+    auto it = landmarks->find(name);
+    return (it != landmarks->cend()) ? it->second : null;
+  };
+  
+  /*
+   * Compute the calibration of one lower limb without modifying the helper.
+   * Thus, both sides can be calibrated concurrently. The results are applied with applyLowerLimbCalibration().
+   * The segment lengths and the foot offsets are averaged over the frames of the static trial (lazy reductions, no intermediate array).
+   */
+  bool PluginGaitPrivate::calibrateLowerLimb(int side, const math::Position* HJC, const TaggedMappedPositions* landmarks, LowerLimbCalibration* output) const _OPENMA_NOEXCEPT
   {
-    auto pptr = this->pint();
     std::string prefix;
-    double s = 0.0, ankleWidth = 0.0, kneeWidth = 0.0, seglength = 0.0;
-    double *staticPlantarFlexionOffset = nullptr, *staticRotationOffset = nullptr;
+    double s = 0.0, ankleWidth = 0.0, kneeWidth = 0.0;
     bool footFlat = false;
     if (side == Side::Left)
     {
@@ -114,8 +130,6 @@ namespace body
       ankleWidth = this->LeftAnkleWidth;
       kneeWidth = this->LeftKneeWidth;
       footFlat = this->LeftFootFlatEnabled;
-      staticPlantarFlexionOffset = &(this->LeftStaticPlantarFlexionOffset);
-      staticRotationOffset = &(this->LeftStaticRotationOffset);
     }
     else if (side == Side::Right)
     {
@@ -124,8 +138,6 @@ namespace body
       ankleWidth = this->RightAnkleWidth;
       kneeWidth = this->RightKneeWidth;
       footFlat = this->RightFootFlatEnabled;
-      staticPlantarFlexionOffset = &(this->RightStaticPlantarFlexionOffset);
-      staticRotationOffset = &(this->RightStaticRotationOffset);
     }
     else
     {
@@ -136,8 +148,8 @@ namespace body
     // Thigh
     // -----------------------------------------
     // Required landmarks: *.ITB, *.LFE
-    const auto& ITB = (*landmarks)[prefix+"ITB"];
-    const auto& LFE = (*landmarks)[prefix+"LFE"];
+    const auto& ITB = _ma_pig_landmark(landmarks, prefix+"ITB");
+    const auto& LFE = _ma_pig_landmark(landmarks, prefix+"LFE");
     if (!ITB.isValid() || !LFE.isValid())
     {
       error("PluginGait - Missing landmarks to define the thigh. Calibration aborted.");
@@ -145,23 +157,14 @@ namespace body
     }
     // Compute the knee joint centre (KJC)
     const math::Position KJC = compute_chord((this->MarkerDiameter + kneeWidth) / 2.0, LFE, *HJC, ITB);
-    // Set the segment length
-    seglength = (KJC - *HJC).norm().mean();
-    pptr->setProperty(prefix+"Thigh.length", seglength);
-    // Set the body inertial coordinate system (relative to the SCS)
-    const double relOriBcsFromScs[9] = {
-      0., -1., 0., // BCS u axis has to point to the right. SCS v axis is along the ML axis but pointing to the left (LM)
-      1.,  0., 0., // BCS v axis has to point forward. SCS u axis is pointing forward too
-      0.,  0., 1.  // BCS w axis has to point upward. SCS w axis is going updward too
-    };
-    double relPosBcsFromScs[3] = {0.,0.,seglength};
-    new ReferenceFrame(prefix+"Thigh.BCS", relOriBcsFromScs, relPosBcsFromScs, pptr);
+    // Segment length
+    output->ThighLength = (KJC - *HJC).norm().mean();
     // -----------------------------------------
     // Shank
     // -----------------------------------------
     // Required landmarks: *.LTM, *.LS
-    const auto& LTM = (*landmarks)[prefix+"LTM"];
-    const auto& LS = (*landmarks)[prefix+"LS"];
+    const auto& LTM = _ma_pig_landmark(landmarks, prefix+"LTM");
+    const auto& LS = _ma_pig_landmark(landmarks, prefix+"LS");
     if (!LTM.isValid() || !LS.isValid())
     {
       error("PluginGait - Missing landmarks to define the shank. Calibration aborted.");
@@ -169,35 +172,21 @@ namespace body
     }
     // Compute the ankle joint centre (AJC)
     const math::Position AJC = compute_chord((this->MarkerDiameter + ankleWidth) / 2.0, LTM, KJC, LS);
-    // Set the segment length
-    seglength = (AJC - KJC).norm().mean();
-    pptr->setProperty(prefix+"Shank.length", seglength);
-    // Set the body inertial coordinate system (relative to the SCS)
-    //  - Same relative orientation than for the thigh
-    relPosBcsFromScs[2] = seglength;
-    new ReferenceFrame(prefix+"Shank.BCS", relOriBcsFromScs, relPosBcsFromScs, pptr);
+    // Segment length
+    output->ShankLength = (AJC - KJC).norm().mean();
     // -----------------------------------------
     // Foot
     // -----------------------------------------
     // Required landmarks: *.MTH2, *.HEE
-    const auto& MTH2 = (*landmarks)[prefix+"MTH2"];
-    math::Position HEE = (*landmarks)[prefix+"HEE"]; // Copy instead of a map due to possible modification on its coordinates if the foot flat option is activated
+    const auto& MTH2 = _ma_pig_landmark(landmarks, prefix+"MTH2");
+    math::Position HEE = _ma_pig_landmark(landmarks, prefix+"HEE"); // Copy instead of a map due to possible modification on its coordinates if the foot flat option is activated
     if (!MTH2.isValid() || !HEE.isValid())
     {
       error("PluginGait - Missing landmarks to define the foot. Calibration aborted.");
       return false;
     }
-    // Set the segment length
-    seglength = (MTH2 - HEE).norm().mean();
-    pptr->setProperty(prefix+"Foot.length", seglength);
-    // Set the body inertial coordinate system (relative to the SCS)
-    //  - The BCS origin is the same than the SCS. That's why the relative posiiton is set to nullptr (which internaly is equal to 0,0,0)
-    const double relOriBcsFromScsFoot[9] = {
-      0., -1.,  0., // BCS u axis (right) corresponds to SCS -v axis
-      0.,  0., -1., // BCS v axis (forward) corresponds to SCS -w axis
-      1.,  0.,  0.  // BCS w axis (upward) corresponds to SCS -u axis
-    };
-    new ReferenceFrame(prefix+"Foot.BCS", relOriBcsFromScsFoot, nullptr, pptr);
+    // Segment length
+    output->FootLength = (MTH2 - HEE).norm().mean();
     // Compute foot offset angles
     if (footFlat)
     {
@@ -224,8 +213,78 @@ namespace body
       return false;
     }
     math::Vector::Values offsetAngles = uncorrected_foot.inverse().transform(foot).eulerAngles(1,0,2).mean().values();
-    *staticPlantarFlexionOffset = -1.0 * offsetAngles.coeff(0);
-    *staticRotationOffset = s * offsetAngles.coeff(1);
+    output->StaticPlantarFlexionOffset = -1.0 * offsetAngles.coeff(0);
+    output->StaticRotationOffset = s * offsetAngles.coeff(1);
+    return true;
+  };
+  
+  void PluginGaitPrivate::applyLowerLimbCalibration(int side, const LowerLimbCalibration* input) _OPENMA_NOEXCEPT
+  {
+    auto pptr = this->pint();
+    const std::string prefix = (side == Side::Left) ? "L." : "R.";
+    // Set the body inertial coordinate system (relative to the SCS)
+    const double relOriBcsFromScs[9] = {
+      0., -1., 0., // BCS u axis has to point to the right. SCS v axis is along the ML axis but pointing to the left (LM)
+      1.,  0., 0., // BCS v axis has to point forward. SCS u axis is pointing forward too
+      0.,  0., 1.  // BCS w axis has to point upward. SCS w axis is going updward too
+    };
+    // - Thigh
+    pptr->setProperty(prefix+"Thigh.length", input->ThighLength);
+    double relPosBcsFromScs[3] = {0.,0.,input->ThighLength};
+    new ReferenceFrame(prefix+"Thigh.BCS", relOriBcsFromScs, relPosBcsFromScs, pptr);
+    // - Shank (same relative orientation than for the thigh)
+    pptr->setProperty(prefix+"Shank.length", input->ShankLength);
+    relPosBcsFromScs[2] = input->ShankLength;
+    new ReferenceFrame(prefix+"Shank.BCS", relOriBcsFromScs, relPosBcsFromScs, pptr);
+    // - Foot
+    //   The BCS origin is the same than the SCS. That's why the relative posiiton is set to nullptr (which internaly is equal to 0,0,0)
+    pptr->setProperty(prefix+"Foot.length", input->FootLength);
+    const double relOriBcsFromScsFoot[9] = {
+      0., -1.,  0., // BCS u axis (right) corresponds to SCS -v axis
+      0.,  0., -1., // BCS v axis (forward) corresponds to SCS -w axis
+      1.,  0.,  0.  // BCS w axis (upward) corresponds to SCS -u axis
+    };
+    new ReferenceFrame(prefix+"Foot.BCS", relOriBcsFromScsFoot, nullptr, pptr);
+    // - Offsets
+    if (side == Side::Left)
+    {
+      this->LeftStaticPlantarFlexionOffset = input->StaticPlantarFlexionOffset;
+      this->LeftStaticRotationOffset = input->StaticRotationOffset;
+    }
+    else
+    {
+      this->RightStaticPlantarFlexionOffset = input->StaticPlantarFlexionOffset;
+      this->RightStaticRotationOffset = input->StaticRotationOffset;
+    }
+  };
+  
+  bool PluginGaitPrivate::calibrateHead(const TaggedMappedPositions* landmarks, double* offset) const _OPENMA_NOEXCEPT
+  {
+    // Required landmarks: L.HF, L.HB, R.HF and R.HB
+    const auto& L_HF = _ma_pig_landmark(landmarks, "L.HF");
+    const auto& L_HB = _ma_pig_landmark(landmarks, "L.HB");
+    const auto& R_HF = _ma_pig_landmark(landmarks, "R.HF");
+    const auto& R_HB = _ma_pig_landmark(landmarks, "R.HB");
+    if (!L_HF.isValid() || !L_HB.isValid() || !R_HF.isValid() || !R_HB.isValid())
+    {
+      error("PluginGait - Missing landmarks to define the head. Calibration aborted.");
+      return false;
+    }
+    // NOTE : The markers are first averaged before the computation of the offset!
+    const math::Position _L_HF = L_HF.mean();
+    const math::Position _L_HB = L_HB.mean();
+    const math::Position _R_HF = R_HF.mean();
+    const math::Position _R_HB = R_HB.mean();
+    // WARNING: The origin (set to the middle of the four points) is not the same than Vicon!
+    const math::Vector u = ((_L_HF + _R_HF) / 2.0 - (_L_HB + _R_HB) / 2.0).normalized();
+    const math::Vector w = u.cross((_L_HF + _L_HB) / 2.0 - (_R_HF + _R_HB) / 2.0).normalized();
+    const math::Pose head(u, w.cross(u), w, (_L_HF + _R_HF + _L_HB + _R_HB) / 4.0);
+    if (head.isOccluded())
+    {
+      error("PluginGait - Impossible to find a least one valid frame for the head motion. Calibration aborted.");
+      return false;
+    }
+    *offset = -1.0 * head.eulerAngles(2,0,1).mean().values().z();
     return true;
   };
   
@@ -961,10 +1020,13 @@ namespace body
 
   /**
    * Calibrate this helper based on the first Trial object found in @a trials. If @a subject is not a null pointer, its dynamic properties are copied to this object.
+   * The lower limbs and the head offset can be computed concurrently (see the property threads and parallel_for()). By default, they are computed sequentially.
+   * Their results are applied to the helper only if all of them succeeded. The parameters of the pelvis (e.g. Pelvis.length) computed before are set in any case.
    * @todo Explain how to set custom hip joint centre
    */
   bool PluginGait::calibrate(Node* trials, Subject* subject)
   {
+    OPENMA_PROFILE_SCOPE("PluginGait::calibrate");
     if (trials == nullptr)
     {
       error("PluginGait - Null trials passed. Calibration aborted.");
@@ -994,14 +1056,15 @@ namespace body
     }
     
     // Calibrate the helper
+    math::Position L_HJC(1); L_HJC.residuals().setZero();
+    math::Position R_HJC(1); R_HJC.residuals().setZero();
+    math::Pose pelvis;
     
     // --------------------------------------------------
     // LOWER LIMB
     // --------------------------------------------------
     if (optr->Region & Region::Lower)
     {
-      math::Position L_HJC(1); L_HJC.residuals().setZero();
-      math::Position R_HJC(1); R_HJC.residuals().setZero();
       auto& _R_HJC = R_HJC.values();
       auto& _L_HJC = L_HJC.values();
       const auto& L_ASIS = landmarks["L.ASIS"];
@@ -1081,25 +1144,44 @@ namespace body
       
       const math::Vector v = (L_ASIS - R_ASIS).normalized();
       const math::Vector w = ((R_ASIS - SC).cross(L_ASIS - SC)).normalized();
-      const math::Pose pelvis(v.cross(w), v, w, (L_ASIS + R_ASIS) / 2.0);
+      pelvis = math::Pose(v.cross(w), v, w, (L_ASIS + R_ASIS) / 2.0);
       // Set the segment length
       // NOTE: the coefficient 0.828 comes from Vicon
       this->setProperty("Pelvis.length", 0.828 * (_L_HJC - _R_HJC).matrix().norm());
-      // -----------------------------------------
-      // Other lower limbs (dependant of the hip joint centres)
-      // -----------------------------------------
-      if ((optr->Side & Side::Left) == Side::Left)
+    }
+    
+    // --------------------------------------------------
+    // LOWER LIMBS AND HEAD
+    // --------------------------------------------------
+    // The computations on the frames of the static trial are independent between the sides and the head. They are done concurrently and applied to this helper afterwards.
+    const int sides[2] = {Side::Left, Side::Right};
+    const math::Position* HJCs[2] = {&L_HJC, &R_HJC};
+    PluginGaitPrivate::LowerLimbCalibration lowerLimbs[2];
+    double headOffset = 0.0;
+    std::vector<std::function<bool()>> tasks;
+    for (int i = 0 ; i < 2 ; ++i)
+    {
+      if ((optr->Region & Region::Lower) && ((optr->Side & sides[i]) == sides[i]))
       {
-        const math::Position HJC = pelvis.transform(L_HJC.replicate(pelvis.rows()));
-        if (!optr->calibrateLowerLimb(Side::Left, &HJC, &landmarks))
-          return false;
+        tasks.emplace_back([&,i]() {
+          const math::Position HJC = pelvis.transform(HJCs[i]->replicate(pelvis.rows()));
+          return optr->calibrateLowerLimb(sides[i], &HJC, &landmarks, &lowerLimbs[i]);
+        });
       }
-      if ((optr->Side & Side::Right) == Side::Right)
+    }
+    if ((optr->Region & Region::Upper) && optr->HeadOffsetEnabled)
+      tasks.emplace_back([&]() {return optr->calibrateHead(&landmarks, &headOffset);});
+    std::vector<char> succeeded(tasks.size(), 0);
+    parallel_for(tasks.size(), [&](size_t idx) {succeeded[idx] = tasks[idx]() ? 1 : 0;}, this->threads());
+    if (std::find(succeeded.cbegin(), succeeded.cend(), 0) != succeeded.cend())
+      return false;
+    if (optr->Region & Region::Lower)
+    {
+      for (int i = 0 ; i < 2 ; ++i)
       {
-        const math::Position HJC = pelvis.transform(R_HJC.replicate(pelvis.rows()));
-        if (!optr->calibrateLowerLimb(Side::Right, &HJC, &landmarks))
-          return false;
-       }
+        if ((optr->Side & sides[i]) == sides[i])
+          optr->applyLowerLimbCalibration(sides[i], &lowerLimbs[i]);
+      }
     }
     // --------------------------------------------------
     // UPPER LIMB
@@ -1118,36 +1200,7 @@ namespace body
       this->setProperty("Torso.length", 0);
       this->setProperty("Head.length", 0);
       if (optr->HeadOffsetEnabled)
-      {
-        // -----------------------------------------
-        // Head
-        // -----------------------------------------
-        // Required landmarks: L.HF, L.HB, R.HF and R.HB
-        const auto& L_HF = landmarks["L.HF"];
-        const auto& L_HB = landmarks["L.HB"];
-        const auto& R_HF = landmarks["R.HF"];
-        const auto& R_HB = landmarks["R.HB"];
-        if (!L_HF.isValid() || !L_HB.isValid() || !R_HF.isValid() || !R_HB.isValid())
-        {
-          error("PluginGait - Missing landmarks to define the head. Calibration aborted.");
-          return false;
-        }
-        // NOTE : The markers are first averaged before the computation of the offset!
-        const math::Position _L_HF = L_HF.mean();
-        const math::Position _L_HB = L_HB.mean();
-        const math::Position _R_HF = R_HF.mean();
-        const math::Position _R_HB = R_HB.mean();        
-        // WARNING: The origin (set to the middle of the four points) is not the same than Vicon!
-        const math::Vector u = ((_L_HF + _R_HF) / 2.0 - (_L_HB + _R_HB) / 2.0).normalized();
-        const math::Vector w = u.cross((_L_HF + _L_HB) / 2.0 - (_R_HF + _R_HB) / 2.0).normalized();
-        const math::Pose head(u, w.cross(u), w, (_L_HF + _R_HF + _L_HB + _R_HB) / 4.0);
-        if (head.isOccluded())
-        {
-          error("PluginGait - Impossible to find a least one valid frame for the head motion. Calibration aborted.");
-          return false;
-        }
-        optr->HeadOffset = -1.0 * head.eulerAngles(2,0,1).mean().values().z();
-      }
+        optr->HeadOffset = headOffset;
     }
     return true;
   };
@@ -2005,10 +2058,12 @@ namespace body
   };
   
   /*
-   * Returns a InverseDynamicMatrix node
+   * Returns a InverseDynamicNewtonEuler node if the property InverseDynamicMethod is set to InverseDynamicMethod::NewtonEuler. Otherwise, returns a InverseDynamicMatrix node.
    */
   InverseDynamicProcessor* PluginGait::defaultInverseDynamicProcessor()
   {
+    if (this->inverseDynamicMethod() == InverseDynamicMethod::NewtonEuler)
+      return new InverseDynamicNewtonEuler(this);
     return new InverseDynamicMatrix(this);
   };
   
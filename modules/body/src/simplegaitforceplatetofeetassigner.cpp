@@ -165,9 +165,9 @@ namespace body
         continue;
       }
       std::vector<TimeSequence*> tss{L_HEE, L_MTH1, R_HEE, R_MTH1};
-      std::vector<math::Map<math::Position>> markers; markers.reserve(4);
+      std::vector<math::Map<const math::Position>> markers; markers.reserve(4);
       for (size_t j = 0 ; j < tss.size() ; ++j)
-        markers.push_back(math::to_position(tss[j]));
+        markers.push_back(math::to_position(static_cast<const TimeSequence*>(tss[j])));
       double sampleRate = 0.0; double startTime = 0.0; unsigned samples = 0;
       if (!compare_timesequences_properties(tss, sampleRate, startTime, samples))
       {
@@ -181,7 +181,17 @@ namespace body
       {
         auto forceplate = forceplates[j];
         auto wrench = forceplate->wrench(instrument::Location::CentreOfPressure, true, 10.0, sampleRate);
-        math::Map<math::Position> cop(samples, wrench->data()+6*samples, wrench->data()+9*samples);
+        // NOTE: An error message should already be displayed if the wrench is null.
+        if (wrench == nullptr)
+          continue;
+        if (wrench->samples() != samples)
+        {
+          warning("The wrench of the force plate '%s' does not have the same number of samples than the markers of the model '%s'. You may need to assign it manually to a foot.", forceplate->name().c_str(), model->name().c_str());
+          continue;
+        }
+        wrench->linearize();
+        // The position of the wrench (i.e. the CoP) is stored in the components 7 to 9.
+        math::Map<math::Position> cop = math::to_vector(wrench, 6);
         math::Scalar L_diff = (L_Middle - cop).norm().min();
         math::Scalar R_diff = (R_Middle - cop).norm().min();
         if (L_diff.isOccluded() || R_diff.isOccluded())
@@ -34,6 +34,7 @@
 
 #include "openma/body/skeletonhelper.h"
 #include "openma/body/skeletonhelper_p.h"
+#include "openma/body/enums.h"
 #include "openma/body/externalwrenchassigner.h"
 #include "openma/body/inversedynamicsprocessor.h"
 #include "openma/body/inertialparametersestimator.h"
@@ -41,8 +42,13 @@
 #include "openma/body/model.h"
 #include "openma/body/poseestimator.h"
 #include "openma/body/referenceframe.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
 #include "openma/base/trial.h"
 
+#include <memory> // std::unique_ptr
+#include <mutex>
+
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
 // -------------------------------------------------------------------------- //
@@ -54,7 +60,7 @@ namespace ma
 namespace body
 {
   SkeletonHelperPrivate::SkeletonHelperPrivate(SkeletonHelper* pint, const std::string& name, int region, int side)
-  : NodePrivate(pint,name), Region(region), Side(side)
+  : NodePrivate(pint,name), Region(region), Side(side), InverseDynamicMethod(body::InverseDynamicMethod::Matrix), Threads(1u)
 #if !defined(_MSC_VER) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
     , Gravity{{0.,0.,0.}}
 #endif
@@ -101,7 +107,7 @@ namespace body
   
   /**
    * @typedef TaggedMappedPositions
-   * List of math::Map<math::Position> tagged with a name. This typedef is for example used to retrieve landmarks for a model.
+   * List of math::Map<const math::Position> tagged with a name. This typedef is for example used to retrieve landmarks for a model.
    * @sa extract_landmark_positions()
    */
   
@@ -123,6 +129,16 @@ namespace body
      * @sa gravity() setGravity()
      */
     std::array<double,3> Gravity;
+    /**
+     * This property holds the algorithm used by the default inverse dynamic processor (see defaultInverseDynamicProcessor()). By default, this property is set to InverseDynamicMethod::Matrix.
+     * @sa inverseDynamicMethod() setInverseDynamicMethod()
+     */
+    int InverseDynamicMethod;
+    /**
+     * This property holds the number of threads used by the method calibrate() of the inheriting classes. A value of 0 means that all the hardware threads are used. By default, the calibration is sequential (i.e. 1 thread).
+     * @sa threads() setThreads()
+     */
+    unsigned Threads;
   };
 #endif
   
@@ -166,6 +182,49 @@ namespace body
     return optr->Gravity;
   };
   
+  /**
+   * Returns the internal parameter InverseDynamicMethod.
+   */
+  int SkeletonHelper::inverseDynamicMethod() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->InverseDynamicMethod;
+  };
+  
+  /**
+   * Sets the internal parameter InverseDynamicMethod. You can use the enum InverseDynamicMethod to set this value.
+   */
+  void SkeletonHelper::setInverseDynamicMethod(int value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (optr->InverseDynamicMethod == value)
+      return;
+    optr->InverseDynamicMethod = value;
+    this->modified();
+  };
+  
+  /**
+   * Returns the internal parameter Threads.
+   */
+  unsigned SkeletonHelper::threads() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Threads;
+  };
+  
+  /**
+   * Sets the internal parameter Threads.
+   * @note This property does not concern the method reconstruct() which has its own argument.
+   */
+  void SkeletonHelper::setThreads(unsigned value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (optr->Threads == value)
+      return;
+    optr->Threads = value;
+    this->modified();
+  };
+  
   /**
    * @fn virtual bool SkeletonHelper::calibrate(Node* trials, Subject* subject) _OPENMA_NOEXCEPT = 0;
    * This methods must be overloaded by inheriting classes to calibrate the helper. For this, the content of @a trials and @a subject can be used.
@@ -174,9 +233,15 @@ namespace body
   
   /**
    * For each direct children corresponding to a Trial object in @a trials, create a model and reconstruct the associated movement. Each Model is added to the @a output.
+   *
+   * Once the helper is calibrated, the trials are independent. They can then be reconstructed concurrently using several @a threads (0 means all the hardware threads).
+   * In this case, each model is built in its own subtree by a worker thread and the models are added to the @a output in the order of the trials.
+   * The nodes shared by the models (landmarks translator, external wrench assigner, inertial parameters estimator, inverse dynamic processor) are retrieved or created before the reconstruction.
+   * The content of the helper is then only read by the workers. The only difference with a sequential reconstruction is that each model receives a copy of the body inertial coordinate systems (BCS) stored in the helper.
    */
-  bool SkeletonHelper::reconstruct(Node* output, Node* trials)
+  bool SkeletonHelper::reconstruct(Node* output, Node* trials, unsigned threads)
   {
+    OPENMA_PROFILE_SCOPE("SkeletonHelper::reconstruct");
     auto optr = this->pimpl();
     if (output == nullptr)
     {
@@ -196,28 +261,57 @@ namespace body
       error("SkeletonHelper - No pose estimator found. Movement reconstruction aborted.");
       return false;
     }
-    int inc = -1;
     auto _trials = trials->findChildren<Trial*>({},{},false);
-    for (auto trial : _trials)
+    const bool concurrent = (_trials.size() > 1) && (parallel_threads(threads) > 1);
+    // Nodes shared by all the models.
+    // With a sequential reconstruction, they are looked for each trial (as they can be created by the pose estimator).
+    LandmarksTranslator* translator = nullptr;
+    ExternalWrenchAssigner* ewa = nullptr;
+    InertialParametersEstimator* ipe = nullptr;
+    InverseDynamicProcessor* idp = nullptr;
+    auto retrieveSharedNodes = [&]() {
+      translator = this->findChild<LandmarksTranslator*>({},{},false);
+      if (!optr->hasNonNullGravity())
+        return;
+      if ((ewa = this->findChild<ExternalWrenchAssigner*>({},{},false)) == nullptr)
+        ewa = this->defaultExternalWrenchAssigner();
+      if ((ipe = this->findChild<InertialParametersEstimator*>({},{},false)) == nullptr)
+        ipe = this->defaultInertialParametersEstimator();
+      if ((idp = this->findChild<InverseDynamicProcessor*>({},{},false)) == nullptr)
+        idp = this->defaultInverseDynamicProcessor();
+    };
+    if (concurrent)
     {
-      ++inc;
+      if (this->findChild<LandmarksTranslator*>({},{},false) == nullptr)
+        this->defaultLandmarksTranslator();
+      retrieveSharedNodes();
+    }
+    // Each model is built in a temporary node (also used to compute the inverse dynamics)
+    std::vector<std::unique_ptr<Node>> temps(_trials.size());
+    std::vector<Model*> models(_trials.size(), nullptr);
+    std::mutex guard;
+    parallel_for(_trials.size(), [&](size_t idx) {
+      const int inc = static_cast<int>(idx);
+      auto trial = _trials[idx];
       if (trial == nullptr)
       {
         error("SkeletonHelper - Trial #%i is null. Movement reconstruction skipped for this trial.", inc);
-        continue;
+        return;
       }
+      OPENMA_PROFILE_SCOPE("SkeletonHelper::reconstruct (trial)");
+      OPENMA_PROFILE_COUNT("trials",1);
       auto model = new Model(std::string{});
       if (!this->setupModel(model))
       {
         error("SkeletonHelper - Error in the model set up. Movement reconstruction skipped for the trial #%i", inc);
         delete model;
-        continue;
+        return;
       }
       if (!estimator->run(model, this, trial))
       {
         error("SkeletonHelper - Error in the model reconstruction. Movement reconstruction skipped for the trial #%i", inc);
         delete model;
-        continue;
+        return;
       }
       auto segments = model->segments()->children();
       for (auto seg : segments)
@@ -225,10 +319,18 @@ namespace body
         seg->setProperty("length", this->property(seg->name()+".length"));
         ReferenceFrame* bcs = nullptr;
         if ((bcs = this->findChild<ReferenceFrame*>(seg->name()+".BCS")) != nullptr)
-          bcs->addParent(seg);
+        {
+          // A shared BCS would be modified concurrently (e.g. by the inertial parameters estimator)
+          if (concurrent)
+            bcs->clone(seg);
+          else
+            bcs->addParent(seg);
+        }
       }
-      // Attach the model to the output
-      model->addParent(output);
+      // Keep the model (it will be attached to the output later)
+      temps[idx].reset(new Node("_TRID"));
+      model->addParent(temps[idx].get());
+      models[idx] = model;
       // Copy the gravity
       // FIXME WE MUST FIND A WAY TO NOT FORCE THE SETTING OF THE GRAVITY TO THE UNIT MM/S^2
       const double g[3] = {optr->Gravity[0] * 1000., optr->Gravity[1] * 1000., optr->Gravity[2] * 1000.};
@@ -237,45 +339,51 @@ namespace body
       const auto& props = this->dynamicProperties();
       for (const auto& prop : props)
         model->setProperty(prop.first, prop.second);
+      if (!concurrent)
+        retrieveSharedNodes();
       // Attach the landmarks translator to the model. It can be used later.
-      auto translator = this->findChild<LandmarksTranslator*>({},{},false);
       if (translator != nullptr)
+      {
+        std::lock_guard<std::mutex> lock(guard);
         translator->addParent(model);
+      }
       // Attach the trial to the model. It can be used later.
       trial->addParent(model);
       // Computation of the inverse dynamics?
       if (optr->hasNonNullGravity())
       {
-        Node temp("_TRID");
-        model->addParent(&temp);
+        auto temp = temps[idx].get();
         // Associate FP wrench to feet
-        ExternalWrenchAssigner* ewa = this->findChild<ExternalWrenchAssigner*>({},{},false);
-        if (ewa == nullptr)
-          ewa = this->defaultExternalWrenchAssigner();
-        if ((ewa != nullptr) && !ewa->run(&temp))
         {
-          error("SkeletonHelper - Error during the setting of external wrenches. Inverse dynamics computation skipped for the trial #%i", inc);
-          continue;
+          OPENMA_PROFILE_SCOPE("ExternalWrenchAssigner::run");
+          if ((ewa != nullptr) && !ewa->run(temp))
+          {
+            error("SkeletonHelper - Error during the setting of external wrenches. Inverse dynamics computation skipped for the trial #%i", inc);
+            return;
+          }
         }
         // Compute BSIPs
-        InertialParametersEstimator* ipe = this->findChild<InertialParametersEstimator*>({},{},false);
-        if (ipe == nullptr)
-          ipe = this->defaultInertialParametersEstimator();
-        if ((ipe != nullptr) && !ipe->run(&temp))
         {
-          error("SkeletonHelper - Error during the estimation of the segment inertial parameters. Inverse dynamics computation skipped for the trial #%i", inc);
-          continue;
+          OPENMA_PROFILE_SCOPE("InertialParametersEstimator::run");
+          if ((ipe != nullptr) && !ipe->run(temp))
+          {
+            error("SkeletonHelper - Error during the estimation of the segment inertial parameters. Inverse dynamics computation skipped for the trial #%i", inc);
+            return;
+          }
         }
         // Compute inverse dynamics in the global frame
-        InverseDynamicProcessor* idp = this->findChild<InverseDynamicProcessor*>({},{},false);
-        if (idp == nullptr)
-          idp = this->defaultInverseDynamicProcessor();
-        if ((idp != nullptr) && !idp->run(&temp))
+        if ((idp != nullptr) && !idp->run(temp))
         {
           error("SkeletonHelper - Error during the computation of the inverse dynamics. Inverse dynamics computation skipped for the trial #%i", inc);
-          continue;
+          return;
         }
       }
+    }, concurrent ? threads : 1u);
+    // Attach the models to the output (in the order of the trials)
+    for (auto model : models)
+    {
+      if (model != nullptr)
+        model->addParent(output);
     }
     return true;
   };
@@ -321,6 +429,7 @@ namespace body
    * @fn virtual InverseDynamicProcessor* SkeletonHelper::defaultInverseDynamicProcessor() = 0;
    * Create a InverseDynamicProcessor node used by the SkeletonHelper object to compoute joint kinetics.
    * This method is called by the method SkeletonHelper::reconstruct() if no other processor was found.
+   * The created processor should respect the algorithm selected with the property InverseDynamicMethod.
    */
   
   /**
@@ -337,6 +446,8 @@ namespace body
     optr->Region = optr_src->Region;
     optr->Side = optr_src->Side;
     optr->Gravity = optr_src->Gravity;
+    optr->InverseDynamicMethod = optr_src->InverseDynamicMethod;
+    optr->Threads = optr_src->Threads;
   };
 };
 };
\ No newline at end of file
@@ -38,6 +38,7 @@
 #include "openma/body/skeletonhelper.h"
 #include "openma/base/trial.h"
 #include "openma/base/logger.h"
+#include "openma/base/profiler.h"
 
 // -------------------------------------------------------------------------- //
 //                                 PUBLIC API                                 //
@@ -73,6 +74,7 @@ namespace body
    */
   bool SkeletonHelperPoseEstimator::run(Model* output, SkeletonHelper* helper, Trial* trial)
   {
+    OPENMA_PROFILE_SCOPE("SkeletonHelperPoseEstimator::run");
     if (helper == nullptr)
     {
       error("You try to use a skeleton helper pose estimator but a null skeleton helper was passed. Reconstruction aborted.");
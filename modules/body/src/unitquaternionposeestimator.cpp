@@ -33,6 +33,7 @@
  */
 
 #include "openma/body/unitquaternionposeestimator.h"
+#include "openma/body/unitquaternionposeestimator_p.h"
 
 #include "openma/body/landmarksregistrar.h"
 #include "openma/body/landmarkstranslator.h"
@@ -44,12 +45,58 @@
 #include "openma/body/utils.h"
 #include "openma/base/trial.h"
 #include "openma/base/logger.h"
+#include "openma/base/profiler.h"
 #include "openma/math.h"
 
 #include <Eigen/Eigenvalues> // Eigen::SelfAdjointEigenSolver
 
 #include <iostream>
 
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+namespace body
+{
+  UnitQuaternionPoseEstimatorPrivate::UnitQuaternionPoseEstimatorPrivate(UnitQuaternionPoseEstimator* pint, const std::string& name)
+  : PoseEstimatorPrivate(pint,name), ClusterBindings(), BindingMutex()
+  {};
+  
+  UnitQuaternionPoseEstimatorPrivate::~UnitQuaternionPoseEstimatorPrivate() = default;
+  
+  /*
+   * Returns the local markers associated with the given @a landmarks for the @a segment. They are looked for in the node @a mcr (MarkerClusterRegistration) only if the previous binding of this segment is not valid anymore.
+   * A missing local marker is represented by a null pointer.
+   */
+  auto UnitQuaternionPoseEstimatorPrivate::bindCluster(const std::string& segment, const Node* mcr, const std::vector<TimeSequence*>& landmarks) -> const ClusterBinding&
+  {
+    auto& binding = this->ClusterBindings[segment];
+    bool valid = (binding.Registration == mcr) && (binding.RegistrationTimestamp == mcr->timestamp()) && (binding.Landmarks.size() == landmarks.size());
+    for (size_t i = 0 ; valid && (i < landmarks.size()) ; ++i)
+      valid = (binding.Landmarks[i] == landmarks[i]->name());
+    if (valid)
+      return binding;
+    binding.Registration = mcr;
+    binding.RegistrationTimestamp = mcr->timestamp();
+    binding.Landmarks.resize(landmarks.size());
+    binding.Points.resize(landmarks.size());
+    for (size_t i = 0 ; i < landmarks.size() ; ++i)
+    {
+      binding.Landmarks[i] = landmarks[i]->name();
+      binding.Points[i] = mcr->findChild<Point*>(segment + "." + binding.Landmarks[i],{},false);
+    }
+    binding.Frame = mcr->findChild<ReferenceFrame*>(segment + ".SCS",{},false);
+    return binding;
+  };
+};
+};
+
+#endif
+
 // -------------------------------------------------------------------------- //
 //                                 PUBLIC API                                 //
 // -------------------------------------------------------------------------- //
@@ -76,7 +123,7 @@ namespace body
    * Constructor
    */
   UnitQuaternionPoseEstimator::UnitQuaternionPoseEstimator(const std::string& name, Node* parent)
-  : PoseEstimator(name,parent)
+  : PoseEstimator(*new UnitQuaternionPoseEstimatorPrivate(this,name),parent)
   {};
   
   /**
@@ -89,6 +136,7 @@ namespace body
    */
   bool UnitQuaternionPoseEstimator::run(Model* output, SkeletonHelper* helper, Trial* trial)
   {
+    OPENMA_PROFILE_SCOPE("UnitQuaternionPoseEstimator::run");
     // 0. Check
     if (output == nullptr)
     {
@@ -112,37 +160,39 @@ namespace body
       error("UnitQuaternionPoseEstimator - No marker cluster registration found. Pose estimator aborted.");
       return false;
     }
+    auto optr = this->pimpl();
     const auto& lt = helper->findChild<LandmarksTranslator*>({},{},false);
     const auto& segments = output->segments()->findChildren<Segment*>({},{},false);
     double startTime = 0.0, sampleRate = 0.0;
-    bool ok = false;
     for (auto segment : segments)
     {
       const auto& lr = segment->findChild<LandmarksRegistrar*>({},{},false);
       if (lr == nullptr)
         continue;
       // Look for the markers in the trial and the marker cluster registration
-      auto globalMarkers = extract_landmark_positions(nullptr, lr->retrieveLandmarks(lt, trial->timeSequences()), &sampleRate, &startTime, &ok);
-      if (!ok)
+      // The resolution of the labels is cached by the registrar and by this estimator: the next trials sharing the same layout only copy pointers
+      const auto& landmarks = lr->retrieveLandmarks(lt, trial->timeSequences());
+      if (!find_common_sampling(landmarks, &sampleRate, &startTime))
       {
         error("UnitQuaternionPoseEstimator - The sampling information is not consistent between required landmarks (sampling rates or start times are not the same). Calibration aborted.");
         return false;
       }
-      std::vector<std::pair<Eigen::Map<Eigen::Matrix<double,3,1>>,const math::Map<math::Position>&>> mappedMarkers;
-      mappedMarkers.reserve(globalMarkers.size());
-      auto it = globalMarkers.begin();
-      while (it != globalMarkers.end())
+      std::vector<Point*> localMarkers;
+      ReferenceFrame* relframe = nullptr;
       {
-        Point* localMarker = nullptr;
-        if (!it->second.isValid() || ((localMarker = mcr->findChild<Point*>(segment->name()+"."+it->first,{},false)) == nullptr))
-          it = globalMarkers.erase(it);
-        else
-        {
-          mappedMarkers.push_back({localMarker->data(),it->second});
-          ++it;
-        }
+        std::lock_guard<std::mutex> lock(optr->BindingMutex);
+        const auto& binding = optr->bindCluster(segment->name(), mcr, landmarks);
+        localMarkers = binding.Points;
+        relframe = binding.Frame;
+      }
+      std::vector<std::pair<Eigen::Map<Eigen::Matrix<double,3,1>>,math::Map<const math::Position>>> mappedMarkers;
+      mappedMarkers.reserve(landmarks.size());
+      for (size_t j = 0 ; j < landmarks.size() ; ++j)
+      {
+        auto globalMarker = math::to_position(static_cast<const TimeSequence*>(landmarks[j]));
+        if (globalMarker.isValid() && (localMarkers[j] != nullptr))
+          mappedMarkers.push_back({localMarkers[j]->data(),globalMarker});
       }
-      assert(globalMarkers.size() == mappedMarkers.size());
       if (mappedMarkers.size() < 3)
       {
         error("Less than 3 valid markers was found for the segment '%s'. Impossible to compute the TCS. Pose estimator aborted.", segment->name().c_str());
@@ -150,7 +200,7 @@ namespace body
       }
       // Reconstruct for each sample
       unsigned numSamples = std::numeric_limits<unsigned>::max();
-      for (const auto& marker : globalMarkers)
+      for (const auto& marker : mappedMarkers)
       {
         numSamples = std::min<unsigned>(numSamples, marker.second.rows());
         if (marker.second.rows() != numSamples)
@@ -166,8 +216,8 @@ namespace body
       for (unsigned i = 0 ; i < numSamples ; ++i)
       {
         int inc = 0;
-        ps1.setZero(3,static_cast<int>(globalMarkers.size()));
-        ps2.setZero(3,static_cast<int>(globalMarkers.size()));
+        ps1.setZero(3,static_cast<int>(mappedMarkers.size()));
+        ps2.setZero(3,static_cast<int>(mappedMarkers.size()));
         for (const auto& m : mappedMarkers)
         {
           if (m.second.residuals().coeff(i) >= 0.0)
@@ -226,7 +276,6 @@ namespace body
       }
       // Reconstruction of the SCS
       // Look for Reference frame in the node MarkerClusterRegistration
-      auto relframe = mcr->findChild<ReferenceFrame*>(segment->name() + ".SCS", {}, false);
       if (relframe != nullptr)
       {
         relframe->addParent(segment);
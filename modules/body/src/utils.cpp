@@ -40,12 +40,32 @@
 #include "openma/body/inertialparameters.h"
 #include "openma/body/segment.h"
 #include "openma/body/skeletonhelper.h"
+#include "openma/base/profiler.h"
 #include "openma/base/trial.h"
 
 namespace ma
 {
 namespace body
 {
+  /*
+   * Compose the given relative data @a rel (one sample) with all the reference frames found in the @a path, starting from the index @a last down to the index 1.
+   * The node at the index 0 is the segment itself and is then not used.
+   */
+  template <typename T>
+  static inline void _ma_body_compose_relative_frames(T& rel, const std::vector<const Node*>& path, size_t last)
+  {
+    const double res[1] = {0.};
+    T temp;
+    for (size_t i = last ; i > 0 ; --i)
+    {
+      auto relrefframe = node_cast<const ReferenceFrame*>(path[i]);
+      if (relrefframe == nullptr)
+        continue;
+      temp = math::Map<const math::Pose>(1,relrefframe->data(),res).transform(rel);
+      rel = temp;
+    }
+  };
+  
   /**
    * Returns a collection of mapped time sequences based on the stored LandmarksTranslator in the given @a helper.
    * The time sequences are extracted from the child node "TimeSequences" of the given @a trial.
@@ -58,8 +78,9 @@ namespace body
    * If all the landmarks have the same start time, and if the output @a start is given, its value will be assigned to the found common start time (-1.0 otherwise).
    * If all the landmarks have the same sample rate and start time, and if the output @a ok is given, its value will be assigned to true (false otherwise).
    */
-  std::unordered_map<std::string,math::Map<math::Vector>> extract_landmark_positions(SkeletonHelper* helper, Trial* trial, double* rate, double* start, bool* ok) _OPENMA_NOEXCEPT
+  std::unordered_map<std::string,math::Map<const math::Vector>> extract_landmark_positions(SkeletonHelper* helper, Trial* trial, double* rate, double* start, bool* ok) _OPENMA_NOEXCEPT
   {
+    OPENMA_PROFILE_SCOPE("extract_landmark_positions");
     auto lt = helper->findChild<LandmarksTranslator*>({},{},false);
     // No defined translator? Let's use the one embedded within the helper (if any)
     if (lt == nullptr)
@@ -78,19 +99,18 @@ namespace body
    * If all the landmarks have the same start time, and if the output @a start is given, its value will be assigned to the found common start time (-1.0 otherwise).
    * If all the landmarks have the same sample rate and start time, and if the output @a ok is given, its value will be assigned to true (false otherwise).
    */
-  std::unordered_map<std::string,math::Map<math::Vector>> extract_landmark_positions(LandmarksTranslator* lt, const std::vector<TimeSequence*>& markers, double* rate, double* start, bool* ok) _OPENMA_NOEXCEPT
+  std::unordered_map<std::string,math::Map<const math::Vector>> extract_landmark_positions(LandmarksTranslator* lt, const std::vector<TimeSequence*>& markers, double* rate, double* start, bool* ok) _OPENMA_NOEXCEPT
   {
-    std::unordered_map<std::string,math::Map<math::Vector>> positions;
-    
-    double sampleRate = -1.0, startTime = -1.0;
-    bool common = true;
+    std::unordered_map<std::string,math::Map<const math::Vector>> positions;
+    positions.reserve(markers.size());
     std::vector<TimeSequence*> landmarks;
+    landmarks.reserve(markers.size());
     // No translator found? Create positions for all the markers found
     if (lt == nullptr)
     {
       for (auto it = markers.cbegin() ; it != markers.cend() ; ++it)
       {
-        positions.insert(std::make_pair((*it)->name(),math::to_position(*it)));
+        positions.insert(std::make_pair((*it)->name(),math::to_position(static_cast<const TimeSequence*>(*it))));
         landmarks.push_back(*it);
       }
     }
@@ -102,20 +122,37 @@ namespace body
         std::string name = lt->convertIfExists((*it)->name());
         if (!name.empty())
         {
-          positions.insert(std::make_pair(name,math::to_position(*it)));
+          positions.insert(std::make_pair(name,math::to_position(static_cast<const TimeSequence*>(*it))));
           landmarks.push_back(*it);
         }
       }
     }
     // Detect the common sampling information
-    auto it = landmarks.cbegin();
-    if (it != landmarks.cend())
+    bool common = find_common_sampling(landmarks, rate, start);
+    if (ok != nullptr)
+      *ok = common;
+    
+    return positions;
+  };
+  
+  /**
+   * Determine the common sample rate and the common start time of the given time sequences @a tss.
+   * If all the time sequences have the same sample rate, and if the output @a rate is given, its value will be assigned to the found common sample rate (-1.0 otherwise).
+   * If all the time sequences have the same start time, and if the output @a start is given, its value will be assigned to the found common start time (-1.0 otherwise).
+   * Returns true if all the time sequences have the same sample rate and start time (or if @a tss is empty), false otherwise.
+   */
+  bool find_common_sampling(const std::vector<TimeSequence*>& tss, double* rate, double* start) _OPENMA_NOEXCEPT
+  {
+    double sampleRate = -1.0, startTime = -1.0;
+    bool common = true;
+    auto it = tss.cbegin();
+    if (it != tss.cend())
     {
       sampleRate = (*it)->sampleRate();
       startTime = (*it)->startTime();
       ++it;
     }
-    for ( ; it != landmarks.cend() ; ++it)
+    for ( ; it != tss.cend() ; ++it)
     {
       if ((fabs(sampleRate - (*it)->sampleRate()) > std::numeric_limits<float>::epsilon())
        || (fabs(startTime - (*it)->startTime()) > std::numeric_limits<float>::epsilon()))
@@ -131,10 +168,7 @@ namespace body
       *rate = sampleRate;
     if (start != nullptr)
       *start = startTime;
-    if (ok != nullptr)
-      *ok = common;
-    
-    return positions;
+    return common;
   };
   
   /**
@@ -144,6 +178,8 @@ namespace body
    */
   TimeSequence* average_marker(const TimeSequence* marker, Node* parent)
   {
+    if (marker == nullptr)
+      return nullptr;
     math::Position avgpos = math::to_position(marker).mean();
     return math::to_timesequence(avgpos, marker->name(), marker->sampleRate(), marker->startTime(), marker->type(), marker->unit(), parent);
   };
@@ -162,19 +198,11 @@ namespace body
     if (path.empty())
       return math::Pose();
     // Compute the pose
-    const double res[1] = {0.};
-    math::Pose temp, mot(1);
+    math::Pose mot(1);
     mot.residuals().setZero();
     std::copy_n(relframe->data(), 12, mot.values().data());
-    for (size_t i = path.size()-2 ; i > 0 ; --i)
-    {
-      auto relrefframe = node_cast<const ReferenceFrame*>(path[i]);
-      if (relrefframe == nullptr)
-        continue;
-      temp = math::Map<const math::Pose>(1,relrefframe->data(),res).transform(mot);
-      mot = temp;
-    }
-    temp = segpose.transform(mot.replicate(segpose.rows()));
+    _ma_body_compose_relative_frames(mot, path, path.size()-2);
+    math::Pose temp = segpose.transform(mot.replicate(segpose.rows()));
     return temp;
   };
   
@@ -192,19 +220,11 @@ namespace body
     if (path.empty())
       return math::Position();
     // Compute the position
-    const double res[1] = {0.};
-    math::Position temp, traj(1);
+    math::Position traj(1);
     traj.residuals().setZero();
     std::copy_n(relpoint->data(), 3, traj.values().data());
-    for (size_t i = path.size()-2 ; i > 0 ; --i)
-    {
-      auto relrefframe = node_cast<const ReferenceFrame*>(path[i]);
-      if (relrefframe == nullptr)
-        continue;
-      temp = math::Map<const math::Pose>(1,relrefframe->data(),res).transform(traj);
-      traj = temp;
-    }
-    temp = segpose.transform(traj.replicate(segpose.rows()));
+    _ma_body_compose_relative_frames(traj, path, path.size()-2);
+    math::Position temp = segpose.transform(traj.replicate(segpose.rows()));
     return temp;
   };
   
@@ -215,8 +235,17 @@ namespace body
    */
   math::Array<9> transform_relative_inertia(InertialParameters* relbsip, const Segment* seg, const math::Pose& pose) _OPENMA_NOEXCEPT
   {
-    ReferenceFrame rInertia("rInertia", relbsip->inertia(), relbsip);
-    return transform_relative_frame(&rInertia, seg, pose).block<9>(0).transform(pose.block<9>(0).transpose());
+    // NOTE: The tensor of inertia is not attached to a temporary node. Thus, this function does not modify the tree and can be used concurrently.
+    auto path = seg->retrievePath(relbsip);
+    if (path.empty())
+      return math::Array<9>();
+    math::Pose mot(1);
+    mot.residuals().setZero();
+    mot.values().setZero();
+    std::copy_n(relbsip->inertia(), 9, mot.values().data());
+    _ma_body_compose_relative_frames(mot, path, path.size()-1);
+    const math::Pose temp = pose.transform(mot.replicate(pose.rows()));
+    return temp.block<9>(0).transform(pose.block<9>(0).transpose());
   };
   
   /**
@@ -225,8 +254,16 @@ namespace body
    */
   math::Position transform_relative_com(InertialParameters* relbsip, const Segment* seg, const math::Pose& pose) _OPENMA_NOEXCEPT
   {
-    Point rCoM("rCoM", relbsip->centerOfMass(), relbsip);
-    return transform_relative_point(&rCoM, seg, pose);
+    // NOTE: The centre of mass is not attached to a temporary node. Thus, this function does not modify the tree and can be used concurrently.
+    auto path = seg->retrievePath(relbsip);
+    if (path.empty())
+      return math::Position();
+    math::Position traj(1);
+    traj.residuals().setZero();
+    std::copy_n(relbsip->centerOfMass(), 3, traj.values().data());
+    _ma_body_compose_relative_frames(traj, path, path.size()-1);
+    math::Position temp = pose.transform(traj.replicate(pose.rows()));
+    return temp;
   };
 };
 };
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "benchmark.h"
+
+#include <openma/body.h>
+#include <openma/math.h>
+
+// Benchmarks of the body module on long trials:
+//  - Calibration and reconstruction of the Plug-in Gait model (full body)
+//  - Pose estimation of marker clusters with the UnitQuaternionPoseEstimator (four segments with five markers)
+//  - Inverse dynamics of a lower limb with the InverseDynamicMatrix processor
+// The models created by the previous repetition are removed (not timed) before each repetition.
+
+// Static configuration of the markers used by the Plug-in Gait model (mm)
+const std::vector<std::string> pig_labels = {
+  "LFHD", "RFHD", "LBHD", "RBHD", "C7", "T10", "CLAV", "STRN", "RBAK", "LSHO", "LELB", "LWRA", "LWRB", "LFIN", "RSHO", "RELB", "RWRA", "RWRB",
+  "RFIN", "LASI", "RASI", "LPSI", "RPSI", "LTHI", "LKNE", "LTIB", "LANK", "LHEE", "LTOE", "RTHI", "RKNE", "RTIB", "RANK", "RHEE", "RTOE"
+};
+const std::vector<double> pig_positions = {
+    -9.31614,  98.4004,  1708.82,   -102.067,  106.608,  1699.85,     49.114,  239.001,  1690.48,   -135.49,   225.241,  1693.51,
+   -32.101,   305.965,  1537.99,     -29.3063, 366.065,  1234.47,    -32.0801, 178.05,   1439.51,    -31.3109, 151.538,  1255.23,
+  -159.875,   376.101,  1392.9,      116.273,  272.807,  1522.31,    404.687,  305.708,  1368.27,    650.832,  197.08,   1269.59,
+   656.977,   268.677,  1239.92,     729.127,  233.285,  1265.93,   -188.522,  275.133,  1500.63,   -461.85,   334.356,  1340.68,
+  -716.922,   233.089,  1246.88,    -723.836,  310.492,  1227.42,   -800.992,  267.995,  1219.17,     77.72,   174.99,   1020.48,
+  -150.94,    176.197,  1024.18,      12.6587, 353.036,  1038.09,    -85.5816, 354.41,   1038.36,    186.926,  279.299,   639.768,
+   136.557,   295.284,   521.505,    188.745,  341.687,   303.991,   137.672,  345.958,    77.651,     92.4398, 367.748,    46.3688,
+   149.798,   172.335,    40.6635,  -240.644,  259.205,   620.718,  -185.973,  264.585,   506.987,   -240.693,  325.189,   314.01,
+  -157.429,   333.84,     72.7816,   -99.1657, 381.434,    41.7802, -150.393,  177.695,    39.8623
+};
+
+// Skeleton helper with four segments tracked by clusters of markers (the pose of the segments is only set for the registration)
+class ClustersHelper : public ma::body::SkeletonHelper
+{
+public:
+  ClustersHelper() : ma::body::SkeletonHelper("ClustersHelper") {};
+  virtual bool calibrate(ma::Node* , ma::Subject* ) override {return true;};
+  virtual ma::body::LandmarksTranslator* defaultLandmarksTranslator() override {return nullptr;};
+  virtual ma::body::PoseEstimator* defaultPoseEstimator() override {return new ma::body::SkeletonHelperPoseEstimator("ClustersHelperPoseEstimator",this);};
+  virtual ma::body::InertialParametersEstimator* defaultInertialParametersEstimator() override {return nullptr;};
+  virtual ma::body::ExternalWrenchAssigner* defaultExternalWrenchAssigner() override {return nullptr;};
+  virtual ma::body::InverseDynamicProcessor* defaultInverseDynamicProcessor() override {return nullptr;};
+  static const std::vector<std::string> Segments;
+protected:
+  virtual bool setupModel(ma::body::Model* model) const override
+  {
+    for (const auto& name : Segments)
+    {
+      auto seg = new ma::body::Segment(name, ma::body::Part::User, ma::body::Side::Center, model->segments());
+      std::vector<std::string> markers;
+      for (unsigned i = 0 ; i < 5 ; ++i)
+        markers.push_back(name + std::to_string(i));
+      new ma::body::LandmarksRegistrar(name + ".Cluster", markers, seg);
+    }
+    return true;
+  };
+  virtual bool reconstructModel(ma::body::Model* model, ma::Trial* ) override
+  {
+    for (const auto& name : Segments)
+    {
+      auto pose = new ma::TimeSequence(name + ".SCS", 13, 1, 100.0, 0.0, ma::TimeSequence::Pose, "", model->segments()->findChild<ma::body::Segment*>(name));
+      const double identity[13] = {1.,0.,0., 0.,1.,0., 0.,0.,1., 0.,0.,0., 0.};
+      std::copy_n(identity, 13, pose->data());
+    }
+    return true;
+  };
+};
+
+const std::vector<std::string> ClustersHelper::Segments = {"LTH", "RTH", "LSH", "RSH"};
+
+// Right lower limb (foot, shank, thigh, pelvis) with inertial parameters and an external wrench applied on the foot
+ma::body::Model* generate_lower_limb_model(ma::Node* root, unsigned samples, double rate)
+{
+  auto model = new ma::body::Model("LowerLimb", root);
+  const double g[3] = {0., 0., -9810.};
+  model->setGravity(g); // mm.s^-2
+  const char* names[4] = {"R.Foot", "R.Shank", "R.Thigh", "Pelvis"};
+  const int parts[4] = {ma::body::Part::Foot, ma::body::Part::Shank, ma::body::Part::Thigh, ma::body::Part::Pelvis};
+  const double masses[4] = {1.08, 4.32, 11.07, 12.78};
+  const double relcom[4][3] = {{54.0526, -21.3663, 3.6790}, {-22.1367, -189.084, 3.2283}, {-18.622, -194.846, 14.988}, {2.5438, -25.43787, -0.54510}};
+  const double relinertia[4][9] = {
+    {6.24925470579212e+02, 0., 0., 0., 2.96028709073682e+03, 0., 0., 0., 2.80243394418913e+03},
+    {7.20347164309006e+04, 0., 0., 0., 9.18810158557406e+03, 0., 0., 0., 7.20347164309006e+04},
+    {1.92048657677671e+05, 0., 0., 0., 5.13804375475340e+04, 0., 0., 0., 2.05521750190136e+05},
+    {1.07601694913786e+05, 0., 0., 0., 1.18519031864651e+05, 0., 0., 0., 9.51970685812099e+04}
+  };
+  const double heights[4] = {80., 480., 900., 1000.};
+  ma::body::Segment* segments[4];
+  for (unsigned s = 0 ; s < 4 ; ++s)
+  {
+    segments[s] = new ma::body::Segment(names[s], parts[s], (s == 3) ? ma::body::Side::Center : ma::body::Side::Right, model->segments());
+    new ma::body::InertialParameters(std::string(names[s]) + ".BSIP", masses[s], relcom[s], relinertia[s], segments[s]);
+    // Walking motion with a flexion/extension of the segment around the medio-lateral axis
+    auto scs = new ma::TimeSequence(std::string(names[s]) + ".SCS", 13, samples, rate, 0.0, ma::TimeSequence::Pose, "", segments[s]);
+    double* data = scs->data();
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      const double t = static_cast<double>(i) / rate;
+      const double a = 0.4 * std::sin(2.0 * M_PI * t + 0.5 * s), c = std::cos(a), n = std::sin(a);
+      const double values[13] = {c, 0., -n, 0., 1., 0., n, 0., c, 1200.0 * t + 100.0 * n, 0., heights[s] + 10.0 * c, 0.};
+      for (unsigned j = 0 ; j < 13 ; ++j)
+        data[i + j * samples] = values[j];
+    }
+  }
+  auto ankle = new ma::body::Joint("R.Ankle", segments[1], ma::body::Anchor::origin(segments[0]), segments[0], model->joints());
+  auto knee = new ma::body::Joint("R.Knee", segments[2], ma::body::Anchor::origin(segments[1]), segments[1], model->joints());
+  auto hip = new ma::body::Joint("R.Hip", segments[3], ma::body::Anchor::origin(segments[2]), segments[2], model->joints());
+  new ma::body::Chain("R.LowerLimb", {{hip, knee, ankle}}, model->chains());
+  auto wrench = new ma::TimeSequence("FP", 10, samples, rate, 0.0, ma::TimeSequence::Wrench, "", segments[0]);
+  for (unsigned i = 0 ; i < samples ; ++i)
+  {
+    const double t = static_cast<double>(i % static_cast<unsigned>(rate)) / rate;
+    const double stance = (t < 0.6) ? std::sin(M_PI * t / 0.6) : 0.0;
+    const double values[10] = {50. * stance, 10. * stance, 700. * stance, 0., 0., 1000. * stance, 1200.0 * i / rate, 0., 0., 0.};
+    for (unsigned j = 0 ; j < 10 ; ++j)
+      wrench->data()[i + j * samples] = values[j];
+  }
+  return model;
+};
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("body", argc, argv);
+  const unsigned samples = bench.samples();
+  const double rate = 100.0;
+
+  // Plug-in Gait
+  ma::body::PluginGait pig(ma::body::Region::Full, ma::body::Side::Both);
+  pig.setMarkerDiameter(16.0); // mm
+  pig.setHeadOffsetEnabled(true);
+  pig.setLeftFootFlatEnabled(true);
+  pig.setLeftLegLength(940.0); // mm
+  pig.setLeftKneeWidth(110.0); // mm
+  pig.setLeftAnkleWidth(70.0); // mm
+  pig.setRightFootFlatEnabled(true);
+  pig.setRightLegLength(940.0); // mm
+  pig.setRightKneeWidth(120.0); // mm
+  pig.setRightAnkleWidth(70.0); // mm
+  pig.setLeftShoulderOffset(50.0); // mm
+  pig.setRightShoulderOffset(50.0); // mm
+  pig.setLeftElbowWidth(80.0); // mm
+  pig.setRightElbowWidth(80.0); // mm
+  pig.setLeftWristWidth(40.0); // mm
+  pig.setRightWristWidth(40.0); // mm
+  pig.setLeftHandThickness(30.0); // mm
+  pig.setRightHandThickness(30.0); // mm
+  const unsigned staticSamples = 200;
+  ma::Node pigStatic("pigStatic"), pigDynamic("pigDynamic"), pigModels("pigModels");
+  ma::benchmark::generate_markers(new ma::Trial("static", &pigStatic), pig_labels, pig_positions, staticSamples, rate);
+  ma::benchmark::generate_markers(new ma::Trial("dynamic", &pigDynamic), pig_labels, pig_positions, samples, rate);
+  bench.run("plugingait.calibrate", staticSamples, [&]() {
+    if (!pig.calibrate(&pigStatic, nullptr))
+      std::fprintf(stderr, "plugingait.calibrate: failure\n");
+  });
+  bench.run("plugingait.reconstruct", samples, [&]() {pigModels.clear();}, [&]() {
+    if (!pig.reconstruct(&pigModels, &pigDynamic))
+      std::fprintf(stderr, "plugingait.reconstruct: failure\n");
+  });
+
+  // Unit quaternion pose estimator (clusters of five markers)
+  std::vector<std::string> clusterLabels;
+  std::vector<double> clusterPositions;
+  ma::benchmark::Random rnd(3u);
+  for (size_t s = 0 ; s < ClustersHelper::Segments.size() ; ++s)
+  {
+    for (unsigned i = 0 ; i < 5 ; ++i)
+    {
+      clusterLabels.push_back(ClustersHelper::Segments[s] + std::to_string(i));
+      clusterPositions.push_back((s % 2 ? -150. : 150.) + rnd(-40., 40.));
+      clusterPositions.push_back(rnd(-40., 40.));
+      clusterPositions.push_back((s < 2 ? 650. : 300.) + rnd(-40., 40.));
+    }
+  }
+  ClustersHelper clusters;
+  ma::Node clustersStatic("clustersStatic"), clustersDynamic("clustersDynamic"), clustersModels("clustersModels");
+  ma::benchmark::generate_markers(new ma::Trial("static", &clustersStatic), clusterLabels, clusterPositions, 1, rate, 0.0);
+  ma::benchmark::generate_markers(new ma::Trial("dynamic", &clustersDynamic), clusterLabels, clusterPositions, samples, rate);
+  if (!ma::body::register_marker_cluster(&clusters, &clustersStatic))
+    std::fprintf(stderr, "unitquaternionposeestimator: registration failure\n");
+  bench.run("unitquaternionposeestimator.reconstruct", samples, [&]() {clustersModels.clear();}, [&]() {
+    if (!ma::body::reconstruct(&clustersModels, &clusters, &clustersDynamic))
+      std::fprintf(stderr, "unitquaternionposeestimator.reconstruct: failure\n");
+  });
+
+  // Inverse dynamics
+  ma::Node dynamics("dynamics");
+  generate_lower_limb_model(&dynamics, samples, rate);
+  ma::body::InverseDynamicMatrix dyninv;
+  bench.run("inversedynamicsmatrix.run", samples, [&]() {
+    dyninv.run(&dynamics);
+  });
+  ma::body::InverseDynamicMatrix dyninvpar;
+  dyninvpar.setThreads(4);
+  bench.run("inversedynamicsmatrix.run.threads4", samples, [&]() {
+    dyninvpar.run(&dynamics);
+  });
+
+  return bench.report();
+};
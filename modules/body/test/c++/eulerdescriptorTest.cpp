@@ -1,6 +1,28 @@
 #include <cxxtest/TestDrive.h>
 
 #include <openma/body/eulerdescriptor.h>
+#include <openma/body/joint.h>
+#include <openma/body/segment.h>
+#include <openma/base/timesequence.h>
+
+#include <cmath>
+
+void eulerdescriptor_generate_rotation_about_x(ma::body::Segment* seg, const std::vector<double>& angles)
+{
+  const unsigned samples = static_cast<unsigned>(angles.size());
+  auto ts = new ma::TimeSequence(seg->name()+".SCS", 13, samples, 100.0, 0.0, ma::TimeSequence::Pose, "", seg);
+  auto data = ts->data();
+  for (unsigned i = 0 ; i < 13*samples ; ++i)
+    data[i] = 0.0;
+  for (unsigned i = 0 ; i < samples ; ++i)
+  {
+    data[i] = 1.0;
+    data[4*samples+i] = std::cos(angles[i]);
+    data[5*samples+i] = std::sin(angles[i]);
+    data[7*samples+i] = -std::sin(angles[i]);
+    data[8*samples+i] = std::cos(angles[i]);
+  }
+};
 
 CXXTEST_SUITE(EulerDescriptorTest)
 {
@@ -24,6 +46,81 @@ CXXTEST_SUITE(EulerDescriptorTest)
     TS_WARN("TODO");
   }
   
+  CXXTEST_TEST(batchEvaluation)
+  {
+    const unsigned samples = 250;
+    std::vector<double> proximalAngles(samples), distalAngles(samples), otherAngles(samples);
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      proximalAngles[i] = 0.001 * i;
+      distalAngles[i] = 0.004 * i;
+      otherAngles[i] = -0.002 * i;
+    }
+    ma::Node root("root");
+    auto a = new ma::body::Segment("A", 0, 0, &root);
+    auto b = new ma::body::Segment("B", 0, 0, &root);
+    auto c = new ma::body::Segment("C", 0, 0, &root);
+    eulerdescriptor_generate_rotation_about_x(a, proximalAngles);
+    eulerdescriptor_generate_rotation_about_x(b, distalAngles);
+    eulerdescriptor_generate_rotation_about_x(c, otherAngles);
+    auto ab = new ma::body::Joint("AB", a, b, &root);
+    auto bc = new ma::body::Joint("BC", b, c, &root);
+    auto global = new ma::body::Joint("Global", nullptr, c, &root);
+    std::vector<ma::body::Descriptor*> descriptors{
+      new ma::body::EulerDescriptor("AB.XYZ", ma::body::EulerDescriptor::XYZ, ab),
+      new ma::body::EulerDescriptor("AB.ZXZ", ma::body::EulerDescriptor::ZXZ, ab),
+      new ma::body::EulerDescriptor("BC.YXZ", ma::body::EulerDescriptor::YXZ, {{-1.,1.,1.}}, bc),
+      new ma::body::EulerDescriptor("Global.XYZ", ma::body::EulerDescriptor::XYZ, global),
+    };
+    std::vector<const ma::Node*> inputs{ab, ab, bc, global};
+    std::unordered_map<std::string, ma::Any> options{
+      {"suffixProximal", ".SCS"},
+      {"suffixDistal", ".SCS"},
+      {"enableDegreeConversion", true},
+      {"adaptForInterpretation", true}
+    };
+    ma::Node serial("serial"), concurrent("concurrent");
+    for (size_t i = 0 ; i < descriptors.size() ; ++i)
+      TS_ASSERT_EQUALS(descriptors[i]->evaluate(&serial, inputs[i], options), true);
+    TS_ASSERT_EQUALS(ma::body::Descriptor::evaluate(&concurrent, descriptors, inputs, options, 4), true);
+    auto serialOutputs = serial.findChildren<ma::TimeSequence*>();
+    auto concurrentOutputs = concurrent.findChildren<ma::TimeSequence*>();
+    TS_ASSERT_EQUALS(serialOutputs.size(), descriptors.size());
+    TS_ASSERT_EQUALS(concurrentOutputs.size(), descriptors.size());
+    for (size_t i = 0 ; i < std::min(serialOutputs.size(), concurrentOutputs.size()) ; ++i)
+    {
+      TS_ASSERT_EQUALS(serialOutputs[i]->name(), descriptors[i]->name());
+      TS_ASSERT_EQUALS(concurrentOutputs[i]->name(), descriptors[i]->name());
+      TS_ASSERT_EQUALS(concurrentOutputs[i]->unit(), std::string("deg"));
+      TS_ASSERT_EQUALS(std::equal(serialOutputs[i]->data(), serialOutputs[i]->data() + 4*samples, concurrentOutputs[i]->data()), true);
+    }
+    // Relative rotation about the X axis
+    auto angles = concurrent.findChild<ma::TimeSequence*>("AB.XYZ");
+    TS_ASSERT(angles != nullptr);
+    if (angles == nullptr) return;
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      TS_ASSERT_DELTA(angles->data()[i], (distalAngles[i] - proximalAngles[i]) * 180.0 / M_PI, 1e-10);
+      TS_ASSERT_DELTA(angles->data()[samples+i], 0.0, 1e-10);
+      TS_ASSERT_DELTA(angles->data()[2*samples+i], 0.0, 1e-10);
+    }
+  };
+  
+  CXXTEST_TEST(batchEvaluationFailure)
+  {
+    ma::Node root("root");
+    auto a = new ma::body::Segment("A", 0, 0, &root);
+    auto b = new ma::body::Segment("B", 0, 0, &root);
+    eulerdescriptor_generate_rotation_about_x(a, {0.0, 0.1});
+    auto ab = new ma::body::Joint("AB", a, b, &root);
+    std::vector<ma::body::Descriptor*> descriptors{new ma::body::EulerDescriptor("AB.XYZ", ma::body::EulerDescriptor::XYZ, ab)};
+    std::vector<const ma::Node*> inputs{ab};
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(ma::body::Descriptor::evaluate(&output, descriptors, inputs, {{"suffixProximal", ".SCS"},{"suffixDistal", ".SCS"}}, 2), false);
+    TS_ASSERT_EQUALS(output.children().size(), 0ul);
+    TS_ASSERT_EQUALS(ma::body::Descriptor::evaluate(&output, descriptors, {}, {}, 2), false);
+  };
+  
   CXXTEST_TEST(clone)
   {
     TS_WARN("Implement the method ma::body::EulerDescriptor::clone()");
@@ -40,5 +137,7 @@ CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, processConstructorOne)
 CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, processConstructorTwo)
 CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, processConstructorThree)
 CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, configure)
+CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, batchEvaluation)
+CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, batchEvaluationFailure)
 CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, clone)
 CXXTEST_TEST_REGISTRATION(EulerDescriptorTest, copy)
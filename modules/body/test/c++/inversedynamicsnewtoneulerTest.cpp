@@ -0,0 +1,143 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/body/inversedynamicsnewtoneuler.h>
+#include <openma/body/inversedynamicsmatrix.h>
+#include <openma/body/plugingait.h>
+#include <openma/math.h>
+
+#include "inversedynamicsTest_def.h"
+
+void dyninv_compare_outputs(ma::Node* ref, ma::Node* res, const std::string& name)
+{
+  auto tsref = ref->findChild<const ma::TimeSequence*>(name);
+  auto tsres = res->findChild<const ma::TimeSequence*>(name);
+  TSM_ASSERT_DIFFERS(name, tsref, nullptr);
+  TSM_ASSERT_DIFFERS(name, tsres, nullptr);
+  if ((tsref == nullptr) || (tsres == nullptr))
+    return;
+  TSM_ASSERT_EQUALS(name, tsres->samples(), tsref->samples());
+  TSM_ASSERT_EQUALS(name, tsres->components(), tsref->components());
+  TSM_ASSERT_EQUALS(name, tsres->type(), tsref->type());
+  TSM_ASSERT_EQUALS(name, tsres->unit(), tsref->unit());
+  for (size_t i = 0 ; i < tsref->elements() ; ++i)
+    TSM_ASSERT_DELTA(name + " #" + std::to_string(i), tsres->data()[i], tsref->data()[i], 1e-8 * std::max(1.0, std::fabs(tsref->data()[i])));
+}
+
+CXXTEST_SUITE(InverseDynamicNewtonEulerTest)
+{
+  CXXTEST_TEST(gait)
+  {
+    ma::Node rootref("Root");
+    auto modelref = dyninv_generate_gait_model(&rootref);
+    ma::body::InverseDynamicMatrix dyninvref;
+    TS_ASSERT_EQUALS(dyninvref.run(&rootref), true);
+    
+    ma::Node root("Root");
+    auto model = dyninv_generate_gait_model(&root);
+    ma::body::InverseDynamicNewtonEuler dyninv;
+    TS_ASSERT_EQUALS(dyninv.run(&root), true);
+    
+    for (const auto& name : {"R.Ankle.Force","R.Ankle.Moment","R.Knee.Force","R.Knee.Moment","R.Hip.Force","R.Hip.Moment"})
+      dyninv_compare_outputs(modelref->joints(), model->joints(), name);
+    for (const auto& name : {"R.Foot.SCS.Omega","R.Shank.SCS.Omega","R.Thigh.SCS.Omega"})
+      dyninv_compare_outputs(modelref->segments(), model->segments(), name);
+  };
+  
+  CXXTEST_TEST(occlusion)
+  {
+    ma::Node rootref("Root");
+    auto modelref = dyninv_generate_gait_model(&rootref);
+    ma::Node root("Root");
+    auto model = dyninv_generate_gait_model(&root);
+    // Occluded shank pose in the middle of the trial
+    for (auto m : {modelref, model})
+    {
+      auto shank = m->segments()->findChild<ma::TimeSequence*>("R.Shank.SCS");
+      TS_ASSERT_DIFFERS(shank, nullptr);
+      shank->data()[12 * shank->samples() + 5] = -1.0;
+    }
+    ma::body::InverseDynamicMatrix dyninvref;
+    dyninvref.run(&rootref);
+    ma::body::InverseDynamicNewtonEuler dyninv;
+    dyninv.run(&root);
+    for (const auto& name : {"R.Ankle.Force","R.Ankle.Moment","R.Knee.Force","R.Knee.Moment","R.Hip.Force","R.Hip.Moment"})
+      dyninv_compare_outputs(modelref->joints(), model->joints(), name);
+    for (const auto& name : {"R.Foot.SCS.Omega","R.Shank.SCS.Omega","R.Thigh.SCS.Omega"})
+      dyninv_compare_outputs(modelref->segments(), model->segments(), name);
+    auto knee = model->joints()->findChild<const ma::TimeSequence*>("R.Knee.Moment");
+    TS_ASSERT_EQUALS(knee->data()[3 * knee->samples() + 5], -1.0);
+  };
+  
+  CXXTEST_TEST(stride)
+  {
+    ma::Node rootref("Root");
+    auto modelref = dyninv_generate_gait_model(&rootref);
+    ma::body::InverseDynamicMatrix dyninvref;
+    TS_ASSERT_EQUALS(dyninvref.run(&rootref), true);
+    
+    ma::Node root("Root");
+    auto model = dyninv_generate_gait_model(&root);
+    // The columns of the inputs are not contiguous anymore
+    for (auto ts : root.findChildren<ma::TimeSequence*>())
+    {
+      ts->reserve(ts->samples() + 7);
+      TS_ASSERT_DIFFERS(ts->stride(), ts->samples());
+    }
+    ma::body::InverseDynamicNewtonEuler dyninv;
+    TS_ASSERT_EQUALS(dyninv.run(&root), true);
+    
+    for (const auto& name : {"R.Ankle.Force","R.Ankle.Moment","R.Knee.Force","R.Knee.Moment","R.Hip.Force","R.Hip.Moment"})
+      dyninv_compare_outputs(modelref->joints(), model->joints(), name);
+    for (const auto& name : {"R.Foot.SCS.Omega","R.Shank.SCS.Omega","R.Thigh.SCS.Omega"})
+      dyninv_compare_outputs(modelref->segments(), model->segments(), name);
+  };
+  
+  CXXTEST_TEST(compactStorage)
+  {
+    // The compact elements are widened, the results are the same than with double values rounded to single precision
+    ma::Node root("Root"), rootref("Root");
+    auto model = dyninv_generate_gait_model(&root);
+    auto modelref = dyninv_generate_gait_model(&rootref);
+    for (const auto& name : {"R.Foot.SCS","R.Shank.SCS","R.Thigh.SCS","Pelvis.SCS","FP"})
+    {
+      auto ts = model->segments()->findChild<ma::TimeSequence*>(name);
+      auto tsref = modelref->segments()->findChild<ma::TimeSequence*>(name);
+      TSM_ASSERT_DIFFERS(name, ts, nullptr);
+      TSM_ASSERT_DIFFERS(name, tsref, nullptr);
+      ts->setStorage(ma::TimeSequence::Storage::Float);
+      tsref->setStorage(ma::TimeSequence::Storage::Float);
+      tsref->setStorage(ma::TimeSequence::Storage::Double);
+    }
+    ma::body::InverseDynamicNewtonEuler dyninv;
+    TS_ASSERT_EQUALS(dyninv.run(&root), true);
+    TS_ASSERT_EQUALS(dyninv.run(&rootref), true);
+    for (const auto& name : {"R.Ankle.Force","R.Ankle.Moment","R.Knee.Force","R.Knee.Moment","R.Hip.Force","R.Hip.Moment"})
+      dyninv_compare_outputs(modelref->joints(), model->joints(), name);
+    ma::body::InverseDynamicMatrix dyninvmat;
+    TS_ASSERT_EQUALS(dyninvmat.run(&root), true);
+    TS_ASSERT_EQUALS(dyninvmat.run(&rootref), true);
+    for (const auto& name : {"R.Ankle.Force","R.Ankle.Moment","R.Knee.Force","R.Knee.Moment","R.Hip.Force","R.Hip.Moment"})
+      dyninv_compare_outputs(modelref->joints(), model->joints(), name);
+    for (const auto& name : {"R.Foot.SCS.Omega","R.Shank.SCS.Omega","R.Thigh.SCS.Omega"})
+      dyninv_compare_outputs(modelref->segments(), model->segments(), name);
+  };
+  
+  CXXTEST_TEST(defaultProcessor)
+  {
+    ma::body::PluginGait helper(ma::body::Region::Lower, ma::body::Side::Both);
+    TS_ASSERT_EQUALS(helper.inverseDynamicMethod(), ma::body::InverseDynamicMethod::Matrix);
+    auto idp = helper.defaultInverseDynamicProcessor();
+    TS_ASSERT_DIFFERS(ma::node_cast<ma::body::InverseDynamicMatrix*>(idp), nullptr);
+    helper.setProperty("inverseDynamicMethod", ma::body::InverseDynamicMethod::NewtonEuler);
+    TS_ASSERT_EQUALS(helper.inverseDynamicMethod(), ma::body::InverseDynamicMethod::NewtonEuler);
+    idp = helper.defaultInverseDynamicProcessor();
+    TS_ASSERT_DIFFERS(ma::node_cast<ma::body::InverseDynamicNewtonEuler*>(idp), nullptr);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(InverseDynamicNewtonEulerTest)
+CXXTEST_TEST_REGISTRATION(InverseDynamicNewtonEulerTest, gait)
+CXXTEST_TEST_REGISTRATION(InverseDynamicNewtonEulerTest, occlusion)
+CXXTEST_TEST_REGISTRATION(InverseDynamicNewtonEulerTest, stride)
+CXXTEST_TEST_REGISTRATION(InverseDynamicNewtonEulerTest, compactStorage)
+CXXTEST_TEST_REGISTRATION(InverseDynamicNewtonEulerTest, defaultProcessor)
@@ -50,6 +50,44 @@ CXXTEST_SUITE(LandmarksRegistrarTest)
     TS_ASSERT_EQUALS(lmks[3],tss[3]);
   };
   
+  CXXTEST_TEST(retrieveLandmarksSameLayout)
+  {
+    ma::body::LandmarksRegistrar reg("reg",{"pt1","pt2","pt3","pt4"});
+    ma::body::LandmarksTranslator lt("lt",{
+      {"uname*1", "pt1"},
+      {"uname*2", "pt2"},
+      {"uname*4", "pt4"}
+    });
+    ma::Node trial1("trial1"), trial2("trial2");
+    auto tss1 = ma::make_nodes<ma::TimeSequence*>(4,4,0,100.0,0.0,ma::TimeSequence::Position,"mm",&trial1);
+    auto tss2 = ma::make_nodes<ma::TimeSequence*>(4,4,0,100.0,0.0,ma::TimeSequence::Position,"mm",&trial2);
+    auto lmks = reg.retrieveLandmarks(&lt,&trial1);
+    TS_ASSERT_EQUALS(lmks.size(),3u);
+    TS_ASSERT_EQUALS(lmks[0],tss1[0]);
+    TS_ASSERT_EQUALS(lmks[1],tss1[1]);
+    TS_ASSERT_EQUALS(lmks[2],tss1[3]);
+    // Same layout: the resolved labels are reused
+    lmks = reg.retrieveLandmarks(&lt,&trial2);
+    TS_ASSERT_EQUALS(lmks.size(),3u);
+    TS_ASSERT_EQUALS(lmks[0],tss2[0]);
+    TS_ASSERT_EQUALS(lmks[1],tss2[1]);
+    TS_ASSERT_EQUALS(lmks[2],tss2[3]);
+    // Different layout
+    tss2[2]->setName("uname*4");
+    tss2[3]->setName("uname*3");
+    lmks = reg.retrieveLandmarks(&lt,&trial2);
+    TS_ASSERT_EQUALS(lmks.size(),3u);
+    TS_ASSERT_EQUALS(lmks[2],tss2[2]);
+    // Different labels
+    reg.setLabels({"pt2"});
+    lmks = reg.retrieveLandmarks(&lt,&trial2);
+    TS_ASSERT_EQUALS(lmks.size(),1u);
+    TS_ASSERT_EQUALS(lmks[0],tss2[1]);
+    // Without translator
+    lmks = reg.retrieveLandmarks(nullptr,&trial2);
+    TS_ASSERT_EQUALS(lmks.size(),0u);
+  };
+  
   CXXTEST_TEST(clone)
   {
     ma::Node root("root");
@@ -85,5 +123,6 @@ CXXTEST_SUITE_REGISTRATION(LandmarksRegistrarTest)
 CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, getset)
 CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, retrieveLandmarks)
 CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, retrieveLandmarksBis)
+CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, retrieveLandmarksSameLayout)
 CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, clone)
 CXXTEST_TEST_REGISTRATION(LandmarksRegistrarTest, copy)
\ No newline at end of file
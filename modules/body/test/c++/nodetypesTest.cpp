@@ -0,0 +1,66 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/body.h>
+#include <openma/base/nodefactory.h>
+#include <openma/io.h>
+
+#include "test_file_path.h"
+
+CXXTEST_SUITE(NodeTypesTest)
+{
+  CXXTEST_TEST(registration)
+  {
+    ma::body::register_node_types();
+    TS_ASSERT_EQUALS(ma::body::register_node_types(), false);
+    TS_ASSERT_DIFFERS(ma::find_node_type("Joint").Create, nullptr);
+    ma::body::Segment segment("seg");
+    TS_ASSERT_EQUALS(ma::find_node_type(&segment).Tag, "Segment");
+    ma::Node node("node");
+    TS_ASSERT_EQUALS(ma::find_node_type(&node).Create, nullptr);
+  };
+  
+  CXXTEST_TEST(omaRoundTrip)
+  {
+    ma::body::register_node_types();
+    ma::Node root("root");
+    auto model = new ma::body::Model("Model", &root);
+    auto thigh = new ma::body::Segment("L.Thigh", ma::body::Part::Thigh, ma::body::Side::Left, model->segments());
+    auto shank = new ma::body::Segment("L.Shank", ma::body::Part::Shank, ma::body::Side::Left, model->segments());
+    new ma::body::Joint("L.Knee", thigh, shank, model->joints());
+    TS_ASSERT_EQUALS(ma::io::write(&root, OPENMA_TDD_PATH_OUT("oma/body_model.oma")), true);
+    
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(ma::io::read(&output, OPENMA_TDD_PATH_OUT("oma/body_model.oma")), true);
+    auto m = output.child<ma::body::Model*>(0);
+    TS_ASSERT_DIFFERS(m, nullptr);
+    if (m == nullptr) return;
+    TS_ASSERT_EQUALS(m->name(), "Model");
+    TS_ASSERT_EQUALS(m->segments()->children().size(), 2ul);
+    auto s1 = m->segment(0);
+    auto s2 = m->segment(1);
+    TS_ASSERT_DIFFERS(s1, nullptr);
+    TS_ASSERT_DIFFERS(s2, nullptr);
+    if ((s1 == nullptr) || (s2 == nullptr)) return;
+    TS_ASSERT_EQUALS(s1->name(), "L.Thigh");
+    TS_ASSERT_EQUALS(s1->part(), ma::body::Part::Thigh);
+    TS_ASSERT_EQUALS(s1->side(), ma::body::Side::Left);
+    TS_ASSERT_EQUALS(s2->name(), "L.Shank");
+    TS_ASSERT_EQUALS(s2->part(), ma::body::Part::Shank);
+    auto j = m->joint(0);
+    TS_ASSERT_DIFFERS(j, nullptr);
+    if (j == nullptr) return;
+    TS_ASSERT_EQUALS(j->name(), "L.Knee");
+    TS_ASSERT_EQUALS(j->proximalSegment(), s1);
+    TS_ASSERT_EQUALS(j->distalSegment(), s2);
+    TS_ASSERT_DIFFERS(j->proximalAnchor(), nullptr);
+    TS_ASSERT_DIFFERS(j->distalAnchor(), nullptr);
+    if ((j->proximalAnchor() == nullptr) || (j->distalAnchor() == nullptr)) return;
+    TS_ASSERT_EQUALS(j->proximalAnchor()->source(), s1);
+    TS_ASSERT_EQUALS(j->distalAnchor()->source(), s2);
+    TS_ASSERT_EQUALS(s1->parents().size(), 2ul);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(NodeTypesTest)
+CXXTEST_TEST_REGISTRATION(NodeTypesTest, registration)
+CXXTEST_TEST_REGISTRATION(NodeTypesTest, omaRoundTrip)
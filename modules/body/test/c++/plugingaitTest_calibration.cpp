@@ -330,6 +330,46 @@ CXXTEST_SUITE(PluginGaitCalibrationTest)
     TS_ASSERT_EQUALS(helper.rightStaticPlantarFlexionOffset(), 0.0);
     TS_ASSERT_EQUALS(helper.rightStaticRotationOffset(), 0.0);
   };
+  
+  CXXTEST_TEST(calibrateBothFullBodyThreads)
+  {
+    ma::body::PluginGait helper1(ma::body::Region::Full, ma::body::Side::Both);
+    TS_ASSERT_EQUALS(helper1.threads(), 1u);
+    TS_ASSERT_EQUALS(helper1.property("threads").cast<unsigned>(), 1u);
+    helper1.setMarkerDiameter(16.0); // mm
+    helper1.setHeadOffsetEnabled(true);
+    helper1.setLeftFootFlatEnabled(true);
+    helper1.setLeftLegLength(940.0); // mm
+    helper1.setLeftKneeWidth(110.0); // mm
+    helper1.setLeftAnkleWidth(70.0); // mm
+    helper1.setRightFootFlatEnabled(true);
+    helper1.setRightLegLength(940.0); // mm
+    helper1.setRightKneeWidth(120.0); // mm
+    helper1.setRightAnkleWidth(70.0); // mm
+    ma::body::PluginGait helper3(ma::body::Region::Full, ma::body::Side::Both);
+    helper3.copy(&helper1);
+    helper3.setProperty("threads", 3u);
+    TS_ASSERT_EQUALS(helper3.threads(), 3u);
+    
+    ma::Node root("root");
+    generate_static_trial_frames(&root, 200);
+    TS_ASSERT_EQUALS(helper1.calibrate(&root, nullptr), true);
+    TS_ASSERT_EQUALS(helper3.calibrate(&root, nullptr), true);
+    
+    // The tasks are independent. The results must be identical.
+    TS_ASSERT_EQUALS(helper3.interAsisDistance(), helper1.interAsisDistance());
+    TS_ASSERT_EQUALS(helper3.headOffset(), helper1.headOffset());
+    TS_ASSERT_EQUALS(helper3.property("Pelvis.length").cast<double>(), helper1.property("Pelvis.length").cast<double>());
+    TS_ASSERT_EQUALS(helper3.leftAsisTrochanterAPDistance(), helper1.leftAsisTrochanterAPDistance());
+    TS_ASSERT_EQUALS(helper3.leftStaticPlantarFlexionOffset(), helper1.leftStaticPlantarFlexionOffset());
+    TS_ASSERT_EQUALS(helper3.leftStaticRotationOffset(), helper1.leftStaticRotationOffset());
+    TS_ASSERT_EQUALS(helper3.property("L.Thigh.length").cast<double>(), helper1.property("L.Thigh.length").cast<double>());
+    TS_ASSERT_EQUALS(helper3.rightAsisTrochanterAPDistance(), helper1.rightAsisTrochanterAPDistance());
+    TS_ASSERT_EQUALS(helper3.rightStaticPlantarFlexionOffset(), helper1.rightStaticPlantarFlexionOffset());
+    TS_ASSERT_EQUALS(helper3.rightStaticRotationOffset(), helper1.rightStaticRotationOffset());
+    TS_ASSERT_EQUALS(helper3.property("R.Shank.length").cast<double>(), helper1.property("R.Shank.length").cast<double>());
+    TS_ASSERT_DIFFERS(helper1.property("L.Thigh.length").cast<double>(), 0.0);
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(PluginGaitCalibrationTest)  
@@ -344,4 +384,5 @@ CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate2BothFullBodyNoOpt
 CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate3BothLowerBodyFF)
 CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate3BothLowerBodyFF_N18)
 CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate3BothLowerBodynoFF)
-CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate2BothUpperBodyHeadOffsetDisabled)
\ No newline at end of file
+CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrate2BothUpperBodyHeadOffsetDisabled)
+CXXTEST_TEST_REGISTRATION(PluginGaitCalibrationTest, calibrateBothFullBodyThreads)
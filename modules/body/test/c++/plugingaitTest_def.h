@@ -11,6 +11,8 @@
 
 #include <openma/math.h>
 
+#include <cmath>
+
 ma::TimeSequence* make_marker(const std::string& name, double* data, ma::Trial* trial)
 {
   const unsigned samples = 1;
@@ -73,6 +75,27 @@ void generate_static_trial_oneframe(ma::Node* root)
     make_marker(labels[i], raw+i*4, trial);
 };
 
+// The markers of the previous trial are repeated over several frames with a small deterministic noise (different for each marker and coordinate).
+void generate_static_trial_frames(ma::Node* root, unsigned samples)
+{
+  ma::Node temp("temp");
+  generate_static_trial_oneframe(&temp);
+  auto source = temp.child<ma::Trial*>(0);
+  ma::Trial* trial = new ma::Trial("trial",root);
+  unsigned inc = 0;
+  for (auto marker : source->timeSequences()->findChildren<ma::TimeSequence*>())
+  {
+    auto ts = new ma::TimeSequence(marker->name(), 4, samples, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      for (unsigned j = 0 ; j < 3 ; ++j)
+        ts->data(i,j) = marker->data(0,j) + 2.0 * std::sin(0.1 * static_cast<double>(i) + static_cast<double>(3 * inc + j));
+      ts->data(i,3) = 0.0;
+    }
+    ++inc;
+  }
+};
+
 void compare_segment_motion(ma::body::Model* model, ma::Trial* trial, const std::string& frame, const std::vector<std::string>& markers, std::vector<double> precision = std::vector<double>(4,1e-5))
 {
   assert(markers.size() == 4);
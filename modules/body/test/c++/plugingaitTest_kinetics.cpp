@@ -19,6 +19,8 @@
 #include <openma/instrument/enums.h>
 #include <openma/io.h>
 
+#include <algorithm>
+
 CXXTEST_SUITE(PluginGaitKineticsTest)
 {
   CXXTEST_TEST(inverseDynamicsBothLowerBodyOneFrame)
@@ -301,8 +303,52 @@ CXXTEST_SUITE(PluginGaitKineticsTest)
 #endif
     */
   };
+  
+  CXXTEST_TEST(inverseDynamicsParallelTrials)
+  {
+    ma::body::PluginGait helper(ma::body::Region::Lower, ma::body::Side::Both);
+    helper.setGravity(std::array<double,3>{{0,0,-9.81}}); // m/s^2
+    helper.setMarkerDiameter(14.0); // mm
+    helper.setLeftLegLength(780.0); // mm
+    helper.setLeftKneeWidth(90); // mm
+    helper.setLeftAnkleWidth(70.0); // mm
+    helper.setRightLegLength(780.0); // mm
+    helper.setRightKneeWidth(95.0); // mm
+    helper.setRightAnkleWidth(70.0); // mm
+    helper.setProperty("mass",33.0); // kg
+    helper.setProperty("height", 1465.0); // mm
+    
+    ma::Node rootCalibration("rootCalibration"), rootDynamic("rootDynamic"), rootModel("rootModel"), rootModelParallel("rootModelParallel");
+    generate_trial_from_c3d_file(&rootCalibration, OPENMA_TDD_PATH_IN("c3d/plugingait/PiG_Calibration4.c3d"));
+    TS_ASSERT(helper.calibrate(&rootCalibration, nullptr));
+    for (int i = 0 ; i < 3 ; ++i)
+      generate_trial_from_c3d_file(&rootDynamic, OPENMA_TDD_PATH_IN("c3d/plugingait/PiG_Motion4_noFF_noHO.c3d"));
+    TS_ASSERT(helper.reconstruct(&rootModel, &rootDynamic));
+    TS_ASSERT(ma::body::reconstruct(&rootModelParallel, &helper, &rootDynamic, 3));
+    auto models = rootModel.findChildren<ma::body::Model*>({},{},false);
+    auto modelsParallel = rootModelParallel.findChildren<ma::body::Model*>({},{},false);
+    TS_ASSERT_EQUALS(models.size(), 3u);
+    TS_ASSERT_EQUALS(modelsParallel.size(), models.size());
+    for (size_t i = 0 ; i < std::min(models.size(), modelsParallel.size()) ; ++i)
+    {
+      TS_ASSERT_EQUALS(modelsParallel[i]->name(), models[i]->name());
+      TS_ASSERT_EQUALS(modelsParallel[i]->findChild<ma::Trial*>(), rootDynamic.child<ma::Trial*>(i));
+      auto kinetics = models[i]->joints()->findChildren<ma::TimeSequence*>({},{},true);
+      TS_ASSERT(!kinetics.empty());
+      for (const auto& ts : kinetics)
+      {
+        auto other = modelsParallel[i]->joints()->findChild<ma::TimeSequence*>(ts->name(),{{"type",ts->type()}});
+        TSM_ASSERT_DIFFERS(ts->name(), other, nullptr);
+        if (other == nullptr)
+          continue;
+        TSM_ASSERT_EQUALS(ts->name(), other->elements(), ts->elements());
+        TSM_ASSERT(ts->name(), std::equal(ts->data(), ts->data() + ts->elements(), other->data()));
+      }
+    }
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(PluginGaitKineticsTest)
 CXXTEST_TEST_REGISTRATION(PluginGaitKineticsTest, inverseDynamicsBothLowerBodyOneFrame)
-CXXTEST_TEST_REGISTRATION(PluginGaitKineticsTest, inverseDynamicsBothLowerBodyFullFramesHeadOffsetDisabled)
\ No newline at end of file
+CXXTEST_TEST_REGISTRATION(PluginGaitKineticsTest, inverseDynamicsBothLowerBodyFullFramesHeadOffsetDisabled)
+CXXTEST_TEST_REGISTRATION(PluginGaitKineticsTest, inverseDynamicsParallelTrials)
\ No newline at end of file
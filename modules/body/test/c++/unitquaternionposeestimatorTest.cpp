@@ -123,6 +123,76 @@ CXXTEST_SUITE(UnitQuaternionPoseEstimatorTest)
     TS_ASSERT_DELTA(cube_tcs->data()[2*11+1],  5.0, 1e-15);
   };
   
+  CXXTEST_TEST(cubeBindingInvalidated)
+  {
+    ma::Node rootCalibration("rootCalibration");
+    ma::Trial trialCalibration("trialCalibration",&rootCalibration);
+    auto tsscal = ma::make_nodes<ma::TimeSequence*>(8,4,1,100.0,0.0,ma::TimeSequence::Position,"mm",trialCalibration.timeSequences());
+    set_pt_data(tsscal[0], 10.0, 10.0, 10.0);
+    set_pt_data(tsscal[1], 10.0, 20.0, 10.0);
+    set_pt_data(tsscal[2], 20.0, 20.0, 10.0);
+    set_pt_data(tsscal[3], 20.0, 10.0, 10.0);
+    set_pt_data(tsscal[4], 10.0, 10.0,  0.0);
+    set_pt_data(tsscal[5], 10.0, 20.0,  0.0);
+    set_pt_data(tsscal[6], 20.0, 20.0,  0.0);
+    set_pt_data(tsscal[7], 20.0, 10.0,  0.0);
+    // Translated by 10 mm along the axis X
+    ma::Node rootDynamic("rootDynamic");
+    ma::Trial trialDynamic("trialDynamic",&rootDynamic);
+    auto tssdyn = ma::make_nodes<ma::TimeSequence*>(8,4,1,100.0,0.0,ma::TimeSequence::Position,"mm",trialDynamic.timeSequences());
+    for (size_t i = 0 ; i < 8 ; ++i)
+      set_pt_data(tssdyn[i], tsscal[i]->data()[0] + 10.0, tsscal[i]->data()[1], tsscal[i]->data()[2]);
+    CubeHelper helper;
+    TS_ASSERT_EQUALS(ma::body::register_marker_cluster(&helper,&rootCalibration), true);
+    auto mcr = helper.findChild("MarkerClusterRegistration",{},false);
+    TS_ASSERT_DIFFERS(mcr, nullptr);
+    // First reconstruction: the binding is created
+    ma::Node models1("models1");
+    TS_ASSERT_EQUALS(ma::body::reconstruct(&models1,&helper,&rootDynamic), true);
+    auto cube_tcs = models1.findChild<ma::TimeSequence*>("Cube.TCS");
+    TS_ASSERT_DIFFERS(cube_tcs, nullptr);
+    TS_ASSERT_DELTA(cube_tcs->data()[0],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[4],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[8],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[9],  25.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[10], 15.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[11], 5.0,  1e-12);
+    // Different landmark names: the first marker is missing. Reusing the previous binding would associate the wrong local markers.
+    tssdyn[0]->setName("Unknown");
+    ma::Node models2("models2");
+    TS_ASSERT_EQUALS(ma::body::reconstruct(&models2,&helper,&rootDynamic), true);
+    cube_tcs = models2.findChild<ma::TimeSequence*>("Cube.TCS");
+    TS_ASSERT_DIFFERS(cube_tcs, nullptr);
+    TS_ASSERT_DELTA(cube_tcs->data()[0],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[4],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[8],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[9],  25.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[10], 15.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[11], 5.0,  1e-12);
+    tssdyn[0]->setName("uname*1");
+    // Modified registration: the local markers are replaced by new ones shifted by 1 mm along the axis X. The previous binding points to deleted markers.
+    auto locals = mcr->findChildren<ma::body::Point*>({},{},false);
+    TS_ASSERT_EQUALS(locals.size(), 8u);
+    for (auto local : locals)
+    {
+      const std::string name = local->name();
+      const double coords[3] = {local->data()[0] + 1.0, local->data()[1], local->data()[2]};
+      local->removeParent(mcr);
+      delete local;
+      new ma::body::Point(name,coords,mcr);
+    }
+    ma::Node models3("models3");
+    TS_ASSERT_EQUALS(ma::body::reconstruct(&models3,&helper,&rootDynamic), true);
+    cube_tcs = models3.findChild<ma::TimeSequence*>("Cube.TCS");
+    TS_ASSERT_DIFFERS(cube_tcs, nullptr);
+    TS_ASSERT_DELTA(cube_tcs->data()[0],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[4],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[8],  1.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[9],  24.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[10], 15.0, 1e-12);
+    TS_ASSERT_DELTA(cube_tcs->data()[11], 5.0,  1e-12);
+  };
+  
   CXXTEST_TEST(lowerlimbs)
   {
     ma::Node staticTrials("staticTrials"), dynamicTrials("dynamicTrials");
@@ -182,4 +252,5 @@ CXXTEST_SUITE(UnitQuaternionPoseEstimatorTest)
 CXXTEST_SUITE_REGISTRATION(UnitQuaternionPoseEstimatorTest)
 CXXTEST_TEST_REGISTRATION(UnitQuaternionPoseEstimatorTest, cube)
 CXXTEST_TEST_REGISTRATION(UnitQuaternionPoseEstimatorTest, cubeRotated)
+CXXTEST_TEST_REGISTRATION(UnitQuaternionPoseEstimatorTest, cubeBindingInvalidated)
 CXXTEST_TEST_REGISTRATION(UnitQuaternionPoseEstimatorTest, lowerlimbs)
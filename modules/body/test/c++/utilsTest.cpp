@@ -173,14 +173,40 @@ CXXTEST_SUITE(UtilsTest)
     TS_ASSERT_EQUALS(start,0.0);
     TS_ASSERT_EQUALS(ok,true);
     TS_ASSERT_EQUALS(lmks.size(),4u);
-    lmks["pt1"].values().setRandom();
-    lmks["pt2"].values().setRandom();
-    lmks["pt3"].values().setRandom();
-    lmks["pt4"].values().setRandom();
-    TS_ASSERT_DELTA(lmks["pt1"].values().coeff(0),tss[0]->data()[0],1e-15);
-    TS_ASSERT_DELTA(lmks["pt2"].values().coeff(0),tss[1]->data()[0],1e-15);
-    TS_ASSERT_DELTA(lmks["pt3"].values().coeff(0),tss[2]->data()[0],1e-15);
-    TS_ASSERT_DELTA(lmks["pt4"].values().coeff(0),tss[3]->data()[0],1e-15);
+    // The landmarks stored with double values are mapped (no copy)
+    for (auto ts : tss)
+      ts->data()[0] = static_cast<double>(std::rand()) / RAND_MAX;
+    TS_ASSERT_DELTA(lmks["pt1"].values().coeff(0,0),tss[0]->data()[0],1e-15);
+    TS_ASSERT_DELTA(lmks["pt2"].values().coeff(0,0),tss[1]->data()[0],1e-15);
+    TS_ASSERT_DELTA(lmks["pt3"].values().coeff(0,0),tss[2]->data()[0],1e-15);
+    TS_ASSERT_DELTA(lmks["pt4"].values().coeff(0,0),tss[3]->data()[0],1e-15);
+  };
+  
+  CXXTEST_TEST(extractLandmarkPositionsCompact)
+  {
+    ma::body::LandmarksTranslator lt("lt",{
+      {"uname*1", "pt1"},
+      {"uname*2", "pt2"}
+    });
+    ma::Node root("root");
+    auto tss = ma::make_nodes<ma::TimeSequence*>(2,4,2,100.0,0.0,ma::TimeSequence::Position,"mm",&root);
+    const double values[8] = {1.5, 2.5, -3.25, 4.0, 5.5, 6.75, 0.0, 0.0};
+    std::copy_n(values, 8, tss[1]->data());
+    tss[1]->setStorage(ma::TimeSequence::Storage::Float);
+    // The landmarks stored with compact elements are widened
+    auto lmks = ma::body::extract_landmark_positions(&lt, tss);
+    TS_ASSERT_EQUALS(lmks.size(),2u);
+    TS_ASSERT_EQUALS(lmks.count("pt2"),1u);
+    TS_ASSERT_EQUALS(lmks["pt2"].rows(),2);
+    TS_ASSERT_EQUALS(lmks["pt2"].values().coeff(1,2),6.75);
+    TS_ASSERT_EQUALS(lmks["pt2"].residuals().coeff(1),0.0);
+    lmks = ma::body::extract_landmark_positions(nullptr, tss);
+    TS_ASSERT_EQUALS(lmks.size(),2u);
+    auto avg = ma::body::average_marker(tss[1],&root);
+    TS_ASSERT_DIFFERS(avg, nullptr);
+    TS_ASSERT_EQUALS(avg->data()[0], 2.0);
+    TS_ASSERT_EQUALS(avg->data()[1], 0.375);
+    TS_ASSERT_EQUALS(avg->data()[2], 6.125);
   };
   
   CXXTEST_TEST(averageMarker)
@@ -218,4 +244,5 @@ CXXTEST_SUITE_REGISTRATION(UtilsTest)
 CXXTEST_TEST_REGISTRATION(UtilsTest, transformRelative)
 CXXTEST_TEST_REGISTRATION(UtilsTest, transformInvalid)
 CXXTEST_TEST_REGISTRATION(UtilsTest, extractLandmarkPositions)
+CXXTEST_TEST_REGISTRATION(UtilsTest, extractLandmarkPositionsCompact)
 CXXTEST_TEST_REGISTRATION(UtilsTest, averageMarker)
\ No newline at end of file
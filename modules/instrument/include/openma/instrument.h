@@ -37,9 +37,15 @@
 
 #include "openma/instrument/enums.h"
 #include "openma/instrument/forceplate.h"
+#include "openma/instrument/forceplatetype1.h"
 #include "openma/instrument/forceplatetype2.h"
 #include "openma/instrument/forceplatetype3.h"
 #include "openma/instrument/forceplatetype4.h"
 #include "openma/instrument/forceplatetype5.h"
+#include "openma/instrument/forceplatetype6.h"
+#include "openma/instrument/forceplatetype7.h"
+#include "openma/instrument/forceplatetype11.h"
+#include "openma/instrument/forceplatetype12.h"
+#include "openma/instrument/forceplatetype21.h"
 
 #endif // __openma_instrument_h
\ No newline at end of file
@@ -56,8 +56,8 @@ namespace instrument
   public:
     typedef enum : int {
       Unknown = 0x00,
-      // Type1 = 0x01,
-      // Raw9x6 = Type1,
+      Type1 = 0x01,
+      Raw9x6 = Type1,
       Type2 = 0x02,
       Raw6x6 = Type2,
       Type3 = 0x03,
@@ -66,16 +66,16 @@ namespace instrument
       Cal6x6 = Type4,
       Type5 = 0x05,
       Cal6x8 = Type5,
-      // Type6 = 0x06,
-      // Cal12x12 = Type6,
-      // Type7 = 0x07,
-      // Poly8x8 = Type7,
-      // Type11 = 0x0B,
-      // KistlerSplitBeltTreadmill = Type11,
-      // Type12 = 0x0C,
-      // KistlerGaitwayTreadmill = Type12,
-      // Type21 = 0x15,
-      // AmtiStairway = Type21
+      Type6 = 0x06,
+      Cal12x12 = Type6,
+      Type7 = 0x07,
+      Poly8x8 = Type7,
+      Type11 = 0x0B,
+      KistlerSplitBeltTreadmill = Type11,
+      Type12 = 0x0C,
+      KistlerGaitwayTreadmill = Type12,
+      Type21 = 0x15,
+      AmtiStairway = Type21
     } Type;
     
     ~ForcePlate() _OPENMA_NOEXCEPT;
@@ -104,16 +104,19 @@ namespace instrument
     
     TimeSequence* wrench(Location loc, bool global = true, double threshold = 10.0, double rate = -1.0);
     
+    bool beginStream(Location loc, bool global = true, double threshold = 10.0);
+    bool processStream(const std::vector<const double*>& channels, unsigned samples, double* wrench);
+    void endStream() _OPENMA_NOEXCEPT;
+    bool isStreaming() const _OPENMA_NOEXCEPT;
+    unsigned long streamedSamples() const _OPENMA_NOEXCEPT;
+    
   protected:
     ForcePlate(ForcePlatePrivate& pimpl, Node* parent) _OPENMA_NOEXCEPT;
     
     std::string stringifyLocation(Location loc) const _OPENMA_NOEXCEPT;
     std::vector<TimeSequence*> retrieveChannels() const _OPENMA_NOEXCEPT;
-    bool removeBaseline(std::vector<TimeSequence*>& cpts, Node* tempRoot);
-    virtual bool computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts) = 0;
-    bool resampleWrench(TimeSequence* w, double factor);
-    bool computePosition(TimeSequence* w, Location loc, double threshold);
-    bool transformToGlobal(TimeSequence* w);
+    bool computeBaselines(std::vector<double>& baselines, const std::vector<TimeSequence*>& cpts) const;
+    virtual bool computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold) = 0;
     
     virtual void copyContents(const Node* source) _OPENMA_NOEXCEPT override;
   };
@@ -41,9 +41,14 @@
  */
 
 #include "openma/base/hardware_p.h"
+#include "openma/base/timesequence.h"
+#include "openma/instrument/enums.h"
 
 #include <array>
 #include <vector>
+#include <utility> // std::pair
+#include <cassert>
+#include <cmath> // std::fabs
 
 namespace ma
 {
@@ -64,6 +69,35 @@ namespace instrument
     ForcePlatePrivate(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels);
     ~ForcePlatePrivate() _OPENMA_NOEXCEPT;
     
+    struct WrenchCache
+    {
+      Location Loc;
+      bool Global;
+      double Threshold;
+      double Rate;
+      TimeSequence* Output;
+      unsigned long OutputTimestamp;
+      unsigned long ConfigurationRevision;
+      std::vector<std::pair<TimeSequence*,unsigned long>> Channels;
+    };
+    
+    struct WrenchStream
+    {
+      bool Active;
+      Location Loc;
+      bool Global;
+      double Threshold;
+      unsigned long Samples; // Number of samples already processed
+      unsigned BaselineCount; // Number of samples accumulated in the soft reset window
+      std::vector<double> BaselineSums;
+      std::vector<double> Baselines;
+    };
+    
+    static bool isWrenchCacheValid(const WrenchCache& cache, const TimeSequence* output, const std::vector<TimeSequence*>& channels, unsigned long revision) _OPENMA_NOEXCEPT;
+    static bool isCalibrationMatrixValid(const ForcePlate* fp, const std::vector<double>& data, unsigned rows, unsigned cols) _OPENMA_NOEXCEPT;
+    
+    template <unsigned N, typename C> static void computeWrench(const ForcePlate* fp, double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold, C&& calibration);
+    
     int Type;
     std::array<double,12> ReferenceFrame;
     std::array<double,12> SurfaceCorners;
@@ -72,6 +106,104 @@ namespace instrument
     std::vector<double> CalibrationMatrixData;
     bool SoftResetEnabled;
     std::array<int,2> SoftResetBaselineSamples;
+    unsigned long ConfigurationRevision; // Incremented each time a setting used to compute the wrench is modified
+    std::vector<WrenchCache> WrenchCaches;
+    WrenchStream Stream;
+  };
+  
+  /*
+   * Fused computation of the wrench associated with a force plate.
+   * Each sample of the output @a w corresponds to the same sample in the @a channels (already resampled if necessary).
+   * The output @a w is stored in column-major order (@a samples rows and 10 columns) as the data of a TimeSequence.
+   * For each sample, the channels are read once and the following steps are done without intermediate buffers:
+   *  - the @a baselines are removed from the channels
+   *  - the @a calibration (specific to each type of force plate) is used to compute the forces and moments at the origin of the force plate
+   *  - the moments are transported to the requested location @a loc (and the CoP or PWA is computed)
+   *  - the wrench is transformed into the global frame (if requested)
+   * The @a calibration is a callable object with the signature void(const double* channels, double* wrench) where @a channels contains N values and @a wrench 6 values (forces and moments).
+   */
+  template <unsigned N, typename C>
+  void ForcePlatePrivate::computeWrench(const ForcePlate* fp, double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold, C&& calibration)
+  {
+    assert(channels.size() == N);
+    assert(baselines.size() == N);
+    const double* raw[N];
+    for (unsigned n = 0 ; n < N ; ++n)
+      raw[n] = channels[n];
+    const auto& o = fp->relativeSurfaceOrigin();
+    const auto& T = fp->referenceFrame(); // Rotation matrix (column-major) followed by the translation
+    const bool located = (loc != Location::Origin);
+    const bool cop = (loc == Location::CentreOfPressure);
+    const bool pwa = (loc == Location::PointOfApplication);
+    double* out = w;
+    double c[N], fm[6];
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      for (unsigned n = 0 ; n < N ; ++n)
+        c[n] = raw[n][i] - baselines[n];
+      calibration(c, fm);
+      double Fx = fm[0], Fy = fm[1], Fz = fm[2], Mx = fm[3], My = fm[4], Mz = fm[5];
+      double Px = 0., Py = 0., Pz = 0.;
+      if (located)
+      {
+        Px = o[0];
+        Py = o[1];
+        Pz = o[2];
+        Mx += Fy * o[2] - o[1] * Fz;
+        My += Fz * o[0] - o[2] * Fx;
+        Mz += Fx * o[1] - o[0] * Fy;
+      }
+      if (cop)
+      {
+        Px = - My / Fz;
+        Py =   Mx / Fz;
+      }
+      else if (pwa)
+      {
+        // For explanations of the PWA calculation, see Shimba T. (1984), 
+        // "An estimation of center of gravity from force platform data", 
+        // Journal of Biomechanics 17(1), 53–60.
+        const double sNF = Fx * Fx + Fy * Fy + Fz * Fz;
+        Px = (Fy * Mz - Fz * My) / sNF - (Fx * Fx * My - Fx * (Fy * Mx)) / (sNF * Fz);
+        Py = (Fz * Mx - Fx * Mz) / sNF - (Fx * (Fy * My) - Fy * Fy * Mx) / (sNF * Fz);
+      }
+      if (cop || pwa)
+      {
+        Mx += Fy * Pz - Py * Fz;
+        My += Fz * Px - Pz * Fx;
+        Mz += Fx * Py - Px * Fy;
+        // Reset the frames where the vertical force is below the threshold
+        if (std::fabs(Fz) < threshold)
+        {
+          Fx = 0.; Fy = 0.; Fz = 0.;
+          Mx = 0.; My = 0.; Mz = 0.;
+          Px = o[0]; Py = o[1]; Pz = o[2];
+        }
+      }
+      if (global)
+      {
+        const double F[3] = {Fx, Fy, Fz}, M[3] = {Mx, My, Mz}, P[3] = {Px, Py, Pz};
+        Fx = T[0] * F[0] + T[3] * F[1] + T[6] * F[2];
+        Fy = T[1] * F[0] + T[4] * F[1] + T[7] * F[2];
+        Fz = T[2] * F[0] + T[5] * F[1] + T[8] * F[2];
+        Mx = T[0] * M[0] + T[3] * M[1] + T[6] * M[2];
+        My = T[1] * M[0] + T[4] * M[1] + T[7] * M[2];
+        Mz = T[2] * M[0] + T[5] * M[1] + T[8] * M[2];
+        Px = T[0] * P[0] + T[3] * P[1] + T[6] * P[2] + T[9];
+        Py = T[1] * P[0] + T[4] * P[1] + T[7] * P[2] + T[10];
+        Pz = T[2] * P[0] + T[5] * P[1] + T[8] * P[2] + T[11];
+      }
+      out[i]           = Fx;
+      out[i+  samples] = Fy;
+      out[i+2*samples] = Fz;
+      out[i+3*samples] = Mx;
+      out[i+4*samples] = My;
+      out[i+5*samples] = Mz;
+      out[i+6*samples] = Px;
+      out[i+7*samples] = Py;
+      out[i+8*samples] = Pz;
+      out[i+9*samples] = 0.; // Residual
+    }
   };
 };
 };
@@ -57,7 +57,7 @@ namespace instrument
     void setSensorOffsets(const std::array<double,2>& value) _OPENMA_NOEXCEPT;
     
   protected:
-    virtual bool computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts) final;
+    virtual bool computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold) final;
     virtual Node* allocateNew() const override;
     virtual void copyContents(const Node* source) _OPENMA_NOEXCEPT override;
   };
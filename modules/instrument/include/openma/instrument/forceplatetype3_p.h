@@ -51,6 +51,7 @@ namespace instrument
   class ForcePlateType3Private : public ForcePlatePrivate
   {
   public:
+    ForcePlateType3Private(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels, unsigned rows, unsigned cols);
     ForcePlateType3Private(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels);
     ~ForcePlateType3Private() _OPENMA_NOEXCEPT;
     
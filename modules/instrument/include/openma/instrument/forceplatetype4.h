@@ -51,8 +51,10 @@ namespace instrument
     ~ForcePlateType4() _OPENMA_NOEXCEPT;
     
   protected:
-    virtual bool computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts) final;
-    virtual Node* allocateNew() const final;
+    ForcePlateType4(const std::string& name, int type, Node* parent);
+    
+    virtual bool computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold) final;
+    virtual Node* allocateNew() const override;
   };
 };
 };
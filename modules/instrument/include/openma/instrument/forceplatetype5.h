@@ -51,7 +51,7 @@ namespace instrument
     ~ForcePlateType5() _OPENMA_NOEXCEPT;
     
   protected:
-    virtual bool computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts) final;
+    virtual bool computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold) final;
     virtual Node* allocateNew() const final;
   };
 };
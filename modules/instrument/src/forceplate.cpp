@@ -36,9 +36,11 @@
 #include "openma/instrument/forceplate_p.h"
 #include "openma/base/timesequence.h"
 #include "openma/base/logger.h"
+#include "openma/base/profiler.h"
 #include "openma/math.h"
 
 #include <Eigen/Geometry>
+#include <Eigen_openma/SignalProcessing/Resample.h>
 
 #include <algorithm> // std::copy
 #include <cassert>
@@ -63,10 +65,16 @@ namespace instrument
     CalibrationMatrixDimensions{{rows,cols}},
     CalibrationMatrixData(),
     SoftResetEnabled(false),
-    SoftResetBaselineSamples{{0,0}}
+    SoftResetBaselineSamples{{0,0}},
+    ConfigurationRevision(0ul),
+    WrenchCaches(),
+    Stream()
 #else
     CalibrationMatrixData(),
-    SoftResetEnabled(false)
+    SoftResetEnabled(false),
+    ConfigurationRevision(0ul),
+    WrenchCaches(),
+    Stream()
 #endif
   {
 #if defined(_MSC_VER) && (_MSC_VER < 1900)
@@ -118,6 +126,34 @@ namespace instrument
   
   ForcePlatePrivate::~ForcePlatePrivate() _OPENMA_NOEXCEPT
   {};
+  
+  /*
+   * Check if the content of the @a output is still valid based on the given @a cache.
+   * The output must not have been modified since its computation, the @a channels must be the same (and not modified) and the configuration of the force plate must be the same (see @a revision).
+   */
+  bool ForcePlatePrivate::isWrenchCacheValid(const WrenchCache& cache, const TimeSequence* output, const std::vector<TimeSequence*>& channels, unsigned long revision) _OPENMA_NOEXCEPT
+  {
+    if ((cache.ConfigurationRevision != revision) || (output->timestamp() != cache.OutputTimestamp) || (cache.Channels.size() != channels.size()))
+      return false;
+    for (size_t i = 0 ; i < channels.size() ; ++i)
+    {
+      if ((cache.Channels[i].first != channels[i]) || (cache.Channels[i].second != channels[i]->timestamp()))
+        return false;
+    }
+    return true;
+  };
+  
+  /*
+   * Check if the calibration matrix @a data of the force plate @a fp contains @a rows x @a cols values.
+   * An error message is displayed if it is not the case.
+   */
+  bool ForcePlatePrivate::isCalibrationMatrixValid(const ForcePlate* fp, const std::vector<double>& data, unsigned rows, unsigned cols) _OPENMA_NOEXCEPT
+  {
+    if (data.size() == static_cast<size_t>(rows) * static_cast<size_t>(cols))
+      return true;
+    error("The calibration matrix of the force plate '%s' must contain %u values (%u found). Impossible to do wrench computation.", fp->name().c_str(), rows * cols, static_cast<unsigned>(data.size()));
+    return false;
+  };
 };
 };
 
@@ -158,7 +194,10 @@ namespace instrument
    *  - the dimensions (1x2) of the calibration matrix (optional)
    *  - the data of the calibration matrix (optional)
    *
-   * @todo add a method to remove the baseline
+   * The baseline of the channels can be removed during the computation of the wrench (see setSoftResetEnabled()).
+   *
+   * An inheriting class has only to implement the method computeWrench(), which gives in a single pass the wrench from the (already resampled) data of the channels.
+   * @note This method replaces the methods removeBaseline() and computeWrenchAtOrigin() of the previous versions. A class which implemented computeWrenchAtOrigin() should now implement computeWrench() and give its calibration step to ForcePlatePrivate::computeWrench().
    */
   
  
@@ -204,6 +243,8 @@ namespace instrument
     T.col(1) = T.col(2).cross(T.col(0));
     Eigen::Matrix<double,3,1> so = SC.rowwise().mean();
     T.col(3) = T.bottomLeftCorner<3,3>() * -off + so;
+    ++optr->ConfigurationRevision;
+    this->modified();
   };
   
   
@@ -306,6 +347,7 @@ namespace instrument
     if (optr->CalibrationMatrixData == value)
       return;
     optr->CalibrationMatrixData = value;
+    ++optr->ConfigurationRevision;
     this->modified();
   };
   
@@ -319,6 +361,7 @@ namespace instrument
     if (optr->SoftResetEnabled == value)
       return;
     optr->SoftResetEnabled = value;
+    ++optr->ConfigurationRevision;
     this->modified();
   };
 
@@ -340,6 +383,7 @@ namespace instrument
     if (optr->SoftResetBaselineSamples == value)
       return;
     optr->SoftResetBaselineSamples = value;
+    ++optr->ConfigurationRevision;
     this->modified();
   };
   
@@ -355,62 +399,238 @@ namespace instrument
   /**
    * Compute the wrench associated with this force plate at the requested Location @a loc, expressed in the local or @a global frame.
    * An optional @a threshold (10N by default) can be given to invalidate the computation (due to inaccuracy).
-   * You can also choose to downsample the computed wrench by specifying the @a rate.
+   * You can also choose to resample the computed wrench by specifying the @a rate. In this case, the channels are first resampled with a polyphase anti-aliasing FIR filter (see Eigen::PolyphaseResampler) and the wrench is only computed at the requested rate.
+   * The ratio between the @a rate and the sample rate of the channels does not need to be an integer (e.g. 1000 Hz to 120 Hz), but it must be approximated by a rational factor (see Eigen::rat).
+   *
+   * The computed wrench is stored in the outputs() of the force plate and kept in cache. One output is kept for each combination of @a loc, @a global, @a threshold, and @a rate.
+   * The wrench is computed again only if the channels (or their content), the configuration of the force plate (geometry, calibration, soft reset), or the output itself were modified since the last computation.
+   * Otherwise, the cached output is returned directly.
    */
   TimeSequence* ForcePlate::wrench(Location loc, bool global, double threshold, double rate)
   {
+    OPENMA_PROFILE_SCOPE("ForcePlate::wrench");
     auto channels = this->retrieveChannels();
     if (channels.empty())
     {
       error("At least one channel for the force plate '%s' was not found. Impossible to do wrench computation.", this->name().c_str());
       return nullptr;
     }
-    double sampleRate = 0., startTime = 0., factor = 1.;
+    double sampleRate = 0., startTime = 0.;
     unsigned samples = 0;
     if (!compare_timesequences_properties(channels, sampleRate, startTime, samples))
     {
       error("At least one channel for the force plate '%s' does not have the same sample rate, start time, or number of samples than the other. Impossible to do wrench computation.", this->name().c_str());
       return nullptr;
     }
+    Eigen::DenseIndex up = 1, down = 1;
     if (rate > 0.0)
     {
-      if (modf(sampleRate / rate, &factor) > std::numeric_limits<float>::epsilon())
+      if (!Eigen::rat(rate / sampleRate, &up, &down))
       {
-        error("The current implementation does not support non integer factor to downsample forceplate signals");
+        error("The ratio between the requested sample rate (%f Hz) and the sample rate of the channels (%f Hz) of the force plate '%s' cannot be approximated by a rational factor. Impossible to do wrench computation.", rate, sampleRate, this->name().c_str());
         return nullptr;
       }
     }
     else
       rate = sampleRate;
+    // Is there an output already computed for the same settings and still up to date?
+    auto optr = this->pimpl();
+    auto outputs = this->outputs();
+    TimeSequence* w = nullptr;
+    // Remove the cached outputs deleted since their computation (the pointer is only compared, not dereferenced)
+    optr->WrenchCaches.erase(std::remove_if(optr->WrenchCaches.begin(), optr->WrenchCaches.end(), [&](const ForcePlatePrivate::WrenchCache& c){return this->findChild<TimeSequence*>(c.Output) == nullptr;}), optr->WrenchCaches.end());
+    auto cache = std::find_if(optr->WrenchCaches.begin(), optr->WrenchCaches.end(), [&](const ForcePlatePrivate::WrenchCache& c){return (c.Loc == loc) && (c.Global == global) && (c.Threshold == threshold) && (c.Rate == rate);});
+    if (cache != optr->WrenchCaches.end())
+    {
+      w = cache->Output;
+      if (ForcePlatePrivate::isWrenchCacheValid(*cache, w, channels, optr->ConfigurationRevision))
+      {
+        OPENMA_PROFILE_COUNT("cache_hits",1);
+        return w;
+      }
+    }
+    OPENMA_PROFILE_COUNT("samples",samples);
+    // Otherwise, look for an existing output not already associated with other settings, or create a new one
     std::string name = this->name() + ".Wrench." + (global ? "Global." : "Local.") + this->stringifyLocation(loc);
-    auto w = this->outputs()->findChild<TimeSequence*>(name,{{"type",ma::TimeSequence::Wrench},{"components",10},{"sampleRate",rate}},false);
     if (w == nullptr)
-      w = new TimeSequence(name, 10, samples, rate, startTime, ma::TimeSequence::Wrench,"",this->outputs());
-    Node* tempChannelsRoot;
-    if ((tempChannelsRoot = this->findChild("TempChannels")) == nullptr)
-      tempChannelsRoot = new Node("TempChannels", this);
-    std::vector<TimeSequence*> cpts;
-    // Is it necessary to do the computation or the cache is still up to date?
-    if (w->timestamp() < this->timestamp())
     {
-      if (!this->removeBaseline(channels, tempChannelsRoot)
-          || !this->computeWrenchAtOrigin(w, channels)
-            || !this->resampleWrench(w, factor)
-              || !this->computePosition(w, loc, threshold)
-                || (global && !this->transformToGlobal(w)))
+      auto candidates = outputs->findChildren<TimeSequence*>(name,{{"type",ma::TimeSequence::Wrench},{"components",10},{"sampleRate",rate}},false);
+      for (auto candidate : candidates)
+      {
+        if (std::find_if(optr->WrenchCaches.cbegin(), optr->WrenchCaches.cend(), [&](const ForcePlatePrivate::WrenchCache& c){return c.Output == candidate;}) == optr->WrenchCaches.cend())
+        {
+          w = candidate;
+          break;
+        }
+      }
+    }
+    if (w == nullptr)
+      w = new TimeSequence(name, 10, 0, rate, startTime, ma::TimeSequence::Wrench,"",outputs);
+    std::vector<double> baselines;
+    std::vector<const double*> data(channels.size(), nullptr);
+    std::vector<std::vector<double>> resampled, widened;
+    // Channels using a compact storage (or not stored contiguously) are first widened
+    widened.reserve(channels.size());
+    for (size_t i = 0 ; i < channels.size() ; ++i)
+    {
+      if ((channels[i]->storage() == TimeSequence::Storage::Double) && (channels[i]->stride() == samples) && !channels[i]->isRingBuffer())
+        data[i] = static_cast<const TimeSequence*>(channels[i])->data(); // Read-only access (the buffer stays shareable)
+      else
       {
-        // An error message should aready be displayed by other used methods
-        delete w;
-        w = nullptr;
+        widened.emplace_back(samples);
+        channels[i]->read(0, 0, samples, widened.back().data());
+        data[i] = widened.back().data();
       }
-      // Delete temporary channels where baseline was removed
-      auto tempChannels = tempChannelsRoot->children();
-      for (auto channel : tempChannels)
-        delete channel;
     }
+    if ((up == 1) && (down == 1))
+    {
+      w->resize(samples);
+    }
+    else
+    {
+      // Resample the channels before the computation of the wrench
+      const Eigen::PolyphaseResampler<double> resampler(up, down);
+      const auto num = resampler.outputSize(samples);
+      resampled.resize(channels.size(), std::vector<double>(num));
+      for (size_t i = 0 ; i < channels.size() ; ++i)
+      {
+        resampler.resample(resampled[i].data(), data[i], samples);
+        data[i] = resampled[i].data();
+      }
+      w->resize(num);
+    }
+    w->setStartTime(startTime);
+    bool computed = false;
+    {
+      // The content of the output is modified (notified at the destruction of the writer)
+      TimeSequence::Writer writer(w);
+      computed = this->computeBaselines(baselines, channels) && this->computeWrench(writer.data(), w->samples(), data, baselines, loc, global, threshold);
+    }
+    if (!computed)
+    {
+      // An error message should aready be displayed by other used methods
+      if (cache != optr->WrenchCaches.end())
+        optr->WrenchCaches.erase(cache);
+      delete w;
+      return nullptr;
+    }
+    // Store the state of the inputs used for this computation
+    if (cache == optr->WrenchCaches.end())
+      cache = optr->WrenchCaches.insert(optr->WrenchCaches.end(), ForcePlatePrivate::WrenchCache{loc, global, threshold, rate, nullptr, 0ul, 0ul, {}});
+    cache->Output = w;
+    cache->OutputTimestamp = w->timestamp();
+    cache->ConfigurationRevision = optr->ConfigurationRevision;
+    cache->Channels.resize(channels.size());
+    for (size_t i = 0 ; i < channels.size() ; ++i)
+      cache->Channels[i] = std::make_pair(channels[i], channels[i]->timestamp());
     return w;
   };
   
+  /**
+   * Prepare the incremental computation of the wrench for live data.
+   * Contrary to the method wrench() which needs the complete content of the channels, the samples are given block by block with the method processStream() and the corresponding wrench is directly computed.
+   * The settings @a loc, @a global, and @a threshold have the same meaning than for the method wrench() and are used for all the blocks of the stream.
+   * The state of the stream (number of processed samples, baselines) is reset. All the memory required by the stream is allocated here and not when each block is processed.
+   * If the soft reset is enabled, the sample indices set by setSoftResetSamples() are relative to the first sample of the stream.
+   * Returns false if the soft reset indices are corrupted.
+   */
+  bool ForcePlate::beginStream(Location loc, bool global, double threshold)
+  {
+    auto optr = this->pimpl();
+    if (optr->SoftResetEnabled && ((optr->SoftResetBaselineSamples[0] < 0) || (optr->SoftResetBaselineSamples[1] < optr->SoftResetBaselineSamples[0])))
+    {
+      error("The sample indices to remove channels' baseline for the forceplate '%s' are corrupted.", optr->Name.c_str());
+      optr->Stream.Active = false;
+      return false;
+    }
+    const size_t num = this->channelsNumberRequired();
+    optr->Stream.Active = true;
+    optr->Stream.Loc = loc;
+    optr->Stream.Global = global;
+    optr->Stream.Threshold = threshold;
+    optr->Stream.Samples = 0ul;
+    optr->Stream.BaselineCount = 0u;
+    optr->Stream.BaselineSums.assign(num, 0.0);
+    optr->Stream.Baselines.assign(num, 0.0);
+    return true;
+  };
+  
+  /**
+   * Compute the wrench for a block of @a samples given for each channel in @a channels.
+   * The channels must be given in the same order than the indices used by the method setChannel() and each of them must contain at least @a samples values.
+   * The output @a wrench must be able to store @a samples x 10 values. As for the data of a TimeSequence, the components (forces, moments, position, residual) are stored in column-major order.
+   * The channels are used at their acquisition rate (no resampling is done) and the computation relies on the same type-specific calibration than the method wrench().
+   *
+   * When the soft reset is enabled, the baselines are updated with the samples of the block included in the soft reset window before the computation of the wrench. Thus, the blocks received before the end of this window are corrected with the partial mean of the window.
+   * Once the window is complete, the result is the same than the one obtained by the method wrench() on the complete data.
+   *
+   * No memory is allocated by this method. Returns false if no stream was started (see beginStream()) or if the number of channels is not correct.
+   */
+  bool ForcePlate::processStream(const std::vector<const double*>& channels, unsigned samples, double* wrench)
+  {
+    auto optr = this->pimpl();
+    auto& stream = optr->Stream;
+    if (!stream.Active)
+    {
+      error("No stream was started for the force plate '%s'. Impossible to do wrench computation.", optr->Name.c_str());
+      return false;
+    }
+    if (channels.size() != stream.Baselines.size())
+    {
+      error("The number of channels given to the force plate '%s' is not correct (%i instead of %i). Impossible to do wrench computation.", optr->Name.c_str(), static_cast<int>(channels.size()), static_cast<int>(stream.Baselines.size()));
+      return false;
+    }
+    if (samples == 0u)
+      return true;
+    if (optr->SoftResetEnabled)
+    {
+      // Intersection between the block and the soft reset window
+      const unsigned long first = std::max(stream.Samples, static_cast<unsigned long>(optr->SoftResetBaselineSamples[0]));
+      const unsigned long last = std::min(stream.Samples + samples - 1ul, static_cast<unsigned long>(optr->SoftResetBaselineSamples[1]));
+      if (first <= last)
+      {
+        for (size_t i = 0 ; i < channels.size() ; ++i)
+        {
+          for (unsigned long j = first ; j <= last ; ++j)
+            stream.BaselineSums[i] += channels[i][j - stream.Samples];
+          stream.Baselines[i] = stream.BaselineSums[i] / static_cast<double>(stream.BaselineCount + last - first + 1ul);
+        }
+        stream.BaselineCount += static_cast<unsigned>(last - first + 1ul);
+      }
+    }
+    if (!this->computeWrench(wrench, samples, channels, stream.Baselines, stream.Loc, stream.Global, stream.Threshold))
+      return false;
+    stream.Samples += samples;
+    return true;
+  };
+  
+  /**
+   * Stop the current stream (if any). A new stream must be started with beginStream() before to process other blocks.
+   */
+  void ForcePlate::endStream() _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    optr->Stream.Active = false;
+  };
+  
+  /**
+   * Returns true if a stream was started with beginStream() and not stopped since.
+   */
+  bool ForcePlate::isStreaming() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Stream.Active;
+  };
+  
+  /**
+   * Returns the number of samples processed since the beginning of the current stream.
+   */
+  unsigned long ForcePlate::streamedSamples() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->Stream.Samples;
+  };
+  
   /**
    * Constructor to be used by inherited object which want to add informations (static properties, members, etc) to the private implementation.
    */
@@ -465,11 +685,14 @@ namespace instrument
   };
   
   /**
-   * Compute the baseline for each channel and remove it. Internally, the baseline is not directly removed from the raw data of the mapped channels. Instead, new temporary TimeSequence objects are created and will be used to compute the wrench..
+   * Compute the baseline of each channel in @a cpts when the soft reset is enabled.
+   * The baseline corresponds to the mean of the samples set by setSoftResetBaselineSamples(). If the soft reset is disabled, all the baselines are set to 0.
+   * The baselines are not removed from the raw data of the mapped channels, but during the computation of the wrench (see computeWrench()).
    */
-  bool ForcePlate::removeBaseline(std::vector<TimeSequence*>& cpts, Node* tempRoot)
+  bool ForcePlate::computeBaselines(std::vector<double>& baselines, const std::vector<TimeSequence*>& cpts) const
   {
     auto optr = this->pimpl();
+    baselines.assign(cpts.size(), 0.0);
     if (optr->SoftResetEnabled)
     {
       if ((optr->SoftResetBaselineSamples[0] < 0) || (optr->SoftResetBaselineSamples[1] < optr->SoftResetBaselineSamples[0]) || (static_cast<unsigned>(optr->SoftResetBaselineSamples[1]) >= cpts[0]->samples()))
@@ -477,125 +700,25 @@ namespace instrument
         error("The sample indices to remove channels' baseline for the forceplate '%s' are corrupted.", optr->Name.c_str());
         return false;
       }
-      if (tempRoot == nullptr)
-      {
-        error("Temporary node to store channels with baseline removed was not found.");
-        return false;
-      }
+      const unsigned num = optr->SoftResetBaselineSamples[1] - optr->SoftResetBaselineSamples[0] + 1;
+      Eigen::ArrayXd values(num);
       for (size_t i = 0 ; i < cpts.size() ; ++i)
       {
-        auto cpt = static_cast<TimeSequence*>(cpts[i]->clone(tempRoot));
-        auto value = math::Map<math::Array<1>>::Values(cpt->data(), cpt->samples(), 1);
-        value -= value.block(optr->SoftResetBaselineSamples[0],0,optr->SoftResetBaselineSamples[1]-optr->SoftResetBaselineSamples[0]+1,1).mean();
-        cpts[i] = cpt;
+        cpts[i]->read(0, optr->SoftResetBaselineSamples[0], num, values.data());
+        baselines[i] = values.mean();
       }
     }
     return true;
   };
   
   /**
-   * Resample the TimeSequence @a w based on the given @a factor
-   * @note This method accepts only @a factor greater than 1.0. Moreover, the scale factor is transformed internally as an integer.
+   * @fn virtual bool ForcePlate::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold) = 0;
+   * Compute in a single pass the wrench @a w from the data of the @a channels.
+   * The @a baselines are removed from the channels, the calibration specific to the type of force plate is applied, and the position (and moments) are expressed at the location @a loc. If @a global is true, the wrench is transformed to the global frame.
+   * The @a channels are already resampled to the rate of the wrench and contain at least @a samples values. The output @a w is a column-major buffer of @a samples rows and 10 columns (as the data of a TimeSequence).
+   * Inheriting classes should rely on the method ForcePlatePrivate::computeWrench() where only the calibration step has to be given.
    */
-  bool ForcePlate::resampleWrench(TimeSequence* w, double factor)
-  {
-    if (factor > 1.0)
-    {
-      // Right now, only downsample integer factor is supported
-      math::Wrench dsw = math::to_wrench(w).downsample(static_cast<unsigned>(factor));
-      w->resize(dsw.rows());
-      std::copy_n(dsw.values().data(),    dsw.rows()*9, w->data());
-      std::copy_n(dsw.residuals().data(), dsw.rows(), w->data()+dsw.rows()*9);
-    }
-    return true;
-  }
-  
-  /**
-   * Compute the postion of the wrench based on the requested Location @a loc.
-   * The @a threshold is used to invalidate all the position where the associated absolute vertical force is below this value.
-   */
-  bool ForcePlate::computePosition(TimeSequence* w, Location loc, double threshold)
-  {
-    auto W = math::to_wrench(w);
-    auto o = this->relativeSurfaceOrigin();
-    // Adaptation of the moment and position depending of the specified location
-    auto Fx = W.values().col(0);
-    auto Fy = W.values().col(1);
-    auto Fz = W.values().col(2);
-    auto Mx = W.values().col(3);
-    auto My = W.values().col(4);
-    auto Mz = W.values().col(5);
-    auto Px = W.values().col(6);
-    auto Py = W.values().col(7);
-    auto Pz = W.values().col(8);
-    auto res = W.residuals();
-    if (loc == Location::Origin)
-    {
-      Px.setZero();
-      Py.setZero();
-      Pz.setZero();
-      res.setZero();
-    }
-    else
-    {
-      // Position
-      Px.setConstant(o[0]);
-      Py.setConstant(o[1]);
-      Pz.setConstant(o[2]);
-      // Moment
-      Mx += Fy * o[2] - o[1] * Fz;
-      My += Fz * o[0] - o[2] * Fx;
-      Mz += Fx * o[1] - o[0] * Fy;
-      // Residuals
-      res.setZero();
-    }
-    if (loc == Location::CentreOfPressure)
-    {
-      Px = - My / Fz;
-      Py =   Mx / Fz;
-    }
-    else if (loc == Location::PointOfApplication)
-    {
-      // For explanations of the PWA calculation, see Shimba T. (1984), 
-      // "An estimation of center of gravity from force platform data", 
-      // Journal of Biomechanics 17(1), 53–60.
-      math::Array<1>::Values sNF = W.values().block(0,0,W.rows(),3).square().rowwise().sum();
-      Px = (Fy * Mz - Fz * My) / sNF - (Fx.square() * My - Fx * (Fy * Mx)) / (sNF * Fz);
-      Py = (Fz * Mx - Fx * Mz) / sNF - (Fx * (Fy * My) - Fy.square() * Mx) / (sNF * Fz);
-    }
-    if ((loc == Location::CentreOfPressure) || (loc == Location::PointOfApplication))
-    {
-      // Moment
-      Mx += Fy * Pz - Py * Fz;
-      My += Fz * Px - Pz * Fx;
-      Mz += Fx * Py - Px * Fy;
-      // Set to 0, all frame where the vertical force is below the threshold
-      Eigen::Matrix<double,1,9> reset; reset << 0., 0., 0., 0., 0., 0., o[0], o[1], o[2];
-      W.values() = (Fz.abs() < threshold).replicate<1,9>().select(reset.replicate(W.rows(),1), W.values());
-    }
-    return true;
-  };
   
-  /**
-   * Transform the given TimeSequence (@a w) representing a wrench to the laboratory frame.
-   */
-  bool ForcePlate::transformToGlobal(TimeSequence* w)
-  {
-    auto W = math::to_wrench(w);
-    Eigen::Map<const Eigen::Matrix<double, 3, 3>> R(this->referenceFrame().data(), 3,3);
-    Eigen::Map<const Eigen::Array<double, 1, 3>> t(this->referenceFrame().data()+9,1,3);
-    // Forces rotation
-    W.values().block(0,0,W.rows(),3).matrix() *= R.transpose();
-    // Moments rotation
-    W.values().block(0,3,W.rows(),3).matrix() *= R.transpose();
-    // Position rotation
-    W.values().block(0,6,W.rows(),3).matrix() *= R.transpose();
-    // Position translation
-    W.values().block(0,6,W.rows(),3) += t.replicate(W.rows(),1);
-    return true;
-  };
-  
-
   /**
    * Copy the content of the @a source
    */
@@ -618,6 +741,10 @@ namespace instrument
     optr->CalibrationMatrixData = optr_src->CalibrationMatrixData;
     optr->SoftResetEnabled = optr_src->SoftResetEnabled;
     optr->SoftResetBaselineSamples = optr_src->SoftResetBaselineSamples;
+    // The cached outputs of the source cannot be used (they are not the same nodes)
+    optr->WrenchCaches.clear();
+    optr->Stream.Active = false;
+    ++optr->ConfigurationRevision;
   };
 };
 };
@@ -0,0 +1,96 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/instrument/forceplatetype1.h"
+#include "openma/instrument/forceplate_p.h"
+#include "openma/base/timesequence.h"
+
+OPENMA_INSTANCE_STATIC_TYPEID(ma::instrument::ForcePlateType1)
+
+namespace ma
+{
+namespace instrument
+{
+
+  /**
+   * @class ForcePlateType1 "openma/instrument/forceplatetype1.h"
+   * Force platform with 6 channels: Fx, Fy, Fz, Px, Py, Tz
+   * The centre of pressure (Px, Py) is expressed relatively to the surface origin and Tz is the free moment around the vertical axis.
+   * This kind of force plate does not have a calibration matrix as the channels are already expressed in physical units.
+   */
+
+  /**
+   * Constructor
+   */
+  ForcePlateType1::ForcePlateType1(const std::string& name, Node* parent)
+  : ForcePlate(*new ForcePlatePrivate(this, name, 1, {{"Fx","Fy","Fz","Px","Py","Tz"}}), parent)
+  {};
+  
+  /**
+   * Destructor (default)
+   */
+  ForcePlateType1::~ForcePlateType1() _OPENMA_NOEXCEPT = default;
+  
+  /**
+   * Compute the wrench from analog channel data associated with this force plate.
+   * The forces and moments at the origin of the force plate are computed for each sample in the fused computation realized by ForcePlatePrivate::computeWrench().
+   * @note The soft reset is not applied on the centre of pressure channels (Px, Py) as they are not offsets but positions. Their baselines are added back by the calibration step.
+   */
+  bool ForcePlateType1::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
+  {
+    // Channels: Fx, Fy, Fz, Px, Py, Tz
+    const auto o = this->relativeSurfaceOrigin();
+    const double bx = baselines[3], by = baselines[4];
+    ForcePlatePrivate::computeWrench<6>(this, w, samples, channels, baselines, loc, global, threshold, [&o,bx,by](const double* c, double* fm) {
+      const double &Fx = c[0], &Fy = c[1], &Fz = c[2], &Tz = c[5];
+      const double Px = o[0] + c[3] + bx, Py = o[1] + c[4] + by, Pz = o[2];
+      fm[0] = Fx;
+      fm[1] = Fy;
+      fm[2] = Fz;
+      fm[3] = Py * Fz - Pz * Fy;
+      fm[4] = Pz * Fx - Px * Fz;
+      fm[5] = Tz + Px * Fy - Py * Fx;
+    });
+    return true;
+  };
+   
+  /**
+   * Create a new ForcePlateType1 object on the heap
+   */
+  Node* ForcePlateType1::allocateNew() const
+  {
+    return new ForcePlateType1(this->name());
+  };
+};
+};
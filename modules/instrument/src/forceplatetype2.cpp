@@ -33,6 +33,7 @@
  */
 
 #include "openma/instrument/forceplatetype2.h"
+#include "openma/instrument/forceplate_p.h"
 #include "openma/base/timesequence.h"
 #include "openma/math.h"
 
@@ -62,18 +63,14 @@ namespace instrument
   ForcePlateType2::~ForcePlateType2() _OPENMA_NOEXCEPT = default;
   
   /**
-   * Compute forces and moments from analog channel data associated with this force plate.
+   * Compute the wrench from analog channel data associated with this force plate.
+   * The forces and moments at the origin of the force plate are computed for each sample in the fused computation realized by ForcePlatePrivate::computeWrench().
    */
-  bool ForcePlateType2::computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts)
+  bool ForcePlateType2::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
   {
-    auto W = math::to_wrench(w);
-    using MapAnalog = math::Map<const math::Array<1>>::Values;
-    W.values().col(0) = MapAnalog(cpts[0]->data(), W.rows(), 1); // Fx
-    W.values().col(1) = MapAnalog(cpts[1]->data(), W.rows(), 1); // Fy
-    W.values().col(2) = MapAnalog(cpts[2]->data(), W.rows(), 1); // Fz
-    W.values().col(3) = MapAnalog(cpts[3]->data(), W.rows(), 1); // Mx
-    W.values().col(4) = MapAnalog(cpts[4]->data(), W.rows(), 1); // My
-    W.values().col(5) = MapAnalog(cpts[5]->data(), W.rows(), 1); // Mz
+    ForcePlatePrivate::computeWrench<6>(this, w, samples, channels, baselines, loc, global, threshold, [](const double* c, double* fm) {
+      std::copy_n(c, 6, fm); // Fx, Fy, Fz, Mx, My, Mz
+    });
     return true;
   };
   
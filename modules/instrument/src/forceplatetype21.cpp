@@ -0,0 +1,70 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/instrument/forceplatetype21.h"
+
+OPENMA_INSTANCE_STATIC_TYPEID(ma::instrument::ForcePlateType21)
+
+namespace ma
+{
+namespace instrument
+{
+
+  /**
+   * @class ForcePlateType21 "openma/instrument/forceplatetype21.h"
+   * Force platform embedded in a step of an AMTI stairway.
+   * Each step has 6 channels (Fx, Fy, Fz, Mx, My, Mz) and a calibration matrix 6x6. The computation of the wrench is the same than for the ForcePlateType4. Only the type differs.
+   */
+
+  /**
+   * Constructor
+   */
+  ForcePlateType21::ForcePlateType21(const std::string& name, Node* parent)
+  : ForcePlateType4(name, 21, parent)
+  {};
+  
+  /**
+   * Destructor (default)
+   */
+  ForcePlateType21::~ForcePlateType21() _OPENMA_NOEXCEPT = default;
+  
+  /**
+   * Create a new ForcePlateType21 object on the heap
+   */
+  Node* ForcePlateType21::allocateNew() const
+  {
+    return new ForcePlateType21(this->name());
+  };
+};
+};
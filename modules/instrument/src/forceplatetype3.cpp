@@ -47,8 +47,8 @@ namespace ma
 {
 namespace instrument
 {
-  ForcePlateType3Private::ForcePlateType3Private(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels)
-  : ForcePlatePrivate(pint, name, type, std::move(labels))
+  ForcePlateType3Private::ForcePlateType3Private(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels, unsigned rows, unsigned cols)
+  : ForcePlatePrivate(pint, name, type, std::move(labels), rows, cols)
 #if !defined(_MSC_VER) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
     , SensorOffsets{{0.,0}}
 #endif
@@ -59,6 +59,10 @@ namespace instrument
 #endif
   };
   
+  ForcePlateType3Private::ForcePlateType3Private(ForcePlate* pint, const std::string& name, int type, std::vector<std::string>&& labels)
+  : ForcePlateType3Private(pint, name, type, std::move(labels), 0, 0)
+  {};
+  
   ForcePlateType3Private::~ForcePlateType3Private() _OPENMA_NOEXCEPT = default;
 };
 };
@@ -115,32 +119,27 @@ namespace instrument
     if (optr->SensorOffsets == value)
       return;
     optr->SensorOffsets = value;
+    ++optr->ConfigurationRevision;
     this->modified();
   };
   
   /**
-   * Compute forces and moments from analog channel data associated with this force plate.
+   * Compute the wrench from analog channel data associated with this force plate.
+   * The forces and moments at the origin of the force plate are computed for each sample in the fused computation realized by ForcePlatePrivate::computeWrench().
    */
-  bool ForcePlateType3::computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts)
+  bool ForcePlateType3::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
   {
     auto optr = this->pimpl();
-    const auto& offsets = optr->SensorOffsets;
-    auto W = math::to_wrench(w);
-    using MapAnalog = math::Map<const math::Array<1>>::Values;
-    auto Fx12 = MapAnalog(cpts[0]->data(), W.rows(), 1);
-    auto Fx34 = MapAnalog(cpts[1]->data(), W.rows(), 1);
-    auto Fy14 = MapAnalog(cpts[2]->data(), W.rows(), 1);
-    auto Fy23 = MapAnalog(cpts[3]->data(), W.rows(), 1);
-    auto Fz1 =  MapAnalog(cpts[4]->data(), W.rows(), 1);
-    auto Fz2 =  MapAnalog(cpts[5]->data(), W.rows(), 1);
-    auto Fz3 =  MapAnalog(cpts[6]->data(), W.rows(), 1);
-    auto Fz4 =  MapAnalog(cpts[7]->data(), W.rows(), 1);
-    W.values().col(0) = Fx12 + Fx34;
-    W.values().col(1) = Fy14 + Fy23;
-    W.values().col(2) = Fz1 + Fz2 + Fz3 + Fz4;
-    W.values().col(3) = offsets[1] * (Fz1 + Fz2 - Fz3 - Fz4);
-    W.values().col(4) = offsets[0] * (Fz2 + Fz3 - Fz1 - Fz4);
-    W.values().col(5) = offsets[1] * (Fx34 - Fx12) + offsets[0] * (Fy14 - Fy23);
+    const auto offsets = optr->SensorOffsets;
+    ForcePlatePrivate::computeWrench<8>(this, w, samples, channels, baselines, loc, global, threshold, [&offsets](const double* c, double* fm) {
+      const double &Fx12 = c[0], &Fx34 = c[1], &Fy14 = c[2], &Fy23 = c[3], &Fz1 = c[4], &Fz2 = c[5], &Fz3 = c[6], &Fz4 = c[7];
+      fm[0] = Fx12 + Fx34;
+      fm[1] = Fy14 + Fy23;
+      fm[2] = Fz1 + Fz2 + Fz3 + Fz4;
+      fm[3] = offsets[1] * (Fz1 + Fz2 - Fz3 - Fz4);
+      fm[4] = offsets[0] * (Fz2 + Fz3 - Fz1 - Fz4);
+      fm[5] = offsets[1] * (Fx34 - Fx12) + offsets[0] * (Fy14 - Fy23);
+    });
     return true;
   };
   
@@ -33,6 +33,7 @@
  */
 
 #include "openma/instrument/forceplatetype4.h"
+#include "openma/instrument/forceplate_p.h"
 #include "openma/base/timesequence.h"
 #include "openma/math.h"
 
@@ -53,7 +54,14 @@ namespace instrument
    * Constructor
    */
   ForcePlateType4::ForcePlateType4(const std::string& name, Node* parent)
-  : ForcePlate(*new ForcePlatePrivate(this, name, 4, {{"Fx","Fy","Fz","Mx","My","Mz"}}, 6, 6), parent)
+  : ForcePlateType4(name, 4, parent)
+  {};
+  
+  /**
+   * Constructor to be used by inherited object sharing the same channels and the same computation of the wrench but with a different @a type (e.g. ForcePlateType21).
+   */
+  ForcePlateType4::ForcePlateType4(const std::string& name, int type, Node* parent)
+  : ForcePlate(*new ForcePlatePrivate(this, name, type, {{"Fx","Fy","Fz","Mx","My","Mz"}}, 6, 6), parent)
   {};
   
   /**
@@ -62,30 +70,19 @@ namespace instrument
   ForcePlateType4::~ForcePlateType4() _OPENMA_NOEXCEPT = default;
   
   /**
-   * Compute forces and moments from analog channel data associated with this force plate.
+   * Compute the wrench from analog channel data associated with this force plate.
+   * The forces and moments at the origin of the force plate are computed for each sample in the fused computation realized by ForcePlatePrivate::computeWrench().
    */
-  bool ForcePlateType4::computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts)
+  bool ForcePlateType4::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
   {
-    // Compute the force at the FP origin
-    auto cFx = cpts[0]->data();
-    auto cFy = cpts[1]->data();
-    auto cFz = cpts[2]->data();
-    auto cMx = cpts[3]->data();
-    auto cMy = cpts[4]->data();
-    auto cMz = cpts[5]->data();
-    auto W = math::to_wrench(w);
+    // Channels: Fx, Fy, Fz, Mx, My, Mz
+    if (!ForcePlatePrivate::isCalibrationMatrixValid(this, this->calibrationMatrixData(), 6, 6))
+      return false;
     const Eigen::Map<const Eigen::Matrix<double,6,6>> X(this->calibrationMatrixData().data());
-    Eigen::Matrix<double,6,1> c;
-    for (unsigned i = 0 ; i < W.rows() ; ++i)
-    {
-      c.coeffRef(0) = cFx[i];
-      c.coeffRef(1) = cFy[i];
-      c.coeffRef(2) = cFz[i];
-      c.coeffRef(3) = cMx[i];
-      c.coeffRef(4) = cMy[i];
-      c.coeffRef(5) = cMz[i];
-      W.values().block<1,6>(i,0) = X * c;
-    }
+    ForcePlatePrivate::computeWrench<6>(this, w, samples, channels, baselines, loc, global, threshold, [&X](const double* c, double* fm) {
+      Eigen::Map<Eigen::Matrix<double,6,1>> W(fm);
+      W.noalias() = X * Eigen::Map<const Eigen::Matrix<double,6,1>>(c);
+    });
     return true;
   };
    
@@ -33,6 +33,7 @@
  */
 
 #include "openma/instrument/forceplatetype5.h"
+#include "openma/instrument/forceplate_p.h"
 #include "openma/base/timesequence.h"
 #include "openma/math.h"
 
@@ -62,34 +63,17 @@ namespace instrument
   ForcePlateType5::~ForcePlateType5() _OPENMA_NOEXCEPT = default;
   
   /**
-   * Compute forces and moments from analog channel data associated with this force plate.
+   * Compute the wrench from analog channel data associated with this force plate.
+   * The forces and moments at the origin of the force plate are computed for each sample in the fused computation realized by ForcePlatePrivate::computeWrench().
    */
-  bool ForcePlateType5::computeWrenchAtOrigin(TimeSequence* w, const std::vector<TimeSequence*>& cpts)
+  bool ForcePlateType5::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
   {
-    // Compute the force at the FP origin
-    auto cFz1  = cpts[0]->data();
-    auto cFz2  = cpts[1]->data();
-    auto cFz3  = cpts[2]->data();
-    auto cFz4  = cpts[3]->data();
-    auto cFx12 = cpts[4]->data();
-    auto cFx34 = cpts[5]->data();
-    auto cFy14 = cpts[6]->data();
-    auto cFy23 = cpts[7]->data();
-    auto W = math::to_wrench(w);
+    // Channels: Fz1, Fz2, Fz3, Fz4, Fx12, Fx34, Fy14, Fy23
     const Eigen::Map<const Eigen::Matrix<double,6,8>> X(this->calibrationMatrixData().data());
-    Eigen::Matrix<double,8,1> c;
-    for (unsigned i = 0 ; i < W.rows() ; ++i)
-    {
-      c.coeffRef(0) = cFz1[i];
-      c.coeffRef(1) = cFz2[i];
-      c.coeffRef(2) = cFz3[i];
-      c.coeffRef(3) = cFz4[i];
-      c.coeffRef(4) = cFx12[i];
-      c.coeffRef(5) = cFx34[i];
-      c.coeffRef(6) = cFy14[i];
-      c.coeffRef(7) = cFy23[i];
-      W.values().block<1,6>(i,0) = X * c;
-    }
+    ForcePlatePrivate::computeWrench<8>(this, w, samples, channels, baselines, loc, global, threshold, [&X](const double* c, double* fm) {
+      Eigen::Map<Eigen::Matrix<double,6,1>> W(fm);
+      W.noalias() = X * Eigen::Map<const Eigen::Matrix<double,8,1>>(c);
+    });
     return true;
   };
   
@@ -0,0 +1,163 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/instrument/forceplatetype6.h"
+#include "openma/instrument/forceplatetype6_p.h"
+#include "openma/base/timesequence.h"
+#include "openma/math.h"
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+namespace instrument
+{
+  ForcePlateType6Private::ForcePlateType6Private(ForcePlate* pint, const std::string& name)
+  : ForcePlateType3Private(pint, name, 6, {{"Fx1","Fy1","Fz1","Fx2","Fy2","Fz2","Fx3","Fy3","Fz3","Fx4","Fy4","Fz4"}}, 12, 12)
+  {};
+  
+  ForcePlateType6Private::~ForcePlateType6Private() _OPENMA_NOEXCEPT = default;
+};
+};
+
+#endif
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+OPENMA_INSTANCE_STATIC_TYPEID(ma::instrument::ForcePlateType6)
+
+namespace ma
+{
+namespace instrument
+{
+
+  /**
+   * @class ForcePlateType6 "openma/instrument/forceplatetype6.h"
+   * Force platform with 12 channels (the three components of the force measured by each of the four sensors: Fx1, Fy1, Fz1, ..., Fx4, Fy4, Fz4) and a calibration matrix 12x12.
+   * The calibration matrix is applied on the channels to correct the cross-talk between the sensors before the computation of the forces and moments.
+   * @important It is important to set sensor offsets with the method setSensorOffsets().
+   */
+
+  /**
+   * Constructor
+   */
+  ForcePlateType6::ForcePlateType6(const std::string& name, Node* parent)
+  : ForcePlate(*new ForcePlateType6Private(this, name), parent)
+  {};
+  
+  /**
+   * Destructor (default)
+   */
+  ForcePlateType6::~ForcePlateType6() _OPENMA_NOEXCEPT = default;
+  
+  /**
+   * Return an array of 2 sensor offsets used by the force plate to compute moments.
+   * The first offset represents the distance between the sensor axes and the y-axis of the force plate.
+   * The second offset represents the distance between the sensor axes and the x-axis of the force plate.
+   */
+  const std::array<double,2>& ForcePlateType6::sensorOffsets() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->SensorOffsets;
+  };
+  
+  /**
+   * The input @a value[0] represents the distance between the sensor axes and the y-axis of the force plate.
+   * The input @a value[1] represents the distance between the sensor axes and the x-axis of the force plate.
+   */
+  void ForcePlateType6::setSensorOffsets(const std::array<double,2>& value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (optr->SensorOffsets == value)
+      return;
+    optr->SensorOffsets = value;
+    ++optr->ConfigurationRevision;
+    this->modified();
+  };
+  
+  /**
+   * Compute the wrench from analog channel data associated with this force plate.
+   * For each sample, the calibrated sensor forces are computed by a fixed-size (12x12) matrix-vector product (vectorized by Eigen) and the forces and moments at the origin of the force plate are deduced from them in the fused computation realized by ForcePlatePrivate::computeWrench().
+   */
+  bool ForcePlateType6::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
+  {
+    auto optr = this->pimpl();
+    if (!ForcePlatePrivate::isCalibrationMatrixValid(this, optr->CalibrationMatrixData, 12, 12))
+      return false;
+    const Eigen::Map<const Eigen::Matrix<double,12,12>> X(optr->CalibrationMatrixData.data());
+    const auto offsets = optr->SensorOffsets;
+    ForcePlatePrivate::computeWrench<12>(this, w, samples, channels, baselines, loc, global, threshold, [&X,&offsets](const double* c, double* fm) {
+      Eigen::Matrix<double,12,1> s;
+      s.noalias() = X * Eigen::Map<const Eigen::Matrix<double,12,1>>(c);
+      const double &Fx1 = s[0], &Fy1 = s[1], &Fz1 = s[2], &Fx2 = s[3], &Fy2 = s[4], &Fz2 = s[5],
+                   &Fx3 = s[6], &Fy3 = s[7], &Fz3 = s[8], &Fx4 = s[9], &Fy4 = s[10], &Fz4 = s[11];
+      fm[0] = Fx1 + Fx2 + Fx3 + Fx4;
+      fm[1] = Fy1 + Fy2 + Fy3 + Fy4;
+      fm[2] = Fz1 + Fz2 + Fz3 + Fz4;
+      fm[3] = offsets[1] * (Fz1 + Fz2 - Fz3 - Fz4);
+      fm[4] = offsets[0] * (Fz2 + Fz3 - Fz1 - Fz4);
+      fm[5] = offsets[1] * (Fx3 + Fx4 - Fx1 - Fx2) + offsets[0] * (Fy1 + Fy4 - Fy2 - Fy3);
+    });
+    return true;
+  };
+  
+  /**
+   * Create a new ForcePlateType6 object on the heap
+   */
+  Node* ForcePlateType6::allocateNew() const
+  {
+    return new ForcePlateType6(this->name());
+  };
+  
+  /**
+   * Copy the content of the @a source
+   */
+  void ForcePlateType6::copyContents(const Node* source) _OPENMA_NOEXCEPT
+  {
+    auto src = node_cast<const ForcePlateType6*>(source);
+    if (src == nullptr)
+      return;
+    auto optr = this->pimpl();
+    auto optr_src = src->pimpl();
+    this->ForcePlate::copyContents(src);
+    optr->SensorOffsets = optr_src->SensorOffsets;
+  };
+};
+};
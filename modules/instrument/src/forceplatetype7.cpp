@@ -0,0 +1,177 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "openma/instrument/forceplatetype7.h"
+#include "openma/instrument/forceplatetype7_p.h"
+#include "openma/base/timesequence.h"
+#include "openma/math.h"
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace ma
+{
+namespace instrument
+{
+  ForcePlateType7Private::ForcePlateType7Private(ForcePlate* pint, const std::string& name, int type)
+  : ForcePlateType3Private(pint, name, type, {{"Fx12","Fx34","Fy14","Fy23","Fz1","Fz2","Fz3","Fz4"}}, 8, 8)
+  {};
+  
+  ForcePlateType7Private::~ForcePlateType7Private() _OPENMA_NOEXCEPT = default;
+};
+};
+
+#endif
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+OPENMA_INSTANCE_STATIC_TYPEID(ma::instrument::ForcePlateType7)
+
+namespace ma
+{
+namespace instrument
+{
+
+  /**
+   * @class ForcePlateType7 "openma/instrument/forceplatetype7.h"
+   * Force platform with 8 channels (Fx12, Fx34, Fy14, Fy23, Fz1, Fz2, Fz3, Fz4) and a calibration matrix 8x8.
+   * The channels are the same than for the force plate type 3 but they are first corrected by the calibration matrix.
+   * A manufacturer known to use this force plate is Kistler
+   * @important It is important to set sensor offsets with the method setSensorOffsets().
+   */
+
+  /**
+   * Constructor
+   */
+  ForcePlateType7::ForcePlateType7(const std::string& name, Node* parent)
+  : ForcePlateType7(*new ForcePlateType7Private(this, name, 7), parent)
+  {};
+  
+  /**
+   * Constructor to be used by inherited object sharing the same channels and the same computation of the wrench but with a different @a type (e.g. ForcePlateType11, ForcePlateType12).
+   */
+  ForcePlateType7::ForcePlateType7(const std::string& name, int type, Node* parent)
+  : ForcePlateType7(*new ForcePlateType7Private(this, name, type), parent)
+  {};
+  
+  /**
+   * Constructor to be used by inherited object which want to add informations (static properties, members, etc) to the private implementation.
+   */
+  ForcePlateType7::ForcePlateType7(ForcePlateType7Private& pimpl, Node* parent) _OPENMA_NOEXCEPT
+  : ForcePlate(pimpl, parent)
+  {};
+  
+  /**
+   * Destructor (default)
+   */
+  ForcePlateType7::~ForcePlateType7() _OPENMA_NOEXCEPT = default;
+  
+  /**
+   * Return an array of 2 sensor offsets used by the force plate to compute moments.
+   * The first offset represents the distance between the transducer axes and the y-axis of the force plate.
+   * The second offset represents the distance between the transducer axes and the x-axis of the force plate.
+   */
+  const std::array<double,2>& ForcePlateType7::sensorOffsets() const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    return optr->SensorOffsets;
+  };
+  
+  /**
+   * The input @a value[0] represents the distance between the transducer axes and the y-axis of the force plate.
+   * The input @a value[1] represents the distance between the transducer axes and the x-axis of the force plate.
+   */
+  void ForcePlateType7::setSensorOffsets(const std::array<double,2>& value) _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    if (optr->SensorOffsets == value)
+      return;
+    optr->SensorOffsets = value;
+    ++optr->ConfigurationRevision;
+    this->modified();
+  };
+  
+  /**
+   * Compute the wrench from analog channel data associated with this force plate.
+   * For each sample, the channels are corrected by a fixed-size (8x8) matrix-vector product (vectorized by Eigen) and the forces and moments at the origin of the force plate are deduced from them in the fused computation realized by ForcePlatePrivate::computeWrench().
+   */
+  bool ForcePlateType7::computeWrench(double* w, unsigned samples, const std::vector<const double*>& channels, const std::vector<double>& baselines, Location loc, bool global, double threshold)
+  {
+    auto optr = this->pimpl();
+    if (!ForcePlatePrivate::isCalibrationMatrixValid(this, optr->CalibrationMatrixData, 8, 8))
+      return false;
+    const Eigen::Map<const Eigen::Matrix<double,8,8>> X(optr->CalibrationMatrixData.data());
+    const auto offsets = optr->SensorOffsets;
+    ForcePlatePrivate::computeWrench<8>(this, w, samples, channels, baselines, loc, global, threshold, [&X,&offsets](const double* c, double* fm) {
+      Eigen::Matrix<double,8,1> s;
+      s.noalias() = X * Eigen::Map<const Eigen::Matrix<double,8,1>>(c);
+      const double &Fx12 = s[0], &Fx34 = s[1], &Fy14 = s[2], &Fy23 = s[3], &Fz1 = s[4], &Fz2 = s[5], &Fz3 = s[6], &Fz4 = s[7];
+      fm[0] = Fx12 + Fx34;
+      fm[1] = Fy14 + Fy23;
+      fm[2] = Fz1 + Fz2 + Fz3 + Fz4;
+      fm[3] = offsets[1] * (Fz1 + Fz2 - Fz3 - Fz4);
+      fm[4] = offsets[0] * (Fz2 + Fz3 - Fz1 - Fz4);
+      fm[5] = offsets[1] * (Fx34 - Fx12) + offsets[0] * (Fy14 - Fy23);
+    });
+    return true;
+  };
+  
+  /**
+   * Create a new ForcePlateType7 object on the heap
+   */
+  Node* ForcePlateType7::allocateNew() const
+  {
+    return new ForcePlateType7(this->name());
+  };
+  
+  /**
+   * Copy the content of the @a source
+   */
+  void ForcePlateType7::copyContents(const Node* source) _OPENMA_NOEXCEPT
+  {
+    auto src = node_cast<const ForcePlateType7*>(source);
+    if (src == nullptr)
+      return;
+    auto optr = this->pimpl();
+    auto optr_src = src->pimpl();
+    this->ForcePlate::copyContents(src);
+    optr->SensorOffsets = optr_src->SensorOffsets;
+  };
+};
+};
@@ -61,7 +61,13 @@
 %include "../include/openma/instrument/enums.h"
 
 %include "instrument/forceplate.i"
+%include "instrument/forceplatetype1.i"
 %include "instrument/forceplatetype2.i"
 %include "instrument/forceplatetype3.i"
 %include "instrument/forceplatetype4.i"
-%include "instrument/forceplatetype5.i"
\ No newline at end of file
+%include "instrument/forceplatetype5.i"
+%include "instrument/forceplatetype6.i"
+%include "instrument/forceplatetype7.i"
+%include "instrument/forceplatetype11.i"
+%include "instrument/forceplatetype12.i"
+%include "instrument/forceplatetype21.i"
\ No newline at end of file
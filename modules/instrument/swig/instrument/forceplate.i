@@ -46,8 +46,8 @@ namespace instrument
     %extend {
     enum class Type : int {
       Unknown = ForcePlate::Unknown,
-      // Type1 = ForcePlate::Type1,
-      // Raw9x6 = ForcePlate::Raw9x6,
+      Type1 = ForcePlate::Type1,
+      Raw9x6 = ForcePlate::Raw9x6,
       Type2 = ForcePlate::Type2,
       Raw6x6 = ForcePlate::Raw6x6,
       Type3 = ForcePlate::Type3,
@@ -56,16 +56,16 @@ namespace instrument
       Cal6x6 = ForcePlate::Cal6x6,
       Type5 = ForcePlate::Type5,
       Cal6x8 = ForcePlate::Cal6x8,
-      // Type6 = ForcePlate::Type6,
-      // Cal12x12 = ForcePlate::Cal12x12,
-      // Type7 = ForcePlate::Type7,
-      // Poly8x8 = ForcePlate::Poly8x8,
-      // Type11 = ForcePlate::Type11,
-      // KistlerSplitBeltTreadmill = ForcePlate::KistlerSplitBeltTreadmill,
-      // Type12 = ForcePlate::Type12,
-      // KistlerGaitwayTreadmill = ForcePlate::KistlerGaitwayTreadmill,
-      // Type21 = ForcePlate::Type21,
-      // AmtiStairway = ForcePlate::AmtiStairway
+      Type6 = ForcePlate::Type6,
+      Cal12x12 = ForcePlate::Cal12x12,
+      Type7 = ForcePlate::Type7,
+      Poly8x8 = ForcePlate::Poly8x8,
+      Type11 = ForcePlate::Type11,
+      KistlerSplitBeltTreadmill = ForcePlate::KistlerSplitBeltTreadmill,
+      Type12 = ForcePlate::Type12,
+      KistlerGaitwayTreadmill = ForcePlate::KistlerGaitwayTreadmill,
+      Type21 = ForcePlate::Type21,
+      AmtiStairway = ForcePlate::AmtiStairway
     };
     };
     
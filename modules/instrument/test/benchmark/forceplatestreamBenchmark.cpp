@@ -0,0 +1,55 @@
+#include <openma/instrument/forceplatetype3.h>
+#include <openma/base/timesequence.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Latency of the incremental computation of the wrench (ForcePlate::processStream) for several block sizes.
+// The force plate (type 3) is sampled at 1000 Hz and the wrench is computed at the centre of pressure in the global frame.
+int main(int , char* [])
+{
+  const unsigned samples = 100000;
+  const double rate = 1000.0;
+  ma::instrument::ForcePlateType3 fp("FP");
+  const char* labels[8] = {"Fx12","Fx34","Fy14","Fy23","Fz1","Fz2","Fz3","Fz4"};
+  for (unsigned i = 0 ; i < 8 ; ++i)
+  {
+    auto ch = new ma::TimeSequence(labels[i],1,samples,rate,0.0,ma::TimeSequence::Analog,"N");
+    for (unsigned j = 0 ; j < samples ; ++j)
+      ch->data()[j] = (i < 4 ? 10.0 : -200.0) * (1.0 + 0.5 * std::sin(0.01 * j + i));
+    fp.setChannel(labels[i], ch);
+  }
+  fp.setGeometry({{0.,0.,-40.}}, {{200.,300.,0.}}, {{-200.,300.,0.}}, {{-200.,-300.,0.}}, {{200.,-300.,0.}});
+  fp.setSensorOffsets({{120.,200.}});
+  fp.setSoftResetEnabled(true);
+  fp.setSoftResetSamples({{0,99}});
+  std::printf("%10s %10s %14s %14s %14s %16s\n", "block", "blocks", "median (us)", "p99 (us)", "max (us)", "per sample (ns)");
+  const unsigned sizes[5] = {1, 8, 32, 128, 1024};
+  std::vector<const double*> channels(8, nullptr);
+  std::vector<double> w(1024 * 10);
+  std::vector<double> latencies;
+  latencies.reserve(samples);
+  for (unsigned size : sizes)
+  {
+    fp.beginStream(ma::instrument::Location::CentreOfPressure, true);
+    latencies.clear();
+    for (unsigned offset = 0 ; offset + size <= samples ; offset += size)
+    {
+      for (unsigned i = 0 ; i < 8 ; ++i)
+        channels[i] = fp.channel(i)->data() + offset;
+      const auto start = std::chrono::high_resolution_clock::now();
+      fp.processStream(channels, size, w.data());
+      const auto end = std::chrono::high_resolution_clock::now();
+      latencies.push_back(std::chrono::duration<double,std::micro>(end - start).count());
+    }
+    fp.endStream();
+    std::sort(latencies.begin(), latencies.end());
+    const double median = latencies[latencies.size() / 2];
+    const double p99 = latencies[(latencies.size() * 99) / 100];
+    std::printf("%10u %10u %14.3f %14.3f %14.3f %16.1f\n", size, static_cast<unsigned>(latencies.size()), median, p99, latencies.back(), 1000.0 * median / size);
+  }
+  return 0;
+};
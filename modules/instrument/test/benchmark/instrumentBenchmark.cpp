@@ -0,0 +1,74 @@
+#include "benchmark.h"
+
+#include <openma/instrument/forceplatetype2.h>
+#include <openma/instrument/forceplatetype3.h>
+#include <openma/instrument/forceplatetype4.h>
+#include <openma/instrument/enums.h>
+
+// Benchmarks of the instrument module: computation of the wrench of force plates (ForcePlate::wrench) sampled at 1000 Hz.
+// The channels are marked as modified before each repetition to not measure the cached wrench (except for the task "cached").
+
+void set_forceplate_channels(ma::instrument::ForcePlate* fp, const std::vector<std::string>& labels, unsigned samples)
+{
+  for (size_t i = 0 ; i < labels.size() ; ++i)
+  {
+    auto ch = new ma::TimeSequence(labels[i], 1, samples, 1000.0, 0.0, ma::TimeSequence::Analog, "N");
+    for (unsigned j = 0 ; j < samples ; ++j)
+    {
+      // Simple stance phase repeated every second (the vertical channels are larger)
+      const double t = static_cast<double>(j % 1000) / 1000.0;
+      const double stance = (t < 0.6) ? std::sin(M_PI * t / 0.6) : 0.0;
+      ch->data()[j] = ((labels.size() == 8) ? (i < 4 ? 20.0 : -200.0) : (i == 2 ? -700.0 : 30.0 * (i+1))) * stance + 0.01 * std::sin(0.1 * j + i);
+    }
+    fp->setChannel(labels[i], ch);
+  }
+  fp->setGeometry({{0.,0.,-40.}}, {{200.,300.,0.}}, {{-200.,300.,0.}}, {{-200.,-300.,0.}}, {{200.,-300.,0.}});
+};
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("instrument", argc, argv);
+  const unsigned samples = bench.samples() * 10; // 1000 Hz
+
+  ma::instrument::ForcePlateType2 fp2("FP2");
+  set_forceplate_channels(&fp2, {"Fx","Fy","Fz","Mx","My","Mz"}, samples);
+  ma::instrument::ForcePlateType3 fp3("FP3");
+  set_forceplate_channels(&fp3, {"Fx12","Fx34","Fy14","Fy23","Fz1","Fz2","Fz3","Fz4"}, samples);
+  fp3.setSensorOffsets({{120.,200.}});
+  ma::instrument::ForcePlateType4 fp4("FP4");
+  set_forceplate_channels(&fp4, {"Fx","Fy","Fz","Mx","My","Mz"}, samples);
+  std::vector<double> cal(36, 0.0);
+  for (unsigned i = 0 ; i < 6 ; ++i)
+  {
+    for (unsigned j = 0 ; j < 6 ; ++j)
+      cal[i*6+j] = (i == j) ? 1.5 : 0.01;
+  }
+  fp4.setCalibrationMatrixData(cal);
+
+  auto invalidate = [](ma::instrument::ForcePlate* fp) {
+    return [fp]() {fp->channel(0)->modified();};
+  };
+  bench.run("forceplate.type2.wrench.origin", samples, invalidate(&fp2), [&]() {
+    ma::benchmark::do_not_optimize(fp2.wrench(ma::instrument::Location::Origin));
+  });
+  bench.run("forceplate.type2.wrench.cop", samples, invalidate(&fp2), [&]() {
+    ma::benchmark::do_not_optimize(fp2.wrench(ma::instrument::Location::CentreOfPressure));
+  });
+  bench.run("forceplate.type2.wrench.pwa", samples, invalidate(&fp2), [&]() {
+    ma::benchmark::do_not_optimize(fp2.wrench(ma::instrument::Location::PointOfApplication));
+  });
+  bench.run("forceplate.type2.wrench.pwa_100Hz", samples, invalidate(&fp2), [&]() {
+    ma::benchmark::do_not_optimize(fp2.wrench(ma::instrument::Location::PointOfApplication, true, 10.0, 100.0));
+  });
+  bench.run("forceplate.type2.wrench.cached", samples, [&]() {
+    ma::benchmark::do_not_optimize(fp2.wrench(ma::instrument::Location::PointOfApplication));
+  });
+  bench.run("forceplate.type3.wrench.cop", samples, invalidate(&fp3), [&]() {
+    ma::benchmark::do_not_optimize(fp3.wrench(ma::instrument::Location::CentreOfPressure));
+  });
+  bench.run("forceplate.type4.wrench.cop", samples, invalidate(&fp4), [&]() {
+    ma::benchmark::do_not_optimize(fp4.wrench(ma::instrument::Location::CentreOfPressure));
+  });
+
+  return bench.report();
+};
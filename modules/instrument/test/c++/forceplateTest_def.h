@@ -3,9 +3,12 @@
 
 #include <openma/instrument/forceplate.h>
 #include <openma/instrument/forceplatetype3.h>
+#include <openma/instrument/forceplatetype7.h>
 #include <openma/base/timesequence.h>
 #include <openma/math.h>
 
+#include <Eigen/LU> // Inverse
+
 static unsigned sample10_fpsamples = 22;
 static unsigned gait1_fpsamples = 17;
 static unsigned gaitfb1_fpsamples = 198;
@@ -376,7 +379,8 @@ void forceplatetest_compare_fp5_clone(ma::instrument::ForcePlate* ref, ma::instr
   TS_ASSERT_DIFFERS(ref->channel("Fy23"), clone->channel("Fy23"));
 };
 
-void forceplatetest_fill_gaitfb1_type3(ma::instrument::ForcePlateType3* fp)
+template <typename T>
+void forceplatetest_fill_gaitfb1_type3(T* fp)
 {
   double rate = 100.0;
   double start = 0.0;
@@ -406,7 +410,7 @@ void forceplatetest_fill_gaitfb1_type3(ma::instrument::ForcePlateType3* fp)
   fp->setChannel("Fz4", p8);
   fp->setGeometry(fp3rso, fp3sc1, fp3sc2, fp3sc3, fp3sc4);
   fp->setSensorOffsets(fp3offsets);
-  TS_ASSERT_EQUALS(fp->channels()->findChildren<ma::TimeSequence*>({},{},false).size(),8ul);
+  TS_ASSERT_EQUALS(fp->channels()->template findChildren<ma::TimeSequence*>({},{},false).size(),8ul);
 };
 
 void forceplatetest_compare_gaitfb1_type3_wrench_local(ma::instrument::ForcePlate* fp)
@@ -505,4 +509,35 @@ void forceplatetest_compare_fp3_clone(ma::instrument::ForcePlate* ref, ma::instr
   TS_ASSERT_DIFFERS(ref->channel("Fy23"), clone->channel("Fy23"));
 };
 
+// The channels of the force plate type 3 are transformed by the inverse of the calibration matrix to have the same wrench
+void forceplatetest_fill_gaitfb1_type7(ma::instrument::ForcePlateType7* fp, const std::vector<double>& cal)
+{
+  forceplatetest_fill_gaitfb1_type3(fp);
+  const Eigen::Map<const Eigen::Matrix<double,8,8>> X(cal.data());
+  const Eigen::Matrix<double,8,8> Xinv = X.inverse();
+  const Eigen::Map<const Eigen::Matrix<double,Eigen::Dynamic,8>> s(fp3datain, gaitfb1_fpsamples, 8);
+  const Eigen::Matrix<double,Eigen::Dynamic,8> c = s * Xinv.transpose();
+  const char* labels[8] = {"Fx12","Fx34","Fy14","Fy23","Fz1","Fz2","Fz3","Fz4"};
+  for (unsigned i = 0 ; i < 8 ; ++i)
+    std::copy_n(c.col(i).data(), gaitfb1_fpsamples, fp->channel(labels[i])->data());
+  fp->setCalibrationMatrixData(cal);
+};
+
+std::vector<double> forceplatetest_crosstalk_calibration8()
+{
+  std::vector<double> cal(64, 0.0);
+  for (unsigned j = 0 ; j < 8 ; ++j)
+    for (unsigned i = 0 ; i < 8 ; ++i)
+      cal[j*8+i] = (i == j) ? 1.0 - 0.015 * i : 0.003 * (static_cast<double>(j) - static_cast<double>(i));
+  return cal;
+};
+
+std::vector<double> forceplatetest_identity_calibration8()
+{
+  std::vector<double> cal(64, 0.0);
+  for (unsigned i = 0 ; i < 8 ; ++i)
+    cal[i*8+i] = 1.0;
+  return cal;
+};
+
 #endif // forceplateTest_def_h
\ No newline at end of file
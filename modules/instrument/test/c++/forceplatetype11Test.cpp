@@ -0,0 +1,71 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype11.h>
+#include <openma/instrument/forceplatetype12.h>
+
+CXXTEST_SUITE(ForcePlateType11Test)
+{
+  CXXTEST_TEST(type)
+  {
+    ma::instrument::ForcePlateType11 fp("FP");
+    TS_ASSERT_EQUALS(fp.type(), 11);
+    TS_ASSERT_EQUALS(fp.channelsNumberRequired(), 8u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[0], 8u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[1], 8u);
+  };
+  
+  CXXTEST_TEST(wrench_local)
+  {
+    ma::instrument::ForcePlateType11 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_global)
+  {
+    ma::instrument::ForcePlateType11 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType11 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    auto fp11_ = static_cast<ma::instrument::ForcePlate*>(fp.clone());
+    TS_ASSERT_EQUALS(fp11_->type(), 11);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType11*>(fp11_), fp11_);
+    forceplatetest_compare_fp3_clone(&fp, fp11_);
+    forceplatetest_compare_gaitfb1_type3_wrench_local(fp11_);
+    delete fp11_;
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType11 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_identity_calibration8());
+    fp.setCalibrationMatrixData(std::vector<double>(36, 1.0));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType7 fp7("FP7", &root);
+    ma::instrument::ForcePlateType11 fp("FP11", &root);
+    TS_ASSERT_EQUALS(root.findChildren<ma::instrument::ForcePlateType7*>().size(), 2ul);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType11*>(), &fp);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType7*>(&fp), &fp);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType12*>(static_cast<ma::Node*>(&fp)), nullptr);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType11Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, type)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, wrench_local)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, wrench_global)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, wrongCalibration)
+CXXTEST_TEST_REGISTRATION(ForcePlateType11Test, nodeid)
@@ -0,0 +1,71 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype11.h>
+#include <openma/instrument/forceplatetype12.h>
+
+CXXTEST_SUITE(ForcePlateType12Test)
+{
+  CXXTEST_TEST(type)
+  {
+    ma::instrument::ForcePlateType12 fp("FP");
+    TS_ASSERT_EQUALS(fp.type(), 12);
+    TS_ASSERT_EQUALS(fp.channelsNumberRequired(), 8u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[0], 8u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[1], 8u);
+  };
+  
+  CXXTEST_TEST(wrench_local)
+  {
+    ma::instrument::ForcePlateType12 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_global)
+  {
+    ma::instrument::ForcePlateType12 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType12 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    auto fp12_ = static_cast<ma::instrument::ForcePlate*>(fp.clone());
+    TS_ASSERT_EQUALS(fp12_->type(), 12);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType12*>(fp12_), fp12_);
+    forceplatetest_compare_fp3_clone(&fp, fp12_);
+    forceplatetest_compare_gaitfb1_type3_wrench_local(fp12_);
+    delete fp12_;
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType12 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_identity_calibration8());
+    fp.setCalibrationMatrixData(std::vector<double>(36, 1.0));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType7 fp7("FP7", &root);
+    ma::instrument::ForcePlateType12 fp("FP12", &root);
+    TS_ASSERT_EQUALS(root.findChildren<ma::instrument::ForcePlateType7*>().size(), 2ul);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType12*>(), &fp);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType7*>(&fp), &fp);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType11*>(static_cast<ma::Node*>(&fp)), nullptr);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType12Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, type)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, wrench_local)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, wrench_global)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, wrongCalibration)
+CXXTEST_TEST_REGISTRATION(ForcePlateType12Test, nodeid)
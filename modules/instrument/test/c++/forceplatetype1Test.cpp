@@ -0,0 +1,119 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype1.h>
+
+void forceplatetest_fill_type1(ma::instrument::ForcePlate* fp)
+{
+  const unsigned samples = 5;
+  const double rate = 100.0;
+  // Fx, Fy, Fz, Px, Py, Tz
+  const double data[30] = {
+    10., 12., -5., 0., 3.,
+    -2., 4., 8., 1., -7.,
+    -700., -650., -720., -300., -800.,
+    15., -25., 40., 0., 120.,
+    -35., 60., 12., -80., 5.,
+    1500., -200., 0., 350., -1200.
+  };
+  const char* labels[6] = {"Fx","Fy","Fz","Px","Py","Tz"};
+  for (unsigned i = 0 ; i < 6 ; ++i)
+  {
+    auto ch = new ma::TimeSequence("Channel_0" + std::to_string(i+1),1,samples,rate,0.0,ma::TimeSequence::Analog,i < 3 ? "N" : (i < 5 ? "mm" : "Nmm"));
+    std::copy_n(data+i*samples, samples, ch->data());
+    fp->setChannel(labels[i], ch);
+  }
+  fp->setGeometry({{0.,0.,-10.}}, {{250.,300.,0.}}, {{-250.,300.,0.}}, {{-250.,-300.,0.}}, {{250.,-300.,0.}});
+};
+
+CXXTEST_SUITE(ForcePlateType1Test)
+{
+  CXXTEST_TEST(centreOfPressure)
+  {
+    ma::instrument::ForcePlateType1 fp("FP");
+    forceplatetest_fill_type1(&fp);
+    auto w = fp.wrench(ma::instrument::Location::CentreOfPressure, false, 0.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    const unsigned samples = 5;
+    const auto& o = fp.relativeSurfaceOrigin();
+    auto Fx = fp.channel("Fx")->data(), Fy = fp.channel("Fy")->data(), Fz = fp.channel("Fz")->data();
+    auto Px = fp.channel("Px")->data(), Py = fp.channel("Py")->data(), Tz = fp.channel("Tz")->data();
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      const std::string s = std::to_string(i);
+      TSM_ASSERT_DELTA(s, w->data()[i],           Fx[i], 1e-12);
+      TSM_ASSERT_DELTA(s, w->data()[i+samples],   Fy[i], 1e-12);
+      TSM_ASSERT_DELTA(s, w->data()[i+2*samples], Fz[i], 1e-12);
+      // Only the free moment remains around the vertical axis at the centre of pressure
+      TSM_ASSERT_DELTA(s, w->data()[i+5*samples], Tz[i], 1e-9);
+      TSM_ASSERT_DELTA(s, w->data()[i+6*samples], Px[i]+o[0], 1e-9);
+      TSM_ASSERT_DELTA(s, w->data()[i+7*samples], Py[i]+o[1], 1e-9);
+      TSM_ASSERT_DELTA(s, w->data()[i+8*samples], o[2], 1e-9);
+    }
+  };
+  
+  CXXTEST_TEST(wrenchAtOrigin)
+  {
+    ma::instrument::ForcePlateType1 fp("FP");
+    forceplatetest_fill_type1(&fp);
+    auto w = fp.wrench(ma::instrument::Location::Origin, false, 0.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    const unsigned samples = 5;
+    const auto& o = fp.relativeSurfaceOrigin();
+    auto Fx = fp.channel("Fx")->data(), Fy = fp.channel("Fy")->data(), Fz = fp.channel("Fz")->data();
+    auto Px = fp.channel("Px")->data(), Py = fp.channel("Py")->data(), Tz = fp.channel("Tz")->data();
+    for (unsigned i = 0 ; i < samples ; ++i)
+    {
+      const std::string s = std::to_string(i);
+      const double P[3] = {Px[i]+o[0], Py[i]+o[1], o[2]};
+      TSM_ASSERT_DELTA(s, w->data()[i+3*samples], P[1] * Fz[i] - P[2] * Fy[i], 1e-9);
+      TSM_ASSERT_DELTA(s, w->data()[i+4*samples], P[2] * Fx[i] - P[0] * Fz[i], 1e-9);
+      TSM_ASSERT_DELTA(s, w->data()[i+5*samples], Tz[i] + P[0] * Fy[i] - P[1] * Fx[i], 1e-9);
+    }
+  };
+  
+  CXXTEST_TEST(softReset)
+  {
+    ma::instrument::ForcePlateType1 fp("FP");
+    forceplatetest_fill_type1(&fp);
+    fp.setSoftResetSamples({{0,1}});
+    fp.setSoftResetEnabled(true);
+    auto w = fp.wrench(ma::instrument::Location::CentreOfPressure, false, 0.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    const unsigned samples = 5;
+    const auto& o = fp.relativeSurfaceOrigin();
+    auto Fz = fp.channel("Fz")->data(), Px = fp.channel("Px")->data(), Py = fp.channel("Py")->data();
+    // The baseline is removed from the forces but not from the position of the centre of pressure
+    TS_ASSERT_DELTA(w->data()[2+2*samples], Fz[2] - (Fz[0]+Fz[1])/2.0, 1e-9);
+    TS_ASSERT_DELTA(w->data()[2+6*samples], Px[2]+o[0], 1e-9);
+    TS_ASSERT_DELTA(w->data()[2+7*samples], Py[2]+o[1], 1e-9);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType1 fp("FP");
+    forceplatetest_fill_type1(&fp);
+    auto fp1_ = static_cast<ma::instrument::ForcePlateType1*>(fp.clone());
+    TS_ASSERT_EQUALS(fp1_->type(), 1);
+    forceplatetest_compare_fp_clone(&fp, fp1_);
+    auto w1 = fp.wrench(ma::instrument::Location::Origin), w2 = fp1_->wrench(ma::instrument::Location::Origin);
+    for (unsigned i = 0 ; i < w1->elements() ; ++i)
+      TS_ASSERT_DELTA(w1->data()[i], w2->data()[i], 1e-15);
+    delete fp1_;
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType1 fp("FP", &root);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType1*>(), &fp);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType1Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType1Test, centreOfPressure)
+CXXTEST_TEST_REGISTRATION(ForcePlateType1Test, wrenchAtOrigin)
+CXXTEST_TEST_REGISTRATION(ForcePlateType1Test, softReset)
+CXXTEST_TEST_REGISTRATION(ForcePlateType1Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType1Test, nodeid)
@@ -0,0 +1,62 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype4.h>
+#include <openma/instrument/forceplatetype21.h>
+
+CXXTEST_SUITE(ForcePlateType21Test)
+{
+  CXXTEST_TEST(type)
+  {
+    ma::instrument::ForcePlateType21 fp("FP");
+    TS_ASSERT_EQUALS(fp.type(), 21);
+    TS_ASSERT_EQUALS(fp.channelsNumberRequired(), 6u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[0], 6u);
+    TS_ASSERT_EQUALS(fp.calibrationMatrixDimensions()[1], 6u);
+  };
+  
+  CXXTEST_TEST(wrench)
+  {
+    ma::instrument::ForcePlateType21 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    forceplatetest_compare_sample10_wrench_at_origin(&fp, fp4dataout);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType21 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    auto fp21_ = static_cast<ma::instrument::ForcePlate*>(fp.clone());
+    TS_ASSERT_EQUALS(fp21_->type(), 21);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType21*>(fp21_), fp21_);
+    forceplatetest_compare_fp4_clone(&fp, fp21_);
+    forceplatetest_compare_sample10_wrench_at_origin(fp21_, fp4dataout);
+    delete fp21_;
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType21 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    fp.setCalibrationMatrixData(std::vector<double>(fp4cal,fp4cal+30));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType4 fp4("FP4", &root);
+    ma::instrument::ForcePlateType21 fp("FP21", &root);
+    TS_ASSERT_EQUALS(root.findChildren<ma::instrument::ForcePlateType4*>().size(), 2ul);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType21*>(), &fp);
+    TS_ASSERT_EQUALS(ma::node_cast<ma::instrument::ForcePlateType4*>(&fp), &fp);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType21Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType21Test, type)
+CXXTEST_TEST_REGISTRATION(ForcePlateType21Test, wrench)
+CXXTEST_TEST_REGISTRATION(ForcePlateType21Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType21Test, wrongCalibration)
+CXXTEST_TEST_REGISTRATION(ForcePlateType21Test, nodeid)
@@ -4,6 +4,8 @@
 
 #include <openma/instrument/forceplatetype2.h>
 
+#include <Eigen_openma/SignalProcessing/Resample.h>
+
 CXXTEST_SUITE(ForcePlateType2Test)
 {
   CXXTEST_TEST(wrench)
@@ -55,6 +57,101 @@ CXXTEST_SUITE(ForcePlateType2Test)
       TSM_ASSERT_DELTA(s, w->data()[i+5*sample10_fpsamples], fp2data[i+5*sample10_fpsamples] - -4563.57997, 1e-4);
     }
   }
+  
+  CXXTEST_TEST(downsampledWrench)
+  {
+    ma::instrument::ForcePlateType2 fp("FP");
+    forceplatetest_fill_sample10_type2(&fp);
+    fp.setSoftResetEnabled(true);
+    auto w = fp.wrench(ma::instrument::Location::Origin, true, 5.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    auto wd = fp.wrench(ma::instrument::Location::Origin, true, 5.0, w->sampleRate() / 2.0);
+    TS_ASSERT_DIFFERS(wd, nullptr);
+    TS_ASSERT_DIFFERS(wd, w);
+    TS_ASSERT_EQUALS(wd->samples(), sample10_fpsamples / 2);
+    TS_ASSERT_EQUALS(wd->sampleRate(), w->sampleRate() / 2.0);
+    // The computation at the origin is linear: resampling the channels or the wrench must give the same result
+    for (unsigned j = 0 ; j < 10 ; ++j)
+    {
+      Eigen::Matrix<double,Eigen::Dynamic,1> ref = Eigen::resample(Eigen::Matrix<double,Eigen::Dynamic,1>(Eigen::Map<const Eigen::Matrix<double,Eigen::Dynamic,1>>(w->data()+j*w->samples(), w->samples())), 1, 2);
+      for (unsigned i = 0 ; i < wd->samples() ; ++i)
+        TSM_ASSERT_DELTA(std::to_string(j) + ":" + std::to_string(i), wd->data()[i+j*wd->samples()], ref(i), 1e-9);
+    }
+    TS_ASSERT_EQUALS(fp.findChild("TempChannels"), nullptr);
+  }
+  
+  CXXTEST_TEST(resampledWrenchNonIntegerRatio)
+  {
+    ma::instrument::ForcePlateType2 fp("FP");
+    forceplatetest_fill_sample10_type2(&fp);
+    auto w = fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    auto wr = fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0, w->sampleRate() * 3.0 / 5.0);
+    TS_ASSERT_DIFFERS(wr, nullptr);
+    TS_ASSERT_EQUALS(wr->samples(), (sample10_fpsamples - 1) * 3 / 5 + 1);
+    TS_ASSERT_DELTA(wr->sampleRate(), w->sampleRate() * 3.0 / 5.0, 1e-12);
+    TS_ASSERT_EQUALS(wr->startTime(), w->startTime());
+    // Ratio which cannot be approximated with the default settings
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0, w->sampleRate() / 20000.0), nullptr);
+  }
+  
+  CXXTEST_TEST(wrenchCache)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType2 fp("FP", &root);
+    forceplatetest_fill_sample10_type2(&fp);
+    auto w = fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    auto ts = w->timestamp();
+    // Same settings: the cached output is returned without computation
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_EQUALS(w->timestamp(), ts);
+    // Different threshold: another output
+    auto w2 = fp.wrench(ma::instrument::Location::CentreOfPressure, true, 10.0);
+    TS_ASSERT_DIFFERS(w2, nullptr);
+    TS_ASSERT_DIFFERS(w2, w);
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_EQUALS(w->timestamp(), ts);
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 10.0), w2);
+    // The modification of the plate by its outputs or its parent does not invalidate the cache
+    root.modified();
+    fp.outputs()->modified();
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_EQUALS(w->timestamp(), ts);
+    // Modified channel
+    auto fz = fp.channel("Fz");
+    const double fz0 = fz->data()[0];
+    fz->data()[0] = 2.0 * fz0;
+    fz->modified();
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin, false, 5.0)->data()[2*sample10_fpsamples], 2.0 * fz0);
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_LESS_THAN(ts, w->timestamp());
+    ts = w->timestamp();
+    // Soft reset
+    fp.setSoftResetEnabled(true);
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_LESS_THAN(ts, w->timestamp());
+    ts = w->timestamp();
+    fp.setSoftResetSamples({{0,5}});
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_LESS_THAN(ts, w->timestamp());
+    ts = w->timestamp();
+    // Geometry
+    fp.setGeometry({{0.,0.,-10.}},{{100.,200.,0.}},{{-100.,200.,0.}},{{-100.,-200.,0.}},{{100.,-200.,0.}});
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_LESS_THAN(ts, w->timestamp());
+    ts = w->timestamp();
+    // Replaced channel
+    fp.setChannel("Fz", static_cast<ma::TimeSequence*>(fz->clone()));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0), w);
+    TS_ASSERT_LESS_THAN(ts, w->timestamp());
+    ts = w->timestamp();
+    // Deleted output
+    delete w;
+    w = fp.wrench(ma::instrument::Location::CentreOfPressure, true, 5.0);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    TS_ASSERT_EQUALS(fp.outputs()->findChildren<ma::TimeSequence*>({},{},false).size(), 3ul);
+  }
 };
 
 CXXTEST_SUITE_REGISTRATION(ForcePlateType2Test)
@@ -62,4 +159,7 @@ CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, wrench)
 CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, pointOfApplicationCrossVerification)
 CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, clone)
 CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, nodeid)
-CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, softReset)
\ No newline at end of file
+CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, softReset)
+CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, downsampledWrench)
+CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, resampledWrenchNonIntegerRatio)
+CXXTEST_TEST_REGISTRATION(ForcePlateType2Test, wrenchCache)
\ No newline at end of file
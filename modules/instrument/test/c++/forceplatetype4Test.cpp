@@ -24,6 +24,79 @@ CXXTEST_SUITE(ForcePlateType4Test)
     delete fp4_;
   };
   
+  CXXTEST_TEST(stream)
+  {
+    ma::instrument::ForcePlateType4 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    fp.setSoftResetEnabled(true);
+    auto ref = fp.wrench(ma::instrument::Location::CentreOfPressure, true);
+    TS_ASSERT_DIFFERS(ref, nullptr);
+    TS_ASSERT_EQUALS(fp.isStreaming(), false);
+    TS_ASSERT_EQUALS(fp.beginStream(ma::instrument::Location::CentreOfPressure, true), true);
+    TS_ASSERT_EQUALS(fp.isStreaming(), true);
+    // The soft reset window (samples 0 to 9) is completed by the first block
+    const unsigned blocks[3] = {10, 1, 11};
+    std::vector<const double*> channels(6, nullptr);
+    std::vector<double> w;
+    unsigned offset = 0;
+    for (unsigned b = 0 ; b < 3 ; ++b)
+    {
+      for (unsigned i = 0 ; i < 6 ; ++i)
+        channels[i] = fp.channel(i)->data() + offset;
+      w.resize(blocks[b] * 10);
+      TS_ASSERT_EQUALS(fp.processStream(channels, blocks[b], w.data()), true);
+      for (unsigned c = 0 ; c < 10 ; ++c)
+        for (unsigned i = 0 ; i < blocks[b] ; ++i)
+          TS_ASSERT_DELTA(w[i + c * blocks[b]], ref->data()[offset + i + c * sample10_fpsamples], 1e-10);
+      offset += blocks[b];
+    }
+    TS_ASSERT_EQUALS(fp.streamedSamples(), sample10_fpsamples);
+    fp.endStream();
+    TS_ASSERT_EQUALS(fp.processStream(channels, 1, w.data()), false);
+  };
+  
+  CXXTEST_TEST(streamPartialBaseline)
+  {
+    ma::instrument::ForcePlateType4 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    fp.setSoftResetEnabled(true);
+    fp.setSoftResetSamples({{1,4}});
+    TS_ASSERT_EQUALS(fp.beginStream(ma::instrument::Location::Origin, false), true);
+    std::vector<const double*> channels(6, nullptr);
+    double w[30], wref[30];
+    // The first block contains only the samples 1 and 2 of the soft reset window
+    for (unsigned i = 0 ; i < 6 ; ++i)
+      channels[i] = fp.channel(i)->data();
+    TS_ASSERT_EQUALS(fp.processStream(channels, 3, w), true);
+    // Same computation without soft reset but with the channels corrected manually
+    ma::instrument::ForcePlateType4 fpref("FPRef");
+    forceplatetest_fill_sample10_type4(&fpref);
+    std::vector<std::vector<double>> corrected(6, std::vector<double>(3));
+    for (unsigned i = 0 ; i < 6 ; ++i)
+    {
+      const double* d = fp.channel(i)->data();
+      const double baseline = (d[1] + d[2]) / 2.0;
+      for (unsigned j = 0 ; j < 3 ; ++j)
+        corrected[i][j] = d[j] - baseline;
+      channels[i] = corrected[i].data();
+    }
+    TS_ASSERT_EQUALS(fpref.beginStream(ma::instrument::Location::Origin, false), true);
+    TS_ASSERT_EQUALS(fpref.processStream(channels, 3, wref), true);
+    for (unsigned i = 0 ; i < 30 ; ++i)
+      TS_ASSERT_DELTA(w[i], wref[i], 1e-10);
+    // Wrong number of channels
+    channels.resize(5);
+    TS_ASSERT_EQUALS(fp.processStream(channels, 3, w), false);
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType4 fp("FP");
+    forceplatetest_fill_sample10_type4(&fp);
+    fp.setCalibrationMatrixData(std::vector<double>(fp4cal,fp4cal+30));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
   CXXTEST_TEST(nodeid)
   {
     ma::Node root("root");
@@ -35,4 +108,7 @@ CXXTEST_SUITE(ForcePlateType4Test)
 CXXTEST_SUITE_REGISTRATION(ForcePlateType4Test)
 CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, wrench)
 CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, stream)
+CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, streamPartialBaseline)
+CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, wrongCalibration)
 CXXTEST_TEST_REGISTRATION(ForcePlateType4Test, nodeid)
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype6.h>
+
+#include <Eigen/LU> // Inverse
+
+// The channels of the force plate type 3 are split between the four sensors to have the same wrench
+void forceplatetest_fill_gaitfb1_type6(ma::instrument::ForcePlateType6* fp, const std::vector<double>& cal)
+{
+  double rate = 100.0;
+  double start = 0.0;
+  const char* labels[12] = {"Fx1","Fy1","Fz1","Fx2","Fy2","Fz2","Fx3","Fy3","Fz3","Fx4","Fy4","Fz4"};
+  // Index of the type 3 channel (Fx12, Fx34, Fy14, Fy23, Fz1, Fz2, Fz3, Fz4) and its ratio for each sensor channel
+  const unsigned idx[12] = {0,2,4,0,3,5,1,3,6,1,2,7};
+  const double ratio[12] = {.5,.5,1.,.5,.5,1.,.5,.5,1.,.5,.5,1.};
+  // The calibration matrix is inverted to obtain the raw channels
+  const Eigen::Map<const Eigen::Matrix<double,12,12>> X(cal.data());
+  const Eigen::Matrix<double,12,12> Xinv = X.inverse();
+  Eigen::Matrix<double,Eigen::Dynamic,12> s(gaitfb1_fpsamples,12);
+  for (unsigned i = 0 ; i < 12 ; ++i)
+    s.col(i) = Eigen::Map<const Eigen::Matrix<double,Eigen::Dynamic,1>>(fp3datain+idx[i]*gaitfb1_fpsamples, gaitfb1_fpsamples) * ratio[i];
+  const Eigen::Matrix<double,Eigen::Dynamic,12> c = s * Xinv.transpose();
+  for (unsigned i = 0 ; i < 12 ; ++i)
+  {
+    auto ch = new ma::TimeSequence("Channel_" + std::to_string(i+1),1,gaitfb1_fpsamples,rate,start,ma::TimeSequence::Analog,"N");
+    std::copy_n(c.col(i).data(), gaitfb1_fpsamples, ch->data());
+    fp->setChannel(labels[i], ch);
+  }
+  fp->setGeometry(fp3rso, fp3sc1, fp3sc2, fp3sc3, fp3sc4);
+  fp->setSensorOffsets(fp3offsets);
+  fp->setCalibrationMatrixData(cal);
+  TS_ASSERT_EQUALS(fp->channels()->findChildren<ma::TimeSequence*>({},{},false).size(),12ul);
+};
+
+std::vector<double> forceplatetest_identity_calibration(unsigned n)
+{
+  std::vector<double> cal(n*n, 0.0);
+  for (unsigned i = 0 ; i < n ; ++i)
+    cal[i*n+i] = 1.0;
+  return cal;
+};
+
+std::vector<double> forceplatetest_crosstalk_calibration(unsigned n)
+{
+  std::vector<double> cal(n*n, 0.0);
+  for (unsigned j = 0 ; j < n ; ++j)
+    for (unsigned i = 0 ; i < n ; ++i)
+      cal[j*n+i] = (i == j) ? 1.0 + 0.01 * i : 0.002 * (static_cast<double>(i) - static_cast<double>(j));
+  return cal;
+};
+
+CXXTEST_SUITE(ForcePlateType6Test)
+{
+  CXXTEST_TEST(wrench_local)
+  {
+    ma::instrument::ForcePlateType6 fp("FP");
+    forceplatetest_fill_gaitfb1_type6(&fp, forceplatetest_identity_calibration(12));
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_global)
+  {
+    ma::instrument::ForcePlateType6 fp("FP");
+    forceplatetest_fill_gaitfb1_type6(&fp, forceplatetest_identity_calibration(12));
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_crosstalk)
+  {
+    ma::instrument::ForcePlateType6 fp("FP");
+    forceplatetest_fill_gaitfb1_type6(&fp, forceplatetest_crosstalk_calibration(12));
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType6 fp("FP");
+    forceplatetest_fill_gaitfb1_type6(&fp, forceplatetest_crosstalk_calibration(12));
+    auto fp6_ = static_cast<ma::instrument::ForcePlateType6*>(fp.clone());
+    TS_ASSERT_EQUALS(fp6_->type(), 6);
+    forceplatetest_compare_fp_clone(&fp, fp6_);
+    TS_ASSERT_DELTA(fp.sensorOffsets()[0], fp6_->sensorOffsets()[0], 1e-15);
+    TS_ASSERT_DELTA(fp.sensorOffsets()[1], fp6_->sensorOffsets()[1], 1e-15);
+    forceplatetest_compare_gaitfb1_type3_wrench_local(fp6_);
+    delete fp6_;
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType6 fp("FP");
+    forceplatetest_fill_gaitfb1_type6(&fp, forceplatetest_identity_calibration(12));
+    fp.setCalibrationMatrixData(forceplatetest_identity_calibration(8));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType6 fp("FP", &root);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType6*>(), &fp);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType6Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, wrench_local)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, wrench_global)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, wrench_crosstalk)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, wrongCalibration)
+CXXTEST_TEST_REGISTRATION(ForcePlateType6Test, nodeid)
@@ -0,0 +1,64 @@
+#include <cxxtest/TestDrive.h>
+
+#include "forceplateTest_def.h"
+
+#include <openma/instrument/forceplatetype7.h>
+
+CXXTEST_SUITE(ForcePlateType7Test)
+{
+  CXXTEST_TEST(wrench_local)
+  {
+    ma::instrument::ForcePlateType7 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_identity_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_global)
+  {
+    ma::instrument::ForcePlateType7 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_identity_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(wrench_crosstalk)
+  {
+    ma::instrument::ForcePlateType7 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    forceplatetest_compare_gaitfb1_type3_wrench_local(&fp);
+    forceplatetest_compare_gaitfb1_type3_wrench_global(&fp);
+  };
+  
+  CXXTEST_TEST(clone)
+  {
+    ma::instrument::ForcePlateType7 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_crosstalk_calibration8());
+    auto fp7_ = static_cast<ma::instrument::ForcePlateType7*>(fp.clone());
+    TS_ASSERT_EQUALS(fp7_->type(), 7);
+    forceplatetest_compare_fp3_clone(&fp, fp7_);
+    forceplatetest_compare_gaitfb1_type3_wrench_local(fp7_);
+    delete fp7_;
+  };
+  
+  CXXTEST_TEST(wrongCalibration)
+  {
+    ma::instrument::ForcePlateType7 fp("FP");
+    forceplatetest_fill_gaitfb1_type7(&fp, forceplatetest_identity_calibration8());
+    fp.setCalibrationMatrixData(std::vector<double>(36, 1.0));
+    TS_ASSERT_EQUALS(fp.wrench(ma::instrument::Location::Origin), nullptr);
+  };
+  
+  CXXTEST_TEST(nodeid)
+  {
+    ma::Node root("root");
+    ma::instrument::ForcePlateType7 fp("FP", &root);
+    TS_ASSERT_EQUALS(root.findChild<ma::instrument::ForcePlateType7*>(), &fp);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(ForcePlateType7Test)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, wrench_local)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, wrench_global)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, wrench_crosstalk)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, clone)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, wrongCalibration)
+CXXTEST_TEST_REGISTRATION(ForcePlateType7Test, nodeid)
@@ -39,6 +39,7 @@
 #include "openma/base/opaque.h"
 #include "openma/base/macros.h" // _OPENMA_CONSTEXPR, _OPENMA_NOEXCEPT
 #include "openma/base/exception.h"
+#include "openma/base/any.h"
 
 #include <string>
 #include <memory> // std::unique_ptr
@@ -80,6 +81,9 @@ namespace io
     Device* device() const _OPENMA_NOEXCEPT;
     void setDevice(Device* device) _OPENMA_NOEXCEPT;
     
+    Any option(const std::string& name) const _OPENMA_NOEXCEPT;
+    void setOption(const std::string& name, const Any& value);
+    
     Error errorCode() const _OPENMA_NOEXCEPT;
     const std::string& errorMessage() const _OPENMA_NOEXCEPT;
   
@@ -43,7 +43,10 @@
 #include "openma/io/handler.h"
 #include "openma/base/macros.h" // _OPENMA_NOEXCEPT
 
+#include "openma/base/any.h"
+
 #include <string>
+#include <unordered_map>
 
 namespace ma
 {
@@ -66,6 +69,7 @@ namespace io
     Device* Source;
     Error ErrorCode;
     std::string ErrorMessage;
+    std::unordered_map<std::string,Any> Options;
   };
 };
 };
@@ -38,6 +38,7 @@
 #include "openma/io_export.h"
 #include "openma/base/opaque.h"
 #include "openma/base/macros.h"
+#include "openma/base/any.h"
 
 #include <memory> // std::unique_ptr
 #include <string>
@@ -67,6 +68,9 @@ namespace io
     void setFormat(const std::string& format);
     const std::string& format() const _OPENMA_NOEXCEPT;
     
+    Any option(const std::string& name) const _OPENMA_NOEXCEPT;
+    void setOption(const std::string& name, const Any& value);
+    
     bool canRead();
     bool read(Node* root);
     
@@ -374,11 +374,20 @@ namespace io
     }
     // Data
     // Note: We want the reaction of the measure, so all the data are multiplied by -1.
+    std::vector<TimeSequence::Writer> writers;
+    std::vector<double*> data;
+    writers.reserve(tss.size());
+    data.reserve(tss.size());
+    for (auto ts : tss)
+    {
+      writers.emplace_back(ts);
+      data.push_back(writers.back().data());
+    }
     for (unsigned i = 0 ; i < samples ; ++i)
     {
       int inc = 0;
-      for (auto ts : tss)
-        ts->data()[i] = -1.0 * static_cast<double>(stream.readI16()) * scale[inc++];
+      for (auto ptr : data)
+        ptr[i] = -1.0 * static_cast<double>(stream.readI16()) * scale[inc++];
     }
   };
 };
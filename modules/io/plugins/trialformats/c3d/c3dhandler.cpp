@@ -34,6 +34,7 @@
 
 #include "c3dhandler.h"
 #include "c3ddatastream.h"
+#include "c3dparametertable.h"
 
 #include "openma/io/handler_p.h"
 #include "openma/io/device.h"
@@ -46,15 +47,23 @@
 #include "openma/base/timesequence.h"
 #include "openma/base/event.h"
 #include "openma/base/logger.h"
+#include "openma/base/parallel.h"
+#include "openma/base/profiler.h"
 
 #include "openma/instrument/forceplate.h"
+#include "openma/instrument/forceplatetype1.h"
 #include "openma/instrument/forceplatetype2.h"
 #include "openma/instrument/forceplatetype3.h"
 #include "openma/instrument/forceplatetype4.h"
 #include "openma/instrument/forceplatetype5.h"
+#include "openma/instrument/forceplatetype6.h"
+#include "openma/instrument/forceplatetype7.h"
+#include "openma/instrument/forceplatetype11.h"
+#include "openma/instrument/forceplatetype12.h"
+#include "openma/instrument/forceplatetype21.h"
 
 #include <string>
-#include <list>
+#include <algorithm> // std::max, std::min
 #include <vector>
 #include <tuple>
 #include <array>
@@ -62,6 +71,8 @@
 #include <functional> // std::function
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring> // memcpy
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -71,6 +82,146 @@ namespace ma
 {
 namespace io
 {
+  // Words of the Data section decoded from their bytes. The result does not depend on the byte order of the host (IEEE processor).
+  struct _C3DWordsIEEELittleEndian
+  {
+    static inline uint16_t u16(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      const uint8_t* b = reinterpret_cast<const uint8_t*>(ptr);
+      return static_cast<uint16_t>(b[0] | (b[1] << 8));
+    };
+    static inline uint32_t u32(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      const uint8_t* b = reinterpret_cast<const uint8_t*>(ptr);
+      return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) | (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+    };
+  };
+  
+  struct _C3DWordsIEEEBigEndian
+  {
+    static inline uint16_t u16(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      const uint8_t* b = reinterpret_cast<const uint8_t*>(ptr);
+      return static_cast<uint16_t>((b[0] << 8) | b[1]);
+    };
+    static inline uint32_t u32(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      const uint8_t* b = reinterpret_cast<const uint8_t*>(ptr);
+      return (static_cast<uint32_t>(b[0]) << 24) | (static_cast<uint32_t>(b[1]) << 16) | (static_cast<uint32_t>(b[2]) << 8) | static_cast<uint32_t>(b[3]);
+    };
+  };
+  
+  struct _C3DWordsVAXLittleEndian
+  {
+    static inline uint16_t u16(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      return _C3DWordsIEEELittleEndian::u16(ptr);
+    };
+    // Same conversion than in the class VAXLittleEndianConverter: the words are swapped and the exponent is divided by 4.
+    static inline uint32_t u32(const char* ptr) _OPENMA_NOEXCEPT
+    {
+      const uint8_t* b = reinterpret_cast<const uint8_t*>(ptr);
+      const uint8_t e = (b[1] == 0) ? 0 : static_cast<uint8_t>(b[1] - 1);
+      return static_cast<uint32_t>(b[2]) | (static_cast<uint32_t>(b[3]) << 8) | (static_cast<uint32_t>(b[0]) << 16) | (static_cast<uint32_t>(e) << 24);
+    };
+  };
+  
+  template <typename W>
+  static inline int16_t _c3d_read_i16(const char* ptr) _OPENMA_NOEXCEPT
+  {
+    return static_cast<int16_t>(W::u16(ptr));
+  };
+  
+  template <typename W>
+  static inline float _c3d_read_float(const char* ptr) _OPENMA_NOEXCEPT
+  {
+    const uint32_t bits = W::u32(ptr);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+  };
+  
+  // The residual word stores the mask in its most significant byte and the residual in its least significant byte.
+  // NOTE: For the float format, the residual can be negative and its absolute value is used (see C3DDataStreamFloat::readPoint()).
+  static inline double _c3d_residual(int16_t word, double scale, bool absolute) _OPENMA_NOEXCEPT
+  {
+    const uint16_t bits = static_cast<uint16_t>(word);
+    if (static_cast<int8_t>(bits >> 8) < 0)
+      return -1.0;
+    const double residual = static_cast<double>(static_cast<int8_t>(bits & 0xFF)) * scale;
+    return absolute ? std::fabs(residual) : residual;
+  };
+  
+  // Decode one point (4 words per frame) starting at @a ptr. The @a stride is the size of a frame.
+  template <typename W>
+  void _c3d_decode_point(const char* ptr, size_t stride, size_t samples, bool integer, double scale, double* values) _OPENMA_NOEXCEPT
+  {
+    double* x = values, *y = values + samples, *z = values + 2 * samples, *r = values + 3 * samples;
+    if (integer)
+    {
+      for (size_t i = 0 ; i < samples ; ++i, ptr += stride)
+      {
+        x[i] = _c3d_read_i16<W>(ptr) * scale;
+        y[i] = _c3d_read_i16<W>(ptr + 2) * scale;
+        z[i] = _c3d_read_i16<W>(ptr + 4) * scale;
+        r[i] = _c3d_residual(_c3d_read_i16<W>(ptr + 6), scale, false);
+      }
+    }
+    else
+    {
+      for (size_t i = 0 ; i < samples ; ++i, ptr += stride)
+      {
+        x[i] = _c3d_read_float<W>(ptr);
+        y[i] = _c3d_read_float<W>(ptr + 4);
+        z[i] = _c3d_read_float<W>(ptr + 8);
+        r[i] = _c3d_residual(static_cast<int16_t>(_c3d_read_float<W>(ptr + 12)), scale, true);
+      }
+    }
+  };
+  
+  template <typename W> struct _C3DAnalogFloat {static inline double read(const char* ptr) _OPENMA_NOEXCEPT {return _c3d_read_float<W>(ptr);};};
+  template <typename W> struct _C3DAnalogSignedInteger {static inline double read(const char* ptr) _OPENMA_NOEXCEPT {return static_cast<double>(_c3d_read_i16<W>(ptr));};};
+  template <typename W> struct _C3DAnalogUnsignedInteger {static inline double read(const char* ptr) _OPENMA_NOEXCEPT {return static_cast<double>(W::u16(ptr));};};
+  
+  // Decode one analog channel starting at @a ptr. Each frame contains @a subsamples values separated by @a step bytes.
+  template <typename A>
+  void _c3d_decode_analog(const char* ptr, size_t stride, size_t step, size_t samples, size_t subsamples, double zero, double scale, double* values) _OPENMA_NOEXCEPT
+  {
+    for (size_t i = 0 ; i < samples ; ++i, ptr += stride)
+    {
+      const char* word = ptr;
+      for (size_t j = 0 ; j < subsamples ; ++j, word += step)
+        *(values++) = (A::read(word) - zero) * scale;
+    }
+  };
+  
+  // Decode the columns in the range [@a first, @a last) (points first, then analog channels).
+  template <typename W>
+  void _c3d_decode_columns(const char* data, size_t first, size_t last, const std::vector<double*>& columns, size_t numPoints, size_t numAnalogs, size_t samples, size_t subsamples, double pointScale, bool analogSigned, const std::vector<double>& zeros, const std::vector<double>& scales) _OPENMA_NOEXCEPT
+  {
+    const bool integer = pointScale > 0;
+    const size_t wordSize = integer ? 2 : 4;
+    const size_t analogOffset = 4 * numPoints * wordSize;
+    const size_t frameSize = analogOffset + numAnalogs * subsamples * wordSize;
+    for (size_t idx = first ; idx < last ; ++idx)
+    {
+      if (idx < numPoints)
+      {
+        _c3d_decode_point<W>(data + 4 * idx * wordSize, frameSize, samples, integer, pointScale, columns[idx]);
+        continue;
+      }
+      const size_t channel = idx - numPoints;
+      const char* ptr = data + analogOffset + channel * wordSize;
+      const size_t step = numAnalogs * wordSize;
+      if (!integer)
+        _c3d_decode_analog<_C3DAnalogFloat<W>>(ptr, frameSize, step, samples, subsamples, zeros[channel], scales[channel], columns[idx]);
+      else if (analogSigned)
+        _c3d_decode_analog<_C3DAnalogSignedInteger<W>>(ptr, frameSize, step, samples, subsamples, zeros[channel], scales[channel], columns[idx]);
+      else
+        _c3d_decode_analog<_C3DAnalogUnsignedInteger<W>>(ptr, frameSize, step, samples, subsamples, zeros[channel], scales[channel], columns[idx]);
+    }
+  };
+  
   class C3DHandlerPrivate : public HandlerPrivate
   {
   public:
@@ -104,7 +255,7 @@ namespace io
     };
     
     template <typename T>
-    static void mergeProperties(std::vector<T>* target, Trial* trial, const std::string& base, int finalSize = -1, T&& defaultValue = T());
+    static void mergeParameters(std::vector<T>* target, const C3DParameterTable* parameters, const char* group, const char* name, int finalSize = -1, T&& defaultValue = T());
     
     template <typename T>
     static void createProperties(std::unordered_map<std::string,Any>& props, const std::string& name, const T& value);
@@ -116,6 +267,9 @@ namespace io
     static void createProperties(std::unordered_map<std::string,Any>& props, const std::string& name, const std::vector<T>& values, const std::vector<unsigned>& dims, size_t inc = 1);
     
     static void extractForcePlatformData(instrument::ForcePlate* fp, const std::vector<TimeSequence*>& analogs, double* origin, double* corners, int* channelIndices, size_t channelStep, double* calMatrix = nullptr, const unsigned* calMatrixSize = nullptr);
+    
+    C3DDataStream* createDataStream(BinaryStream* raw) const;
+    void decodeDataColumns(const char* data, ByteOrder byteOrder, const std::vector<TimeSequence*>& points, const std::vector<TimeSequence*>& analogs, size_t pointSamples, size_t analogSamplesPerPointSample) const;
   };
   
   C3DHandlerPrivate::C3DHandlerPrivate()
@@ -126,19 +280,71 @@ namespace io
   
   C3DHandlerPrivate::~C3DHandlerPrivate() _OPENMA_NOEXCEPT = default;
   
+  /*
+   * Create the data stream corresponding to the format (integer or float) used in the Data section.
+   */
+  C3DDataStream* C3DHandlerPrivate::createDataStream(BinaryStream* raw) const
+  {
+    if (this->PointScale > 0) // integer
+    {
+      if (!this->AnalogSignedIntegerFormat)
+        return new C3DDataStreamUnsignedInteger(raw);
+      else
+        return new C3DDataStreamSignedInteger(raw);
+    }
+    return new C3DDataStreamFloat(raw); // float
+  };
+  
+  /*
+   * Decode the Data section (starting at @a data) column per column.
+   * Because the layout of the frames is fixed, each point and each analog channel can be decoded independently using strided reads.
+   * The words are converted directly from the (memory mapped) data. The columns are split in one contiguous range per thread and each thread only writes in the time sequences of its range.
+   */
+  void C3DHandlerPrivate::decodeDataColumns(const char* data, ByteOrder byteOrder, const std::vector<TimeSequence*>& points, const std::vector<TimeSequence*>& analogs, size_t pointSamples, size_t analogSamplesPerPointSample) const
+  {
+    const size_t wordSize = (this->PointScale > 0) ? 2 : 4;
+    const size_t frameSize = (4 * points.size() + analogs.size() * analogSamplesPerPointSample) * wordSize;
+    // The data pointers and the analog scales are extracted in the calling thread
+    std::vector<double*> columns;
+    columns.reserve(points.size() + analogs.size());
+    for (auto& pt: points)
+      columns.push_back(pt->data());
+    for (auto& an: analogs)
+      columns.push_back(an->data());
+    std::vector<double> scales(analogs.size());
+    for (size_t i = 0 ; i < analogs.size() ; ++i)
+      scales[i] = this->AnalogChannelScale[i] * this->AnalogUniversalScale;
+    // NOTE: Small trials are decoded in the calling thread. The creation of threads would cost more than the decoding.
+    const size_t workers = ((pointSamples * frameSize) < 65536) ? 1 : std::min(static_cast<size_t>(parallel_threads()), columns.size());
+    parallel_for(workers, [&](size_t worker) {
+      const size_t first = worker * columns.size() / workers, last = (worker + 1) * columns.size() / workers;
+      switch (byteOrder)
+      {
+      case ByteOrder::VAXLittleEndian:
+        _c3d_decode_columns<_C3DWordsVAXLittleEndian>(data, first, last, columns, points.size(), analogs.size(), pointSamples, analogSamplesPerPointSample, this->PointScale, this->AnalogSignedIntegerFormat, this->AnalogZeroOffset, scales);
+        break;
+      case ByteOrder::IEEEBigEndian:
+        _c3d_decode_columns<_C3DWordsIEEEBigEndian>(data, first, last, columns, points.size(), analogs.size(), pointSamples, analogSamplesPerPointSample, this->PointScale, this->AnalogSignedIntegerFormat, this->AnalogZeroOffset, scales);
+        break;
+      default:
+        _c3d_decode_columns<_C3DWordsIEEELittleEndian>(data, first, last, columns, points.size(), analogs.size(), pointSamples, analogSamplesPerPointSample, this->PointScale, this->AnalogSignedIntegerFormat, this->AnalogZeroOffset, scales);
+        break;
+      }
+    }, static_cast<unsigned>(workers));
+  };
+  
   template <typename T>
-  void C3DHandlerPrivate::mergeProperties(std::vector<T>* target, Trial* trial, const std::string& base, int finalSize, T&& defaultValue)
+  void C3DHandlerPrivate::mergeParameters(std::vector<T>* target, const C3DParameterTable* parameters, const char* group, const char* name, int finalSize, T&& defaultValue)
   {
     target->clear();
     int numCollapsed = 0;
     int inc = 2;
-    std::string label = base;
-    while (1)
+    std::vector<T> values;
+    // The values are read directly from the parameter table (no Any object is created). Only the names of the continued parameters (e.g. LABELS2) are built.
+    const C3DParameterTable::Entry* entry = parameters->find(group, name);
+    while (entry != nullptr)
     {
-      Any prop = trial->property(label);
-      if (!prop.isValid())
-        break;
-      std::vector<T> values = prop.cast<std::vector<T>>();
+      parameters->values(*entry, &values);
       size_t num = target->size() + values.size();
       if (!values.empty())
       {
@@ -152,7 +358,7 @@ namespace io
       }
       if (numCollapsed == finalSize)
         break;
-      label = base + std::to_string(inc);
+      entry = parameters->find(group, (name + std::to_string(inc)).c_str());
       ++inc;
     }
     if (numCollapsed < finalSize)
@@ -237,9 +443,10 @@ namespace io
       auto calVal = fp->calibrationMatrixData();
       const auto& calDims = fp->calibrationMatrixDimensions();
       assert((calDims[0] <= calMatrixSize[0]) && (calDims[1] <= calMatrixSize[1]));
+      // Both matrices are stored in column-major order. The parameter can be larger than required when force plates of different types are mixed.
       for (unsigned j = 0 ; j < calDims[1] ; ++j)
         for (unsigned i = 0 ; i < calDims[0] ; ++i)
-          calVal[i*calDims[1] + j] = calMatrix[i*calMatrixSize[1] + j];
+          calVal[j*calDims[0] + i] = calMatrix[j*calMatrixSize[0] + i];
       fp->setCalibrationMatrixData(calVal);
     }
     // TODO Manage case where there are missing channels
@@ -285,6 +492,7 @@ namespace io
   
   void C3DHandler::readDevice(Node* output)
   {
+    OPENMA_PROFILE_SCOPE("C3DHandler::readDevice");
     auto optr = this->pimpl();
     BinaryStream stream(optr->Source);
     
@@ -380,166 +588,31 @@ namespace io
         }
       }
   // Parameter
-      optr->Source->seek((512 * (parameterFirstBlock - 1)), Origin::Begin);
+      const size_t parameterOffset = 512 * (parameterFirstBlock - 1);
       // From the C3D documentation:
       // "The first two bytes of the parameter record are only meaningful if they also form the first word of the file"
       // [...]
       // "This is because one common technique for creating C3D files used to be to maintain a parameter 'template' as a separate file"
-      optr->Source->seek(2, Origin::Current);
+      optr->Source->seek(parameterOffset + 2, Origin::Begin);
       uint8_t blockNumber = stream.readU8();
-      optr->Source->seek(1, Origin::Current); // Processor type
-      size_t totalBytesRead = 4; // the four bytes read previously.
-      using group_t = std::tuple<int,std::string>;  // id, label
-      std::list<group_t> groups;
-      using parameter_t = std::tuple<int,std::string,Any>;  // id, label, value(s)
-      std::list<parameter_t> parameters;
-      // std::list<MetaData::Pointer> parameters;
-      // MetaData::Pointer root = output->GetMetaData();
-      bool alreadyDisplayParameterOverflowMessage = false;
-      // Extract the group and parameters
-      while (1)
-      { 
-        int8_t numCharLabel = stream.readI8(); totalBytesRead += abs(numCharLabel) + 1;
-        if (numCharLabel == 0)
-          break; // Parameter section end
-        int8_t id = stream.readI8(); totalBytesRead += 1;
-        if (id == 0)
-          throw(FormatError("Error during the ID extraction in the parameter section - ID equal to 0"));
-        bool lastEntry = false; // Used to determine the end of the Parameter section
-        std::string label = stream.readString(abs(numCharLabel));
-        int offset = stream.readU16(); totalBytesRead += offset;
-        if (offset == 0)
-          lastEntry = true;
-        offset -= 2;
-        if (id < 0)
-        {
-          groups.emplace_back(id,label);
-          uint8_t numCharDesc = stream.readU8(); offset -= 1;
-          // The group's description is not stored and then sought.
-          optr->Source->seek(numCharDesc, Origin::Current); offset -= numCharDesc;
-        }
-        else
-        {
-          int8_t type = stream.readI8(); offset -= 1;
-          int8_t numDims = stream.readI8(); offset -= 1;
-          std::vector<uint8_t> dims(numDims);
-          stream.readU8(numDims,dims.data()); offset -= numDims;
-          int prod = 1;
-          int8_t inc = 0 ; while (inc < numDims) prod *= dims[inc++];
-          int dataSize = static_cast<int>(prod * abs(type));
-          bool dataSizeExceeded = (dataSize > offset) && (!lastEntry);
-          if (dataSizeExceeded)
-            warning("ORG.C3D - %s - The size of the data for the parameter '%s' exceeds the space available before the next entry. Trying to continue...", optr->Source->name(), label.c_str());
-          Any value;
-          switch (type)
-          {
-          case -1: // Char (transformed into strings)
-            {
-            int rows = 1;
-            if (dims.size() >= 2)
-            {
-              int8_t inc2 = 1 ; while (inc2 < numDims) rows *= dims[inc2++];
-              prod = dims[0]; // reused
-              std::vector<uint8_t>(dims.begin()+1, dims.end()).swap(dims); // Remove the first element
-              std::vector<std::string> p(dataSizeExceeded ? 0 : rows);
-              stream.readString(prod, p.size(), p.data());
-              value = Any(p, dims);
-            }
-            else
-            {
-              value = Any(stream.readString(dims[0]));
-            }
-            break;
-            }
-          case 1: // Byte
-            {
-            std::vector<int8_t> p(dataSizeExceeded ? 0 : prod);
-            stream.readI8(p.size(), p.data());
-            value = Any(p, dims);
-            break;
-            }
-          case 2: // Integer
-            {
-            std::vector<int16_t> p(dataSizeExceeded ? 0 : prod);
-            stream.readI16(p.size(), p.data());
-            value = Any(p, dims);
-            break;
-            }
-          case 4: // Real
-            {
-            std::vector<float> p(dataSizeExceeded ? 0 : prod);
-            stream.readFloat(p.size(), p.data());
-            value = Any(p, dims);
-            break;
-            }
-          default :
-            throw(FormatError("Data parameter type unknown for the entry: '" + label + "'"));
-            break;
-          }
-          parameters.emplace_back(id,label,value);
-          offset -= dataSize;
-          if (offset != 0)
-          {
-            uint8_t numCharDesc = stream.readU8(); offset -= 1;
-            // The parameter's description is not stored and then sought.
-            optr->Source->seek(numCharDesc, Origin::Current);
-            offset -= numCharDesc;
-          }
-          else
-            warning("ORG.C3D - %s - Where is the byte to set the number of characters in the description of the parameter '%s'? Trying to continue...", optr->Source->name(), label.c_str());
-        }
-        if (lastEntry)
-          offset = 0;
-        if (offset < 0)
-        {
-          warning("ORG.C3D - %s - Error during the pointing of the next parameter. Trying to continue...", optr->Source->name());
-          optr->Source->seek(offset, Origin::Current);
-          offset = 0;
-        }
-        // Checks if the next parameter is not pointing in the Data section.
-        if ((totalBytesRead + offset) > static_cast<unsigned int>((blockNumber * 512)))
-        {
-          if ((totalBytesRead + offset) > static_cast<unsigned int>(((dataFirstBlock - 2) * 512)))
-          {
-            warning("ORG.C3D - %s - The next parameter is pointing in the Data section. Parameters' extraction is stopped", optr->Source->name());
-            totalBytesRead = blockNumber * 512; // Force the number of totalBytesRead to not trigger the "Bad data first block" exception.
-            break;
-          }
-          else if (!alreadyDisplayParameterOverflowMessage)
-          {
-            warning("ORG.C3D - %s - The next parameter is pointing outside of the parameter section but not yet in the Data section. Trying to continue...", optr->Source->name());
-            alreadyDisplayParameterOverflowMessage = true;
-          }
-        }
-        if (lastEntry)
-          break; // Parameter section end
-        optr->Source->seek(offset, Origin::Current);
-      }
-      // Assemble groups and parameters
-      auto itG = groups.begin();
-      auto itP = parameters.begin();
-      if (!parameters.empty())
+      // The parameters are parsed in a single pass from memory. As some files have parameters pointing outside of the Parameter section, the parsed memory goes until the Data section.
+      size_t parameterSize = std::max<size_t>(blockNumber * 512, (dataFirstBlock > parameterFirstBlock) ? 512 * (dataFirstBlock - parameterFirstBlock) : 0);
+      parameterSize = std::min<size_t>(parameterSize, optr->Source->size() - parameterOffset);
+      const char* parameterData = optr->Source->data();
+      std::vector<char> parameterCopy;
+      if (parameterData != nullptr)
+        parameterData += parameterOffset;
+      else
       {
-        while(1)
-        {
-          if (itP == parameters.end())
-          {
-            ++itG;
-            itP = parameters.begin();
-            if ((itG == groups.end()) || (itP == parameters.end()))
-              break;
-          }
-          if (std::get<0>(*itG) == -std::get<0>(*itP))
-          {
-            trial->setProperty(std::get<1>(*itG)+":"+std::get<1>(*itP),std::move(std::get<2>(*itP)));
-            itP = parameters.erase(itP); 
-          }
-          else
-            ++itP;
-        }
+        parameterCopy.resize(parameterSize);
+        optr->Source->seek(parameterOffset, Origin::Begin);
+        optr->Source->read(parameterCopy.data(), parameterSize);
+        parameterData = parameterCopy.data();
       }
-      if (parameters.size() != 0)
-        warning("ORG.C3D - %s - Some parameters are orphans. No group has the same ID. These parameters are lost", optr->Source->name());
+      auto parameters = std::make_shared<C3DParameterTable>();
+      size_t totalBytesRead = parameters->parse(parameterData, parameterSize, stream.byteOrder(), blockNumber, dataFirstBlock, optr->Source->name());
+      // The properties of the trial are only created when they are requested
+      trial->setPropertySource(parameters);
       int totalBlocksRead = static_cast<int>(ceil((double)totalBytesRead / 512.0));
       if (totalBlocksRead != blockNumber)
       {
@@ -547,20 +620,20 @@ namespace io
         blockNumber = totalBlocksRead;
       }
     // Events in Parameter section
-      std::string eventPrefix = "EVENT:";
-      Any eventUsed = trial->property(eventPrefix+"USED");
-      if (!eventUsed.isValid())
+      const char* eventGroup = "EVENT";
+      const C3DParameterTable::Entry* eventUsed = parameters->find(eventGroup, "USED");
+      if (eventUsed == nullptr)
       {
         // Take a chance to find the events in EVENTS group instead of EVENT
         // The BKINtechnologies Dexterit-E software use similar metadata than what proposed Vicon (See sample22 on C3D.org)
-        std::string eventPrefix = "EVENTS:";
-        eventUsed =  trial->property(eventPrefix+"USED");
-        if (eventUsed.isValid())
+        eventGroup = "EVENTS";
+        eventUsed = parameters->find(eventGroup, "USED");
+        if (eventUsed != nullptr)
           warning("ORG.C3D - %s - EVENTS group found instead of EVENT. The EVENTS group is used to extract events", optr->Source->name());
       }
-      if (eventUsed.isValid())
+      if (eventUsed != nullptr)
       {
-        int eventsNumber = eventUsed;
+        int eventsNumber = parameters->value<int>(*eventUsed);
         std::vector<std::string> eventsLabel;
         std::vector<double> eventsTime;
         std::vector<int> eventsIconId;
@@ -569,17 +642,17 @@ namespace io
         std::vector<std::string> eventsDescription;
         std::vector<std::string> eventUniqueLabels;
         std::vector<int16_t> eventUniqueColours;
-        C3DHandlerPrivate::mergeProperties<std::string>(&eventsLabel, trial, eventPrefix+"LABELS", eventsNumber, "uname*");
-        C3DHandlerPrivate::mergeProperties(&eventsTime, trial, eventPrefix+"TIMES");
+        C3DHandlerPrivate::mergeParameters<std::string>(&eventsLabel, parameters.get(), eventGroup, "LABELS", eventsNumber, "uname*");
+        C3DHandlerPrivate::mergeParameters(&eventsTime, parameters.get(), eventGroup, "TIMES");
         if (eventsTime.size() < static_cast<size_t>(2 * eventsNumber))
           warning("ORG.C3D - %s - The EVENT:TIMES doesn't contain the appropriate number of values. The extracted times could be corrupted", optr->Source->name());
         eventsTime.resize(2 * eventsNumber, 0.0);
-        C3DHandlerPrivate::mergeProperties(&eventsContext, trial, eventPrefix+"CONTEXTS", eventsNumber);
-        C3DHandlerPrivate::mergeProperties(&eventsSubject, trial, eventPrefix+"SUBJECTS", eventsNumber);
-        C3DHandlerPrivate::mergeProperties(&eventsDescription, trial, eventPrefix+"DESCRIPTIONS", eventsNumber);
-        C3DHandlerPrivate::mergeProperties(&eventsIconId, trial, eventPrefix+"ICON_IDS", eventsNumber);
-        C3DHandlerPrivate::mergeProperties(&eventUniqueLabels, trial, "EVENT_CONTEXT:LABELS");
-        C3DHandlerPrivate::mergeProperties(&eventUniqueColours, trial, "EVENT_CONTEXT:COLOURS", eventUniqueLabels.size()*3);
+        C3DHandlerPrivate::mergeParameters(&eventsContext, parameters.get(), eventGroup, "CONTEXTS", eventsNumber);
+        C3DHandlerPrivate::mergeParameters(&eventsSubject, parameters.get(), eventGroup, "SUBJECTS", eventsNumber);
+        C3DHandlerPrivate::mergeParameters(&eventsDescription, parameters.get(), eventGroup, "DESCRIPTIONS", eventsNumber);
+        C3DHandlerPrivate::mergeParameters(&eventsIconId, parameters.get(), eventGroup, "ICON_IDS", eventsNumber);
+        C3DHandlerPrivate::mergeParameters(&eventUniqueLabels, parameters.get(), "EVENT_CONTEXT", "LABELS");
+        C3DHandlerPrivate::mergeParameters(&eventUniqueColours, parameters.get(), "EVENT_CONTEXT", "COLOURS", eventUniqueLabels.size()*3);
         std::unordered_map<std::string,std::array<int16_t,3>> eventProposedColours;
         for (size_t i = 0, len = eventUniqueLabels.size() ; i < len ; ++i)
           eventProposedColours.emplace(trim_string(eventUniqueLabels[i]), std::array<int16_t,3>{{eventUniqueColours[i*3], eventUniqueColours[i*3+1], eventUniqueColours[i*3+2]}});
@@ -599,17 +672,15 @@ namespace io
       }
     // Configure the acquisition based on some metadata
       // - ANALOG:BITS
-      Any analogBits = trial->property("ANALOG:BITS");
-      if (analogBits.isValid())
-        optr->AnalogResolution = analogBits;
+      const auto analogBits = parameters->find("ANALOG:BITS");
+      if (analogBits != nullptr)
+        optr->AnalogResolution = parameters->value<int>(*analogBits);
       // - TRIAL:ACTUAL_START_FIELD
-      Any trialActualStartField = trial->property("TRIAL:ACTUAL_START_FIELD");
-      if (trialActualStartField.isValid())
+      const auto trialActualStartField = parameters->find("TRIAL", "ACTUAL_START_FIELD");
+      if (trialActualStartField != nullptr)
       {
-        // int lsb = trialActualStartField.cast<int>(0);
-        // int hsb = trialActualStartField.cast<int>(1);
-        // int start = hsb << 16 | lsb;
-        size_t start = trialActualStartField.cast<size_t>(1) << 16 | trialActualStartField.cast<size_t>(0);
+        // The two words are unsigned (least significant word first).
+        size_t start = static_cast<size_t>(parameters->value<uint16_t>(*trialActualStartField, 1)) << 16 | parameters->value<uint16_t>(*trialActualStartField, 0);
         if (start != firstSampleIndex)
         {
           if ((firstSampleIndex != 65535) && hasHeader)
@@ -618,13 +689,11 @@ namespace io
         }
       }
       // - TRIAL:ACTUAL_END_FIELD
-      Any trialActualEndField = trial->property("TRIAL:ACTUAL_END_FIELD");
-      if (trialActualEndField.isValid())
+      const auto trialActualEndField = parameters->find("TRIAL", "ACTUAL_END_FIELD");
+      if (trialActualEndField != nullptr)
       {
-        // int lsb = trialActualEndField.cast<int>(0);
-        // int hsb = trialActualEndField.cast<int>(1);
-        // int end = hsb << 16 | lsb;
-        size_t end = trialActualEndField.cast<size_t>(1) << 16 | trialActualEndField.cast<size_t>(0);
+        // The two words are unsigned (least significant word first).
+        size_t end = static_cast<size_t>(parameters->value<uint16_t>(*trialActualEndField, 1)) << 16 | parameters->value<uint16_t>(*trialActualEndField, 0);
         if (end != lastSampleIndex)
         {
           if ((lastSampleIndex != 65535) && hasHeader)
@@ -635,14 +704,14 @@ namespace io
       // - POINT:LONG_FRAMES
       //   TODO: IMPLEMENT THE CASE WHERE C3D FILES COME FROM C-MOTION WITH MORE THAN 65535 samples.
       // - POINT:UNITS*
-      std::vector<std::string> pointUnits{
-        trial->property("POINT:UNITS"),
-        trial->property("POINT:ANGLE_UNITS"),
-        trial->property("POINT:FORCE_UNITS"),
-        trial->property("POINT:MOMENT_UNITS"),
-        trial->property("POINT:POWER_UNITS"),
-        trial->property("POINT:SCALAR_UNITS")
-      };
+      const std::array<const char*,6> pointUnitsNames{{"UNITS","ANGLE_UNITS","FORCE_UNITS","MOMENT_UNITS","POWER_UNITS","SCALAR_UNITS"}};
+      std::vector<std::string> pointUnits(pointUnitsNames.size());
+      for (size_t i = 0 ; i < pointUnitsNames.size() ; ++i)
+      {
+        const auto entry = parameters->find("POINT", pointUnitsNames[i]);
+        if (entry != nullptr)
+          pointUnits[i] = parameters->string(*entry);
+      }
     // Data
       if (dataFirstBlock != 0)
       {
@@ -653,11 +722,11 @@ namespace io
           numberSamplesPerAnalogChannel = 1;
         uint16_t numAnalogs = totalAnalogSamplesPer3dFrame / numberSamplesPerAnalogChannel;
         // ANALOG
-        Any analogUsed = trial->property("ANALOG:USED");
-        if (analogUsed.isValid())
+        const auto analogUsed = parameters->find("ANALOG", "USED");
+        if (analogUsed != nullptr)
         {
           // ANALOG:USED
-          if (numAnalogs != analogUsed)
+          if (numAnalogs != parameters->value<int>(*analogUsed))
             warning("ORG.C3D - %s - The number of analog channels wrote in the header section and in the parameter section are not the same. The value kept is from the header section", optr->Source->name());
           optr->AnalogChannelScale.resize(numAnalogs, 1.0);
           optr->AnalogZeroOffset.resize(numAnalogs, 0.0);
@@ -667,7 +736,7 @@ namespace io
           {
             // Check if values in ANALOG:OFFSET correspond to the informations in ANALOG:FORMAT and ANALOG:BITS
             std::vector<int16_t> zeroOffset;
-            C3DHandlerPrivate::mergeProperties(&zeroOffset, trial, "ANALOG:OFFSET",numAnalogs,int16_t(0));
+            C3DHandlerPrivate::mergeParameters(&zeroOffset, parameters.get(), "ANALOG", "OFFSET",numAnalogs,int16_t(0));
             int bits = optr->AnalogResolution;
             for (size_t inc = 0 ; inc < optr->AnalogZeroOffset.size() ; ++inc)
             {
@@ -689,7 +758,8 @@ namespace io
               warning("ORG.C3D - %s - Analog format and/or their resolution are inconsistent with analog offsets. They were updated", optr->Source->name());
             }
             // - ANALOG:FORMAT
-            if (trial->property("ANALOG:FORMAT").cast<std::string>().compare("UNSIGNED") == 0)
+            const auto analogFormat = parameters->find("ANALOG", "FORMAT");
+            if ((analogFormat != nullptr) && (parameters->string(*analogFormat).compare("UNSIGNED") == 0))
               optr->AnalogSignedIntegerFormat = false;
             else
               optr->AnalogSignedIntegerFormat = true;
@@ -700,11 +770,11 @@ namespace io
                 optr->AnalogZeroOffset[inc] = static_cast<double>(static_cast<uint16_t>(zeroOffset[inc]));
             }
             else // signed
-              C3DHandlerPrivate::mergeProperties(&optr->AnalogZeroOffset, trial, "ANALOG:OFFSET", numAnalogs, 0.0);
+              C3DHandlerPrivate::mergeParameters(&optr->AnalogZeroOffset, parameters.get(), "ANALOG", "OFFSET", numAnalogs, 0.0);
             // - ANALOG:SCALE
-            C3DHandlerPrivate::mergeProperties(&optr->AnalogChannelScale, trial, "ANALOG:SCALE", numAnalogs, 1.0);
+            C3DHandlerPrivate::mergeParameters(&optr->AnalogChannelScale, parameters.get(), "ANALOG", "SCALE", numAnalogs, 1.0);
             // - ANALOG:GEN_SCALE
-            optr->AnalogUniversalScale = trial->property("ANALOG:GEN_SCALE");
+            optr->AnalogUniversalScale = parameters->value<double>("ANALOG:GEN_SCALE");
             if (optr->AnalogUniversalScale == 0.0)
             {
               warning("ORG.C3D - %s - Analog universal scaling factor error. Value zero (0) replaced by one (1)", optr->Source->name());
@@ -714,63 +784,74 @@ namespace io
         }
         // POINT
         // POINT:USED
-        if (trial->property("POINT:USED") != pointNumber)
+        const auto pointUsed = parameters->find("POINT", "USED");
+        if ((pointUsed == nullptr) || (parameters->value<int>(*pointUsed) != pointNumber))
           warning("ORG.C3D - %s - The number of points wrote in the header section and in the parameter section are not the same. The value kept is from the header section", optr->Source->name());
         // POINT:SCALE
-        if (fabs(trial->property("POINT:SCALE").cast<double>() - optr->PointScale) > std::numeric_limits<float>::epsilon())
+        if (fabs(parameters->value<double>("POINT:SCALE") - optr->PointScale) > std::numeric_limits<float>::epsilon())
           warning("ORG.C3D - %s - The point scaling factor written in the header and in the parameter POINT:SCALE are not the same. The first value is kept", optr->Source->name());
-        std::unique_ptr<C3DDataStream> dataStream; 
-        if (optr->PointScale > 0) // integer
-        {
-          if (!optr->AnalogSignedIntegerFormat)
-            dataStream.reset(new C3DDataStreamUnsignedInteger(&stream));
-          else
-            dataStream.reset(new C3DDataStreamSignedInteger(&stream));
-        }
-        else // float
-        {
-          dataStream.reset(new C3DDataStreamFloat(&stream));
-        }
         size_t pointSamples = lastSampleIndex - firstSampleIndex + 1;
         double startTime = static_cast<double>(firstSampleIndex-1) / pointSampleRate;
         auto points = make_nodes<TimeSequence*>(pointNumber,4,pointSamples,pointSampleRate,startTime,TimeSequence::Position,pointUnits[0],trial->timeSequences());
         auto analogs = make_nodes<TimeSequence*>(numAnalogs,1,pointSamples*numberSamplesPerAnalogChannel,pointSampleRate*numberSamplesPerAnalogChannel,startTime,TimeSequence::Analog,"V",trial->timeSequences());
-        try
+        // The samples are written through mutable pointers. The writers let the time sequences share their buffer with their copies once filled.
+        std::vector<TimeSequence::Writer> writers;
+        writers.reserve(points.size() + analogs.size());
+        for (auto& pt: points)
+          writers.emplace_back(pt);
+        for (auto& an: analogs)
+          writers.emplace_back(an);
+        // When the Data section is entirely available in memory (e.g. memory mapped file), the columns are decoded in parallel.
+        // NOTE: The direct decoding converts the words to IEEE floats. It is then not used on VAX hosts.
+        const size_t dataOffset = 512 * (dataFirstBlock - 1);
+        const size_t dataSize = pointSamples * ((4 * points.size()) + (numberSamplesPerAnalogChannel * analogs.size())) * ((optr->PointScale > 0) ? 2 : 4);
+        OPENMA_PROFILE_COUNT("bytes",dataSize);
+        OPENMA_PROFILE_COUNT("samples",pointSamples * (points.size() + numberSamplesPerAnalogChannel * analogs.size()));
+        if ((ByteOrder::Native != ByteOrder::VAXLittleEndian) && (optr->Source->data() != nullptr) && (static_cast<size_t>(optr->Source->size()) >= (dataOffset + dataSize)))
+        {
+          optr->decodeDataColumns(optr->Source->data() + dataOffset, stream.byteOrder(), points, analogs, pointSamples, numberSamplesPerAnalogChannel);
+        }
+        else
         {
-          for (size_t sample = 0 ; sample < pointSamples ; ++sample)
+          std::unique_ptr<C3DDataStream> dataStream(optr->createDataStream(&stream));
+          try
           {
-            for (auto& pt: points)
-            {
-              dataStream->readPoint(
-                &(pt->data()[sample]),
-                &(pt->data()[sample + pointSamples]),
-                &(pt->data()[sample + 2*pointSamples]),
-                &(pt->data()[sample + 3*pointSamples]),
-                optr->PointScale);
-            }
-            size_t analogSample = numberSamplesPerAnalogChannel * sample;
-            for (int subsample = 0 ; subsample < numberSamplesPerAnalogChannel ; ++subsample)
+            for (size_t sample = 0 ; sample < pointSamples ; ++sample)
             {
-              size_t incChannel = 0;
-              for (auto& an: analogs)
+              for (auto& pt: points)
+              {
+                dataStream->readPoint(
+                  &(pt->data()[sample]),
+                  &(pt->data()[sample + pointSamples]),
+                  &(pt->data()[sample + 2*pointSamples]),
+                  &(pt->data()[sample + 3*pointSamples]),
+                  optr->PointScale);
+              }
+              size_t analogSample = numberSamplesPerAnalogChannel * sample;
+              for (int subsample = 0 ; subsample < numberSamplesPerAnalogChannel ; ++subsample)
               {
-                an->data()[analogSample+subsample] = (dataStream->readAnalog() - optr->AnalogZeroOffset[incChannel]) * optr->AnalogChannelScale[incChannel] * optr->AnalogUniversalScale;
-                ++incChannel;
+                size_t incChannel = 0;
+                for (auto& an: analogs)
+                {
+                  an->data()[analogSample+subsample] = (dataStream->readAnalog() - optr->AnalogZeroOffset[incChannel]) * optr->AnalogChannelScale[incChannel] * optr->AnalogUniversalScale;
+                  ++incChannel;
+                }
               }
             }
           }
-        }
-        catch (FormatError& )
-        {
-          // Let's try to continue even if the file is corrupted
-          if (optr->Source->atEnd())
-            warning("ORG.C3D - %s - Some points and/or analog data cannot be extracted and are set as invalid", optr->Source->name());
-          else
-            throw;
+          catch (FormatError& )
+          {
+            // Let's try to continue even if the file is corrupted
+            if (optr->Source->atEnd())
+              warning("ORG.C3D - %s - Some points and/or analog data cannot be extracted and are set as invalid", optr->Source->name());
+            else
+              throw;
+          }
         }
         // Label, description, unit and type
         size_t inc = 0; 
-        bool c3dFromMotion = (trial->property("MANUFACTURER:Company") == "Motion Analysis Corp");
+        const auto manufacturer = parameters->find("MANUFACTURER", "Company");
+        bool c3dFromMotion = (manufacturer != nullptr) && (parameters->string(*manufacturer).compare("Motion Analysis Corp") == 0);
         std::vector<std::string> labels, descriptions;
         // POINT Label, description, unit
         // NOTE: C3D files exported from "Motion Analysis Corp." softwares (EvaRT, Cortex) seem to use POINT:LABELS and POINTS:DESCRIPTIONS as a short and long version of the points' label respectively. Point's Label used in EvaRT and Cortex correspond to values stored in POINTS:DESCRIPTIONS. To distinguish C3D files exported from "Motion Analysis Corp." softwares, it is possible to check the value in the parameter MANUFACTURER:Company.
@@ -778,13 +859,13 @@ namespace io
         if (!c3dFromMotion)
         {
           // POINT:LABELS & POINT:DESCRIPTIONS
-          C3DHandlerPrivate::mergeProperties<std::string>(&labels, trial, "POINT:LABELS", pointNumber, "uname*");
-          C3DHandlerPrivate::mergeProperties<std::string>(&descriptions, trial, "POINT:DESCRIPTIONS", pointNumber);
+          C3DHandlerPrivate::mergeParameters<std::string>(&labels, parameters.get(), "POINT", "LABELS", pointNumber, "uname*");
+          C3DHandlerPrivate::mergeParameters<std::string>(&descriptions, parameters.get(), "POINT", "DESCRIPTIONS", pointNumber);
         }
         else
         {
           // POINT:DESCRIPTIONS (which is in fact the exact label)
-          C3DHandlerPrivate::mergeProperties<std::string>(&labels, trial, "POINT:DESCRIPTIONS", pointNumber, "uname*");
+          C3DHandlerPrivate::mergeParameters<std::string>(&labels, parameters.get(), "POINT", "DESCRIPTIONS", pointNumber, "uname*");
           descriptions.resize(pointNumber);
           // Set the timesqeunces' but also adapt coordinates and residuals for occluded markers
           inc = 0;
@@ -803,6 +884,7 @@ namespace io
             }
           }
         }
+        writers.clear();
         inc = 0;
         for (auto& pt: points)
         {
@@ -812,12 +894,12 @@ namespace io
           ++inc;
         }
         // Point's type and unit
-        const std::array<std::string,5> pointTypeNames{{"POINT:ANGLES","POINT:FORCES","POINT:MOMENTS","POINT:POWERS","POINT:SCALARS"}};
+        const std::array<const char*,5> pointTypeNames{{"ANGLES","FORCES","MOMENTS","POWERS","SCALARS"}};
         const std::array<int,5> pointTypeTypes{{TimeSequence::Angle,TimeSequence::Force,TimeSequence::Moment,TimeSequence::Power,TimeSequence::Scalar}};
         for(size_t i = 0 ; i < pointTypeNames.size() ; ++i)
         {
           std::vector<std::string> labels;
-          C3DHandlerPrivate::mergeProperties<std::string>(&labels, trial, pointTypeNames[i]);
+          C3DHandlerPrivate::mergeParameters<std::string>(&labels, parameters.get(), "POINT", pointTypeNames[i]);
           for (size_t j = 0 ; j < labels.size() ; ++j)
           {
             auto pt = trial->timeSequences()->findChild<TimeSequence*>(trim_string(labels[j]),{},false);
@@ -829,7 +911,7 @@ namespace io
           }
         }
         // ANALOG Label, description, unit
-        if (analogUsed.isValid())
+        if (analogUsed != nullptr)
         {
           std::vector<std::string> labels, descriptions, units;
           std::vector<int16_t> gains;
@@ -837,17 +919,17 @@ namespace io
           if (!c3dFromMotion)
           {
             // POINT:LABELS & POINT:DESCRIPTIONS
-            C3DHandlerPrivate::mergeProperties<std::string>(&labels, trial, "ANALOG:LABELS", numAnalogs, "uname*");
-            C3DHandlerPrivate::mergeProperties<std::string>(&descriptions, trial, "ANALOG:DESCRIPTIONS", numAnalogs);
+            C3DHandlerPrivate::mergeParameters<std::string>(&labels, parameters.get(), "ANALOG", "LABELS", numAnalogs, "uname*");
+            C3DHandlerPrivate::mergeParameters<std::string>(&descriptions, parameters.get(), "ANALOG", "DESCRIPTIONS", numAnalogs);
           }
           else
           {
             // A for the points, Motion Analysis Corp. uses the parameter to store the exact analogs' label
-            C3DHandlerPrivate::mergeProperties<std::string>(&labels, trial, "ANALOG:DESCRIPTIONS", numAnalogs, "uname*");
+            C3DHandlerPrivate::mergeParameters<std::string>(&labels, parameters.get(), "ANALOG", "DESCRIPTIONS", numAnalogs, "uname*");
           }
-          C3DHandlerPrivate::mergeProperties(&units, trial, "ANALOG:UNITS", numAnalogs);
-          C3DHandlerPrivate::mergeProperties(&gains, trial, "ANALOG:GAIN", numAnalogs);
-          C3DHandlerPrivate::mergeProperties(&ranges, trial, "ANALOG:RANGE");
+          C3DHandlerPrivate::mergeParameters(&units, parameters.get(), "ANALOG", "UNITS", numAnalogs);
+          C3DHandlerPrivate::mergeParameters(&gains, parameters.get(), "ANALOG", "GAIN", numAnalogs);
+          C3DHandlerPrivate::mergeParameters(&ranges, parameters.get(), "ANALOG", "RANGE");
           inc = 0;
           for (auto& an: analogs)
           {
@@ -891,43 +973,46 @@ namespace io
           }
         }
         // Finally, try to generate instrument nodes from trial's parameters
-        size_t numfps = trial->property("FORCE_PLATFORM:USED");
+        const auto fpUsed = parameters->find("FORCE_PLATFORM", "USED");
+        size_t numfps = (fpUsed != nullptr) ? parameters->value<size_t>(*fpUsed) : 0;
         if (numfps > 0)
         {
-          const Any& type = trial->property("FORCE_PLATFORM:TYPE");
-          const Any& corners = trial->property("FORCE_PLATFORM:CORNERS");
-          const Any& origin = trial->property("FORCE_PLATFORM:ORIGIN");
-          const Any& channel = trial->property("FORCE_PLATFORM:CHANNEL");
-          const Any& calmatrix = trial->property("FORCE_PLATFORM:CAL_MATRIX");
-          const Any& zero = trial->property("FORCE_PLATFORM:ZERO");
-          if (type.isValid() && corners.isValid() && origin.isValid() && channel.isValid())
+          const auto type = parameters->find("FORCE_PLATFORM", "TYPE");
+          const auto corners = parameters->find("FORCE_PLATFORM", "CORNERS");
+          const auto origin = parameters->find("FORCE_PLATFORM", "ORIGIN");
+          const auto channel = parameters->find("FORCE_PLATFORM", "CHANNEL");
+          const auto calmatrix = parameters->find("FORCE_PLATFORM", "CAL_MATRIX");
+          const auto zero = parameters->find("FORCE_PLATFORM", "ZERO");
+          if ((type != nullptr) && (corners != nullptr) && (origin != nullptr) && (channel != nullptr))
           {
-            // const auto& dimType = type.dimensions();
-            // const auto& dimCorners = corners.dimensions();
-            // const auto& dimOrigin = orgin.dimensions();
-            const auto& dimChannel = channel.dimensions();
-            const auto& dimCalMatrix = calmatrix.dimensions();
-            auto valType = type.cast<std::vector<int>>();
-            auto valCorners = corners.cast<std::vector<double>>();
-            auto valOrigin = origin.cast<std::vector<double>>();
-            auto valChannel = channel.cast<std::vector<int>>();
-            auto valCalMatrix = calmatrix.cast<std::vector<double>>();
-            auto valZero = zero.cast<std::array<int,2>>();
+            const std::vector<unsigned> dimChannel(channel->Dimensions.cbegin(), channel->Dimensions.cend());
+            const std::vector<unsigned> dimCalMatrix = (calmatrix != nullptr) ? std::vector<unsigned>(calmatrix->Dimensions.cbegin(), calmatrix->Dimensions.cend()) : std::vector<unsigned>{};
+            std::vector<int> valType, valChannel;
+            std::vector<double> valCorners, valOrigin, valCalMatrix;
+            parameters->values(*type, &valType);
+            parameters->values(*corners, &valCorners);
+            parameters->values(*origin, &valOrigin);
+            parameters->values(*channel, &valChannel);
+            if (calmatrix != nullptr)
+              parameters->values(*calmatrix, &valCalMatrix);
+            std::array<int,2> valZero{{0,0}};
+            if (zero != nullptr)
+              valZero = {{parameters->value<int>(*zero, 0), parameters->value<int>(*zero, 1)}};
             valZero[0] -= 1; valZero[1] -= 1; // C3D format is 1-based index
             if ((valType.size() >= numfps) && (valCorners.size() >= (12 * numfps)) && (valOrigin.size() == (3 * numfps)) && (dimChannel.size() >= 2) && (dimChannel[1] >= numfps))
             {
               int maxType = *std::max_element(valType.cbegin(), valType.cend());
-              if ((maxType <= 3) || ((maxType > 3) && calmatrix.isValid() && (dimCalMatrix.size() >= 3) && (dimCalMatrix[2] >= numfps)))
+              if ((maxType <= 3) || ((maxType > 3) && (calmatrix != nullptr) && (dimCalMatrix.size() >= 3) && (dimCalMatrix[2] >= numfps)))
               {
                 unsigned channelStep = dimChannel[0];
-                unsigned calMatrixStep = calmatrix.isValid() ? dimCalMatrix[0] * dimCalMatrix[1] : 0;
+                unsigned calMatrixStep = (calmatrix != nullptr) ? dimCalMatrix[0] * dimCalMatrix[1] : 0;
                 for (size_t i = 0 ; i < numfps ; ++i)
                 {
                   instrument::ForcePlate* fp = nullptr;
                   double* o = valOrigin.data()+(i*3);
                   double* c = valCorners.data()+(i*12);
                   int* ch = valChannel.data()+(i*channelStep);
-                  double* cm = calmatrix.isValid() ? valCalMatrix.data()+(i*calMatrixStep) : nullptr;
+                  double* cm = (calmatrix != nullptr) ? valCalMatrix.data()+(i*calMatrixStep) : nullptr;
                   if (o[2] > 0.0)
                   {
                     warning("Origin parameter for the force platform #%i seems to locate the hardware origin from the center of the working surface. Data are set to the opposite to locate the center of the working surface from the hardware's origin.", i+1);
@@ -937,7 +1022,7 @@ namespace io
                   switch(valType[i])
                   {
                   case 1:
-                    error("Force Platform type 1 is not yet supported. Please, report this to the developers");
+                    fp = new instrument::ForcePlateType1("FP"+std::to_string(i+1), trial->hardwares());
                     break;
                   case 2:
                     fp = new instrument::ForcePlateType2("FP"+std::to_string(i+1), trial->hardwares());
@@ -954,24 +1039,34 @@ namespace io
                     fp = new instrument::ForcePlateType5("FP"+std::to_string(i+1), trial->hardwares());
                     break;
                   case 6:
-                    error("Force Platform type 6 is not yet supported. Please, report this to the developers");
+                    fp = new instrument::ForcePlateType6("FP"+std::to_string(i+1), trial->hardwares());
+                    static_cast<instrument::ForcePlateType6*>(fp)->setSensorOffsets(std::array<double,2>{{o[0],o[1]}});
+                    o[0] = 0.0; o[1] = 0.0;
                     break;
                   case 7:
-                    error("Force Platform type 6 is not yet supported. Please, report this to the developers");
-                  break;
+                    fp = new instrument::ForcePlateType7("FP"+std::to_string(i+1), trial->hardwares());
+                    static_cast<instrument::ForcePlateType7*>(fp)->setSensorOffsets(std::array<double,2>{{o[0],o[1]}});
+                    o[0] = 0.0; o[1] = 0.0;
+                    break;
                   case 11:
-                    error("Force Platform type 6 is not yet supported. Please, report this to the developers");
-                  break;
+                    fp = new instrument::ForcePlateType11("FP"+std::to_string(i+1), trial->hardwares());
+                    static_cast<instrument::ForcePlateType7*>(fp)->setSensorOffsets(std::array<double,2>{{o[0],o[1]}});
+                    o[0] = 0.0; o[1] = 0.0;
+                    break;
                   case 12:
-                    error("Force Platform type 6 is not yet supported. Please, report this to the developers");
+                    fp = new instrument::ForcePlateType12("FP"+std::to_string(i+1), trial->hardwares());
+                    static_cast<instrument::ForcePlateType7*>(fp)->setSensorOffsets(std::array<double,2>{{o[0],o[1]}});
+                    o[0] = 0.0; o[1] = 0.0;
                     break;
                   case 21:
-                    error("Force Platform type 6 is not yet supported. Please, report this to the developers");
+                    fp = new instrument::ForcePlateType21("FP"+std::to_string(i+1), trial->hardwares());
                     break;
                   default:
                     error("Unsupported force platform type '%i'. Impossible to extract corresponding data", valType[i]);
                     break;
                   }
+                  if (fp == nullptr)
+                    continue;
                   C3DHandlerPrivate::extractForcePlatformData(fp, analogs, o, c, ch, channelStep, cm, dimCalMatrix.data());
                   fp->setSoftResetSamples(valZero);
                 }
@@ -986,6 +1081,17 @@ namespace io
             warning("Missing parameter(s). Impossible to generate force platform objects.");
         
         }
+        // Optional compact storage (once the force platforms are extracted, as they use the analog channels)
+        // The points are stored as single precision values. The analog channels of an integer file are stored as their raw ADC values (their scale and offset are already set), so the conversion is lossless.
+        if (this->option("CompactStorage").cast<bool>())
+        {
+          OPENMA_PROFILE_SCOPE("C3DHandler::readDevice::compactStorage");
+          for (auto& pt: points)
+            pt->setStorage(TimeSequence::Storage::Float);
+          const auto analogStorage = (optr->PointScale > 0) ? TimeSequence::Storage::Int16 : TimeSequence::Storage::Float;
+          for (auto& an: analogs)
+            an->setStorage(analogStorage);
+        }
       }
     }
   };
@@ -1597,10 +1703,10 @@ namespace io
         for (const auto& point : points)
         {
           dataStream.writePoint(
-            point->data()[frame],
-            point->data()[frame + frames],
-            point->data()[frame + 2*frames],
-            point->data()[frame + 3*frames],
+            point->data(frame,0),
+            point->data(frame,1),
+            point->data(frame,2),
+            point->data(frame,3),
             pointScaleFactor);
         }
         size_t inc = 0, incChannel = 0, analogFrame = numberAnalogSamplesPerPointSample * frame;
@@ -1608,7 +1714,7 @@ namespace io
         while (itA != analogs.cend())
         {
           dataStream.writeAnalog(
-            (*itA)->data()[analogFrame]
+            (*itA)->data(analogFrame,0)
             / optr->AnalogChannelScale[incChannel]
             / optr->AnalogUniversalScale
             + optr->AnalogZeroOffset[incChannel]);
@@ -0,0 +1,366 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "c3dparametertable.h"
+
+#include "openma/io/handler.h" // FormatError
+#include "openma/io/buffer.h"
+#include "openma/io/binarystream.h"
+#include "openma/io/enums.h"
+#include "openma/base/logger.h"
+
+#include <cstdlib> // abs
+
+namespace ma
+{
+namespace io
+{
+  /*
+   * Compact table of the parameters stored in a C3D file.
+   * The parameter section is parsed in a single pass directly from memory (e.g. a memory mapped file). 
+   * Each parameter is stored once with its values converted in the native byte order into a single pool and its key ("GROUP:PARAMETER") is interned in an index.
+   * Typed accessors are proposed to extract numerical values without any memory allocation, while the Any objects are only created on demand (i.e. when a node uses this table as its property source).
+   */
+  
+  C3DParameterTable::C3DParameterTable()
+  : PropertySource(), m_Groups(), m_Entries(), m_Index(), m_Pool()
+  {};
+  
+  C3DParameterTable::~C3DParameterTable() _OPENMA_NOEXCEPT = default;
+  
+  /*
+   * Parses the Parameter section starting at @a data (including the four first bytes of the section) and containing @a size bytes.
+   * The arguments @a blockNumber and @a dataFirstBlock are the values found in the file and are used to detect parameters pointing outside of the Parameter section.
+   * Returns the number of bytes read in the section.
+   */
+  size_t C3DParameterTable::parse(const char* data, size_t size, ByteOrder byteOrder, size_t blockNumber, size_t dataFirstBlock, const char* sourceName)
+  {
+    this->m_Groups.clear();
+    this->m_Entries.clear();
+    this->m_Index.clear();
+    this->m_Pool.clear();
+    // Numerical values are converted using a stream over the same memory
+    Buffer buffer;
+    buffer.open(data, size);
+    buffer.setExceptions(State::End | State::Fail | State::Error);
+    BinaryStream stream(&buffer, byteOrder);
+    const bool bigEndian = (byteOrder == ByteOrder::IEEEBigEndian);
+    std::vector<int8_t> groupIds;
+    size_t totalBytesRead = 4; // the four bytes of the section's header.
+    long pos = 4;
+    auto require = [&](size_t n) {
+      if ((pos < 0) || ((static_cast<size_t>(pos) + n) > size))
+        throw(FormatError("Unexpected end of the parameter section"));
+    };
+    bool alreadyDisplayParameterOverflowMessage = false;
+    while (1)
+    {
+      require(1);
+      int8_t numCharLabel = static_cast<int8_t>(data[pos++]); totalBytesRead += abs(numCharLabel) + 1;
+      if (numCharLabel == 0)
+        break; // Parameter section end
+      require(1);
+      int8_t id = static_cast<int8_t>(data[pos++]); totalBytesRead += 1;
+      if (id == 0)
+        throw(FormatError("Error during the ID extraction in the parameter section - ID equal to 0"));
+      bool lastEntry = false; // Used to determine the end of the Parameter section
+      const size_t numCharLabelAbs = abs(numCharLabel);
+      require(numCharLabelAbs + 2);
+      const char* label = data + pos; pos += numCharLabelAbs;
+      const uint8_t* word = reinterpret_cast<const uint8_t*>(data + pos); pos += 2;
+      int offset = bigEndian ? (word[0] << 8 | word[1]) : (word[1] << 8 | word[0]); totalBytesRead += offset;
+      if (offset == 0)
+        lastEntry = true;
+      offset -= 2;
+      if (id < 0)
+      {
+        groupIds.push_back(id);
+        this->m_Groups.emplace_back(label, numCharLabelAbs);
+        require(1);
+        uint8_t numCharDesc = static_cast<uint8_t>(data[pos++]); offset -= 1;
+        // The group's description is not stored and then sought.
+        pos += numCharDesc; offset -= numCharDesc;
+      }
+      else
+      {
+        Entry entry{-1, std::string(label, numCharLabelAbs), id, 0, {}, 0, 0};
+        require(2);
+        entry.Type = static_cast<int8_t>(data[pos++]); offset -= 1;
+        int8_t numDims = static_cast<int8_t>(data[pos++]); offset -= 1;
+        if (numDims < 0)
+          throw(FormatError("Invalid number of dimensions for the entry: '" + entry.Name + "'"));
+        require(numDims);
+        entry.Dimensions.assign(data + pos, data + pos + numDims); pos += numDims; offset -= numDims;
+        int prod = 1;
+        for (const auto& dim : entry.Dimensions)
+          prod *= dim;
+        const int elementSize = abs(entry.Type);
+        int dataSize = prod * elementSize;
+        bool dataSizeExceeded = (dataSize > offset) && (!lastEntry);
+        if (dataSizeExceeded)
+          warning("ORG.C3D - %s - The size of the data for the parameter '%s' exceeds the space available before the next entry. Trying to continue...", sourceName, entry.Name.c_str());
+        switch (entry.Type)
+        {
+        case -1: // Char (transformed into strings)
+          // NOTE: A single string is always extracted even if its size exceeds the space available.
+          entry.Count = ((numDims >= 2) && dataSizeExceeded) ? 0 : (numDims == 1 ? entry.Dimensions[0] : prod);
+          break;
+        case 1: // Byte
+        case 2: // Integer
+        case 4: // Real
+          entry.Count = dataSizeExceeded ? 0 : prod;
+          break;
+        default :
+          throw(FormatError("Data parameter type unknown for the entry: '" + entry.Name + "'"));
+          break;
+        }
+        require(entry.Count * elementSize);
+        entry.Offset = (this->m_Pool.size() + 3) & ~static_cast<size_t>(3); // 4-byte alignment
+        this->m_Pool.resize(entry.Offset + entry.Count * elementSize);
+        char* values = this->m_Pool.data() + entry.Offset;
+        if (entry.Type == 2)
+        {
+          buffer.seek(pos, Origin::Begin);
+          stream.readI16(entry.Count, reinterpret_cast<int16_t*>(values));
+        }
+        else if (entry.Type == 4)
+        {
+          buffer.seek(pos, Origin::Begin);
+          stream.readFloat(entry.Count, reinterpret_cast<float*>(values));
+        }
+        else if (entry.Count != 0)
+          memcpy(values, data + pos, entry.Count);
+        pos += entry.Count * elementSize;
+        offset -= dataSize;
+        if (offset != 0)
+        {
+          require(1);
+          uint8_t numCharDesc = static_cast<uint8_t>(data[pos++]); offset -= 1;
+          // The parameter's description is not stored and then sought.
+          pos += numCharDesc; offset -= numCharDesc;
+        }
+        else
+          warning("ORG.C3D - %s - Where is the byte to set the number of characters in the description of the parameter '%s'? Trying to continue...", sourceName, entry.Name.c_str());
+        this->m_Entries.push_back(std::move(entry));
+      }
+      if (lastEntry)
+        offset = 0;
+      if (offset < 0)
+      {
+        warning("ORG.C3D - %s - Error during the pointing of the next parameter. Trying to continue...", sourceName);
+        pos += offset;
+        offset = 0;
+      }
+      // Checks if the next parameter is not pointing in the Data section.
+      if ((totalBytesRead + offset) > static_cast<unsigned int>((blockNumber * 512)))
+      {
+        if ((totalBytesRead + offset) > static_cast<unsigned int>(((static_cast<int>(dataFirstBlock) - 2) * 512)))
+        {
+          warning("ORG.C3D - %s - The next parameter is pointing in the Data section. Parameters' extraction is stopped", sourceName);
+          totalBytesRead = blockNumber * 512; // Force the number of totalBytesRead to not trigger the "Bad data first block" exception.
+          break;
+        }
+        else if (!alreadyDisplayParameterOverflowMessage)
+        {
+          warning("ORG.C3D - %s - The next parameter is pointing outside of the parameter section but not yet in the Data section. Trying to continue...", sourceName);
+          alreadyDisplayParameterOverflowMessage = true;
+        }
+      }
+      if (lastEntry)
+        break; // Parameter section end
+      pos += offset;
+    }
+    // Assemble groups and parameters
+    // NOTE: If several groups have the same ID, the parameters are associated with the first one.
+    std::vector<std::vector<size_t>> parametersById(129); // IDs are between 1 and 128 (in absolute value)
+    for (size_t i = 0, len = this->m_Entries.size() ; i < len ; ++i)
+      parametersById[this->m_Entries[i].Id].push_back(i);
+    for (size_t i = 0, len = groupIds.size() ; i < len ; ++i)
+    {
+      auto& parameters = parametersById[-groupIds[i]];
+      for (const auto& idx : parameters)
+      {
+        auto& entry = this->m_Entries[idx];
+        entry.Group = static_cast<int>(i);
+        this->m_Index[this->m_Groups[i] + ":" + entry.Name] = idx;
+      }
+      parameters.clear();
+    }
+    for (const auto& parameters : parametersById)
+    {
+      if (!parameters.empty())
+      {
+        warning("ORG.C3D - %s - Some parameters are orphans. No group has the same ID. These parameters are lost", sourceName);
+        break;
+      }
+    }
+    return totalBytesRead;
+  };
+  
+  /*
+   * Returns the entry associated with the given @a key ("GROUP:PARAMETER") or null if not found.
+   */
+  auto C3DParameterTable::find(const std::string& key) const _OPENMA_NOEXCEPT -> const Entry*
+  {
+    auto it = this->m_Index.find(key);
+    return (it != this->m_Index.end()) ? &(this->m_Entries[it->second]) : nullptr;
+  };
+  
+  /*
+   * Returns the entry associated with the given @a group and parameter @a name or null if not found.
+   * Compared to the other find() method, no key is built. This is the one to use for the parameters with a known name.
+   */
+  auto C3DParameterTable::find(const char* group, const char* name) const _OPENMA_NOEXCEPT -> const Entry*
+  {
+    for (size_t i = 0, len = this->m_Groups.size() ; i < len ; ++i)
+    {
+      if (this->m_Groups[i].compare(group) != 0)
+        continue;
+      for (const auto& entry : this->m_Entries)
+      {
+        if ((entry.Group == static_cast<int>(i)) && (entry.Name.compare(name) == 0))
+          return &entry;
+      }
+    }
+    return nullptr;
+  };
+  
+  /*
+   * Replaces the content of @a values by the strings of the given @a entry.
+   * As for the method any(), the first dimension of a parameter of characters gives the length of each string.
+   * The vector is empty if the entry stores numerical values.
+   */
+  void C3DParameterTable::values(const Entry& entry, std::vector<std::string>* values) const
+  {
+    values->clear();
+    if (entry.Type != -1)
+      return;
+    const char* data = this->m_Pool.data() + entry.Offset;
+    if (entry.Dimensions.size() >= 2)
+    {
+      const size_t length = entry.Dimensions[0];
+      const size_t rows = (length != 0) ? entry.Count / length : 0;
+      values->resize(rows);
+      for (size_t i = 0 ; i < rows ; ++i)
+        (*values)[i].assign(data + i * length, length);
+    }
+    else
+      values->emplace_back(data, entry.Count);
+  };
+  
+  /*
+   * Returns the string at the index @a idx of the given @a entry.
+   * An empty string is returned if the index is out of range or if the entry stores numerical values.
+   */
+  std::string C3DParameterTable::string(const Entry& entry, size_t idx) const
+  {
+    if (entry.Type != -1)
+      return std::string();
+    const char* data = this->m_Pool.data() + entry.Offset;
+    if (entry.Dimensions.size() >= 2)
+    {
+      const size_t length = entry.Dimensions[0];
+      if ((length == 0) || (idx >= (entry.Count / length)))
+        return std::string();
+      return std::string(data + idx * length, length);
+    }
+    return (idx == 0) ? std::string(data, entry.Count) : std::string();
+  };
+  
+  /*
+   * Creates an Any object with the values of the given @a entry.
+   * The type and the dimensions of the created object are the ones stored in the file, except for the characters which are transformed into strings (the first dimension giving the length of each string).
+   */
+  Any C3DParameterTable::any(const Entry& entry) const
+  {
+    const char* values = this->m_Pool.data() + entry.Offset;
+    switch (entry.Type)
+    {
+    case -1:
+      if (entry.Dimensions.size() >= 2)
+      {
+        const size_t length = entry.Dimensions[0];
+        const size_t rows = (length != 0) ? entry.Count / length : 0;
+        std::vector<std::string> p(rows);
+        for (size_t i = 0 ; i < rows ; ++i)
+          p[i].assign(values + i * length, length);
+        return Any(p, std::vector<uint8_t>(entry.Dimensions.begin()+1, entry.Dimensions.end()));
+      }
+      return Any(std::string(values, entry.Count));
+    case 1:
+      return Any(std::vector<int8_t>(values, values + entry.Count), entry.Dimensions);
+    case 2:
+      {
+      std::vector<int16_t> p(entry.Count);
+      if (!p.empty())
+        memcpy(p.data(), values, p.size() * sizeof(int16_t));
+      return Any(p, entry.Dimensions);
+      }
+    case 4:
+      {
+      std::vector<float> p(entry.Count);
+      if (!p.empty())
+        memcpy(p.data(), values, p.size() * sizeof(float));
+      return Any(p, entry.Dimensions);
+      }
+    default:
+      return Any();
+    }
+  };
+  
+  /*
+   * Returns all the extracted entries (including orphan parameters).
+   */
+  auto C3DParameterTable::entries() const _OPENMA_NOEXCEPT -> const std::vector<Entry>&
+  {
+    return this->m_Entries;
+  };
+  
+  bool C3DParameterTable::find(const std::string& key, Any* value) const
+  {
+    const Entry* entry = this->find(key);
+    if (entry == nullptr)
+      return false;
+    *value = this->any(*entry);
+    return true;
+  };
+  
+  void C3DParameterTable::extract(std::unordered_map<std::string,Any>* properties) const
+  {
+    properties->reserve(properties->size() + this->m_Index.size());
+    for (const auto& it : this->m_Index)
+      (*properties)[it.first] = this->any(this->m_Entries[it.second]);
+  };
+};
+};
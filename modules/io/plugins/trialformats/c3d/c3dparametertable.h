@@ -0,0 +1,161 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_io_c3dparametertable_h
+#define __openma_io_c3dparametertable_h
+
+/*
+ * WARNING: This file and its content are not included in the public API and 
+ * can change drastically from one release to another.
+ */
+
+#include "openma/base/propertysource.h"
+#include "openma/base/macros.h" // _OPENMA_NOEXCEPT
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <cstring> // memcpy
+
+namespace ma
+{
+namespace io
+{
+  enum class ByteOrder;
+  
+  class C3DParameterTable : public PropertySource
+  {
+  public:
+    struct Entry
+    {
+      int Group; // Index of the group label
+      std::string Name;
+      int8_t Id;
+      int8_t Type; // -1: char, 1: byte, 2: integer, 4: real
+      std::vector<uint8_t> Dimensions;
+      size_t Offset; // Offset of the values in the pool (native byte order)
+      size_t Count; // Number of values (number of characters for the type char)
+    };
+    
+    C3DParameterTable();
+    ~C3DParameterTable() _OPENMA_NOEXCEPT;
+    
+    size_t parse(const char* data, size_t size, ByteOrder byteOrder, size_t blockNumber, size_t dataFirstBlock, const char* sourceName);
+    
+    const Entry* find(const std::string& key) const _OPENMA_NOEXCEPT;
+    const Entry* find(const char* group, const char* name) const _OPENMA_NOEXCEPT;
+    template <typename T> T value(const Entry& entry, size_t idx = 0, T defaultValue = T()) const _OPENMA_NOEXCEPT;
+    template <typename T> T value(const std::string& key, size_t idx = 0, T defaultValue = T()) const _OPENMA_NOEXCEPT;
+    template <typename T> void values(const Entry& entry, std::vector<T>* values) const;
+    void values(const Entry& entry, std::vector<std::string>* values) const;
+    std::string string(const Entry& entry, size_t idx = 0) const;
+    Any any(const Entry& entry) const;
+    
+    const std::vector<Entry>& entries() const _OPENMA_NOEXCEPT;
+    
+    virtual bool find(const std::string& key, Any* value) const override;
+    virtual void extract(std::unordered_map<std::string,Any>* properties) const override;
+    
+  private:
+    std::vector<std::string> m_Groups;
+    std::vector<Entry> m_Entries;
+    std::unordered_map<std::string,size_t> m_Index; // Interned "GROUP:PARAMETER" keys
+    std::vector<char> m_Pool;
+  };
+  
+  // ----------------------------------------------------------------------- //
+  
+  /*
+   * Returns the numerical value at the index @a idx of the given @a entry converted in the type T.
+   * The @a defaultValue is returned if the index is out of range or if the entry stores characters.
+   * This accessor does not allocate any memory.
+   */
+  template <typename T>
+  inline T C3DParameterTable::value(const Entry& entry, size_t idx, T defaultValue) const _OPENMA_NOEXCEPT
+  {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported");
+    if (idx >= entry.Count)
+      return defaultValue;
+    const char* ptr = this->m_Pool.data() + entry.Offset;
+    switch (entry.Type)
+    {
+    case 1:
+      return static_cast<T>(reinterpret_cast<const int8_t*>(ptr)[idx]);
+    case 2:
+      {
+      int16_t v;
+      memcpy(&v, ptr + idx * sizeof(int16_t), sizeof(int16_t));
+      return static_cast<T>(v);
+      }
+    case 4:
+      {
+      float v;
+      memcpy(&v, ptr + idx * sizeof(float), sizeof(float));
+      return static_cast<T>(v);
+      }
+    default:
+      return defaultValue;
+    }
+  };
+  
+  /*
+   * Convenient method to extract a numerical value from the parameter associated with the given @a key.
+   */
+  template <typename T>
+  inline T C3DParameterTable::value(const std::string& key, size_t idx, T defaultValue) const _OPENMA_NOEXCEPT
+  {
+    const Entry* entry = this->find(key);
+    return (entry != nullptr) ? this->value<T>(*entry, idx, defaultValue) : defaultValue;
+  };
+  
+  /*
+   * Replaces the content of @a values by the numerical values of the given @a entry converted in the type T.
+   * The vector is empty if the entry stores characters.
+   */
+  template <typename T>
+  inline void C3DParameterTable::values(const Entry& entry, std::vector<T>* values) const
+  {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported");
+    values->clear();
+    if (entry.Type == -1)
+      return;
+    values->resize(entry.Count);
+    for (size_t i = 0 ; i < entry.Count ; ++i)
+      (*values)[i] = this->value<T>(entry, i);
+  };
+};
+};
+
+#endif // __openma_io_c3dparametertable_h
@@ -0,0 +1,1117 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "omahandler.h"
+
+#include "openma/io/handler_p.h"
+#include "openma/io/device.h"
+#include "openma/io/enums.h"
+#include "openma/base/any.h"
+#include "openma/base/node.h"
+#include "openma/base/nodefactory.h"
+#include "openma/base/trial.h"
+#include "openma/base/subject.h"
+#include "openma/base/event.h"
+#include "openma/base/timesequence.h"
+#include "openma/base/logger.h"
+
+#include "openma/instrument/forceplatetype1.h"
+#include "openma/instrument/forceplatetype2.h"
+#include "openma/instrument/forceplatetype3.h"
+#include "openma/instrument/forceplatetype4.h"
+#include "openma/instrument/forceplatetype5.h"
+#include "openma/instrument/forceplatetype6.h"
+#include "openma/instrument/forceplatetype7.h"
+#include "openma/instrument/forceplatetype11.h"
+#include "openma/instrument/forceplatetype12.h"
+#include "openma/instrument/forceplatetype21.h"
+
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm> // std::min
+#include <cstring> // memcpy, memcmp
+
+// -------------------------------------------------------------------------- //
+//                                 PRIVATE API                                //
+// -------------------------------------------------------------------------- //
+
+/*
+ * Layout of an OMA file (all the values are stored in little endian):
+ *  - Header: magic "OMAC" + version (uint32)
+ *  - Chunks: one chunk for each component of each time sequence (see OMAHandler::encodeChunk())
+ *  - Graph block: the nodes (type tag, name, specific content, children, properties)
+ *  - Index block: the description of each time sequence and the position of its chunks
+ *  - Footer: offset of the graph block (uint64), offset of the index block (uint64), magic "OMAINDEX"
+ * The footer gives a direct access to the index. Thus, a single time sequence can be extracted without reading the graph.
+ */
+
+namespace ma
+{
+namespace io
+{
+  _OPENMA_CONSTEXPR uint32_t _oma_version = 1u;
+  _OPENMA_CONSTEXPR size_t _oma_header_size = 8;
+  _OPENMA_CONSTEXPR size_t _oma_footer_size = 24;
+  _OPENMA_CONSTEXPR const char _oma_header_magic[] = "OMAC";
+  _OPENMA_CONSTEXPR const char _oma_footer_magic[] = "OMAINDEX";
+  // Minimum number of bytes used to store some elements (used to verify the number of elements read in a corrupted file)
+  _OPENMA_CONSTEXPR size_t _oma_entry_min_size = 81; // Description of a time sequence with one dimension and no chunk
+  _OPENMA_CONSTEXPR size_t _oma_node_min_size = 20; // Node with empty strings, no payload, no child and no property
+  _OPENMA_CONSTEXPR size_t _oma_property_min_size = 5; // Empty key and invalid value
+  
+  enum : uint8_t
+  {
+    _oma_codec_shuffle = 0x01, // Delta of the bits pattern and byte shuffling
+    _oma_codec_lz = 0x02  // LZ77 compression (LZ4 block like)
+  };
+  
+  enum : uint8_t
+  {
+    _oma_any_invalid = 0,
+    _oma_any_bool,
+    _oma_any_int32,
+    _oma_any_uint32,
+    _oma_any_int64,
+    _oma_any_uint64,
+    _oma_any_float,
+    _oma_any_double,
+    _oma_any_string
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  class _OMAEncoder
+  {
+  public:
+    void writeU8(uint8_t value) {this->Data.push_back(static_cast<char>(value));};
+    void writeU32(uint32_t value) {this->writeBytes(value,4);};
+    void writeU64(uint64_t value) {this->writeBytes(value,8);};
+    void writeI32(int32_t value) {this->writeBytes(static_cast<uint32_t>(value),4);};
+    void writeI64(int64_t value) {this->writeBytes(static_cast<uint64_t>(value),8);};
+    void writeFloat(float value) {uint32_t bits; memcpy(&bits,&value,4); this->writeBytes(bits,4);};
+    void writeDouble(double value) {uint64_t bits; memcpy(&bits,&value,8); this->writeBytes(bits,8);};
+    void writeDouble(size_t num, const double* values) {for (size_t i = 0 ; i < num ; ++i) this->writeDouble(values[i]);};
+    void writeFixedString(const char* value, size_t len) {this->Data.insert(this->Data.end(), value, value+len);};
+    void writeString(const std::string& value) {this->writeU32(static_cast<uint32_t>(value.size())); this->Data.insert(this->Data.end(), value.cbegin(), value.cend());};
+    void writeAny(const Any& value);
+    
+    std::vector<char> Data;
+    
+  private:
+    void writeBytes(uint64_t value, unsigned num) {for (unsigned i = 0 ; i < num ; ++i) this->Data.push_back(static_cast<char>((value >> (8*i)) & 0xFF));};
+  };
+  
+  void _OMAEncoder::writeAny(const Any& value)
+  {
+    const auto id = value.type();
+    uint8_t tag = _oma_any_invalid;
+    if (!value.isValid())
+      tag = _oma_any_invalid;
+    else if (id == static_typeid<bool>())
+      tag = _oma_any_bool;
+    else if ((id == static_typeid<char>()) || (id == static_typeid<signed char>()) || (id == static_typeid<short>()) || (id == static_typeid<int>()) || ((id == static_typeid<long>()) && (sizeof(long) == 4)))
+      tag = _oma_any_int32;
+    else if ((id == static_typeid<unsigned char>()) || (id == static_typeid<unsigned short>()) || (id == static_typeid<unsigned>()) || ((id == static_typeid<unsigned long>()) && (sizeof(unsigned long) == 4)))
+      tag = _oma_any_uint32;
+    else if ((id == static_typeid<long>()) || (id == static_typeid<long long>()))
+      tag = _oma_any_int64;
+    else if ((id == static_typeid<unsigned long>()) || (id == static_typeid<unsigned long long>()))
+      tag = _oma_any_uint64;
+    else if (id == static_typeid<float>())
+      tag = _oma_any_float;
+    else if ((id == static_typeid<double>()) || (id == static_typeid<long double>()))
+      tag = _oma_any_double;
+    else if (value.isString())
+      tag = _oma_any_string;
+    else
+      warning("OPENMA.OMA - Unsupported type of value. The property is stored as an invalid value.");
+    this->writeU8(tag);
+    if (tag == _oma_any_invalid)
+      return;
+    const auto dims = value.dimensions();
+    this->writeU32(static_cast<uint32_t>(dims.size()));
+    for (const auto& dim : dims)
+      this->writeU32(dim);
+    const size_t num = value.size();
+    this->writeU32(static_cast<uint32_t>(num));
+    for (size_t i = 0 ; i < num ; ++i)
+    {
+      switch (tag)
+      {
+      case _oma_any_bool:
+        this->writeU8(value.cast<bool>(i) ? 1 : 0);
+        break;
+      case _oma_any_int32:
+        this->writeI32(value.cast<int32_t>(i));
+        break;
+      case _oma_any_uint32:
+        this->writeU32(value.cast<uint32_t>(i));
+        break;
+      case _oma_any_int64:
+        this->writeI64(value.cast<long long>(i));
+        break;
+      case _oma_any_uint64:
+        this->writeU64(value.cast<unsigned long long>(i));
+        break;
+      case _oma_any_float:
+        this->writeFloat(value.cast<float>(i));
+        break;
+      case _oma_any_double:
+        this->writeDouble(value.cast<double>(i));
+        break;
+      default: // _oma_any_string
+        this->writeString(value.cast<std::string>(i));
+        break;
+      }
+    }
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  class _OMADecoder
+  {
+  public:
+    _OMADecoder(const char* data, size_t size) : Data(data), Size(size), Position(0) {};
+    
+    uint8_t readU8() {this->require(1); return static_cast<uint8_t>(this->Data[this->Position++]);};
+    uint32_t readU32() {return static_cast<uint32_t>(this->readBytes(4));};
+    uint64_t readU64() {return this->readBytes(8);};
+    int32_t readI32() {return static_cast<int32_t>(this->readU32());};
+    int64_t readI64() {return static_cast<int64_t>(this->readU64());};
+    float readFloat() {uint32_t bits = this->readU32(); float value; memcpy(&value,&bits,4); return value;};
+    double readDouble() {uint64_t bits = this->readU64(); double value; memcpy(&value,&bits,8); return value;};
+    void readDouble(size_t num, double* values) {for (size_t i = 0 ; i < num ; ++i) values[i] = this->readDouble();};
+    std::string readFixedString(size_t len) {this->require(len); std::string str(this->Data+this->Position,len); this->Position += len; return str;};
+    std::string readString() {const uint32_t len = this->readU32(); this->require(len); std::string str(this->Data+this->Position,len); this->Position += len; return str;};
+    // Read a number of elements. Each element uses at least @a size bytes. Thus, the remaining bytes must be able to store all of them.
+    uint32_t readCount(size_t size) {const uint32_t num = this->readU32(); if (((this->Size - this->Position) / size) < num) throw(FormatError("OPENMA.OMA - Number of elements out of the block. The file is probably corrupted.")); return num;};
+    Any readAny();
+    // Used to skip unknown content.
+    void skip(size_t num) {this->require(num); this->Position += num;};
+    
+  private:
+    void require(size_t num) const {if ((this->Size - this->Position) < num) throw(FormatError("OPENMA.OMA - Unexpected end of block. The file is probably corrupted."));};
+    uint64_t readBytes(unsigned num)
+    {
+      this->require(num);
+      uint64_t value = 0;
+      for (unsigned i = 0 ; i < num ; ++i)
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(this->Data[this->Position++])) << (8*i);
+      return value;
+    };
+    
+    const char* Data;
+    size_t Size;
+    size_t Position;
+  };
+  
+  template <typename T, typename R>
+  Any _oma_read_any_values(const std::vector<unsigned>& dims, uint32_t num, R&& reader)
+  {
+    std::vector<T> values(num);
+    for (uint32_t i = 0 ; i < num ; ++i)
+      values[i] = static_cast<T>(reader());
+    if (dims.empty() && (num == 1))
+      return Any(static_cast<T>(values[0]));
+    return Any(values,dims);
+  };
+  
+  Any _OMADecoder::readAny()
+  {
+    const uint8_t tag = this->readU8();
+    if (tag == _oma_any_invalid)
+      return Any();
+    std::vector<unsigned> dims(this->readCount(4));
+    for (auto& dim : dims)
+      dim = this->readU32();
+    size_t size = 4;
+    if (tag == _oma_any_bool)
+      size = 1;
+    else if ((tag == _oma_any_int64) || (tag == _oma_any_uint64) || (tag == _oma_any_double))
+      size = 8;
+    const uint32_t num = this->readCount(size);
+    switch (tag)
+    {
+    case _oma_any_bool:
+      return _oma_read_any_values<bool>(dims,num,[this](){return this->readU8() != 0;});
+    case _oma_any_int32:
+      return _oma_read_any_values<int>(dims,num,[this](){return this->readI32();});
+    case _oma_any_uint32:
+      return _oma_read_any_values<unsigned>(dims,num,[this](){return this->readU32();});
+    case _oma_any_int64:
+      return _oma_read_any_values<long long>(dims,num,[this](){return this->readI64();});
+    case _oma_any_uint64:
+      return _oma_read_any_values<unsigned long long>(dims,num,[this](){return this->readU64();});
+    case _oma_any_float:
+      return _oma_read_any_values<float>(dims,num,[this](){return this->readFloat();});
+    case _oma_any_double:
+      return _oma_read_any_values<double>(dims,num,[this](){return this->readDouble();});
+    case _oma_any_string:
+      return _oma_read_any_values<std::string>(dims,num,[this](){return this->readString();});
+    default:
+      throw(FormatError("OPENMA.OMA - Unknown type of value."));
+    }
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  /*
+   * Give access to the content of a device. 
+   * If the device is memory mapped (e.g. File opened in reading mode, Buffer), the content is directly accessed. Otherwise, the requested part is read in the given buffer.
+   */
+  class _OMASource
+  {
+  public:
+    _OMASource(Device* device) : Source(device), Mapped(device->data()), Size(0)
+    {
+      if (this->Mapped != nullptr)
+        this->Size = static_cast<uint64_t>(device->size());
+      else
+      {
+        device->seek(0, Origin::End);
+        this->Size = static_cast<uint64_t>(device->tell());
+      }
+    };
+    
+    const char* fetch(uint64_t offset, uint64_t size, std::vector<char>* buffer)
+    {
+      if ((offset > this->Size) || (size > (this->Size - offset)))
+        throw(FormatError("OPENMA.OMA - Block out of the file. The file is probably corrupted."));
+      if (this->Mapped != nullptr)
+        return this->Mapped + offset;
+      buffer->resize(static_cast<size_t>(size));
+      this->Source->seek(static_cast<Device::Offset>(offset), Origin::Begin);
+      this->Source->read(buffer->data(), static_cast<Device::Size>(size));
+      return buffer->data();
+    };
+    
+    Device* Source;
+    const char* Mapped;
+    uint64_t Size;
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  struct _OMAChunk
+  {
+    uint64_t Offset;
+    uint64_t Size;
+  };
+  
+  struct _OMATimeSequenceEntry
+  {
+    std::string Name;
+    uint32_t Node;
+    std::vector<unsigned> Dimensions;
+    uint32_t Samples;
+    double SampleRate;
+    double StartTime;
+    int32_t Type;
+    std::string Unit;
+    double Scale;
+    double Offset;
+    std::array<double,2> Range;
+    uint8_t Storage;
+    std::vector<_OMAChunk> Chunks;
+  };
+  
+  void _oma_write_entry(_OMAEncoder* block, const _OMATimeSequenceEntry& entry)
+  {
+    block->writeString(entry.Name);
+    block->writeU32(entry.Node);
+    block->writeU32(static_cast<uint32_t>(entry.Dimensions.size()));
+    for (const auto& dim : entry.Dimensions)
+      block->writeU32(dim);
+    block->writeU32(entry.Samples);
+    block->writeDouble(entry.SampleRate);
+    block->writeDouble(entry.StartTime);
+    block->writeI32(entry.Type);
+    block->writeString(entry.Unit);
+    block->writeDouble(entry.Scale);
+    block->writeDouble(entry.Offset);
+    block->writeDouble(2,entry.Range.data());
+    block->writeU8(entry.Storage);
+    block->writeU32(static_cast<uint32_t>(entry.Chunks.size()));
+    for (const auto& chunk : entry.Chunks)
+    {
+      block->writeU64(chunk.Offset);
+      block->writeU64(chunk.Size);
+    }
+  };
+  
+  void _oma_read_entry(_OMADecoder* block, _OMATimeSequenceEntry* entry)
+  {
+    entry->Name = block->readString();
+    entry->Node = block->readU32();
+    entry->Dimensions.resize(block->readCount(4));
+    for (auto& dim : entry->Dimensions)
+      dim = block->readU32();
+    entry->Samples = block->readU32();
+    entry->SampleRate = block->readDouble();
+    entry->StartTime = block->readDouble();
+    entry->Type = block->readI32();
+    entry->Unit = block->readString();
+    entry->Scale = block->readDouble();
+    entry->Offset = block->readDouble();
+    block->readDouble(2,entry->Range.data());
+    entry->Storage = block->readU8();
+    entry->Chunks.resize(block->readCount(16));
+    for (auto& chunk : entry->Chunks)
+    {
+      chunk.Offset = block->readU64();
+      chunk.Size = block->readU64();
+    }
+    if (entry->Dimensions.empty() || (entry->Storage > static_cast<uint8_t>(TimeSequence::Storage::Int16)))
+      throw(FormatError("OPENMA.OMA - Corrupted description of the time sequence '" + entry->Name + "'."));
+  };
+  
+  /*
+   * Read the footer and the index block. The offset of the graph block is returned.
+   */
+  uint64_t _oma_read_index(_OMASource* source, std::vector<_OMATimeSequenceEntry>* entries)
+  {
+    std::vector<char> buffer;
+    if (source->Size < (_oma_header_size + _oma_footer_size))
+      throw(FormatError("OPENMA.OMA - The file is too small to contain an index."));
+    const uint64_t footerOffset = source->Size - _oma_footer_size;
+    _OMADecoder footer(source->fetch(footerOffset, _oma_footer_size, &buffer), _oma_footer_size);
+    const uint64_t graphOffset = footer.readU64();
+    const uint64_t indexOffset = footer.readU64();
+    if (footer.readFixedString(8) != _oma_footer_magic)
+      throw(FormatError("OPENMA.OMA - Invalid footer. The file is probably truncated."));
+    if ((graphOffset > indexOffset) || (indexOffset > footerOffset))
+      throw(FormatError("OPENMA.OMA - Invalid offsets in the footer."));
+    _OMADecoder index(source->fetch(indexOffset, footerOffset - indexOffset, &buffer), static_cast<size_t>(footerOffset - indexOffset));
+    entries->resize(index.readCount(_oma_entry_min_size));
+    for (auto& entry : *entries)
+      _oma_read_entry(&index,&entry);
+    return graphOffset;
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  void _oma_lz_write_length(std::vector<uint8_t>* output, size_t len)
+  {
+    while (len >= 255)
+    {
+      output->push_back(255);
+      len -= 255;
+    }
+    output->push_back(static_cast<uint8_t>(len));
+  };
+  
+  /*
+   * Write a sequence: literals followed (if @a matchLength is not null) by a match.
+   * The token uses the high nibble for the number of literals and the low nibble for the length of the match (minus 4).
+   */
+  void _oma_lz_write_sequence(std::vector<uint8_t>* output, const uint8_t* literals, size_t numLiterals, size_t matchOffset, size_t matchLength)
+  {
+    const size_t extraLength = (matchLength != 0) ? matchLength - 4 : 0;
+    output->push_back(static_cast<uint8_t>((std::min<size_t>(numLiterals,15) << 4) | std::min<size_t>(extraLength,15)));
+    if (numLiterals >= 15)
+      _oma_lz_write_length(output, numLiterals - 15);
+    output->insert(output->end(), literals, literals + numLiterals);
+    if (matchLength == 0)
+      return;
+    output->push_back(static_cast<uint8_t>(matchOffset & 0xFF));
+    output->push_back(static_cast<uint8_t>((matchOffset >> 8) & 0xFF));
+    if (extraLength >= 15)
+      _oma_lz_write_length(output, extraLength - 15);
+  };
+  
+  /*
+   * Greedy LZ77 compression using a hash table of 4-byte sequences (64 kB window).
+   * The last sequence contains only literals.
+   */
+  void _oma_lz_compress(const uint8_t* input, size_t num, std::vector<uint8_t>* output)
+  {
+    _OPENMA_CONSTEXPR size_t minMatch = 4, window = 0xFFFF;
+    _OPENMA_CONSTEXPR unsigned hashBits = 12;
+    std::vector<size_t> table(1 << hashBits, 0); // Position + 1 (0 means empty)
+    size_t anchor = 0, i = 0;
+    while (i + minMatch <= num)
+    {
+      uint32_t sequence;
+      memcpy(&sequence, input + i, minMatch);
+      const uint32_t hash = (sequence * 2654435761u) >> (32 - hashBits);
+      const size_t candidate = table[hash];
+      table[hash] = i + 1;
+      if ((candidate != 0) && ((i - candidate + 1) <= window) && (memcmp(input + candidate - 1, input + i, minMatch) == 0))
+      {
+        const size_t reference = candidate - 1;
+        size_t len = minMatch;
+        while (((i + len) < num) && (input[reference + len] == input[i + len]))
+          ++len;
+        _oma_lz_write_sequence(output, input + anchor, i - anchor, i - reference, len);
+        i += len;
+        anchor = i;
+      }
+      else
+        ++i;
+    }
+    _oma_lz_write_sequence(output, input + anchor, num - anchor, 0, 0);
+  };
+  
+  bool _oma_lz_read_length(const uint8_t** input, const uint8_t* end, size_t* len)
+  {
+    uint8_t value;
+    do
+    {
+      if (*input >= end)
+        return false;
+      value = *(*input)++;
+      *len += value;
+    } while (value == 255);
+    return true;
+  };
+  
+  bool _oma_lz_decompress(const uint8_t* input, size_t num, uint8_t* output, size_t size) _OPENMA_NOEXCEPT
+  {
+    const uint8_t* ip = input;
+    const uint8_t* const iend = input + num;
+    uint8_t* op = output;
+    uint8_t* const oend = output + size;
+    while (ip < iend)
+    {
+      const uint8_t token = *ip++;
+      size_t numLiterals = token >> 4;
+      if ((numLiterals == 15) && !_oma_lz_read_length(&ip, iend, &numLiterals))
+        return false;
+      if ((static_cast<size_t>(iend - ip) < numLiterals) || (static_cast<size_t>(oend - op) < numLiterals))
+        return false;
+      memcpy(op, ip, numLiterals);
+      ip += numLiterals;
+      op += numLiterals;
+      if (ip == iend) // Last sequence
+        break;
+      if ((iend - ip) < 2)
+        return false;
+      const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+      ip += 2;
+      size_t matchLength = (token & 0x0F);
+      if ((matchLength == 15) && !_oma_lz_read_length(&ip, iend, &matchLength))
+        return false;
+      matchLength += 4;
+      if ((offset == 0) || (offset > static_cast<size_t>(op - output)) || (static_cast<size_t>(oend - op) < matchLength))
+        return false;
+      // Byte per byte copy as the match can overlap the output
+      const uint8_t* match = op - offset;
+      for (size_t i = 0 ; i < matchLength ; ++i)
+        *op++ = *match++;
+    }
+    return (op == oend);
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  /*
+   * Registered node types. The first type for which the node is castable gives its tag.
+   * Thus, the most derived types must be listed first.
+   * Other modules (e.g. body) can register their own types with the function register_node_type().
+   * Registered types are used before the types listed here for the writing, and after them for the reading.
+   * Remaining types are stored as plain Node objects. Only their name, properties and children are kept.
+   */
+  struct _OMANodeType
+  {
+    const char* Tag;
+    bool (*Match)(const Node*);
+    Node* (*Create)(const std::string&, Node*);
+  };
+  
+  template <typename T>
+  bool _oma_match_node(const Node* node)
+  {
+    return node->isCastable(static_typeid<T>());
+  };
+  
+  template <typename T>
+  Node* _oma_create_node(const std::string& name, Node* parent)
+  {
+    return new T(name, parent);
+  };
+  
+  template <>
+  Node* _oma_create_node<Event>(const std::string& name, Node* parent)
+  {
+    return new Event(name, 0.0, {}, {}, parent);
+  };
+  
+  template <>
+  Node* _oma_create_node<Subject>(const std::string& name, Node* parent)
+  {
+    return new Subject(name, {}, parent);
+  };
+  
+  // Time sequences are created from their index entry.
+  template <>
+  Node* _oma_create_node<TimeSequence>(const std::string& , Node* )
+  {
+    return nullptr;
+  };
+  
+  const std::vector<_OMANodeType>& _oma_node_types()
+  {
+    static const std::vector<_OMANodeType> types{
+      {"ForcePlateType11", &_oma_match_node<instrument::ForcePlateType11>, &_oma_create_node<instrument::ForcePlateType11>},
+      {"ForcePlateType12", &_oma_match_node<instrument::ForcePlateType12>, &_oma_create_node<instrument::ForcePlateType12>},
+      {"ForcePlateType21", &_oma_match_node<instrument::ForcePlateType21>, &_oma_create_node<instrument::ForcePlateType21>},
+      {"ForcePlateType1", &_oma_match_node<instrument::ForcePlateType1>, &_oma_create_node<instrument::ForcePlateType1>},
+      {"ForcePlateType2", &_oma_match_node<instrument::ForcePlateType2>, &_oma_create_node<instrument::ForcePlateType2>},
+      {"ForcePlateType3", &_oma_match_node<instrument::ForcePlateType3>, &_oma_create_node<instrument::ForcePlateType3>},
+      {"ForcePlateType4", &_oma_match_node<instrument::ForcePlateType4>, &_oma_create_node<instrument::ForcePlateType4>},
+      {"ForcePlateType5", &_oma_match_node<instrument::ForcePlateType5>, &_oma_create_node<instrument::ForcePlateType5>},
+      {"ForcePlateType6", &_oma_match_node<instrument::ForcePlateType6>, &_oma_create_node<instrument::ForcePlateType6>},
+      {"ForcePlateType7", &_oma_match_node<instrument::ForcePlateType7>, &_oma_create_node<instrument::ForcePlateType7>},
+      {"TimeSequence", &_oma_match_node<TimeSequence>, &_oma_create_node<TimeSequence>},
+      {"Event", &_oma_match_node<Event>, &_oma_create_node<Event>},
+      {"Subject", &_oma_match_node<Subject>, &_oma_create_node<Subject>},
+      {"Trial", &_oma_match_node<Trial>, &_oma_create_node<Trial>},
+      {"Node", &_oma_match_node<Node>, &_oma_create_node<Node>}
+    };
+    return types;
+  };
+  
+  const _OMANodeType* _oma_find_node_type(const Node* node)
+  {
+    const auto& types = _oma_node_types();
+    for (const auto& type : types)
+    {
+      if (type.Match(node))
+        return &type;
+    }
+    return &types.back();
+  };
+  
+  const _OMANodeType* _oma_find_node_type(const std::string& tag)
+  {
+    for (const auto& type : _oma_node_types())
+    {
+      if (tag.compare(type.Tag) == 0)
+        return &type;
+    }
+    return nullptr;
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  // Content of a force plate not available as static properties
+  void _oma_write_forceplate(_OMAEncoder* block, const instrument::ForcePlate* fp, const std::unordered_map<const Node*,uint32_t>& ids)
+  {
+    block->writeDouble(3, fp->relativeSurfaceOrigin().data());
+    block->writeDouble(12, fp->surfaceCorners().data());
+    const auto& calibration = fp->calibrationMatrixData();
+    block->writeU32(static_cast<uint32_t>(calibration.size()));
+    block->writeDouble(calibration.size(), calibration.data());
+    block->writeU8(fp->isSoftResetEnabled() ? 1 : 0);
+    block->writeI32(fp->softResetSamples()[0]);
+    block->writeI32(fp->softResetSamples()[1]);
+    std::array<double,2> offsets{{0.0, 0.0}};
+    uint8_t hasOffsets = 1;
+    if (fp->isCastable(static_typeid<instrument::ForcePlateType3>()))
+      offsets = static_cast<const instrument::ForcePlateType3*>(fp)->sensorOffsets();
+    else if (fp->isCastable(static_typeid<instrument::ForcePlateType6>()))
+      offsets = static_cast<const instrument::ForcePlateType6*>(fp)->sensorOffsets();
+    else if (fp->isCastable(static_typeid<instrument::ForcePlateType7>()))
+      offsets = static_cast<const instrument::ForcePlateType7*>(fp)->sensorOffsets();
+    else
+      hasOffsets = 0;
+    block->writeU8(hasOffsets);
+    block->writeDouble(2, offsets.data());
+    const unsigned num = fp->channelsNumberRequired();
+    block->writeU32(num);
+    for (unsigned i = 0 ; i < num ; ++i)
+    {
+      const auto it = ids.find(fp->channel(i));
+      block->writeI32((it != ids.cend()) ? static_cast<int32_t>(it->second) : -1);
+    }
+  };
+  
+  void _oma_read_forceplate(_OMADecoder* block, instrument::ForcePlate* fp, std::vector<int32_t>* channels)
+  {
+    std::array<double,3> rso, c1, c2, c3, c4;
+    block->readDouble(3, rso.data());
+    block->readDouble(3, c1.data());
+    block->readDouble(3, c2.data());
+    block->readDouble(3, c3.data());
+    block->readDouble(3, c4.data());
+    fp->setGeometry(rso, c1, c2, c3, c4);
+    std::vector<double> calibration(block->readCount(8));
+    block->readDouble(calibration.size(), calibration.data());
+    if (!calibration.empty())
+      fp->setCalibrationMatrixData(calibration);
+    fp->setSoftResetEnabled(block->readU8() != 0);
+    std::array<int,2> samples;
+    samples[0] = block->readI32();
+    samples[1] = block->readI32();
+    fp->setSoftResetSamples(samples);
+    const bool hasOffsets = (block->readU8() != 0);
+    std::array<double,2> offsets;
+    block->readDouble(2, offsets.data());
+    if (hasOffsets)
+    {
+      if (fp->isCastable(static_typeid<instrument::ForcePlateType3>()))
+        static_cast<instrument::ForcePlateType3*>(fp)->setSensorOffsets(offsets);
+      else if (fp->isCastable(static_typeid<instrument::ForcePlateType6>()))
+        static_cast<instrument::ForcePlateType6*>(fp)->setSensorOffsets(offsets);
+      else if (fp->isCastable(static_typeid<instrument::ForcePlateType7>()))
+        static_cast<instrument::ForcePlateType7*>(fp)->setSensorOffsets(offsets);
+    }
+    channels->resize(block->readCount(4));
+    for (auto& channel : *channels)
+      channel = block->readI32();
+  };
+  
+  // ------------------------------------------------------------------------ //
+  
+  TimeSequence* _oma_create_timesequence(_OMASource* source, const _OMATimeSequenceEntry& entry, Node* parent)
+  {
+    std::vector<char> buffer;
+    // NOTE: The number of chunks is verified before the allocation of the time sequence as the chunks were already checked against the size of the index.
+    size_t components = 1;
+    for (const auto& dim : entry.Dimensions)
+      components *= dim;
+    if (entry.Chunks.size() != components)
+      throw(FormatError("OPENMA.OMA - Wrong number of chunks for the time sequence '" + entry.Name + "'."));
+    auto ts = new TimeSequence(entry.Name, entry.Dimensions, entry.Samples, entry.SampleRate, entry.StartTime, entry.Type, entry.Unit, entry.Scale, entry.Offset, entry.Range, parent);
+    std::vector<double> values(entry.Samples);
+    for (unsigned i = 0 ; i < ts->components() ; ++i)
+    {
+      const auto& chunk = entry.Chunks[i];
+      const char* data = source->fetch(chunk.Offset, chunk.Size, &buffer);
+      if (!OMAHandler::decodeChunk(reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(chunk.Size), values.data(), values.size()))
+      {
+        delete ts;
+        throw(FormatError("OPENMA.OMA - Corrupted chunk for the time sequence '" + entry.Name + "'."));
+      }
+      ts->write(i, 0, entry.Samples, values.data());
+    }
+    if (entry.Storage != static_cast<uint8_t>(TimeSequence::Storage::Double))
+      ts->setStorage(static_cast<TimeSequence::Storage>(entry.Storage));
+    return ts;
+  };
+};
+};
+
+// -------------------------------------------------------------------------- //
+//                                 PUBLIC API                                 //
+// -------------------------------------------------------------------------- //
+
+namespace ma
+{
+namespace io
+{
+  /*
+   * The OMA file format is the native binary container of OpenMA. It is used to cache processed data (e.g. reconstructed models and kinematics) without losing the content of the Node graph.
+   * Each node is stored with a type tag, its static (mutable) and dynamic properties and its children (a node shared by several parents is stored once).
+   * The data of each time sequence are stored component per component in chunks. The values are first encoded using the delta of their bits pattern, then shuffled byte per byte and finally compressed with a LZ77 codec (similar to LZ4).
+   * The index at the end of the file gives a direct access to the chunks. Thus, one time sequence can be extracted (see readTimeSequence()) without decoding the other ones. 
+   * When the device is memory mapped (e.g. File opened in reading mode), the chunks are decoded directly from the mapped memory.
+   * @note Only the types known by this handler are recreated (base and instrument modules). The other ones (e.g. Model, Segment, Joint of the body module) are recreated as Node objects keeping their name, properties, children and time sequences. Thus, a model must be computed again (or its time sequences used directly) after the reading. The capacity and ring buffer configuration of a time sequence are not stored.
+   * @note The number of elements read from a file is verified against the size of the block containing them. Thus, a corrupted file cannot trigger huge allocations for them.
+   */
+  
+  OMAHandler::OMAHandler()
+  : Handler()
+  {};
+  
+  OMAHandler::~OMAHandler() _OPENMA_NOEXCEPT = default;
+  
+  Signature OMAHandler::verifySignature(const Device* const device) _OPENMA_NOEXCEPT
+  {
+    char signature[4] = {0};
+    device->peek(signature,sizeof(signature));
+    if (memcmp(signature, _oma_header_magic, sizeof(signature)) != 0)
+      return Signature::Invalid;
+    return Signature::Valid;
+  };
+  
+  /*
+   * Returns the name of the time sequences stored in the given @a device.
+   * In case of error, an empty list is returned and an error message is sent to the logger.
+   */
+  std::vector<std::string> OMAHandler::listTimeSequences(Device* device)
+  {
+    std::vector<std::string> names;
+    try
+    {
+      _OMASource source(device);
+      std::vector<_OMATimeSequenceEntry> entries;
+      _oma_read_index(&source, &entries);
+      names.reserve(entries.size());
+      for (const auto& entry : entries)
+        names.push_back(entry.Name);
+    }
+    catch (std::exception& e)
+    {
+      error("%s", e.what());
+      names.clear();
+    }
+    return names;
+  };
+  
+  /*
+   * Extract only the time sequence with the given @a name from the @a device (the first one if several time sequences use this name).
+   * Only the index and the chunks of this time sequence are accessed. 
+   * The created time sequence is attached to @a parent. If no time sequence corresponds to @a name or in case of error, nullptr is returned.
+   */
+  TimeSequence* OMAHandler::readTimeSequence(Device* device, const std::string& name, Node* parent)
+  {
+    try
+    {
+      _OMASource source(device);
+      std::vector<_OMATimeSequenceEntry> entries;
+      _oma_read_index(&source, &entries);
+      for (const auto& entry : entries)
+      {
+        if (entry.Name == name)
+          return _oma_create_timesequence(&source, entry, parent);
+      }
+    }
+    catch (std::exception& e)
+    {
+      error("%s", e.what());
+    }
+    return nullptr;
+  };
+  
+  /*
+   * Encode the given @a values in a chunk. 
+   * The first byte of the chunk gives the used codec. The values are encoded using the delta of their bits pattern and then shuffled byte per byte (all the first bytes, then all the second bytes, etc.). 
+   * Because the values of a time sequence are mostly smooth, the most significant bytes are very similar and the shuffled data are well compressed by the LZ77 codec. 
+   * If the compression does not reduce the size, the shuffled data are stored directly.
+   */
+  void OMAHandler::encodeChunk(const double* values, size_t num, std::vector<uint8_t>* chunk)
+  {
+    const size_t size = num * sizeof(double);
+    std::vector<uint8_t> shuffled(size);
+    uint64_t previous = 0;
+    for (size_t i = 0 ; i < num ; ++i)
+    {
+      uint64_t bits;
+      memcpy(&bits, values + i, sizeof(double));
+      const uint64_t delta = bits - previous;
+      previous = bits;
+      for (size_t k = 0 ; k < sizeof(double) ; ++k)
+        shuffled[k * num + i] = static_cast<uint8_t>((delta >> (8 * k)) & 0xFF);
+    }
+    chunk->clear();
+    chunk->reserve(size + 1);
+    chunk->push_back(_oma_codec_shuffle | _oma_codec_lz);
+    _oma_lz_compress(shuffled.data(), size, chunk);
+    if ((chunk->size() - 1) >= size)
+    {
+      chunk->resize(1);
+      (*chunk)[0] = _oma_codec_shuffle;
+      chunk->insert(chunk->end(), shuffled.cbegin(), shuffled.cend());
+    }
+  };
+  
+  /*
+   * Decode the content of @a chunk (with the given @a size) into @a num @a values.
+   * Returns false if the chunk is corrupted or does not contain exactly @a num values.
+   */
+  bool OMAHandler::decodeChunk(const uint8_t* chunk, size_t size, double* values, size_t num) _OPENMA_NOEXCEPT
+  {
+    if (size == 0)
+      return false;
+    const uint8_t codec = chunk[0];
+    const size_t len = num * sizeof(double);
+    std::vector<uint8_t> decompressed;
+    const uint8_t* shuffled = chunk + 1;
+    if ((codec & _oma_codec_lz) == _oma_codec_lz)
+    {
+      decompressed.resize(len);
+      if (!_oma_lz_decompress(chunk + 1, size - 1, decompressed.data(), len))
+        return false;
+      shuffled = decompressed.data();
+    }
+    else if ((size - 1) != len)
+      return false;
+    if ((codec & _oma_codec_shuffle) == _oma_codec_shuffle)
+    {
+      uint64_t previous = 0;
+      for (size_t i = 0 ; i < num ; ++i)
+      {
+        uint64_t delta = 0;
+        for (size_t k = 0 ; k < sizeof(double) ; ++k)
+          delta |= static_cast<uint64_t>(shuffled[k * num + i]) << (8 * k);
+        previous += delta;
+        memcpy(values + i, &previous, sizeof(double));
+      }
+    }
+    else
+      memcpy(values, shuffled, len);
+    return true;
+  };
+  
+  Signature OMAHandler::verifySignature() const _OPENMA_NOEXCEPT
+  {
+    return verifySignature(this->device());
+  };
+  
+  void OMAHandler::readDevice(Node* output)
+  {
+    _OMASource source(this->device());
+    std::vector<char> buffer;
+    // Header
+    _OMADecoder header(source.fetch(0, _oma_header_size, &buffer), _oma_header_size);
+    if (header.readFixedString(4) != _oma_header_magic)
+      throw(FormatError("OPENMA.OMA - Invalid header."));
+    if (header.readU32() > _oma_version)
+      throw(FormatError("OPENMA.OMA - Unsupported version. The file was created by a more recent version of OpenMA."));
+    // Index
+    std::vector<_OMATimeSequenceEntry> entries;
+    const uint64_t graphOffset = _oma_read_index(&source, &entries);
+    // Graph
+    // NOTE: The nodes are first attached to a temporary root. In case of error, they are then automatically deleted.
+    Node staging("_OMAStaging");
+    _OMADecoder graph(source.fetch(graphOffset, source.Size - _oma_footer_size - graphOffset, &buffer), static_cast<size_t>(source.Size - _oma_footer_size - graphOffset));
+    const uint32_t numNodes = graph.readCount(_oma_node_min_size);
+    if (numNodes == 0)
+      throw(FormatError("OPENMA.OMA - Empty graph."));
+    std::vector<Node*> nodes(numNodes, nullptr);
+    std::vector<std::vector<uint32_t>> children(numNodes);
+    std::vector<std::pair<instrument::ForcePlate*, std::vector<int32_t>>> forceplates;
+    std::vector<std::pair<Node*, void (*)(Node*)>> restorations;
+    for (uint32_t i = 0 ; i < numNodes ; ++i)
+    {
+      const std::string tag = graph.readString();
+      const std::string name = graph.readString();
+      const uint32_t payload = graph.readU32();
+      Node* node = nullptr;
+      const _OMANodeType* type = _oma_find_node_type(tag);
+      if (i == 0)
+      {
+        // The first node is the given input during the writing. Only its children are extracted.
+        graph.skip(payload);
+      }
+      else if (type == nullptr)
+      {
+        graph.skip(payload);
+        const NodeType registered = find_node_type(tag);
+        if (registered.Create != nullptr)
+          node = registered.Create(name, &staging);
+        if (node != nullptr)
+        {
+          if (registered.Restore != nullptr)
+            restorations.emplace_back(node, registered.Restore);
+        }
+        else
+        {
+          warning("OPENMA.OMA - Unknown type '%s'. The node '%s' is extracted as a Node object.", tag.c_str(), name.c_str());
+          node = new Node(name, &staging);
+        }
+      }
+      else if (tag.compare("TimeSequence") == 0)
+      {
+        const uint32_t idx = graph.readU32();
+        if (idx >= entries.size())
+          throw(FormatError("OPENMA.OMA - Time sequence out of the index."));
+        node = _oma_create_timesequence(&source, entries[idx], &staging);
+      }
+      else
+      {
+        node = type->Create(name, &staging);
+        if (node->isCastable(static_typeid<instrument::ForcePlate>()))
+        {
+          forceplates.emplace_back(static_cast<instrument::ForcePlate*>(node), std::vector<int32_t>{});
+          _oma_read_forceplate(&graph, forceplates.back().first, &forceplates.back().second);
+        }
+        else
+          graph.skip(payload);
+      }
+      nodes[i] = node;
+      children[i].resize(graph.readCount(4));
+      for (auto& child : children[i])
+      {
+        child = graph.readU32();
+        if ((child == 0) || (child >= numNodes))
+          throw(FormatError("OPENMA.OMA - Child out of the graph."));
+      }
+      const uint32_t numProperties = graph.readCount(_oma_property_min_size);
+      for (uint32_t j = 0 ; j < numProperties ; ++j)
+      {
+        const std::string key = graph.readString();
+        const Any value = graph.readAny();
+        if (node != nullptr)
+          node->setProperty(key, value);
+      }
+    }
+    // Relationships
+    for (uint32_t i = 1 ; i < numNodes ; ++i)
+    {
+      for (const auto& child : children[i])
+        nodes[child]->addParent(nodes[i]);
+    }
+    for (auto& fp : forceplates)
+    {
+      for (size_t j = 0 ; j < fp.second.size() ; ++j)
+      {
+        const int32_t idx = fp.second[j];
+        if ((idx > 0) && (static_cast<uint32_t>(idx) < numNodes) && nodes[idx]->isCastable(static_typeid<TimeSequence>()))
+        {
+          // The channel is detached from the node 'Channels' as it is attached again when mapped.
+          auto channel = static_cast<TimeSequence*>(nodes[idx]);
+          channel->removeParent(fp.first->channels());
+          fp.first->setChannel(static_cast<unsigned>(j), channel);
+        }
+      }
+    }
+    // Registered types rebuild their internal state from their children.
+    for (const auto& restoration : restorations)
+      restoration.second(restoration.first);
+    for (const auto& child : children[0])
+      nodes[child]->addParent(output);
+    // Orphans (i.e. nodes only attached to the temporary root) are deleted with it.
+    for (uint32_t i = 1 ; i < numNodes ; ++i)
+    {
+      if (nodes[i]->parents().size() > 1)
+        nodes[i]->removeParent(&staging);
+    }
+  };
+  
+  void OMAHandler::writeDevice(const Node* const input)
+  {
+    Device* device = this->device();
+    // Gather the nodes. Shared nodes are stored once.
+    std::vector<const Node*> nodes{input};
+    std::unordered_map<const Node*, uint32_t> ids{{input, 0u}};
+    for (size_t i = 0 ; i < nodes.size() ; ++i)
+    {
+      for (const auto& child : nodes[i]->children())
+      {
+        if (ids.find(child) == ids.cend())
+        {
+          ids.emplace(child, static_cast<uint32_t>(nodes.size()));
+          nodes.push_back(child);
+        }
+      }
+    }
+    // Header
+    _OMAEncoder header;
+    header.writeFixedString(_oma_header_magic, 4);
+    header.writeU32(_oma_version);
+    device->write(header.Data.data(), header.Data.size());
+    uint64_t offset = header.Data.size();
+    // Chunks
+    std::vector<_OMATimeSequenceEntry> entries;
+    std::unordered_map<const Node*, uint32_t> entryIds;
+    std::vector<double> values;
+    std::vector<uint8_t> chunk;
+    for (uint32_t i = 1 ; i < nodes.size() ; ++i)
+    {
+      if (!nodes[i]->isCastable(static_typeid<TimeSequence>()))
+        continue;
+      const auto ts = static_cast<const TimeSequence*>(nodes[i]);
+      _OMATimeSequenceEntry entry;
+      entry.Name = ts->name();
+      entry.Node = i;
+      entry.Dimensions = ts->dimensions();
+      entry.Samples = ts->samples();
+      entry.SampleRate = ts->sampleRate();
+      entry.StartTime = ts->startTime();
+      entry.Type = ts->type();
+      entry.Unit = ts->unit();
+      entry.Scale = ts->scale();
+      entry.Offset = ts->offset();
+      entry.Range = ts->range();
+      entry.Storage = static_cast<uint8_t>(ts->storage());
+      values.resize(ts->samples());
+      for (unsigned j = 0 ; j < ts->components() ; ++j)
+      {
+        ts->read(j, 0, ts->samples(), values.data());
+        encodeChunk(values.data(), values.size(), &chunk);
+        device->write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        entry.Chunks.push_back({offset, chunk.size()});
+        offset += chunk.size();
+      }
+      entryIds.emplace(ts, static_cast<uint32_t>(entries.size()));
+      entries.push_back(std::move(entry));
+    }
+    // Graph
+    _OMAEncoder graph, payload;
+    graph.writeU32(static_cast<uint32_t>(nodes.size()));
+    for (uint32_t i = 0 ; i < nodes.size() ; ++i)
+    {
+      const Node* node = nodes[i];
+      payload.Data.clear();
+      const NodeType registered = find_node_type(node);
+      const std::string tag = (registered.Create != nullptr) ? registered.Tag : _oma_find_node_type(node)->Tag;
+      if (node->isCastable(static_typeid<TimeSequence>()))
+        payload.writeU32(entryIds[node]);
+      else if (node->isCastable(static_typeid<instrument::ForcePlate>()))
+        _oma_write_forceplate(&payload, static_cast<const instrument::ForcePlate*>(node), ids);
+      graph.writeString(tag);
+      graph.writeString(node->name());
+      graph.writeU32(static_cast<uint32_t>(payload.Data.size()));
+      graph.Data.insert(graph.Data.end(), payload.Data.cbegin(), payload.Data.cend());
+      const auto& nodeChildren = node->children();
+      graph.writeU32(static_cast<uint32_t>(nodeChildren.size()));
+      for (const auto& child : nodeChildren)
+        graph.writeU32(ids[child]);
+      const auto keys = node->staticPropertyKeys(true);
+      const auto& dynamicProperties = node->dynamicProperties();
+      graph.writeU32(static_cast<uint32_t>(keys.size() + dynamicProperties.size()));
+      for (const auto& key : keys)
+      {
+        graph.writeString(key);
+        graph.writeAny(node->property(key));
+      }
+      for (const auto& prop : dynamicProperties)
+      {
+        graph.writeString(prop.first);
+        graph.writeAny(prop.second);
+      }
+    }
+    device->write(graph.Data.data(), graph.Data.size());
+    const uint64_t graphOffset = offset;
+    offset += graph.Data.size();
+    // Index
+    _OMAEncoder index;
+    index.writeU32(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries)
+      _oma_write_entry(&index, entry);
+    device->write(index.Data.data(), index.Data.size());
+    const uint64_t indexOffset = offset;
+    // Footer
+    _OMAEncoder footer;
+    footer.writeU64(graphOffset);
+    footer.writeU64(indexOffset);
+    footer.writeFixedString(_oma_footer_magic, 8);
+    device->write(footer.Data.data(), footer.Data.size());
+  };
+};
+};
@@ -49,7 +49,7 @@ namespace ma
 namespace io
 {
   HandlerPrivate::HandlerPrivate()
-  : Source(nullptr), ErrorCode(Error::None), ErrorMessage()
+  : Source(nullptr), ErrorCode(Error::None), ErrorMessage(), Options()
   {};
   
   HandlerPrivate::~HandlerPrivate() _OPENMA_NOEXCEPT = default; // Cannot be inlined
@@ -222,6 +222,30 @@ namespace io
     optr->Source = device;
   };
   
+  /**
+   * Returns the value of the option @a name. An invalid Any object is returned if this option was not set.
+   * The available options depend on the handler (e.g. the C3D handler supports the option "CompactStorage").
+   */
+  Any Handler::option(const std::string& name) const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    auto it = optr->Options.find(name);
+    return (it != optr->Options.cend()) ? it->second : Any();
+  };
+  
+  /**
+   * Sets the value of the option @a name. An option is used to adapt the behaviour of a handler during the reading or the writing of a device.
+   * Setting an invalid Any object removes the option.
+   */
+  void Handler::setOption(const std::string& name, const Any& value)
+  {
+    auto optr = this->pimpl();
+    if (!value.isValid())
+      optr->Options.erase(name);
+    else
+      optr->Options[name] = value;
+  };
+  
   /**
    * Returns the current error code.
    */
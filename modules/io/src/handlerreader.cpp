@@ -37,6 +37,9 @@
 #include "openma/io/device.h"
 #include "openma/io/enums.h"
 #include "openma/io/handler.h"
+#include "openma/base/profiler.h"
+
+#include <unordered_map>
 
 // -------------------------------------------------------------------------- //
 //                                 PRIVATE API                                //
@@ -59,10 +62,11 @@ namespace io
     Handler* Reader;
     Error ErrorCode;
     std::string ErrorMessage;
+    std::unordered_map<std::string,Any> Options;
   };
   
   HandlerReaderPrivate::HandlerReaderPrivate(Device* device, const std::string& format)
-  : Source(device), Format(format), Reader(nullptr), ErrorCode(Error::None), ErrorMessage()
+  : Source(device), Format(format), Reader(nullptr), ErrorCode(Error::None), ErrorMessage(), Options()
   {};
   
   HandlerReaderPrivate::~HandlerReaderPrivate() _OPENMA_NOEXCEPT = default; // Cannot be inlined
@@ -253,6 +257,30 @@ namespace io
     return (optr->Reader != nullptr);
   };
   
+  /**
+   * Returns the value of the option @a name. An invalid Any object is returned if this option was not set.
+   */
+  Any HandlerReader::option(const std::string& name) const _OPENMA_NOEXCEPT
+  {
+    auto optr = this->pimpl();
+    auto it = optr->Options.find(name);
+    return (it != optr->Options.cend()) ? it->second : Any();
+  };
+  
+  /**
+   * Sets the value of the option @a name. The options are passed to the handler used to read the device (see Handler::setOption()).
+   * For example, the option "CompactStorage" set to @c true tells the C3D handler to store the extracted time sequences with compact elements (see TimeSequence::setStorage()).
+   * Setting an invalid Any object removes the option.
+   */
+  void HandlerReader::setOption(const std::string& name, const Any& value)
+  {
+    auto optr = this->pimpl();
+    if (!value.isValid())
+      optr->Options.erase(name);
+    else
+      optr->Options[name] = value;
+  };
+  
   /**
    * Read the content of the set device using the set/detected format and add the result as a child (children) of the given object @a root.
    * This method returns @c true if no error was thrown during the reading of the device.
@@ -260,9 +288,12 @@ namespace io
    */
   bool HandlerReader::read(Node* root)
   {
+    OPENMA_PROFILE_SCOPE("HandlerReader::read");
     if (!this->canRead())
       return false;
     auto optr = this->pimpl();
+    for (const auto& opt : optr->Options)
+      optr->Reader->setOption(opt.first, opt.second);
     auto result = optr->Reader->read(root);
     this->setError(optr->Reader->errorCode(), optr->Reader->errorMessage());
     return result;
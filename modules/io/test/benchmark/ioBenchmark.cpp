@@ -0,0 +1,207 @@
+#include "benchmark.h"
+
+#include <openma/io/binarystream.h>
+#include <openma/io/buffer.h>
+#include <openma/io/enums.h>
+#include <openma/io/handlerreader.h>
+#include <openma/io/handlerwriter.h>
+
+// Benchmarks of the io module:
+//  - Bulk conversion of BinaryStream (16-bit integers and floats) for each byte order
+//  - Reading of C3D files (stored in memory) for each processor type (Intel, DEC, MIPS) and for the integer and float formats
+//  - Writing of a C3D file in memory (native byte order and float format, the only configuration supported by the writer)
+// The C3D files are generated from synthetic trials with 100 markers (100 Hz) and 32 analog channels (1000 Hz).
+
+struct ByteOrderInfo
+{
+  const char* Name;
+  ma::io::ByteOrder Order;
+};
+
+const ByteOrderInfo byte_orders[3] = {
+  {"ieee_le", ma::io::ByteOrder::IEEELittleEndian},
+  {"vax_le", ma::io::ByteOrder::VAXLittleEndian},
+  {"ieee_be", ma::io::ByteOrder::IEEEBigEndian}
+};
+
+// The C3D reader uses the name of the device to set the name of the trial (a buffer has no name by default)
+class NamedBuffer : public ma::io::Buffer
+{
+public:
+  NamedBuffer(const char* name) : ma::io::Buffer() {this->setName(name);};
+};
+
+/*
+ * Minimal C3D writer supporting all the processor types and the integer format (not available with the C3D handler).
+ * Only the parameters required by the reader are stored (POINT and ANALOG groups).
+ */
+std::vector<char> generate_c3d(const std::vector<ma::TimeSequence*>& markers, const std::vector<ma::TimeSequence*>& analogs, ma::io::ByteOrder order, bool integer)
+{
+  const unsigned frames = markers.front()->samples();
+  const unsigned spp = analogs.front()->samples() / frames;
+  const uint16_t numPoints = static_cast<uint16_t>(markers.size()), numAnalogs = static_cast<uint16_t>(analogs.size());
+  double maxCoordinate = 0.;
+  for (const auto& marker : markers)
+  {
+    for (unsigned i = 0 ; i < 3 * frames ; ++i)
+      maxCoordinate = std::max(maxCoordinate, std::fabs(marker->data()[i]));
+  }
+  const float pointScale = integer ? static_cast<float>(maxCoordinate / 32000.0) : -0.1f;
+  const float analogScale = static_cast<float>(10.0 / 32768.0);
+  const float rate = static_cast<float>(markers.front()->sampleRate());
+  // Parameter section
+  std::vector<char> parameters(4096 + 8 * (numPoints + numAnalogs), 0);
+  ma::io::Buffer pbuffer;
+  pbuffer.open(parameters.data(), parameters.size(), ma::io::Mode::Out);
+  ma::io::BinaryStream ps(&pbuffer, order);
+  ps.writeI8(1); ps.writeI8(80); ps.writeU8(0); ps.writeI8(static_cast<int8_t>(static_cast<int>(order) + 83));
+  auto group = [&](const std::string& name, int8_t id) {
+    ps.writeI8(static_cast<int8_t>(name.size())); ps.writeI8(-id); ps.writeString(name); ps.writeI16(3); ps.writeU8(0);
+  };
+  auto parameter = [&](const std::string& name, int8_t id, int8_t type, const std::vector<uint8_t>& dims, bool last) {
+    size_t bytes = std::abs(type);
+    for (const auto& dim : dims)
+      bytes *= dim;
+    ps.writeI8(static_cast<int8_t>(name.size())); ps.writeI8(id); ps.writeString(name);
+    ps.writeI16(last ? 0 : static_cast<int16_t>(2 + 2 + dims.size() + bytes + 1));
+    ps.writeI8(type); ps.writeU8(static_cast<uint8_t>(dims.size())); ps.writeU8(dims.size(), dims.data());
+  };
+  auto labels = [&](const std::vector<ma::TimeSequence*>& tss) {
+    for (const auto& ts : tss)
+    {
+      std::string label = ts->name();
+      label.resize(4, ' ');
+      ps.writeString(label);
+    }
+  };
+  group("POINT", 1);
+  parameter("USED", 1, 2, {}, false); ps.writeI16(numPoints); ps.writeU8(0);
+  parameter("SCALE", 1, 4, {}, false); ps.writeFloat(pointScale); ps.writeU8(0);
+  parameter("RATE", 1, 4, {}, false); ps.writeFloat(rate); ps.writeU8(0);
+  parameter("FRAMES", 1, 2, {}, false); ps.writeI16(static_cast<int16_t>(frames)); ps.writeU8(0);
+  parameter("UNITS", 1, -1, {2}, false); ps.writeString("mm"); ps.writeU8(0);
+  parameter("LABELS", 1, -1, {4, static_cast<uint8_t>(numPoints)}, false); labels(markers); ps.writeU8(0);
+  group("ANALOG", 2);
+  parameter("USED", 2, 2, {}, false); ps.writeI16(numAnalogs); ps.writeU8(0);
+  parameter("RATE", 2, 4, {}, false); ps.writeFloat(rate * spp); ps.writeU8(0);
+  parameter("GEN_SCALE", 2, 4, {}, false); ps.writeFloat(1.0f); ps.writeU8(0);
+  parameter("SCALE", 2, 4, {static_cast<uint8_t>(numAnalogs)}, false); ps.writeFloat(numAnalogs, std::vector<float>(numAnalogs, analogScale).data()); ps.writeU8(0);
+  parameter("OFFSET", 2, 2, {static_cast<uint8_t>(numAnalogs)}, false); ps.writeI16(numAnalogs, std::vector<int16_t>(numAnalogs, 0).data()); ps.writeU8(0);
+  parameter("UNITS", 2, -1, {1, static_cast<uint8_t>(numAnalogs)}, false); ps.writeString(std::string(numAnalogs, 'V')); ps.writeU8(0);
+  parameter("LABELS", 2, -1, {4, static_cast<uint8_t>(numAnalogs)}, true); labels(analogs); ps.writeU8(0);
+  const size_t parameterBlocks = (static_cast<size_t>(pbuffer.tell()) + 511) / 512;
+  parameters[2] = static_cast<char>(parameterBlocks);
+  // Header, parameters and data
+  const size_t dataFirstBlock = 2 + parameterBlocks;
+  const size_t dataSize = frames * (4 * numPoints + spp * numAnalogs) * (integer ? 2 : 4);
+  std::vector<char> content(512 * (dataFirstBlock - 1) + dataSize, 0);
+  ma::io::Buffer buffer;
+  buffer.open(content.data(), content.size(), ma::io::Mode::Out);
+  ma::io::BinaryStream stream(&buffer, order);
+  stream.writeI8(2); stream.writeI8(80);
+  stream.writeU16(numPoints);
+  stream.writeU16(static_cast<uint16_t>(numAnalogs * spp));
+  stream.writeU16(1); stream.writeU16(static_cast<uint16_t>(frames));
+  stream.writeU16(10);
+  stream.writeFloat(pointScale);
+  stream.writeU16(static_cast<uint16_t>(dataFirstBlock));
+  stream.writeU16(static_cast<uint16_t>(spp));
+  stream.writeFloat(rate);
+  std::copy_n(parameters.begin(), 512 * parameterBlocks, content.begin() + 512);
+  buffer.seek(512 * (dataFirstBlock - 1), ma::io::Origin::Begin);
+  for (unsigned i = 0 ; i < frames ; ++i)
+  {
+    for (const auto& marker : markers)
+    {
+      const double* data = marker->data();
+      for (unsigned c = 0 ; c < 3 ; ++c)
+      {
+        if (integer)
+          stream.writeI16(static_cast<int16_t>(data[i + c * frames] / pointScale));
+        else
+          stream.writeFloat(static_cast<float>(data[i + c * frames]));
+      }
+      if (integer)
+        stream.writeI16(0);
+      else
+        stream.writeFloat(0.0f);
+    }
+    for (unsigned j = 0 ; j < spp ; ++j)
+    {
+      for (const auto& analog : analogs)
+      {
+        const double value = analog->data()[i * spp + j] / analogScale;
+        if (integer)
+          stream.writeI16(static_cast<int16_t>(value));
+        else
+          stream.writeFloat(static_cast<float>(value));
+      }
+    }
+  }
+  return content;
+};
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("io", argc, argv);
+  const unsigned samples = std::min(bench.samples(), 65535u); // Maximum number of frames stored in the header of a C3D file
+
+  // BinaryStream
+  const size_t values = static_cast<size_t>(samples) * 100;
+  std::vector<char> raw(values * 4, 0);
+  std::vector<int16_t> integers(values);
+  std::vector<float> reals(values);
+  ma::benchmark::Random rnd;
+  for (size_t i = 0 ; i < values ; ++i)
+  {
+    integers[i] = static_cast<int16_t>(rnd(-32000., 32000.));
+    reals[i] = static_cast<float>(rnd(-1000., 1000.));
+  }
+  for (const auto& bo : byte_orders)
+  {
+    ma::io::Buffer buffer;
+    buffer.open(raw.data(), raw.size(), ma::io::Mode::In | ma::io::Mode::Out);
+    ma::io::BinaryStream stream(&buffer, bo.Order);
+    auto rewind = [&]() {buffer.seek(0, ma::io::Origin::Begin);};
+    const std::string prefix = std::string("binarystream.") + bo.Name;
+    bench.run(prefix + ".writeI16", values, rewind, [&]() {stream.writeI16(values, integers.data());});
+    bench.run(prefix + ".readI16", values, rewind, [&]() {stream.readI16(values, integers.data());});
+    bench.run(prefix + ".writeFloat", values, rewind, [&]() {stream.writeFloat(values, reals.data());});
+    bench.run(prefix + ".readFloat", values, rewind, [&]() {stream.readFloat(values, reals.data());});
+  }
+
+  // C3D
+  ma::Node root("root");
+  auto trial = new ma::Trial("trial", &root);
+  const auto markers = ma::benchmark::generate_markers(trial, 100, samples);
+  const auto analogs = ma::benchmark::generate_analogs(trial, 32, samples * 10);
+  const double items = static_cast<double>(samples);
+  ma::Node output("output");
+  for (const auto& bo : byte_orders)
+  {
+    for (int integer = 1 ; integer >= 0 ; --integer)
+    {
+      const std::string name = std::string("c3d.read.") + bo.Name + (integer ? ".integer" : ".float");
+      if (!bench.enabled(name))
+        continue;
+      const std::vector<char> content = generate_c3d(markers, analogs, bo.Order, integer != 0);
+      bench.run(name, items, [&]() {output.clear();}, [&]() {
+        NamedBuffer buffer("benchmark.c3d");
+        buffer.open(content.data(), content.size());
+        ma::io::HandlerReader reader(&buffer, "org.c3d");
+        if (!reader.read(&output))
+          std::fprintf(stderr, "%s: %s\n", name.c_str(), reader.errorMessage().c_str());
+      });
+    }
+  }
+  std::vector<char> content(65536 + static_cast<size_t>(samples) * (4 * markers.size() + 10 * analogs.size()) * 4, 0);
+  bench.run("c3d.write.native.float", items, [&]() {
+    ma::io::Buffer buffer;
+    buffer.open(content.data(), content.size(), ma::io::Mode::Out);
+    ma::io::HandlerWriter writer(&buffer, "org.c3d");
+    if (!writer.write(&root))
+      std::fprintf(stderr, "c3d.write.native.float: %s\n", writer.errorMessage().c_str());
+  });
+
+  return bench.report();
+};
@@ -2,8 +2,10 @@
 
 #include <openma/io/handlerreader.h>
 #include <openma/io/file.h>
+#include <openma/io/utils.h>
 
 #include "c3dhandlerTest_def.h"
+#include "trialformats/c3d/c3dparametertable.h"
 #include "test_file_path.h"
 
 CXXTEST_SUITE(C3DReaderTest)
@@ -115,6 +117,178 @@ CXXTEST_SUITE(C3DReaderTest)
     ma::Node root("root");
     TS_ASSERT_EQUALS(c3dhandlertest_read("Gait 1", OPENMA_TDD_PATH_IN("c3d/other/Gait 1.c3d"), &root), true);
   }
+  
+  CXXTEST_TEST(columnDecoding)
+  {
+    // Large enough trial to decode the columns in parallel
+    ma::Node input("input");
+    auto trial = new ma::Trial("trial", &input);
+    const unsigned frames = 500, analogSamples = 4;
+    for (unsigned j = 0 ; j < 20 ; ++j)
+    {
+      auto pt = new ma::TimeSequence("P" + std::to_string(j), 4, frames, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+      for (unsigned i = 0 ; i < frames ; ++i)
+      {
+        pt->data(i,0) = static_cast<double>(j * 1000 + i);
+        pt->data(i,1) = -static_cast<double>(i) * 0.5;
+        pt->data(i,2) = static_cast<double>(j);
+        pt->data(i,3) = (i % 10 == 0) ? -1.0 : 0.0;
+      }
+    }
+    for (unsigned j = 0 ; j < 8 ; ++j)
+    {
+      auto an = new ma::TimeSequence("A" + std::to_string(j), 1, frames * analogSamples, 100.0 * analogSamples, 0.0, ma::TimeSequence::Analog, "V", trial->timeSequences());
+      for (unsigned i = 0 ; i < frames * analogSamples ; ++i)
+        an->data(i,0) = static_cast<double>(j) + static_cast<double>(i) * 0.25;
+    }
+    TS_ASSERT_EQUALS(c3dhandlertest_write("columnDecoding", OPENMA_TDD_PATH_OUT("c3d/columnDecoding.c3d"), &input), true);
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(c3dhandlertest_read("columnDecoding", OPENMA_TDD_PATH_OUT("c3d/columnDecoding.c3d"), &output), true);
+    auto points = output.findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Position}});
+    auto analogs = output.findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Analog}});
+    TS_ASSERT_EQUALS(points.size(), 20ul);
+    TS_ASSERT_EQUALS(analogs.size(), 8ul);
+    if ((points.size() != 20ul) || (analogs.size() != 8ul))
+      return;
+    TS_ASSERT_EQUALS(points[7]->name(), "P7");
+    TS_ASSERT_EQUALS(points[7]->samples(), frames);
+    TS_ASSERT_DELTA(points[7]->data(123,0), 7123.0, 1e-3);
+    TS_ASSERT_DELTA(points[7]->data(123,1), -61.5, 1e-3);
+    TS_ASSERT_DELTA(points[7]->data(123,2), 7.0, 1e-3);
+    TS_ASSERT_EQUALS(points[7]->data(120,3), -1.0);
+    TS_ASSERT_EQUALS(points[19]->data(frames-1,0), 19499.0);
+    TS_ASSERT_EQUALS(analogs[5]->name(), "A5");
+    TS_ASSERT_EQUALS(analogs[5]->samples(), frames * analogSamples);
+    TS_ASSERT_DELTA(analogs[5]->data(1001,0), 5.0 + 1001.0 * 0.25, 1e-3);
+    TS_ASSERT_DELTA(analogs[0]->data(frames * analogSamples - 1,0), (frames * analogSamples - 1) * 0.25, 1e-3);
+  };
+  
+  CXXTEST_TEST(clonedTrialSharesBuffers)
+  {
+    ma::Node input("input");
+    auto trial = new ma::Trial("trial", &input);
+    const unsigned frames = 20;
+    auto pt = new ma::TimeSequence("P", 4, frames, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+    for (unsigned i = 0 ; i < frames ; ++i)
+    {
+      pt->data(i,0) = static_cast<double>(i);
+      pt->data(i,1) = 1.0;
+      pt->data(i,2) = 2.0;
+      pt->data(i,3) = 0.0;
+    }
+    auto an = new ma::TimeSequence("A", 1, frames, 100.0, 0.0, ma::TimeSequence::Analog, "V", trial->timeSequences());
+    for (unsigned i = 0 ; i < frames ; ++i)
+      an->data(i,0) = static_cast<double>(i) * 0.5;
+    TS_ASSERT_EQUALS(c3dhandlertest_write("clonedTrialSharesBuffers", OPENMA_TDD_PATH_OUT("c3d/clonedTrialSharesBuffers.c3d"), &input), true);
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(c3dhandlertest_read("clonedTrialSharesBuffers", OPENMA_TDD_PATH_OUT("c3d/clonedTrialSharesBuffers.c3d"), &output), true);
+    auto source = output.findChild<ma::Trial*>();
+    TS_ASSERT_DIFFERS(source, nullptr);
+    if (source == nullptr)
+      return;
+    // The time sequences filled by the reader share their buffer with the clones
+    std::unique_ptr<ma::Node> cloned(source->clone());
+    auto srcs = source->timeSequences()->findChildren<const ma::TimeSequence*>();
+    auto dsts = cloned->findChildren<const ma::TimeSequence*>();
+    TS_ASSERT_EQUALS(srcs.size(), 2ul);
+    TS_ASSERT_EQUALS(dsts.size(), srcs.size());
+    if (dsts.size() != srcs.size())
+      return;
+    for (size_t i = 0 ; i < srcs.size() ; ++i)
+    {
+      TS_ASSERT_EQUALS(dsts[i]->name(), srcs[i]->name());
+      TS_ASSERT_EQUALS(dsts[i]->data(), srcs[i]->data());
+    }
+    TS_ASSERT_EQUALS(srcs[0]->data(9,0), 9.0);
+    // The buffer is copied only when one of them is modified
+    cloned->findChild<ma::TimeSequence*>("P")->data(0,0) = -1.0;
+    TS_ASSERT_DIFFERS(cloned->findChild<const ma::TimeSequence*>("P")->data(), srcs[0]->data());
+    TS_ASSERT_EQUALS(srcs[0]->data(0,0), 0.0);
+  };
+  
+  CXXTEST_TEST(compactStorage)
+  {
+    ma::Node input("input");
+    auto trial = new ma::Trial("trial", &input);
+    const unsigned frames = 50, analogSamples = 2;
+    auto pt = new ma::TimeSequence("P", 4, frames, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+    for (unsigned i = 0 ; i < frames ; ++i)
+    {
+      pt->data(i,0) = static_cast<double>(i) * 0.5;
+      pt->data(i,1) = -static_cast<double>(i);
+      pt->data(i,2) = 100.0;
+      pt->data(i,3) = (i % 10 == 0) ? -1.0 : 0.0;
+    }
+    auto an = new ma::TimeSequence("A", 1, frames * analogSamples, 100.0 * analogSamples, 0.0, ma::TimeSequence::Analog, "V", trial->timeSequences());
+    for (unsigned i = 0 ; i < frames * analogSamples ; ++i)
+      an->data(i,0) = static_cast<double>(i) * 0.25;
+    TS_ASSERT_EQUALS(c3dhandlertest_write("compactStorage", OPENMA_TDD_PATH_OUT("c3d/compactStorage.c3d"), &input), true);
+    ma::io::File file;
+    file.open(OPENMA_TDD_PATH_OUT("c3d/compactStorage.c3d"), ma::io::Mode::In);
+    ma::io::HandlerReader reader(&file, "org.c3d");
+    reader.setOption("CompactStorage", true);
+    TS_ASSERT_EQUALS(reader.option("CompactStorage").cast<bool>(), true);
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(reader.read(&output), true);
+    auto points = output.findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Position}});
+    auto analogs = output.findChildren<ma::TimeSequence*>({},{{"type",ma::TimeSequence::Analog}});
+    TS_ASSERT_EQUALS(points.size(), 1ul);
+    TS_ASSERT_EQUALS(analogs.size(), 1ul);
+    if ((points.size() != 1ul) || (analogs.size() != 1ul))
+      return;
+    TS_ASSERT_EQUALS(points[0]->storage(), ma::TimeSequence::Storage::Float);
+    // The written file stores floating point values. Its analog channels cannot be stored as raw integers.
+    TS_ASSERT_EQUALS(analogs[0]->storage(), ma::TimeSequence::Storage::Float);
+    double values[4];
+    points[0]->read(0, 21, 1, values);
+    points[0]->read(1, 21, 1, values+1);
+    points[0]->read(3, 20, 1, values+2);
+    TS_ASSERT_DELTA(values[0], 10.5, 1e-3);
+    TS_ASSERT_DELTA(values[1], -21.0, 1e-3);
+    TS_ASSERT_EQUALS(values[2], -1.0);
+    analogs[0]->read(0, 77, 1, values+3);
+    TS_ASSERT_DELTA(values[3], 77.0 * 0.25, 1e-3);
+    // Without the option, the elements are stored as double
+    reader.setOption("CompactStorage", ma::Any());
+    TS_ASSERT_EQUALS(reader.option("CompactStorage").isValid(), false);
+  };
+  
+  CXXTEST_TEST(parameterTable)
+  {
+    ma::Node input("input");
+    auto trial = new ma::Trial("trial", &input);
+    new ma::TimeSequence("P0", 4, 10, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+    new ma::TimeSequence("P1", 4, 10, 100.0, 0.0, ma::TimeSequence::Position, "mm", trial->timeSequences());
+    new ma::TimeSequence("A0", 1, 20, 200.0, 0.0, ma::TimeSequence::Analog, "V", trial->timeSequences());
+    TS_ASSERT_EQUALS(c3dhandlertest_write("parameterTable", OPENMA_TDD_PATH_OUT("c3d/parameterTable.c3d"), &input), true);
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(c3dhandlertest_read("parameterTable", OPENMA_TDD_PATH_OUT("c3d/parameterTable.c3d"), &output), true);
+    auto result = output.child<ma::Trial*>(0);
+    TS_ASSERT_DIFFERS(result, nullptr);
+    if (result == nullptr)
+      return;
+    // The parameters are not yet converted into dynamic properties
+    auto table = dynamic_cast<const ma::io::C3DParameterTable*>(result->propertySource());
+    TS_ASSERT_DIFFERS(table, nullptr);
+    if (table == nullptr)
+      return;
+    TS_ASSERT_EQUALS(table->value<int>("POINT:USED"), 2);
+    TS_ASSERT_EQUALS(table->value<int>("ANALOG:USED"), 1);
+    TS_ASSERT_DELTA(table->value<double>("POINT:RATE"), 100.0, 1e-5);
+    TS_ASSERT_EQUALS(table->value<int>("POINT:UNKNOWN", 0, -1), -1);
+    TS_ASSERT_EQUALS(table->find("POINT:LABELS")->Type, -1);
+    TS_ASSERT_EQUALS(result->property("POINT:USED").cast<int>(), 2);
+    auto labels = result->property("POINT:LABELS").cast<std::vector<std::string>>();
+    TS_ASSERT_EQUALS(labels.size(), 2ul);
+    if (labels.size() == 2ul)
+      TS_ASSERT_EQUALS(ma::io::trim_string(labels[1]), "P1");
+    TS_ASSERT_EQUALS(result->property("POINT:UNKNOWN").isValid(), false);
+    // Modifying a property resolves the source
+    result->setProperty("POINT:USED", 5);
+    TS_ASSERT_EQUALS(result->propertySource(), nullptr);
+    TS_ASSERT_EQUALS(result->property("POINT:USED").cast<int>(), 5);
+    TS_ASSERT_EQUALS(result->dynamicProperties().count("ANALOG:USED"), 1ul);
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(C3DReaderTest)
@@ -129,4 +303,8 @@ CXXTEST_TEST_REGISTRATION(C3DReaderTest, queryOkOne)
 CXXTEST_TEST_REGISTRATION(C3DReaderTest, queryOkTwo)
 CXXTEST_TEST_REGISTRATION(C3DReaderTest, queryOkThree)
 CXXTEST_TEST_REGISTRATION(C3DReaderTest, sample01)
-CXXTEST_TEST_REGISTRATION(C3DReaderTest, gait1)
\ No newline at end of file
+CXXTEST_TEST_REGISTRATION(C3DReaderTest, gait1)
+CXXTEST_TEST_REGISTRATION(C3DReaderTest, columnDecoding)
+CXXTEST_TEST_REGISTRATION(C3DReaderTest, clonedTrialSharesBuffers)
+CXXTEST_TEST_REGISTRATION(C3DReaderTest, compactStorage)
+CXXTEST_TEST_REGISTRATION(C3DReaderTest, parameterTable)
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/io.h>
+#include <openma/base/node.h>
+#include <openma/base/trial.h>
+#include <openma/base/subject.h>
+#include <openma/base/timesequence.h>
+#include <openma/base/event.h>
+#include <openma/instrument/forceplatetype2.h>
+
+#include "trialformats/oma/omahandler.h"
+#include "test_file_path.h"
+
+#include <cmath>
+#include <limits>
+
+void omahandlertest_generate_trial(ma::Node* root)
+{
+  auto trial = new ma::Trial("Trial", root);
+  trial->setProperty("count", 3);
+  trial->setProperty("labels", std::vector<std::string>{"Left","Right"});
+  trial->setProperty("matrix", ma::Any(std::vector<double>{1.,2.,3.,4.,5.,6.}, std::vector<unsigned>{2,3}));
+  auto subject = new ma::Subject("John", {{"weight",72.5},{"height",1.78}}, root);
+  OPENMA_UNUSED(subject)
+  auto marker = new ma::TimeSequence("LHEE", 4, 500, 100.0, 0.5, ma::TimeSequence::Position, "mm", trial->timeSequences());
+  for (unsigned i = 0 ; i < 500 ; ++i)
+  {
+    marker->data(i,0) = 100.0 * std::sin(static_cast<double>(i) / 50.0);
+    marker->data(i,1) = 10.0 * std::cos(static_cast<double>(i) / 25.0);
+    marker->data(i,2) = 1000.0 + static_cast<double>(i);
+    marker->data(i,3) = (i < 10) ? -1.0 : 0.0;
+  }
+  marker->setDescription("Left heel");
+  auto compact = new ma::TimeSequence("COMPACT", 1, 200, 1000.0, 0.0, ma::TimeSequence::Analog, "V", trial->timeSequences());
+  for (unsigned i = 0 ; i < 200 ; ++i)
+    compact->data(i,0) = 0.25 * static_cast<double>(i % 8);
+  compact->setStorage(ma::TimeSequence::Storage::Float);
+  auto fp = new ma::instrument::ForcePlateType2("FP1", trial->hardwares());
+  fp->setGeometry({{0.0,0.0,-40.0}}, {{500.0,200.0,0.0}}, {{0.0,200.0,0.0}}, {{0.0,0.0,0.0}}, {{500.0,0.0,0.0}});
+  const char* labels[6] = {"Fx","Fy","Fz","Mx","My","Mz"};
+  for (unsigned j = 0 ; j < 6 ; ++j)
+  {
+    auto analog = new ma::TimeSequence(labels[j], 1, 1000, 1000.0, 0.5, ma::TimeSequence::Analog, "N", trial->timeSequences());
+    for (unsigned i = 0 ; i < 1000 ; ++i)
+      analog->data(i,0) = static_cast<double>(j+1) * std::sin(static_cast<double>(i) / 100.0);
+    fp->setChannel(j, analog);
+  }
+  new ma::Event("Foot Strike", 1.5, "Left", "John", trial->events());
+};
+
+CXXTEST_SUITE(OMAHandlerTest)
+{
+  CXXTEST_TEST(codec)
+  {
+    std::vector<double> values(1000);
+    for (size_t i = 0 ; i < values.size() ; ++i)
+      values[i] = std::sin(static_cast<double>(i) / 100.0);
+    values[10] = std::numeric_limits<double>::quiet_NaN();
+    values[11] = -std::numeric_limits<double>::infinity();
+    std::vector<uint8_t> chunk;
+    ma::io::OMAHandler::encodeChunk(values.data(), values.size(), &chunk);
+    TS_ASSERT_LESS_THAN(chunk.size(), values.size() * sizeof(double));
+    std::vector<double> decoded(values.size());
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::decodeChunk(chunk.data(), chunk.size(), decoded.data(), decoded.size()), true);
+    TS_ASSERT_EQUALS(memcmp(values.data(), decoded.data(), values.size() * sizeof(double)), 0);
+    // Corrupted or wrong sizes
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::decodeChunk(chunk.data(), chunk.size() / 2, decoded.data(), decoded.size()), false);
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::decodeChunk(chunk.data(), chunk.size(), decoded.data(), decoded.size() - 1), false);
+  };
+  
+  CXXTEST_TEST(codecConstant)
+  {
+    std::vector<double> values(4096, 1.5);
+    std::vector<uint8_t> chunk;
+    ma::io::OMAHandler::encodeChunk(values.data(), values.size(), &chunk);
+    TS_ASSERT_LESS_THAN(chunk.size(), 512ul);
+    std::vector<double> decoded(values.size());
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::decodeChunk(chunk.data(), chunk.size(), decoded.data(), decoded.size()), true);
+    TS_ASSERT_EQUALS(decoded, values);
+  };
+  
+  CXXTEST_TEST(roundTrip)
+  {
+    ma::Node root("root");
+    omahandlertest_generate_trial(&root);
+    TS_ASSERT_EQUALS(ma::io::write(&root, OPENMA_TDD_PATH_OUT("oma/roundtrip.oma")), true);
+    
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(ma::io::read(&output, OPENMA_TDD_PATH_OUT("oma/roundtrip.oma")), true);
+    TS_ASSERT_EQUALS(output.children().size(), 2ul);
+    auto trial = output.child<ma::Trial*>(0);
+    TS_ASSERT_DIFFERS(trial, nullptr);
+    if (trial == nullptr) return;
+    TS_ASSERT_EQUALS(trial->name(), "Trial");
+    TS_ASSERT_EQUALS(trial->property("count").cast<int>(), 3);
+    TS_ASSERT_EQUALS(trial->property("labels").cast<std::vector<std::string>>(), std::vector<std::string>({"Left","Right"}));
+    TS_ASSERT_EQUALS(trial->property("matrix").dimensions(), std::vector<unsigned>({2,3}));
+    TS_ASSERT_EQUALS(trial->property("matrix").cast<double>(4), 5.0);
+    auto subject = output.child<ma::Subject*>(1);
+    TS_ASSERT_DIFFERS(subject, nullptr);
+    if (subject != nullptr)
+      TS_ASSERT_EQUALS(subject->property("weight").cast<double>(), 72.5);
+    
+    auto marker = trial->findChild<ma::TimeSequence*>("LHEE");
+    auto reference = root.findChild<ma::TimeSequence*>("LHEE");
+    TS_ASSERT_DIFFERS(marker, nullptr);
+    if (marker == nullptr) return;
+    TS_ASSERT_EQUALS(marker->description(), "Left heel");
+    TS_ASSERT_EQUALS(marker->type(), ma::TimeSequence::Position);
+    TS_ASSERT_EQUALS(marker->unit(), "mm");
+    TS_ASSERT_EQUALS(marker->samples(), 500u);
+    TS_ASSERT_EQUALS(marker->components(), 4u);
+    TS_ASSERT_EQUALS(marker->sampleRate(), 100.0);
+    TS_ASSERT_EQUALS(marker->startTime(), 0.5);
+    TS_ASSERT_EQUALS(memcmp(marker->data(), reference->data(), 4 * 500 * sizeof(double)), 0);
+    
+    auto compact = trial->findChild<ma::TimeSequence*>("COMPACT");
+    TS_ASSERT_DIFFERS(compact, nullptr);
+    if (compact == nullptr) return;
+    TS_ASSERT_EQUALS(compact->storage(), ma::TimeSequence::Storage::Float);
+    double value = 0.0;
+    compact->read(0, 7, 1, &value);
+    TS_ASSERT_EQUALS(value, 1.75);
+    
+    auto event = trial->findChild<ma::Event*>("Foot Strike");
+    TS_ASSERT_DIFFERS(event, nullptr);
+    if (event == nullptr) return;
+    TS_ASSERT_EQUALS(event->time(), 1.5);
+    TS_ASSERT_EQUALS(event->context(), "Left");
+    TS_ASSERT_EQUALS(event->subject(), "John");
+    
+    auto fp = trial->findChild<ma::instrument::ForcePlate*>("FP1");
+    TS_ASSERT_DIFFERS(fp, nullptr);
+    if (fp == nullptr) return;
+    TS_ASSERT_EQUALS(fp->type(), 2);
+    TS_ASSERT_EQUALS(fp->relativeSurfaceOrigin()[2], -40.0);
+    TS_ASSERT_EQUALS(fp->surfaceCorners()[0], 500.0);
+    TS_ASSERT_EQUALS(fp->channel(2), trial->findChild<ma::TimeSequence*>("Fz"));
+    // The channels are shared between the hardware and the time sequences
+    TS_ASSERT_EQUALS(fp->channel(2)->parents().size(), 2ul);
+    auto w = fp->wrench(ma::instrument::Location::Origin, false);
+    auto wr = root.findChild<ma::instrument::ForcePlate*>("FP1")->wrench(ma::instrument::Location::Origin, false);
+    TS_ASSERT_DIFFERS(w, nullptr);
+    TS_ASSERT_DIFFERS(wr, nullptr);
+    if ((w == nullptr) || (wr == nullptr)) return;
+    TS_ASSERT_EQUALS(w->data(500,2), wr->data(500,2));
+  };
+  
+  CXXTEST_TEST(singleTimeSequence)
+  {
+    ma::Node root("root");
+    omahandlertest_generate_trial(&root);
+    TS_ASSERT_EQUALS(ma::io::write(&root, OPENMA_TDD_PATH_OUT("oma/single.oma")), true);
+    
+    ma::io::File file;
+    file.open(OPENMA_TDD_PATH_OUT("oma/single.oma"), ma::io::Mode::In);
+    TS_ASSERT_DIFFERS(file.data(), nullptr); // Memory mapped
+    auto names = ma::io::OMAHandler::listTimeSequences(&file);
+    TS_ASSERT_EQUALS(names.size(), 8ul);
+    ma::Node output("output");
+    auto ts = ma::io::OMAHandler::readTimeSequence(&file, "Fz", &output);
+    TS_ASSERT_DIFFERS(ts, nullptr);
+    if (ts == nullptr) return;
+    TS_ASSERT_EQUALS(ts->hasParents(), true);
+    TS_ASSERT_EQUALS(ts->samples(), 1000u);
+    TS_ASSERT_EQUALS(ts->startTime(), 0.5);
+    TS_ASSERT_EQUALS(ts->data(250,0), root.findChild<ma::TimeSequence*>("Fz")->data(250,0));
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::readTimeSequence(&file, "Unknown", &output), nullptr);
+  };
+  
+  CXXTEST_TEST(truncatedFile)
+  {
+    ma::Node root("root");
+    omahandlertest_generate_trial(&root);
+    TS_ASSERT_EQUALS(ma::io::write(&root, OPENMA_TDD_PATH_OUT("oma/truncated.oma")), true);
+    std::vector<char> content;
+    {
+      ma::io::File file;
+      file.open(OPENMA_TDD_PATH_OUT("oma/truncated.oma"), ma::io::Mode::In);
+      content.assign(file.data(), file.data() + file.size() - 10);
+    }
+    ma::io::Buffer buffer;
+    buffer.open(content.data(), content.size());
+    ma::io::HandlerReader reader(&buffer, "openma.oma");
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(reader.read(&output), false);
+    TS_ASSERT_EQUALS(output.hasChildren(), false);
+  };
+  
+  CXXTEST_TEST(corruptedCounts)
+  {
+    ma::Node root("root");
+    omahandlertest_generate_trial(&root);
+    TS_ASSERT_EQUALS(ma::io::write(&root, OPENMA_TDD_PATH_OUT("oma/corrupted.oma")), true);
+    std::vector<char> content;
+    {
+      ma::io::File file;
+      file.open(OPENMA_TDD_PATH_OUT("oma/corrupted.oma"), ma::io::Mode::In);
+      content.assign(file.data(), file.data() + file.size());
+    }
+    // The footer gives the offsets of the graph and the index (little endian)
+    uint64_t offsets[2] = {0, 0};
+    for (unsigned i = 0 ; i < 2 ; ++i)
+      for (unsigned j = 0 ; j < 8 ; ++j)
+        offsets[i] |= static_cast<uint64_t>(static_cast<uint8_t>(content[content.size() - 24 + i * 8 + j])) << (8*j);
+    const uint64_t graphOffset = offsets[0], indexOffset = offsets[1];
+    const char huge[4] = {'\xFF','\xFF','\xFF','\x7F'};
+    // Number of time sequences in the index
+    std::vector<char> index(content);
+    std::copy_n(huge, 4, index.begin() + indexOffset);
+    ma::io::Buffer ibuffer;
+    ibuffer.open(index.data(), index.size());
+    TS_ASSERT_EQUALS(ma::io::OMAHandler::listTimeSequences(&ibuffer).empty(), true);
+    // Number of nodes in the graph
+    std::vector<char> graph(content);
+    std::copy_n(huge, 4, graph.begin() + graphOffset);
+    ma::io::Buffer gbuffer;
+    gbuffer.open(graph.data(), graph.size());
+    ma::io::HandlerReader reader(&gbuffer, "openma.oma");
+    ma::Node output("output");
+    TS_ASSERT_EQUALS(reader.read(&output), false);
+    TS_ASSERT_EQUALS(output.hasChildren(), false);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(OMAHandlerTest)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, codec)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, codecConstant)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, roundTrip)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, singleTimeSequence)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, truncatedFile)
+CXXTEST_TEST_REGISTRATION(OMAHandlerTest, corruptedCounts)
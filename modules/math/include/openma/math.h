@@ -20,6 +20,8 @@
 #include <Eigen_openma/Plugin/Functors.h>
 
 #include <utility> // std::declval
+#include <array> // std::array
+#include <memory> // std::shared_ptr
 #define OPENMA_MATHS_DECLVAL_NESTED(xpr) \
   std::declval<const typename ma::math::Nested<xpr>::type>()
 
@@ -0,0 +1,302 @@
+/* 
+ * Open Source Movement Analysis Library
+ * Copyright (C) 2016, Moveck Solution Inc., all rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name(s) of the copyright holders nor the names
+ *       of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written
+ *       permission.
+ *  
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __openma_math_blockkernels_h
+#define __openma_math_blockkernels_h
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+#include <type_traits>
+
+/*
+ * Fixed-size kernels used by the return values of the operations transform(), inverse() and cross().
+ *
+ * The values of a ma::math::Array are stored column by column (one column per component). An operation expressed with column expressions (e.g. result.col(0) = l11 * r11 + l12 * r21 + l13 * r31) reads several times the same input columns (up to 72 column reads for the composition of two poses).
+ * The kernels below process instead the samples by blocks of OPENMA_MATH_BLOCK_SIZE frames: all the components of one block are computed together (the loop over the frames has a compile-time length and is vectorized) into a small local tile (array of structures of arrays) which is then written back.
+ * The input columns are then streamed only once and the block stays in the L1 cache. As the whole block is read before being written, an output aliasing one of the inputs is also supported.
+ *
+ * The kernels are used only when the inputs and the output give a direct access to their coefficients (column-major storage with contiguous columns). Otherwise the column expressions are used.
+ * The kernels can be disabled by defining OPENMA_MATH_NO_BLOCK_KERNELS before the inclusion of the header openma/math.h.
+ */
+
+#ifndef OPENMA_MATH_BLOCK_SIZE
+  #define OPENMA_MATH_BLOCK_SIZE 8
+#endif
+
+namespace Eigen
+{
+namespace internal
+{
+  // Direct access to the columns of an expression (if possible)
+  template <typename U, bool Direct = std::is_same<typename U::Scalar,double>::value && bool(traits<U>::Flags & DirectAccessBit) && !bool(traits<U>::Flags & RowMajorBit)>
+  struct BlockKernelAccess
+  {
+    static inline bool available(const U& ) {return false;};
+    static inline double* data(const U& ) {return nullptr;};
+    static inline typename U::Index stride(const U& ) {return 0;};
+  };
+  
+  template <typename U>
+  struct BlockKernelAccess<U,true>
+  {
+    static inline bool available(const U& v) {return (v.innerStride() == 1) && ((v.cols() == 1) || (v.outerStride() >= v.rows()));};
+    static inline double* data(const U& v) {return const_cast<double*>(v.data());};
+    static inline typename U::Index stride(const U& v) {return v.outerStride();};
+  };
+  
+  // Columns of one block of frames
+  template <int N>
+  struct BlockKernelColumns
+  {
+    const double* p[N];
+    template <typename Index> inline void set(const double* data, Index stride) {for (int c = 0 ; c < N ; ++c) p[c] = data + c * stride;};
+    inline double operator()(int c, int k) const {return p[c][k];};
+  };
+  
+  /*
+   * Apply the kernel @a K to the values @a v (@a N columns) and store the result in @a result (@a M columns).
+   * Returns false if one of the arguments does not give a direct access to its coefficients.
+   */
+  template <typename K, int N, int M, typename R, typename U>
+  inline bool block_kernel_evaluate(R& result, const U& v)
+  {
+#if !defined(OPENMA_MATH_NO_BLOCK_KERNELS)
+    using Index = typename U::Index;
+    using AR = BlockKernelAccess<typename std::decay<R>::type>;
+    using AU = BlockKernelAccess<typename std::decay<U>::type>;
+    if (!AR::available(result) || !AU::available(v) || (result.rows() != v.rows()) || (v.cols() != N) || (result.cols() != M))
+      return false;
+    const int B = OPENMA_MATH_BLOCK_SIZE;
+    const Index rows = v.rows(), sr = AR::stride(result), sv = AU::stride(v);
+    double* out = AR::data(result);
+    const double* in = AU::data(v);
+    BlockKernelColumns<N> x;
+    double y[M][B];
+    Index i = 0;
+    for ( ; i + B <= rows ; i += B)
+    {
+      x.set(in + i, sv);
+      K::template run<B>(y, x, B);
+      for (int c = 0 ; c < M ; ++c)
+        for (int k = 0 ; k < B ; ++k)
+          out[c*sr+i+k] = y[c][k];
+    }
+    const int n = static_cast<int>(rows - i);
+    if (n > 0)
+    {
+      x.set(in + i, sv);
+      K::template run<B>(y, x, n);
+      for (int c = 0 ; c < M ; ++c)
+        for (int k = 0 ; k < n ; ++k)
+          out[c*sr+i+k] = y[c][k];
+    }
+    return true;
+#else
+    OPENMA_UNUSED(result);
+    OPENMA_UNUSED(v);
+    return false;
+#endif
+  };
+  
+  /*
+   * Apply the kernel @a K to the values @a v1 (@a N1 columns) and @a v2 (@a N2 columns) and store the result in @a result (@a M columns).
+   * Returns false if one of the arguments does not give a direct access to its coefficients.
+   */
+  template <typename K, int N1, int N2, int M, typename R, typename U1, typename U2>
+  inline bool block_kernel_evaluate(R& result, const U1& v1, const U2& v2)
+  {
+#if !defined(OPENMA_MATH_NO_BLOCK_KERNELS)
+    using Index = typename U1::Index;
+    using AR = BlockKernelAccess<typename std::decay<R>::type>;
+    using AU1 = BlockKernelAccess<typename std::decay<U1>::type>;
+    using AU2 = BlockKernelAccess<typename std::decay<U2>::type>;
+    if (!AR::available(result) || !AU1::available(v1) || !AU2::available(v2)
+     || (result.rows() != v1.rows()) || (v2.rows() != v1.rows()) || (v1.cols() != N1) || (v2.cols() != N2) || (result.cols() != M))
+      return false;
+    const int B = OPENMA_MATH_BLOCK_SIZE;
+    const Index rows = v1.rows(), sr = AR::stride(result), sv1 = AU1::stride(v1), sv2 = AU2::stride(v2);
+    double* out = AR::data(result);
+    const double* in1 = AU1::data(v1);
+    const double* in2 = AU2::data(v2);
+    BlockKernelColumns<N1> x1;
+    BlockKernelColumns<N2> x2;
+    double y[M][B];
+    Index i = 0;
+    for ( ; i + B <= rows ; i += B)
+    {
+      x1.set(in1 + i, sv1);
+      x2.set(in2 + i, sv2);
+      K::template run<B>(y, x1, x2, B);
+      for (int c = 0 ; c < M ; ++c)
+        for (int k = 0 ; k < B ; ++k)
+          out[c*sr+i+k] = y[c][k];
+    }
+    const int n = static_cast<int>(rows - i);
+    if (n > 0)
+    {
+      x1.set(in1 + i, sv1);
+      x2.set(in2 + i, sv2);
+      K::template run<B>(y, x1, x2, n);
+      for (int c = 0 ; c < M ; ++c)
+        for (int k = 0 ; k < n ; ++k)
+          out[c*sr+i+k] = y[c][k];
+    }
+    return true;
+#else
+    OPENMA_UNUSED(result);
+    OPENMA_UNUSED(v1);
+    OPENMA_UNUSED(v2);
+    return false;
+#endif
+  };
+  
+  // ----------------------------------------------------------------------- //
+  //                                 Kernels
+  // ----------------------------------------------------------------------- //
+  
+  // NOTE: For each kernel, the argument n is equal to B except for the last (incomplete) block.
+  
+  // Cross product (3 vs 3)
+  struct CrossBlockKernel
+  {
+    template <int B, typename X1, typename X2> static inline void run(double (&y)[3][B], const X1& a, const X2& b, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k] = a(1,k) * b(2,k) - a(2,k) * b(1,k);
+        y[1][k] = a(2,k) * b(0,k) - a(0,k) * b(2,k);
+        y[2][k] = a(0,k) * b(1,k) - a(1,k) * b(0,k);
+      }
+    };
+  };
+  
+  // Motion against motion (12 vs 12)
+  struct Transform12x12BlockKernel
+  {
+    template <int B, typename X1, typename X2> static inline void run(double (&y)[12][B], const X1& l, const X2& r, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k]  = l(0,k) * r(0,k)  + l(3,k) * r(1,k)  + l(6,k) * r(2,k);
+        y[1][k]  = l(1,k) * r(0,k)  + l(4,k) * r(1,k)  + l(7,k) * r(2,k);
+        y[2][k]  = l(2,k) * r(0,k)  + l(5,k) * r(1,k)  + l(8,k) * r(2,k);
+        y[3][k]  = l(0,k) * r(3,k)  + l(3,k) * r(4,k)  + l(6,k) * r(5,k);
+        y[4][k]  = l(1,k) * r(3,k)  + l(4,k) * r(4,k)  + l(7,k) * r(5,k);
+        y[5][k]  = l(2,k) * r(3,k)  + l(5,k) * r(4,k)  + l(8,k) * r(5,k);
+        y[6][k]  = l(0,k) * r(6,k)  + l(3,k) * r(7,k)  + l(6,k) * r(8,k);
+        y[7][k]  = l(1,k) * r(6,k)  + l(4,k) * r(7,k)  + l(7,k) * r(8,k);
+        y[8][k]  = l(2,k) * r(6,k)  + l(5,k) * r(7,k)  + l(8,k) * r(8,k);
+        y[9][k]  = l(0,k) * r(9,k)  + l(3,k) * r(10,k) + l(6,k) * r(11,k) + l(9,k);
+        y[10][k] = l(1,k) * r(9,k)  + l(4,k) * r(10,k) + l(7,k) * r(11,k) + l(10,k);
+        y[11][k] = l(2,k) * r(9,k)  + l(5,k) * r(10,k) + l(8,k) * r(11,k) + l(11,k);
+      }
+    };
+  };
+  
+  // Rotation against rotation (9 vs 9)
+  struct Transform9x9BlockKernel
+  {
+    template <int B, typename X1, typename X2> static inline void run(double (&y)[9][B], const X1& l, const X2& r, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k]  = l(0,k) * r(0,k)  + l(3,k) * r(1,k)  + l(6,k) * r(2,k);
+        y[1][k]  = l(1,k) * r(0,k)  + l(4,k) * r(1,k)  + l(7,k) * r(2,k);
+        y[2][k]  = l(2,k) * r(0,k)  + l(5,k) * r(1,k)  + l(8,k) * r(2,k);
+        y[3][k]  = l(0,k) * r(3,k)  + l(3,k) * r(4,k)  + l(6,k) * r(5,k);
+        y[4][k]  = l(1,k) * r(3,k)  + l(4,k) * r(4,k)  + l(7,k) * r(5,k);
+        y[5][k]  = l(2,k) * r(3,k)  + l(5,k) * r(4,k)  + l(8,k) * r(5,k);
+        y[6][k]  = l(0,k) * r(6,k)  + l(3,k) * r(7,k)  + l(6,k) * r(8,k);
+        y[7][k]  = l(1,k) * r(6,k)  + l(4,k) * r(7,k)  + l(7,k) * r(8,k);
+        y[8][k]  = l(2,k) * r(6,k)  + l(5,k) * r(7,k)  + l(8,k) * r(8,k);
+      }
+    };
+  };
+  
+  // Motion against position (12 vs 3)
+  struct Transform12x3BlockKernel
+  {
+    template <int B, typename X1, typename X2> static inline void run(double (&y)[3][B], const X1& l, const X2& p, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k] = l(0,k) * p(0,k) + l(3,k) * p(1,k) + l(6,k) * p(2,k) + l(9,k);
+        y[1][k] = l(1,k) * p(0,k) + l(4,k) * p(1,k) + l(7,k) * p(2,k) + l(10,k);
+        y[2][k] = l(2,k) * p(0,k) + l(5,k) * p(1,k) + l(8,k) * p(2,k) + l(11,k);
+      }
+    };
+  };
+  
+  // Rotation against position (9 vs 3)
+  struct Transform9x3BlockKernel
+  {
+    template <int B, typename X1, typename X2> static inline void run(double (&y)[3][B], const X1& l, const X2& p, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k] = l(0,k) * p(0,k) + l(3,k) * p(1,k) + l(6,k) * p(2,k);
+        y[1][k] = l(1,k) * p(0,k) + l(4,k) * p(1,k) + l(7,k) * p(2,k);
+        y[2][k] = l(2,k) * p(0,k) + l(5,k) * p(1,k) + l(8,k) * p(2,k);
+      }
+    };
+  };
+  
+  // Inverse of a motion (12)
+  struct InverseBlockKernel
+  {
+    template <int B, typename X> static inline void run(double (&y)[12][B], const X& v, int n)
+    {
+      for (int k = 0 ; k < n ; ++k)
+      {
+        y[0][k] = v(0,k);
+        y[1][k] = v(3,k);
+        y[2][k] = v(6,k);
+        y[3][k] = v(1,k);
+        y[4][k] = v(4,k);
+        y[5][k] = v(7,k);
+        y[6][k] = v(2,k);
+        y[7][k] = v(5,k);
+        y[8][k] = v(8,k);
+        y[9][k]  = -v(0,k) * v(9,k) - v(1,k) * v(10,k) - v(2,k) * v(11,k);
+        y[10][k] = -v(3,k) * v(9,k) - v(4,k) * v(10,k) - v(5,k) * v(11,k);
+        y[11][k] = -v(6,k) * v(9,k) - v(7,k) * v(10,k) - v(8,k) * v(11,k);
+      }
+    };
+  };
+};
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif // __openma_math_blockkernels_h
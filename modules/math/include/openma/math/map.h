@@ -42,7 +42,7 @@ namespace math
   template <typename Derived>
   struct Traits<Map<Derived>>
   {
-    using Values = Eigen::Map<typename Traits<Derived>::Values>;
+    using Values = Eigen::Map<typename Traits<Derived>::Values, Eigen::Unaligned, Eigen::OuterStride<>>;
     using Residuals = Eigen::Map<typename Traits<Derived>::Residuals>;
     using Index = typename Values::Index;
     using Scalar = typename Values::Scalar;
@@ -53,7 +53,7 @@ namespace math
   template <typename Derived>
   struct Traits<Map<const Derived>>
   {
-    using Values = Eigen::Map<const typename Traits<Derived>::Values>;
+    using Values = Eigen::Map<const typename Traits<Derived>::Values, Eigen::Unaligned, Eigen::OuterStride<>>;
     using Residuals = Eigen::Map<const typename Traits<Derived>::Residuals>;
     using Index = typename Values::Index;
     using Scalar = const typename Values::Scalar;
@@ -76,10 +76,17 @@ namespace math
     
     Map();
     Map(Index rows, Scalar* values, Scalar* residuals);
+    Map(Index rows, Index stride, Scalar* values, Scalar* residuals);
+    Map(Index rows, Index stride, Scalar* values, Scalar* residuals, std::shared_ptr<const void> owner);
     template <typename U> Map(const Map<U>& other);
     
     Map& operator= (const Map& other) = delete;
     template <typename U> Map<Derived>& operator= (const XprBase<U>& other);
+    
+    const std::shared_ptr<const void>& owner() const _OPENMA_NOEXCEPT {return this->m_Owner;};
+    
+  private:
+    std::shared_ptr<const void> m_Owner;
   };
   
   /**
@@ -92,12 +99,18 @@ namespace math
   /**
    * @var Map::Values
    * Type representing the data. Depending of the inheriting class (e.g Array or Map), the data are stored using specific Eigen (http://eigen.tuxfamily.org) object (i.e. Eigen::Array or Eigen::Map).
+   * The columns of the mapped values are separated by a stride known only at runtime (e.g. the data of a TimeSequence with reserved memory). Thus, the linear access to the coefficients (e.g. values().coeff(i)) is not available and the access by row and column (e.g. values().coeff(i,j)) must be used.
    */
   /**
    * @var Map::Residuals
    * Type representing the residuals associated with the data. Depending of the inheriting class (e.g Array or Map), the residuals are stored using specific Eigen (http://eigen.tuxfamily.org) object (i.e. Eigen::Array or Eigen::Map).
    */
   
+  /**
+   * @fn const std::shared_ptr<const void>& Map::owner() const
+   * Returns the object keeping alive the mapped memory. The returned pointer is null if the memory is owned by another object (e.g. a TimeSequence).
+   */
+  
   /**
    * @var Map::Index
    * Type used to access elements in Values or Residuals.
@@ -114,7 +127,7 @@ namespace math
    */
   template <typename Derived>
   inline Map<Derived>::Map()
-  : ArrayBase<Map<Derived>>(Values(nullptr,0,Values::ColsAtCompileTime),Residuals(nullptr,0,Residuals::ColsAtCompileTime))
+  : ArrayBase<Map<Derived>>(Values(nullptr,0,Values::ColsAtCompileTime,Eigen::OuterStride<>(0)),Residuals(nullptr,0,Residuals::ColsAtCompileTime))
   {};
   
   /**
@@ -124,7 +137,26 @@ namespace math
    */
   template <typename Derived>
   inline Map<Derived>::Map(Index rows, Scalar* values, Scalar* residuals)
-  : ArrayBase<Map<Derived>>(Values(values,rows,Derived::Values::ColsAtCompileTime), Residuals(residuals,rows,Derived::Residuals::ColsAtCompileTime))
+  : ArrayBase<Map<Derived>>(Values(values,rows,Derived::Values::ColsAtCompileTime,Eigen::OuterStride<>(rows)), Residuals(residuals,rows,Derived::Residuals::ColsAtCompileTime))
+  {};
+  
+  /**
+   * Constructor where the columns of @a values are separated by @a stride elements (e.g. the data of a TimeSequence with reserved memory).
+   * The number of elements in @a residuals must correspond to @a rows elements.
+   */
+  template <typename Derived>
+  inline Map<Derived>::Map(Index rows, Index stride, Scalar* values, Scalar* residuals)
+  : ArrayBase<Map<Derived>>(Values(values,rows,Derived::Values::ColsAtCompileTime,Eigen::OuterStride<>(stride)), Residuals(residuals,rows,Derived::Residuals::ColsAtCompileTime))
+  {};
+  
+  /**
+   * Constructor similar to Map(Index, Index, Scalar*, Scalar*) but where the mapped memory is kept alive by the given @a owner as long as this object (or a copy of it) exists.
+   * This is used for example to map data widened from a TimeSequence using a compact storage (see to_array()).
+   */
+  template <typename Derived>
+  inline Map<Derived>::Map(Index rows, Index stride, Scalar* values, Scalar* residuals, std::shared_ptr<const void> owner)
+  : ArrayBase<Map<Derived>>(Values(values,rows,Derived::Values::ColsAtCompileTime,Eigen::OuterStride<>(stride)), Residuals(residuals,rows,Derived::Residuals::ColsAtCompileTime)),
+    m_Owner(std::move(owner))
   {};
   
   /**
@@ -133,7 +165,8 @@ namespace math
   template <typename Derived>
   template <typename U>
   inline Map<Derived>::Map(const Map<U>& other)
-  : ArrayBase<Map<Derived>>(Values(other.values().data(),other.rows(),Derived::Values::ColsAtCompileTime),Residuals(other.residuals().data(),other.rows(),Derived::Residuals::ColsAtCompileTime))
+  : ArrayBase<Map<Derived>>(Values(other.values().data(),other.rows(),Derived::Values::ColsAtCompileTime,Eigen::OuterStride<>(other.values().outerStride())),Residuals(other.residuals().data(),other.rows(),Derived::Residuals::ColsAtCompileTime)),
+    m_Owner(other.owner())
   {
     static_assert(std::is_same<Derived, typename std::add_const<U>::type>::value, "You can only copy to a read-only (const) Map.");
     static_assert(Derived::Values::ColsAtCompileTime == U::Values::ColsAtCompileTime, "The number of columns must be the same.");
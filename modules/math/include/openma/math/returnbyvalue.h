@@ -37,9 +37,12 @@
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+#include "openma/math/blockkernels.h"
+
 #include <type_traits>
 #include <vector>
 #include <array>
+#include <cmath>
 
 namespace Eigen
 {
@@ -69,7 +72,8 @@ namespace internal
     CrossOpValues(const V1& v1, const V2& v2) : m_V1(v1), m_V2(v2) {};
     template <typename R> inline void evalTo(R& result) const
     {
-      // TODO: Is there a better way to implement the cross product?
+      if (block_kernel_evaluate<CrossBlockKernel,3,3,3>(result, this->m_V1, this->m_V2))
+        return;
       const auto& v1x = this->m_V1.col(0);
       const auto& v1y = this->m_V1.col(1);
       const auto& v1z = this->m_V1.col(2);
@@ -234,30 +238,40 @@ namespace internal
     
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 12 && std::decay<U2>::type::ColsAtCompileTime == 12>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
-      TransformOpValues::evaluate_12x12(result,v1,v2);
+      if (!block_kernel_evaluate<Transform12x12BlockKernel,12,12,12>(result,v1,v2))
+        TransformOpValues::evaluate_12x12(result,v1,v2);
     };
     
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 9 && std::decay<U2>::type::ColsAtCompileTime == 9>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
-      TransformOpValues::evaluate_9x9(result,v1,v2);
+      if (!block_kernel_evaluate<Transform9x9BlockKernel,9,9,9>(result,v1,v2))
+        TransformOpValues::evaluate_9x9(result,v1,v2);
     };
     
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 12 && std::decay<U2>::type::ColsAtCompileTime == 3>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
-      TransformOpValues::evaluate_12x3(result,v1,v2);
+      if (!block_kernel_evaluate<Transform12x3BlockKernel,12,3,3>(result,v1,v2))
+        TransformOpValues::evaluate_12x3(result,v1,v2);
     };
     
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 9 && std::decay<U2>::type::ColsAtCompileTime == 3>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
-      TransformOpValues::evaluate_9x3(result,v1,v2);
+      if (!block_kernel_evaluate<Transform9x3BlockKernel,9,3,3>(result,v1,v2))
+        TransformOpValues::evaluate_9x3(result,v1,v2);
     };
     
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 12 && std::decay<U2>::type::ColsAtCompileTime == Dynamic>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
       if (v2.cols() == 12)
-        TransformOpValues::evaluate_12x12(result,v1,v2);
+      {
+        if (!block_kernel_evaluate<Transform12x12BlockKernel,12,12,12>(result,v1,v2))
+          TransformOpValues::evaluate_12x12(result,v1,v2);
+      }
       else if (v2.cols() == 3)
-        TransformOpValues::evaluate_12x3(result,v1,v2);
+      {
+        if (!block_kernel_evaluate<Transform12x3BlockKernel,12,3,3>(result,v1,v2))
+          TransformOpValues::evaluate_12x3(result,v1,v2);
+      }
       else
         result.setZero(); // Potentially crash the binary
     };
@@ -265,9 +279,15 @@ namespace internal
     template <typename R, typename U1, typename U2> static inline typename std::enable_if<std::decay<U1>::type::ColsAtCompileTime == 9 && std::decay<U2>::type::ColsAtCompileTime == Dynamic>::type evaluate(R& result, const U1& v1, const U2& v2)
     {
       if (v2.cols() == 9)
-        TransformOpValues::evaluate_9x9(result,v1,v2);
+      {
+        if (!block_kernel_evaluate<Transform9x9BlockKernel,9,9,9>(result,v1,v2))
+          TransformOpValues::evaluate_9x9(result,v1,v2);
+      }
       else if (v2.cols() == 3)
-        TransformOpValues::evaluate_9x3(result,v1,v2);
+      {
+        if (!block_kernel_evaluate<Transform9x3BlockKernel,9,3,3>(result,v1,v2))
+          TransformOpValues::evaluate_9x3(result,v1,v2);
+      }
       else
         result.setZero(); // Potentially crash the binary
     };
@@ -342,6 +362,8 @@ namespace internal
     InverseOpValues(const V& v) : m_V(v) {};
     template <typename R> inline void evalTo(R& result) const
     {
+      if (block_kernel_evaluate<InverseBlockKernel,12,12>(result, this->m_V))
+        return;
       const auto& v11 = this->m_V.col(0);
       const auto& v21 = this->m_V.col(1);
       const auto& v31 = this->m_V.col(2);
@@ -419,49 +441,121 @@ namespace internal
     f = (!odd ? -1.0 : 1.0);
   }
   
-  // ABA
-  template <typename T>
-  inline Matrix<typename MatrixBase<T>::Scalar,3,1> rotation_matrix_to_euler_sym(const T& rot, typename MatrixBase<T>::Index i, typename MatrixBase<T>::Index j, typename MatrixBase<T>::Index k, typename MatrixBase<T>::Scalar f)
+  // Operations used by the batched Euler angles kernel (one scalar at a time)
+  struct euler_scalar_ops
   {
-    using std::atan2;
-    using Scalar = typename MatrixBase<T>::Scalar;
-    Matrix<Scalar,3,1> res;
-    Scalar s = Eigen::Matrix<Scalar,2,1>(rot.coeff(j,i), rot.coeff(k,i)).norm();
-    res[1] = atan2(s, rot.coeff(i,i));
-    if (s > NumTraits<Scalar>::dummy_precision())
-    {
-      res[0] = f * atan2(rot.coeff(j,i), rot.coeff(k,i));
-      res[2] = f * atan2(rot.coeff(i,j),-rot.coeff(i,k));
-    }
-    else
-    {
-      res[0] = 0.0;
-      res[2] = f * (rot.coeff(i,i) > 0 ? 1 : -1) * atan2(-rot.coeff(k,j), rot.coeff(j,j));
-    }
-    return res;
-  }
+    using Value = double;
+    using Mask = bool;
+    static _OPENMA_CONSTEXPR int Size = 1;
+    static inline Value load(const double* p) {return *p;};
+    static inline void store(double* p, Value v) {*p = v;};
+    static inline Value set1(double v) {return v;};
+    static inline Value add(Value a, Value b) {return a + b;};
+    static inline Value sub(Value a, Value b) {return a - b;};
+    static inline Value mul(Value a, Value b) {return a * b;};
+    static inline Value div(Value a, Value b) {return a / b;};
+    static inline Value sqrt(Value a) {return std::sqrt(a);};
+    static inline Value abs(Value a) {return std::fabs(a);};
+    static inline Value neg(Value a) {return -a;};
+    static inline Mask gt(Value a, Value b) {return a > b;};
+    static inline Mask signbit(Value a) {return std::signbit(a);};
+    static inline Value select(Mask m, Value a, Value b) {return m ? a : b;};
+    static inline Value copysign(Value a, Value s) {return std::copysign(a, s);};
+  };
   
-  // ABC
-  template <typename T>
-  inline Matrix<typename MatrixBase<T>::Scalar,3,1> rotation_matrix_to_euler_unsym(const T& rot, typename MatrixBase<T>::Index i, typename MatrixBase<T>::Index j, typename MatrixBase<T>::Index k, typename MatrixBase<T>::Scalar f)
+#if defined(EIGEN_VECTORIZE_SSE2)
+  // Operations used by the batched Euler angles kernel (two scalars at a time)
+  struct euler_sse2_ops
   {
-    using std::atan2;
-    using Scalar = typename MatrixBase<T>::Scalar;
-    Matrix<Scalar,3,1> res;
-    double c = Eigen::Matrix<Scalar,2,1>(rot.coeff(i,i), rot.coeff(i,j)).norm();
-    res[1] = f * atan2(-rot.coeff(i,k), c);
-    if (c > NumTraits<Scalar>::dummy_precision())
+    using Value = __m128d;
+    using Mask = __m128d;
+    static _OPENMA_CONSTEXPR int Size = 2;
+    static inline Value load(const double* p) {return _mm_loadu_pd(p);};
+    static inline void store(double* p, Value v) {_mm_storeu_pd(p, v);};
+    static inline Value set1(double v) {return _mm_set1_pd(v);};
+    static inline Value add(Value a, Value b) {return _mm_add_pd(a, b);};
+    static inline Value sub(Value a, Value b) {return _mm_sub_pd(a, b);};
+    static inline Value mul(Value a, Value b) {return _mm_mul_pd(a, b);};
+    static inline Value div(Value a, Value b) {return _mm_div_pd(a, b);};
+    static inline Value sqrt(Value a) {return _mm_sqrt_pd(a);};
+    static inline Value abs(Value a) {return _mm_andnot_pd(_mm_set1_pd(-0.0), a);};
+    static inline Value neg(Value a) {return _mm_xor_pd(_mm_set1_pd(-0.0), a);};
+    static inline Mask gt(Value a, Value b) {return _mm_cmpgt_pd(a, b);};
+    static inline Mask signbit(Value a) {return _mm_castsi128_pd(_mm_shuffle_epi32(_mm_srai_epi32(_mm_castpd_si128(a), 31), _MM_SHUFFLE(3,3,1,1)));};
+    static inline Value select(Mask m, Value a, Value b) {return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));};
+    static inline Value copysign(Value a, Value s) {return _mm_or_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), a), _mm_and_pd(_mm_set1_pd(-0.0), s));};
+  };
+#endif
+  
+  // Branchless arctangent of y/x in the range [-pi,pi].
+  // The octant reduction brings the ratio in [0,1]. A second reduction is done above tan(3*pi/16) (~0.66) before using the rational approximation of the Cephes library (file atan.c).
+  // Compared with std::atan2, the absolute error is lower than 4.5e-16 rad (i.e. 2 ulp around pi). Signed zeros are handled as std::atan2 does. Infinite and NaN inputs are not supported.
+  template <typename Ops>
+  inline typename Ops::Value euler_atan2(typename Ops::Value y, typename Ops::Value x)
+  {
+    using V = typename Ops::Value;
+    using M = typename Ops::Mask;
+    const V P0 = Ops::set1(-8.750608600031904122785e-01), P1 = Ops::set1(-1.615753718733365076637e+01), P2 = Ops::set1(-7.500855792314704667340e+01), P3 = Ops::set1(-1.228866684490136173410e+02), P4 = Ops::set1(-6.485021904942025371773e+01);
+    const V Q0 = Ops::set1(2.485846490142306297962e+01), Q1 = Ops::set1(1.650270098316988542046e+02), Q2 = Ops::set1(4.328810604912902668951e+02), Q3 = Ops::set1(4.853903996359136964868e+02), Q4 = Ops::set1(1.945506571482613964425e+02);
+    const double morebits = 6.123233995736765886130e-17; // Lost bits of pi/2 in double precision
+    const V zero = Ops::set1(0.0), one = Ops::set1(1.0);
+    const V ax = Ops::abs(x), ay = Ops::abs(y);
+    const M swap = Ops::gt(ay, ax);
+    const V num = Ops::select(swap, ax, ay), den = Ops::select(swap, ay, ax);
+    const V t0 = Ops::div(num, Ops::select(Ops::gt(den, zero), den, one)); // 0/0 set to 0
+    const M reduce = Ops::gt(t0, Ops::set1(0.66));
+    const V t = Ops::select(reduce, Ops::div(Ops::sub(t0, one), Ops::add(t0, one)), t0);
+    const V z = Ops::mul(t, t);
+    const V p = Ops::add(Ops::mul(Ops::add(Ops::mul(Ops::add(Ops::mul(Ops::add(Ops::mul(P0, z), P1), z), P2), z), P3), z), P4);
+    const V q = Ops::add(Ops::mul(Ops::add(Ops::mul(Ops::add(Ops::mul(Ops::add(Ops::mul(Ops::add(z, Q0), z), Q1), z), Q2), z), Q3), z), Q4);
+    V r = Ops::add(Ops::mul(t, Ops::div(Ops::mul(z, p), q)), t);
+    r = Ops::add(Ops::select(reduce, Ops::set1(0.78539816339744830962), zero), Ops::add(r, Ops::select(reduce, Ops::set1(0.5 * morebits), zero)));
+    r = Ops::select(swap, Ops::add(Ops::sub(Ops::set1(1.57079632679489661923), r), Ops::set1(morebits)), r);
+    r = Ops::select(Ops::signbit(x), Ops::add(Ops::sub(Ops::set1(3.14159265358979323846), r), Ops::set1(2.0 * morebits)), r);
+    return Ops::copysign(r, y);
+  };
+  
+  // Compute the Euler angles for the frames [idx, idx + Ops::Size[.
+  // The rotation matrix is given by 9 columns (column-major storage: the coefficient (r,c) is in the column c*3+r).
+  // The angle n is computed as angle * scale[n] + offset[n] where the sign factor of the sequence is already included in the scale.
+  template <typename Ops, typename Index>
+  inline void euler_angles_kernel(const double* const* rot, double* const* out, Index idx, Index i, Index j, Index k, bool sym, const double* scale, const double* offset)
+  {
+    using V = typename Ops::Value;
+    using M = typename Ops::Mask;
+    auto coeff = [&](Index r, Index c) -> V {return Ops::load(rot[c*3+r] + idx);};
+    const V zero = Ops::set1(0.0), one = Ops::set1(1.0), eps = Ops::set1(NumTraits<double>::dummy_precision());
+    V angles[3];
+    V hyp;
+    if (sym) // ABA
     {
-      res[0] = f * atan2(rot.coeff(j,k), rot.coeff(k,k));
-      res[2] = f * atan2(rot.coeff(i,j), rot.coeff(i,i));
+      const V ji = coeff(j,i), ki = coeff(k,i), ii = coeff(i,i);
+      hyp = Ops::sqrt(Ops::add(Ops::mul(ji, ji), Ops::mul(ki, ki)));
+      angles[0] = euler_atan2<Ops>(ji, ki);
+      angles[1] = euler_atan2<Ops>(hyp, ii);
+      angles[2] = euler_atan2<Ops>(coeff(i,j), Ops::neg(coeff(i,k)));
+      // Gimbal lock
+      const V gimbal = Ops::mul(Ops::select(Ops::gt(ii, zero), one, Ops::neg(one)), euler_atan2<Ops>(Ops::neg(coeff(k,j)), coeff(j,j)));
+      const M regular = Ops::gt(hyp, eps);
+      angles[0] = Ops::select(regular, angles[0], zero);
+      angles[2] = Ops::select(regular, angles[2], gimbal);
     }
-    else
+    else // ABC
     {
-      res[0] = 0.0;
-      res[2] = f * (rot.coeff(i,k) > 0 ? 1 : -1) * atan2(-rot.coeff(k,j), rot.coeff(j,j));
+      const V ii = coeff(i,i), ij = coeff(i,j), ik = coeff(i,k);
+      hyp = Ops::sqrt(Ops::add(Ops::mul(ii, ii), Ops::mul(ij, ij)));
+      angles[0] = euler_atan2<Ops>(coeff(j,k), coeff(k,k));
+      angles[1] = euler_atan2<Ops>(Ops::neg(ik), hyp);
+      angles[2] = euler_atan2<Ops>(ij, ii);
+      // Gimbal lock
+      const V gimbal = Ops::mul(Ops::select(Ops::gt(ik, zero), one, Ops::neg(one)), euler_atan2<Ops>(Ops::neg(coeff(k,j)), coeff(j,j)));
+      const M regular = Ops::gt(hyp, eps);
+      angles[0] = Ops::select(regular, angles[0], zero);
+      angles[2] = Ops::select(regular, angles[2], gimbal);
     }
-    return res;
-  }
+    for (int n = 0 ; n < 3 ; ++n)
+      Ops::store(out[n] + idx, Ops::add(Ops::mul(angles[n], Ops::set1(scale[n])), Ops::set1(offset[n])));
+  };
   
   template<typename V> struct EulerAnglesOpValues;
 
@@ -481,40 +575,35 @@ namespace internal
     const Index m_A0;
     const Index m_A1;
     const Index m_A2;
+    const std::array<double,3> m_Scale;
+    const std::array<double,3> m_Offset;
   public:
-    EulerAnglesOpValues(const V& v, const unsigned& a0, const unsigned& a1, const unsigned& a2) : m_V(v), m_A0(a0), m_A1(a1), m_A2(a2) {};
+    EulerAnglesOpValues(const V& v, const unsigned& a0, const unsigned& a1, const unsigned& a2, const std::array<double,3>& scale, const std::array<double,3>& offset) : m_V(v), m_A0(a0), m_A1(a1), m_A2(a2), m_Scale(scale), m_Offset(offset) {};
     template <typename R> inline void evalTo(R& result) const
     {
-      using MapStride = Eigen::Stride<Eigen::Dynamic,Eigen::Dynamic>;
-      using MapMatrix33 = Eigen::Map<const Eigen::Matrix<double,3,3>, Eigen::Unaligned, MapStride>;
       const Index rows = this->m_V.rows();
+      // Structure of arrays: each coefficient of the rotation matrices is stored in a contiguous column
       const Eigen::Array<double,Eigen::Dynamic,9> values = this->m_V.block(0,0,rows,9);
-      // result.resize(rows, Eigen::NoChange);
-      const MapStride stride(3*rows,rows);
-      MapMatrix33 rot(nullptr,stride);
+      Eigen::Array<double,Eigen::Dynamic,3> angles(rows,3);
+      const double* rot[9];
+      for (int c = 0 ; c < 9 ; ++c)
+        rot[c] = values.data() + c * rows;
+      double* out[3] = {angles.data(), angles.data() + rows, angles.data() + 2 * rows};
       Index i = 0, j = 0, k = 0;
       Scalar f = Scalar(0);
       rotation_matrix_to_euler_order<R>(i,j,k,f,this->m_A0,this->m_A1);
-      // ABA
-      if (this->m_A0 == this->m_A2)
-      {
-        for (Index idx = 0 ; idx < rows ; ++idx)
-        {
-          // See http://eigen.tuxfamily.org/dox/group__TutorialMapClass.html (section Changing the mapped array) for the syntax
-          new (&rot) MapMatrix33(values.data()+idx,stride);
-          result.row(idx) = rotation_matrix_to_euler_sym(rot, i, j, k, f);
-        }
-      }
-      // ABC
-      else
-      {
-        for (Index idx = 0 ; idx < rows ; ++idx)
-        {
-          // See http://eigen.tuxfamily.org/dox/group__TutorialMapClass.html (section Changing the mapped array) for the syntax
-          new (&rot) MapMatrix33(values.data()+idx,stride);
-          result.row(idx) = rotation_matrix_to_euler_unsym(rot, i, j, k, f);
-        }
-      }
+      const bool sym = (this->m_A0 == this->m_A2);
+      // The sign factor of the sequence and the scale are fused together
+      const double scale[3] = {f * this->m_Scale[0], (sym ? 1.0 : f) * this->m_Scale[1], f * this->m_Scale[2]};
+      const double* offset = this->m_Offset.data();
+      Index idx = 0;
+#if defined(EIGEN_VECTORIZE_SSE2)
+      for ( ; idx + euler_sse2_ops::Size <= rows ; idx += euler_sse2_ops::Size)
+        euler_angles_kernel<euler_sse2_ops>(rot, out, idx, i, j, k, sym, scale, offset);
+#endif
+      for ( ; idx < rows ; ++idx)
+        euler_angles_kernel<euler_scalar_ops>(rot, out, idx, i, j, k, sym, scale, offset);
+      result = angles;
     };
     Index rows() const {return this->m_V.rows();};
     Index cols() const {return 3;};
@@ -788,6 +788,7 @@ namespace math
    * @brief Compute euler angles.
    * @tparam Xpr Type of the expression to transform
    * Template expression to compute euler angles for each row and the associated residuals.
+   * The angles are computed by a batched kernel working on the columns of the rotation matrices (vectorized with SSE2 when available). The arctangent is approximated by a branchless rational function with an absolute error lower than 4.5e-16 rad compared with std::atan2. The gimbal lock is also handled without branch.
    * 
    * @note This operator would be used with an array with at least 9 columns representing an orientation. It can be for example a Pose object.
    * @ingroup openma_math
@@ -802,6 +803,8 @@ namespace math
     Index m_Axis0;
     Index m_Axis1;
     Index m_Axis2;
+    std::array<double,3> m_Scale;
+    std::array<double,3> m_Offset;
     
   public:
     /**
@@ -813,10 +816,11 @@ namespace math
      * auto eao1 = EulerAnglesOp(pose,0,1,2); // Extract eurler angles using axes X, Y', and Z".
      * auto eao2 = EulerAnglesOp(pose,2,0,1); // Extract eurler angles using axes Z, X', and Y".
      * @endcode
+     * Each computed angle @e n is then transformed as @c angle*scale[n]+offset[n] using @a scale and @a offset. This can be used for example to convert the angles in degrees and adapt their sign in the same pass.
      */
-    EulerAnglesOp(const XprBase<Xpr>& x, Index a0, Index a1, Index a2)
+    EulerAnglesOp(const XprBase<Xpr>& x, Index a0, Index a1, Index a2, const std::array<double,3>& scale = {{1.0,1.0,1.0}}, const std::array<double,3>& offset = {{0.0,0.0,0.0}})
     : UnaryOp<EulerAnglesOp<Xpr>,Xpr>(x),
-      m_Axis0(a0), m_Axis1(a1), m_Axis2(a2)
+      m_Axis0(a0), m_Axis1(a1), m_Axis2(a2), m_Scale(scale), m_Offset(offset)
     {};
       
     /**
@@ -830,7 +834,7 @@ namespace math
     auto values() const _OPENMA_NOEXCEPT -> Eigen::internal::EulerAnglesOpValues<decltype(OPENMA_MATHS_DECLVAL_NESTED(Xpr).values())>
     {
       using V = decltype(this->m_Xpr.values());
-      return Eigen::internal::EulerAnglesOpValues<V>(this->m_Xpr.values(), this->m_Axis0, this->m_Axis1, this->m_Axis2);
+      return Eigen::internal::EulerAnglesOpValues<V>(this->m_Xpr.values(), this->m_Axis0, this->m_Axis1, this->m_Axis2, this->m_Scale, this->m_Offset);
     };
 
     /**
@@ -848,6 +852,13 @@ namespace math
   {
     return EulerAnglesOp<Derived>(*this,a0,a1,a2);
   };
+  
+  // Defined here due to the declaration order of the classes. The associated documentation is in the header of the XprBase class.
+  template <typename Derived>
+  inline const EulerAnglesOp<Derived> XprBase<Derived>::eulerAngles(Index a0, Index a1, Index a2, const std::array<double,3>& scale, const std::array<double,3>& offset) const _OPENMA_NOEXCEPT
+  {
+    return EulerAnglesOp<Derived>(*this,a0,a1,a2,scale,offset);
+  };
 
   // ----------------------------------------------------------------------- //
   //                              DERIVATEOP
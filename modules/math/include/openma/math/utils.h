@@ -40,6 +40,33 @@
 
 OPENMA_MATHS_EXPORT bool _ma_math_verify_timesequence(const ma::TimeSequence* ts, int type, unsigned components, unsigned offset);
 
+// Modifiable time sequence: a ring buffer is linearized before to be mapped. Compact elements cannot be mapped as their modification would not be propagated.
+// NOTE: The mutable pointer prevents the time sequence to share its buffer with its next copies (see ma::TimeSequence::data()). Read-only consumers should pass a const time sequence.
+template <typename Result>
+inline Result _ma_math_map_timesequence(ma::TimeSequence* ts, unsigned components, unsigned offset)
+{
+  if (ts->storage() != ma::TimeSequence::Storage::Double)
+    return Result();
+  ts->linearize();
+  return Result(ts->samples(), ts->stride(), ts->data() + ts->stride() * offset, ts->data() + ts->stride() * (ts->components()-1));
+};
+
+// Read-only time sequence: the data are mapped directly if possible. Otherwise (compact elements or ring buffer not linearized), they are widened component by component into a buffer owned by the result.
+template <typename Result>
+inline Result _ma_math_map_timesequence(const ma::TimeSequence* ts, unsigned components, unsigned offset)
+{
+  const unsigned samples = ts->samples();
+  if ((ts->storage() == ma::TimeSequence::Storage::Double) && ts->isLinearized())
+    return Result(samples, ts->stride(), ts->data() + ts->stride() * offset, ts->data() + ts->stride() * (ts->components()-1));
+  std::shared_ptr<double> buffer(new double[static_cast<size_t>(components + 1) * samples], std::default_delete<double[]>());
+  double* values = buffer.get();
+  for (unsigned i = 0 ; i < components ; ++i)
+    ts->read(offset + i, 0, samples, values + static_cast<size_t>(i) * samples);
+  double* residuals = values + static_cast<size_t>(components) * samples;
+  ts->read(ts->components() - 1, 0, samples, residuals);
+  return Result(samples, samples, values, residuals, std::move(buffer));
+};
+
 namespace ma
 {
 namespace math
@@ -53,6 +80,9 @@ namespace math
    * The Result object will have @a componments columns. If necessary the position of the data to extract can be shifted.
    * It is also possible to specify the type of the TimeSequence by specifying a TimeSequence::Type value to @a type. If no type is required, you can let the value to -1.
    * In case the number of components or the shift is greater than the number of columns, a empty object will be returned, This is the same if the expected type is not the good one.
+   * The stride of the time sequence is used to map the columns. In case of a ring buffer, a modifiable time sequence is linearized (see TimeSequence::linearize()) before the extraction.
+   * For a read-only time sequence storing compact elements (see TimeSequence::setStorage()) or a ring buffer not linearized, the data cannot be mapped directly. They are then widened in a buffer owned by the returned object (see Map::owner()).
+   * For a modifiable time sequence storing compact elements, an empty object is returned as the modifications could not be propagated. Use a read-only time sequence or the method TimeSequence::write().
    * @tparam Result Type of the extraction.
    * @a tparam T Type of the TimeSequence (w/o const correctness). 
    * @relates Array
@@ -64,7 +94,7 @@ namespace math
     static_assert(std::is_base_of<ArrayBase<Result>, Result>::value, "The template parameter is not a derived class of ArrayBase.");
     static_assert(std::is_same<TimeSequence, typename std::remove_const<T>::type>::value, "The type of the first arguement is not TimeSequence.");
     if (_ma_math_verify_timesequence(ts, type, components, offset))
-      return Result(ts->samples(), ts->data() + ts->samples() * offset, ts->data() + ts->samples() * (ts->components()-1) );
+      return _ma_math_map_timesequence<Result>(ts, components, offset);
     else
       return Result();
   };
@@ -172,6 +202,37 @@ namespace math
   {
     return to_vector(ts,0,TimeSequence::Position);
   };
+  
+  /**
+   * Extract from a TimeSequence @a ts an Array object whatever the storage used by the time sequence (see TimeSequence::setStorage()).
+   * Contrary to to_array(), the data are copied. Compact elements (e.g. float, int16) are widened to double component by component. Thus, the modifications applied on the resulting array are not propagated to the time sequence.
+   * In case the number of components or the shift is greater than the number of columns, a empty object will be returned, This is the same if the expected type is not the good one.
+   * @tparam N Number of columns to extract.
+   * @relates Array
+   * @ingroup openma_math
+   */
+  template <int N>
+  inline Array<N> to_widened_array(const TimeSequence* ts, unsigned offset = 0, int type = -1)
+  {
+    if (!_ma_math_verify_timesequence(ts, type, N, offset))
+      return Array<N>();
+    const unsigned samples = ts->samples();
+    Array<N> out(samples);
+    for (unsigned i = 0 ; i < static_cast<unsigned>(N) ; ++i)
+      ts->read(offset + i, 0, samples, out.values().data() + i * samples);
+    ts->read(ts->components() - 1, 0, samples, out.residuals().data());
+    return out;
+  };
+  
+  /**
+   * Specialized widening method where the result is a Position object. The input must have 3 columns and the type must be set to TimeSequence::Position.
+   * @relates Array
+   * @ingroup openma_math
+   */
+  inline Position to_widened_position(const TimeSequence* ts)
+  {
+    return to_widened_array<3>(ts,0,TimeSequence::Position);
+  };
  
   // ----------------------------------------------------------------------- //
   
@@ -237,6 +298,12 @@ namespace math
   template <typename T>
   inline TimeSequence* to_timesequence(const ArrayBase<T>& source, const std::string& name, double rate, double start, int type, const std::string& unit, Node* parent)
   {
+    // Mapped values could be not contiguous (e.g. extracted from a time sequence with reserved memory)
+    if (source.values().outerStride() != source.rows())
+    {
+      const typename std::decay<decltype(source.values())>::type::PlainObject values = source.values();
+      return to_timesequence(source.cols()+1, source.rows(), values.data(), source.residuals().data(), name, rate, start, type, unit, parent);
+    }
     return to_timesequence(source.cols()+1, source.rows(), source.values().data(), source.residuals().data(), name, rate, start, type, unit, parent);
   };
   
@@ -255,12 +322,14 @@ namespace math
     assert(w.rows() == o.rows());
     auto ts = to_timesequence(13, u.rows(), nullptr, nullptr, name, rate, start, TimeSequence::Pose, "", parent);
     const Pose::Residuals residuals = generate_residuals((u.residuals() >= 0) && (v.residuals() >= 0) && (w.residuals() >= 0) && (o.residuals() >= 0));
-    const unsigned samples = 3 * residuals.rows();
-    std::copy_n(u.values().data(), samples, ts->data());
-    std::copy_n(v.values().data(), samples, ts->data() + samples);
-    std::copy_n(w.values().data(), samples, ts->data() + 2 * samples);
-    std::copy_n(o.values().data(), samples, ts->data() + 3 * samples);
-    std::copy_n(residuals.data(), residuals.rows(), ts->data() + 4 * samples);
+    const auto rows = residuals.rows();
+    const auto stride = ts->stride();
+    using Values = Eigen::Map<Eigen::Array<double,Eigen::Dynamic,3>, Eigen::Unaligned, Eigen::OuterStride<>>;
+    Values(ts->data(), rows, 3, Eigen::OuterStride<>(stride)) = u.values();
+    Values(ts->data() + 3 * stride, rows, 3, Eigen::OuterStride<>(stride)) = v.values();
+    Values(ts->data() + 6 * stride, rows, 3, Eigen::OuterStride<>(stride)) = w.values();
+    Values(ts->data() + 9 * stride, rows, 3, Eigen::OuterStride<>(stride)) = o.values();
+    std::copy_n(residuals.data(), rows, ts->data() + 12 * stride);
     return ts;
   };
   
@@ -277,11 +346,13 @@ namespace math
     assert(m.rows() == p.rows());
     auto ts = to_timesequence(10, f.rows(), nullptr, nullptr, name, rate, start, TimeSequence::Wrench, "", parent);
     const Pose::Residuals residuals = generate_residuals((f.residuals() >= 0) && (m.residuals() >= 0) && (p.residuals() >= 0));
-    const unsigned samples = 3 * residuals.rows();
-    std::copy_n(f.values().data(), samples, ts->data());
-    std::copy_n(m.values().data(), samples, ts->data() + samples);
-    std::copy_n(p.values().data(), samples, ts->data() + 2 * samples);
-    std::copy_n(residuals.data(), residuals.rows(), ts->data() + 3 * samples);
+    const auto rows = residuals.rows();
+    const auto stride = ts->stride();
+    using Values = Eigen::Map<Eigen::Array<double,Eigen::Dynamic,3>, Eigen::Unaligned, Eigen::OuterStride<>>;
+    Values(ts->data(), rows, 3, Eigen::OuterStride<>(stride)) = f.values();
+    Values(ts->data() + 3 * stride, rows, 3, Eigen::OuterStride<>(stride)) = m.values();
+    Values(ts->data() + 6 * stride, rows, 3, Eigen::OuterStride<>(stride)) = p.values();
+    std::copy_n(residuals.data(), rows, ts->data() + 9 * stride);
     return ts;
   };
   
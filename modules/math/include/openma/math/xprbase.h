@@ -193,6 +193,11 @@ namespace math
      * Returns an object representing an euler angles operation using the given order @a a0, @a a1, @a a2 for the sequence order.
      */
     const EulerAnglesOp<Derived> eulerAngles(Index a0, Index a1, Index a2) const _OPENMA_NOEXCEPT;
+    
+    /**
+     * Returns an object representing an euler angles operation using the given order @a a0, @a a1, @a a2 for the sequence order. Each angle is multiplied by the given @a scale and added to the given @a offset in the same pass.
+     */
+    const EulerAnglesOp<Derived> eulerAngles(Index a0, Index a1, Index a2, const std::array<double,3>& scale, const std::array<double,3>& offset) const _OPENMA_NOEXCEPT;
   };
   
   // ----------------------------------------------------------------------- //
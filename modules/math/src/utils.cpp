@@ -62,6 +62,7 @@ namespace math
     {
       assert(ts->components() == components);
       ts->resize(samples); // Grow / shrink the data (if necessary)
+      ts->setStorage(TimeSequence::Storage::Double); // The content is replaced by double values
       ts->setSampleRate(rate); // Assign possibly a new rate
       ts->setStartTime(start); // Same for the start time
       ts->setUnit(unit); // Same for the unit
@@ -72,10 +73,12 @@ namespace math
     }
     if ((values != nullptr) && (residuals != nullptr))
     {  
+      ts->linearize();
       const unsigned valuesComponents = components - 1;
-      const unsigned offset = valuesComponents * samples;
-      std::copy_n(values, samples * valuesComponents, ts->data());
-      std::copy_n(residuals, samples, ts->data() + offset);
+      const unsigned stride = ts->stride();
+      for (unsigned i = 0 ; i < valuesComponents ; ++i)
+        std::copy_n(values + i * samples, samples, ts->data() + i * stride);
+      std::copy_n(residuals, samples, ts->data() + valuesComponents * stride);
     }
     return ts;
   };
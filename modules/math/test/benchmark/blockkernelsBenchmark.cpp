@@ -0,0 +1,96 @@
+#include <openma/math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// Comparison of the block kernels (used by transform(), inverse() and cross()) with the previous implementation based on column expressions.
+// For each operation, the median duration of several repetitions is reported with the maximum absolute difference between both implementations.
+
+using Values12 = ma::math::Pose::Values;
+using Values3 = ma::math::Position::Values;
+
+template <typename F>
+double benchmark_median_ms(F&& f, int repetitions)
+{
+  std::vector<double> durations;
+  for (int r = 0 ; r < repetitions ; ++r)
+  {
+    const auto start = std::chrono::high_resolution_clock::now();
+    f();
+    const auto end = std::chrono::high_resolution_clock::now();
+    durations.push_back(std::chrono::duration<double,std::milli>(end - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size() / 2];
+};
+
+void reference_inverse(Values12& result, const Values12& v)
+{
+  result.col(0) = v.col(0);
+  result.col(1) = v.col(3);
+  result.col(2) = v.col(6);
+  result.col(3) = v.col(1);
+  result.col(4) = v.col(4);
+  result.col(5) = v.col(7);
+  result.col(6) = v.col(2);
+  result.col(7) = v.col(5);
+  result.col(8) = v.col(8);
+  result.col(9)  = -v.col(0) * v.col(9) - v.col(1) * v.col(10) - v.col(2) * v.col(11);
+  result.col(10) = -v.col(3) * v.col(9) - v.col(4) * v.col(10) - v.col(5) * v.col(11);
+  result.col(11) = -v.col(6) * v.col(9) - v.col(7) * v.col(10) - v.col(8) * v.col(11);
+};
+
+void reference_cross(Values3& result, const Values3& v1, const Values3& v2)
+{
+  result.col(0) = (v1.col(1) * v2.col(2)) - (v1.col(2) * v2.col(1));
+  result.col(1) = (v1.col(2) * v2.col(0)) - (v1.col(0) * v2.col(2));
+  result.col(2) = (v1.col(0) * v2.col(1)) - (v1.col(1) * v2.col(0));
+};
+
+int main(int , char* [])
+{
+  const int rows = 100000, repetitions = 51;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  ma::math::Pose m1(rows), m2(rows);
+  ma::math::Position p1(rows), p2(rows);
+  m1.values() = m1.values().unaryExpr([&](double ) {return dist(gen);});
+  m2.values() = m2.values().unaryExpr([&](double ) {return dist(gen);});
+  p1.values() = p1.values().unaryExpr([&](double ) {return dist(gen);});
+  p2.values() = p2.values().unaryExpr([&](double ) {return dist(gen);});
+  m1.residuals().setZero();
+  m2.residuals().setZero();
+  p1.residuals().setZero();
+  p2.residuals().setZero();
+  
+  Values12 r12(rows,12), k12(rows,12);
+  Values3 r3(rows,3), k3(rows,3);
+  using Transform = Eigen::internal::TransformOpValues<Values12,Values12>;
+  
+  std::printf("%-22s %14s %14s %10s %14s\n", "operation", "columns (ms)", "blocks (ms)", "speedup", "max diff");
+  auto report = [](const char* name, double ref, double blk, double diff) {
+    std::printf("%-22s %14.3f %14.3f %10.2f %14.3e\n", name, ref, blk, ref / blk, diff);
+  };
+  double ref, blk;
+  
+  ref = benchmark_median_ms([&]() {Transform::evaluate_12x12(r12, m1.values(), m2.values());}, repetitions);
+  blk = benchmark_median_ms([&]() {k12 = m1.transform(m2).values();}, repetitions);
+  report("transform 12x12", ref, blk, (r12 - k12).abs().maxCoeff());
+  
+  ref = benchmark_median_ms([&]() {Transform::evaluate_12x3(r3, m1.values(), p1.values());}, repetitions);
+  blk = benchmark_median_ms([&]() {k3 = m1.transform(p1).values();}, repetitions);
+  report("transform 12x3", ref, blk, (r3 - k3).abs().maxCoeff());
+  
+  ref = benchmark_median_ms([&]() {reference_inverse(r12, m1.values());}, repetitions);
+  blk = benchmark_median_ms([&]() {k12 = m1.inverse().values();}, repetitions);
+  report("inverse 12", ref, blk, (r12 - k12).abs().maxCoeff());
+  
+  ref = benchmark_median_ms([&]() {reference_cross(r3, p1.values(), p2.values());}, repetitions);
+  blk = benchmark_median_ms([&]() {k3 = p1.cross(p2).values();}, repetitions);
+  report("cross 3x3", ref, blk, (r3 - k3).abs().maxCoeff());
+  
+  return 0;
+};
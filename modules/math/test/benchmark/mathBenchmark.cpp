@@ -0,0 +1,65 @@
+#include "benchmark.h"
+
+#include <openma/math.h>
+
+// Benchmarks of the math module on long trials:
+//  - Construction of a pose from markers (normalization, cross products)
+//  - Transformation of poses and positions, inverse of poses
+//  - Finite derivatives (velocities and accelerations) of positions and poses
+//  - Euler angles (joint kinematics)
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("math", argc, argv);
+  const unsigned samples = bench.samples();
+  const double rate = 100.0;
+
+  ma::Node root("root");
+  auto trial = new ma::Trial("trial", &root);
+  const auto markers = ma::benchmark::generate_markers(trial, {"O1","A1","L1","O2","A2","L2"}, {0.,0.,1000., 100.,0.,1000., 0.,80.,1000., 0.,0.,500., 100.,20.,500., 10.,80.,500.}, samples, rate);
+  const auto o1 = ma::math::to_position(markers[0]), a1 = ma::math::to_position(markers[1]), l1 = ma::math::to_position(markers[2]);
+  const auto o2 = ma::math::to_position(markers[3]), a2 = ma::math::to_position(markers[4]), l2 = ma::math::to_position(markers[5]);
+
+  ma::math::Pose p1, p2;
+  bench.run("pose.construct", samples, [&]() {
+    const ma::math::Vector u = (a1 - o1).normalized();
+    const ma::math::Vector w = u.cross(l1 - o1).normalized();
+    p1 = ma::math::Pose(u, w.cross(u), w, o1);
+  });
+  {
+    const ma::math::Vector u = (a2 - o2).normalized();
+    const ma::math::Vector w = u.cross(l2 - o2).normalized();
+    p2 = ma::math::Pose(u, w.cross(u), w, o2);
+  }
+
+  ma::math::Pose pose;
+  ma::math::Position position;
+  ma::math::Vector vector;
+  bench.run("pose.transform.pose", samples, [&]() {
+    pose = p1.inverse().transform(p2);
+  });
+  bench.run("pose.transform.position", samples, [&]() {
+    position = p1.transform(o2);
+  });
+  bench.run("pose.inverse", samples, [&]() {
+    pose = p1.inverse();
+  });
+  bench.run("position.derivative.first", samples, [&]() {
+    vector = o1.derivative<1>(1.0 / rate);
+  });
+  bench.run("position.derivative.second", samples, [&]() {
+    vector = o1.derivative<2>(1.0 / rate);
+  });
+  bench.run("pose.derivative.first", samples, [&]() {
+    ma::math::Array<12> d = p1.derivative<1>(1.0 / rate);
+    ma::benchmark::do_not_optimize(d);
+  });
+  bench.run("pose.eulerAngles", samples, [&]() {
+    vector = p1.inverse().transform(p2).eulerAngles(0,1,2);
+  });
+  ma::benchmark::do_not_optimize(pose);
+  ma::benchmark::do_not_optimize(position);
+  ma::benchmark::do_not_optimize(vector);
+
+  return bench.report();
+};
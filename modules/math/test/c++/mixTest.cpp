@@ -112,6 +112,93 @@ CXXTEST_SUITE(MixTest)
     TS_ASSERT_EQUALS(b4.isValid(), true);
   }
   
+  CXXTEST_TEST(toArrayStrided)
+  {
+    ma::TimeSequence marker("MARKER",4,0,100.0,0.0,ma::TimeSequence::Position,"mm");
+    ma::math::Array<4>::Values data = ma::math::Array<4>::Values::Random(10,4);
+    marker.reserve(16);
+    marker.append(data.data(), 10);
+    TS_ASSERT_EQUALS(marker.stride(), 16u);
+    
+    auto a = ma::math::to_array<3>(&marker);
+    TS_ASSERT_EQUALS(a.rows(), 10);
+    TS_ASSERT_EIGEN_DELTA(a.values(), data.block(0,0,10,3), 1e-15);
+    TS_ASSERT_EIGEN_DELTA(a.residuals(), data.block(0,3,10,1), 1e-15);
+    auto b = ma::math::to_array<1>(&marker, 2);
+    TS_ASSERT_EIGEN_DELTA(b.values(), data.block(0,2,10,1), 1e-15);
+    
+    a.values() *= 2.0;
+    TS_ASSERT_EQUALS(marker.data(9,2), 2.0 * data(9,2));
+    
+    ma::Node root("root");
+    auto ts = ma::math::to_timesequence(a, "Copy", 100.0, 0.0, ma::TimeSequence::Position, "mm", &root);
+    TS_ASSERT_EQUALS(ts->stride(), 10u);
+    TS_ASSERT_EIGEN_DELTA(ma::math::to_array<3>(ts).values(), 2.0 * data.block(0,0,10,3), 1e-15);
+  }
+  
+  CXXTEST_TEST(toArrayRingBuffer)
+  {
+    ma::TimeSequence marker("MARKER",4,0,100.0,0.0,ma::TimeSequence::Position,"mm");
+    marker.enableRingBuffer(4);
+    ma::math::Array<4>::Values data = ma::math::Array<4>::Values::Random(6,4);
+    for (unsigned i = 0 ; i < 6 ; ++i)
+    {
+      const double sample[4] = {data(i,0), data(i,1), data(i,2), data(i,3)};
+      marker.append(sample, 1);
+    }
+    TS_ASSERT_EQUALS(marker.samples(), 4u);
+    TS_ASSERT_EQUALS(marker.isLinearized(), false);
+    
+    // A read-only ring buffer is not modified, its data are widened in a buffer owned by the map
+    const ma::TimeSequence* cmarker = &marker;
+    auto a = ma::math::to_array<3>(cmarker);
+    TS_ASSERT_EQUALS(a.isValid(), true);
+    TS_ASSERT_DIFFERS(a.owner(), nullptr);
+    TS_ASSERT_EQUALS(marker.isLinearized(), false);
+    TS_ASSERT_EIGEN_DELTA(a.values(), data.block(2,0,4,3), 1e-15);
+    TS_ASSERT_EIGEN_DELTA(a.residuals(), data.block(2,3,4,1), 1e-15);
+    auto b = ma::math::to_widened_position(cmarker);
+    TS_ASSERT_EIGEN_DELTA(b.values(), data.block(2,0,4,3), 1e-15);
+    
+    auto c = ma::math::to_array<3>(&marker);
+    TS_ASSERT_EQUALS(marker.isLinearized(), true);
+    TS_ASSERT_EQUALS(c.rows(), 4);
+    TS_ASSERT_EIGEN_DELTA(c.values(), data.block(2,0,4,3), 1e-15);
+    TS_ASSERT_EIGEN_DELTA(c.residuals(), data.block(2,3,4,1), 1e-15);
+    auto d = ma::math::to_array<3>(cmarker);
+    TS_ASSERT_EQUALS(d.isValid(), true);
+    TS_ASSERT_EQUALS(d.owner(), nullptr);
+    TS_ASSERT_EQUALS(d.values().data(), marker.data());
+  };
+  
+  CXXTEST_TEST(toWidenedArray)
+  {
+    ma::TimeSequence marker("MARKER",4,10,100.0,0.0,ma::TimeSequence::Position,"mm");
+    auto data = Eigen::Map<ma::math::Array<4>::Values>(marker.data(),10,4);
+    data.setRandom();
+    const ma::math::Array<4>::Values ref = data;
+    marker.setStorage(ma::TimeSequence::Storage::Float);
+    
+    auto a = ma::math::to_array<3>(&marker);
+    TS_ASSERT_EQUALS(a.isValid(), false);
+    // The read-only mapping widens the compact elements
+    const ma::TimeSequence* cmarker = &marker;
+    ma::math::Map<const ma::math::Position> ca = ma::math::to_position(cmarker);
+    TS_ASSERT_EQUALS(ca.rows(), 10);
+    TS_ASSERT_EIGEN_DELTA(ca.values(), ref.block(0,0,10,3), 1e-6);
+    TS_ASSERT_EIGEN_DELTA(ca.residuals(), ref.block(0,3,10,1), 1e-6);
+    const ma::math::Position mean = ma::math::to_array<3>(cmarker, 0, ma::TimeSequence::Position).mean();
+    TS_ASSERT_EIGEN_DELTA(mean.values(), ma::math::to_widened_position(cmarker).mean().values(), 1e-15);
+    auto b = ma::math::to_widened_position(&marker);
+    TS_ASSERT_EQUALS(b.rows(), 10);
+    TS_ASSERT_EIGEN_DELTA(b.values(), ref.block(0,0,10,3), 1e-6);
+    TS_ASSERT_EIGEN_DELTA(b.residuals(), ref.block(0,3,10,1), 1e-6);
+    auto c = ma::math::to_widened_array<1>(&marker, 2);
+    TS_ASSERT_EIGEN_DELTA(c.values(), ref.block(0,2,10,1), 1e-6);
+    auto d = ma::math::to_widened_array<3>(&marker, 2);
+    TS_ASSERT_EQUALS(d.isValid(), false);
+  };
+  
   CXXTEST_TEST(toArrayBis)
   {
     ma::TimeSequence marker("MARKER",4,1,100.0,0.0,ma::TimeSequence::Position,"mm");
@@ -184,5 +271,8 @@ CXXTEST_SUITE_REGISTRATION(MixTest)
 CXXTEST_TEST_REGISTRATION(MixTest, operatorsPlusAndDivide)
 CXXTEST_TEST_REGISTRATION(MixTest, assignment)
 CXXTEST_TEST_REGISTRATION(MixTest, toArray)
+CXXTEST_TEST_REGISTRATION(MixTest, toArrayStrided)
+CXXTEST_TEST_REGISTRATION(MixTest, toArrayRingBuffer)
+CXXTEST_TEST_REGISTRATION(MixTest, toWidenedArray)
 CXXTEST_TEST_REGISTRATION(MixTest, toArrayBis)
 CXXTEST_TEST_REGISTRATION(MixTest, toPose)
\ No newline at end of file
@@ -1,8 +1,54 @@
 #include <cxxtest/TestDrive.h>
 
 #include <openma/math.h>
+#include <Eigen/Geometry> // Eigen::AngleAxisd
 
 #include <cmath> // M_PI
+#include <random>
+#include <vector>
+
+// Reference implementation using a scalar code path with std::atan2 and an explicit branch for the gimbal lock
+void posetest_reference_euler_angles(const ma::math::Pose& pose, int a0, int a1, int a2, Eigen::Array<double,Eigen::Dynamic,3>& angles)
+{
+  const int odd = ((a0 + 1) % 3 == a1) ? 0 : 1;
+  const int i = a0, j = (a0 + 1 + odd) % 3, k = (a0 + 2 - odd) % 3;
+  const double f = (!odd ? -1.0 : 1.0);
+  angles.resize(pose.rows(), 3);
+  for (int row = 0 ; row < pose.rows() ; ++row)
+  {
+    auto R = [&](int r, int c) {return pose.values().coeff(row, c*3+r);};
+    if (a0 == a2)
+    {
+      const double s = std::sqrt(R(j,i) * R(j,i) + R(k,i) * R(k,i));
+      angles(row,1) = std::atan2(s, R(i,i));
+      if (s > 1e-12)
+      {
+        angles(row,0) = f * std::atan2(R(j,i), R(k,i));
+        angles(row,2) = f * std::atan2(R(i,j), -R(i,k));
+      }
+      else
+      {
+        angles(row,0) = 0.0;
+        angles(row,2) = f * (R(i,i) > 0 ? 1 : -1) * std::atan2(-R(k,j), R(j,j));
+      }
+    }
+    else
+    {
+      const double c = std::sqrt(R(i,i) * R(i,i) + R(i,j) * R(i,j));
+      angles(row,1) = f * std::atan2(-R(i,k), c);
+      if (c > 1e-12)
+      {
+        angles(row,0) = f * std::atan2(R(j,k), R(k,k));
+        angles(row,2) = f * std::atan2(R(i,j), R(i,i));
+      }
+      else
+      {
+        angles(row,0) = 0.0;
+        angles(row,2) = f * (R(i,k) > 0 ? 1 : -1) * std::atan2(-R(k,j), R(j,j));
+      }
+    }
+  }
+};
 
 CXXTEST_SUITE(PoseTest)
 {
@@ -297,6 +343,106 @@ CXXTEST_SUITE(PoseTest)
     TS_ASSERT_DELTA(meanbis.values().coeff(0, 1), 0.541052068118242, 1e-5);
     TS_ASSERT_DELTA(meanbis.values().coeff(0, 2), 1.225221134900019, 1e-5);
   };
+  
+  CXXTEST_TEST(eulerAnglesAllSequences)
+  {
+    const int sequences[12][3] = {{0,1,2},{1,2,0},{2,0,1},{0,2,1},{2,1,0},{1,0,2},{2,0,2},{0,1,0},{1,2,1},{2,1,2},{0,2,0},{1,0,1}};
+    // Odd number of rows to use the scalar code path at the end of the vectorized one
+    const int rows = 1001;
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> dist(-M_PI, M_PI);
+    ma::math::Pose motion(rows);
+    motion.values().setZero();
+    motion.residuals().setZero();
+    for (int row = 0 ; row < rows ; ++row)
+    {
+      Eigen::Matrix3d R;
+      // Some rows are in gimbal lock
+      if (row % 10 == 0)
+        R = Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitZ()) * Eigen::AngleAxisd(M_PI / 2.0, Eigen::Vector3d::Unit(row % 3)) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitX());
+      else if (row % 10 == 1)
+        R = Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::Unit(row % 3)).toRotationMatrix();
+      else
+        R = Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitZ()) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitY()) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitX());
+      for (int c = 0 ; c < 9 ; ++c)
+        motion.values().coeffRef(row, c) = R(c % 3, c / 3);
+    }
+    Eigen::Array<double,Eigen::Dynamic,3> reference;
+    for (int s = 0 ; s < 12 ; ++s)
+    {
+      posetest_reference_euler_angles(motion, sequences[s][0], sequences[s][1], sequences[s][2], reference);
+      ma::math::Array<3> angles = motion.eulerAngles(sequences[s][0], sequences[s][1], sequences[s][2]);
+      TS_ASSERT_EQUALS(angles.rows(), rows);
+      // Angles close to +/-pi can be wrapped differently by the approximation
+      Eigen::Array<double,Eigen::Dynamic,3> diff = (angles.values() - reference).abs();
+      diff = diff.min((diff - 2.0 * M_PI).abs());
+      TSM_ASSERT_LESS_THAN(std::to_string(s), diff.maxCoeff(), 1e-14);
+      // Fused scale and offset
+      ma::math::Array<3> degrees = motion.eulerAngles(sequences[s][0], sequences[s][1], sequences[s][2], {{180.0 / M_PI, -180.0 / M_PI, 180.0 / M_PI}}, {{0.0, 90.0, -10.0}});
+      TS_ASSERT_EIGEN_DELTA(degrees.values().col(0), (angles.values().col(0) * 180.0 / M_PI), 1e-12);
+      TS_ASSERT_EIGEN_DELTA(degrees.values().col(1), (angles.values().col(1) * -180.0 / M_PI + 90.0), 1e-12);
+      TS_ASSERT_EIGEN_DELTA(degrees.values().col(2), (angles.values().col(2) * 180.0 / M_PI - 10.0), 1e-12);
+    }
+  };
+  
+  CXXTEST_TEST(blockKernels)
+  {
+    // Number of rows not multiple of the block size to use the last incomplete block
+    const int rows = 8 * 3 + 5;
+    std::mt19937 gen(6789);
+    std::uniform_real_distribution<double> dist(-M_PI, M_PI);
+    ma::math::Pose m1(rows), m2(rows);
+    ma::math::Position p(rows);
+    std::vector<Eigen::Matrix3d> R1(rows), R2(rows);
+    std::vector<Eigen::Vector3d> t1(rows), t2(rows), q(rows);
+    for (int row = 0 ; row < rows ; ++row)
+    {
+      R1[row] = Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitZ()) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitY()) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitX());
+      R2[row] = Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitX()) * Eigen::AngleAxisd(dist(gen), Eigen::Vector3d::UnitZ());
+      t1[row] << dist(gen), dist(gen), dist(gen);
+      t2[row] << dist(gen), dist(gen), dist(gen);
+      q[row] << dist(gen), dist(gen), dist(gen);
+      for (int c = 0 ; c < 9 ; ++c)
+      {
+        m1.values().coeffRef(row, c) = R1[row](c % 3, c / 3);
+        m2.values().coeffRef(row, c) = R2[row](c % 3, c / 3);
+      }
+      for (int c = 0 ; c < 3 ; ++c)
+      {
+        m1.values().coeffRef(row, 9+c) = t1[row](c);
+        m2.values().coeffRef(row, 9+c) = t2[row](c);
+        p.values().coeffRef(row, c) = q[row](c);
+      }
+    }
+    m1.residuals().setZero();
+    m2.residuals().setZero();
+    p.residuals().setZero();
+    ma::math::Pose::Values composed = m1.transform(m2).values();
+    ma::math::Pose::Values inverted = m1.inverse().values();
+    ma::math::Position::Values transformed = m1.transform(p).values();
+    ma::math::Position::Values crossed = p.cross(m1.block<3>(3)).values();
+    TS_ASSERT_EQUALS(composed.rows(), rows);
+    TS_ASSERT_EQUALS(inverted.rows(), rows);
+    TS_ASSERT_EQUALS(transformed.rows(), rows);
+    TS_ASSERT_EQUALS(crossed.rows(), rows);
+    for (int row = 0 ; row < rows ; ++row)
+    {
+      const Eigen::Matrix3d R = R1[row] * R2[row], Ri = R1[row].transpose();
+      const Eigen::Vector3d t = R1[row] * t2[row] + t1[row], ti = -Ri * t1[row], pt = R1[row] * q[row] + t1[row], c = q[row].cross(R1[row].col(1));
+      for (int k = 0 ; k < 9 ; ++k)
+      {
+        TS_ASSERT_DELTA(composed.coeff(row, k), R(k % 3, k / 3), 1e-14);
+        TS_ASSERT_DELTA(inverted.coeff(row, k), Ri(k % 3, k / 3), 1e-14);
+      }
+      for (int k = 0 ; k < 3 ; ++k)
+      {
+        TS_ASSERT_DELTA(composed.coeff(row, 9+k), t(k), 1e-14);
+        TS_ASSERT_DELTA(inverted.coeff(row, 9+k), ti(k), 1e-14);
+        TS_ASSERT_DELTA(transformed.coeff(row, k), pt(k), 1e-14);
+        TS_ASSERT_DELTA(crossed.coeff(row, k), c(k), 1e-14);
+      }
+    }
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(PoseTest)
@@ -306,3 +452,5 @@ CXXTEST_TEST_REGISTRATION(PoseTest, transformPose)
 CXXTEST_TEST_REGISTRATION(PoseTest, transformPosition)
 CXXTEST_TEST_REGISTRATION(PoseTest, transformPositionBis)
 CXXTEST_TEST_REGISTRATION(PoseTest, eulerAngles)
+CXXTEST_TEST_REGISTRATION(PoseTest, eulerAnglesAllSequences)
+CXXTEST_TEST_REGISTRATION(PoseTest, blockKernels)
@@ -39,14 +39,19 @@
 #include "openma/processing/enums.h"
 
 #include <vector>
+#include <string>
 
 namespace ma
 {
+  class Node;
   class TimeSequence;
+  class Event;
   
 namespace processing
 {
   OPENMA_PROCESSING_EXPORT bool filter_butterworth_zero_lag(const std::vector<TimeSequence*>& tss, Response type, double fc, int fn);
+  OPENMA_PROCESSING_EXPORT bool fill_gaps(const std::vector<TimeSequence*>& tss, GapFilling method, unsigned maxGapLength = 0, unsigned threads = 0);
+  OPENMA_PROCESSING_EXPORT std::vector<Node*> normalize_cycles(const std::vector<TimeSequence*>& tss, const std::vector<Event*>& events, const std::string& label, const std::string& context, unsigned points = 101, Node* parent = nullptr, unsigned threads = 0);
 };
 
 };
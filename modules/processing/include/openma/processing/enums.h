@@ -47,6 +47,13 @@ namespace processing
     BandStop
   };
   
+  enum class GapFilling
+  {
+    Linear = 1,
+    Cubic,
+    RigidBody
+  };
+  
   /**
    * @enum Response
    * Enumerator for filter response type
@@ -69,6 +76,25 @@ namespace processing
    * @var Response Response::BandStop
    * To be used when designing a band-stop (or band-rejection) filter response type 
    */
+  
+  /**
+   * @enum GapFilling
+   * Enumerator for the method used to fill the gaps of reconstructed time sequences
+   * @sa fill_gaps
+   * @ingroup openma_processing
+   */
+  /**
+   * @var GapFilling GapFilling::Linear
+   * The gap is filled with a straight line between the samples surrounding the gap
+   */
+  /**
+   * @var GapFilling GapFilling::Cubic
+   * The gap is filled with a piecewise cubic Hermite interpolating polynomial (PCHIP) based on the valid samples surrounding the gap
+   */
+  /**
+   * @var GapFilling GapFilling::RigidBody
+   * The gap is filled by assuming that the time sequence and three of its closest neighbours (valid during the gap) form a rigid body
+   */
 };
 
 };
@@ -34,28 +34,53 @@
 
 #include "openma/processing.h"
 #include "openma/base/timesequence.h"
+#include "openma/base/event.h"
 #include "openma/base/logger.h"
+#include "openma/base/parallel.h"
 #include "openma/math.h" // ma::math::prepare_window_processing
 
 #include <iostream> // Used by IIRFilterDesign
 #include <Eigen_openma/SignalProcessing/IIRFilterDesign.h>
 #include <Eigen_openma/SignalProcessing/FiltFilt.h>
+#include <Eigen_openma/Interpolation/Interp1.h>
+#include <Eigen/SVD> // Eigen::JacobiSVD
+
+#include <algorithm> // std::partial_sort, std::sort
+#include <cmath> // std::floor
+#include <memory> // std::unique_ptr
+
+// Copy of the time sequence @a ts where the elements are stored as double values (see TimeSequence::setStorage()). Used to process time sequences storing compact elements.
+ma::TimeSequence* _ma_processing_widen(const ma::TimeSequence* ts)
+{
+  auto widened = static_cast<ma::TimeSequence*>(ts->clone());
+  widened->setStorage(ma::TimeSequence::Storage::Double);
+  return widened;
+};
+
+// Write back the elements of the @a widened copy into the time sequence @a ts. The elements are converted to the storage of @a ts.
+void _ma_processing_narrow(const ma::TimeSequence* widened, ma::TimeSequence* ts)
+{
+  for (unsigned c = 0, num = ts->components() ; c < num ; ++c)
+    ts->write(c, 0, ts->samples(), widened->data() + c * widened->stride());
+};
 
 void _ma_processing_butterworth_zero_lag_filter(ma::TimeSequence* ts, const Eigen::Matrix<double, Eigen::Dynamic, 1>& b, const Eigen::Matrix<double, Eigen::Dynamic, 1>& a)
 {
-  Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>> data(ts->data(), ts->samples(), ts->components());
+  ts->linearize();
+  Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<>> data(ts->data(), ts->samples(), ts->components(), Eigen::OuterStride<>(ts->stride()));
   data = Eigen::filtfilt(b,a,data);
 };
 
 void _ma_processing_butterworth_zero_lag_filter_windowed(ma::TimeSequence* ts, const Eigen::Matrix<double, Eigen::Dynamic, 1>& b, const Eigen::Matrix<double, Eigen::Dynamic, 1>& a)
 {
+  ts->linearize();
   int cpts = ts->components()-1;
-  Eigen::Map<Eigen::Array<double,Eigen::Dynamic,1>> resin(ts->data()+cpts*ts->samples(), ts->samples(), 1);
+  Eigen::Map<Eigen::Array<double,Eigen::Dynamic,1>> resin(ts->data()+cpts*ts->stride(), ts->samples(), 1);
   Eigen::Array<double,Eigen::Dynamic,1> resout;
   unsigned mwlen = 3 * std::max(a.rows(),b.rows()) - 1;
   std::vector<std::array<unsigned,2>> windows;
   ma::math::prepare_window_processing(resout, windows, resin, mwlen);
-  Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>> data(ts->data(), ts->samples(), ts->components());
+  Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<>> data(ts->data(), ts->samples(), ts->components(), Eigen::OuterStride<>(ts->stride()));
   Eigen::Matrix<double,Eigen::Dynamic,1> temp = Eigen::Matrix<double,Eigen::Dynamic,1>::Zero(data.rows(),1);
   for (int i = 0 ; i < cpts ; ++i)
   {
@@ -66,6 +91,204 @@ void _ma_processing_butterworth_zero_lag_filter_windowed(ma::TimeSequence* ts, c
   resin = resout;
 };
 
+// Samples computed to fill the gaps of one time sequence. They are written back only when all the time sequences are processed (the rigid body method reads the neighbours).
+struct _ma_processing_filled_samples
+{
+  std::vector<unsigned> Indices;
+  std::vector<double> Values; // (components - 1) values per sample
+  unsigned Unfilled = 0;
+};
+
+// Find the gaps (negative residuals) of a reconstructed time sequence. Each gap is given by its first sample and its length.
+std::vector<std::array<unsigned,2>> _ma_processing_find_gaps(const double* residuals, unsigned samples)
+{
+  std::vector<std::array<unsigned,2>> gaps;
+  unsigned i = 0;
+  while (i < samples)
+  {
+    if (residuals[i] < 0.)
+    {
+      unsigned start = i;
+      while ((i < samples) && (residuals[i] < 0.))
+        ++i;
+      gaps.push_back({{start, i - start}});
+    }
+    else
+      ++i;
+  }
+  return gaps;
+};
+
+void _ma_processing_fill_gap_linear(_ma_processing_filled_samples* out, const ma::TimeSequence* ts, const std::array<unsigned,2>& gap)
+{
+  const double* data = ts->data();
+  const unsigned stride = ts->stride(), coords = ts->components() - 1;
+  const unsigned prev = gap[0] - 1, next = gap[0] + gap[1];
+  for (unsigned k = 0 ; k < gap[1] ; ++k)
+  {
+    const double t = static_cast<double>(k + 1) / static_cast<double>(gap[1] + 1);
+    out->Indices.push_back(gap[0] + k);
+    for (unsigned c = 0 ; c < coords ; ++c)
+      out->Values.push_back(data[c*stride+prev] + (data[c*stride+next] - data[c*stride+prev]) * t);
+  }
+};
+
+void _ma_processing_fill_gap_cubic(_ma_processing_filled_samples* out, const ma::TimeSequence* ts, const std::array<unsigned,2>& gap)
+{
+  // Only the valid samples surrounding the gap are used as knots (up to 3 on each side)
+  const unsigned maxKnots = 3;
+  const double* data = ts->data();
+  const unsigned stride = ts->stride(), coords = ts->components() - 1, samples = ts->samples();
+  const double* residuals = data + coords * stride;
+  std::vector<unsigned> knots;
+  for (unsigned i = gap[0], k = 0 ; (i > 0) && (k < maxKnots) && (residuals[i-1] >= 0.) ; --i, ++k)
+    knots.insert(knots.begin(), i - 1);
+  for (unsigned i = gap[0] + gap[1], k = 0 ; (i < samples) && (k < maxKnots) && (residuals[i] >= 0.) ; ++i, ++k)
+    knots.push_back(i);
+  // The PCHIP requires at least 3 knots
+  if (knots.size() < 3)
+  {
+    _ma_processing_fill_gap_linear(out, ts, gap);
+    return;
+  }
+  // The knots and the query points are the same for all the coordinates: the interpolation is prepared once
+  const Eigen::DenseIndex num = knots.size();
+  Eigen::Matrix<double,Eigen::Dynamic,1> x(num), xi(gap[1]);
+  Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic> y(num, coords), yi;
+  for (Eigen::DenseIndex i = 0 ; i < num ; ++i)
+  {
+    x.coeffRef(i) = static_cast<double>(knots[i]);
+    for (unsigned c = 0 ; c < coords ; ++c)
+      y.coeffRef(i,c) = data[c*stride+knots[i]];
+  }
+  for (unsigned k = 0 ; k < gap[1] ; ++k)
+    xi.coeffRef(k) = static_cast<double>(gap[0] + k);
+  Eigen::Interp1Batch<double> interp(Eigen::Interp1Batch<double>::Cubic);
+  interp.prepare(x, xi);
+  interp.apply(&yi, y);
+  for (unsigned k = 0 ; k < gap[1] ; ++k)
+  {
+    out->Indices.push_back(gap[0] + k);
+    for (unsigned c = 0 ; c < coords ; ++c)
+      out->Values.push_back(yi.coeff(k,c));
+  }
+};
+
+// Rigid transformation (least squares, Kabsch algorithm) mapping the reference points @a p to the points @a q, applied to the point @a m.
+Eigen::Vector3d _ma_processing_rigid_transform(const Eigen::Matrix<double,3,Eigen::Dynamic>& p, const Eigen::Matrix<double,3,Eigen::Dynamic>& q, const Eigen::Vector3d& m)
+{
+  const Eigen::Vector3d pc = p.rowwise().mean(), qc = q.rowwise().mean();
+  const Eigen::Matrix3d h = (p.colwise() - pc) * (q.colwise() - qc).transpose();
+  Eigen::JacobiSVD<Eigen::Matrix3d> svd(h, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Eigen::Matrix3d d = Eigen::Matrix3d::Identity();
+  d(2,2) = ((svd.matrixV() * svd.matrixU().transpose()).determinant() < 0.) ? -1.0 : 1.0;
+  const Eigen::Matrix3d r = svd.matrixV() * d * svd.matrixU().transpose();
+  return r * (m - pc) + qc;
+};
+
+void _ma_processing_fill_gap_rigid(_ma_processing_filled_samples* out, const ma::TimeSequence* ts, const std::array<unsigned,2>& gap, const std::vector<const ma::TimeSequence*>& markers)
+{
+  const unsigned neighbours = 3;
+  const unsigned samples = ts->samples();
+  const bool hasPrev = (gap[0] > 0), hasNext = ((gap[0] + gap[1]) < samples);
+  if (!hasPrev && !hasNext)
+  {
+    ++out->Unfilled;
+    return;
+  }
+  const unsigned prev = gap[0] - 1, next = gap[0] + gap[1];
+  const unsigned first = hasPrev ? prev : gap[0], last = hasNext ? next : (next - 1);
+  const unsigned ref = hasPrev ? prev : next;
+  auto coord = [](const ma::TimeSequence* m, unsigned sample, unsigned c) {return m->data()[c*m->stride()+sample];};
+  // Candidates: markers visible during the whole gap and on the reference samples
+  std::vector<std::pair<double,const ma::TimeSequence*>> candidates;
+  for (const auto& marker : markers)
+  {
+    if ((marker == ts) || (marker->samples() != samples))
+      continue;
+    const double* residuals = marker->data() + 3 * marker->stride();
+    unsigned i = first;
+    while ((i <= last) && (residuals[i] >= 0.))
+      ++i;
+    if (i <= last)
+      continue;
+    const double dx = coord(marker,ref,0) - coord(ts,ref,0), dy = coord(marker,ref,1) - coord(ts,ref,1), dz = coord(marker,ref,2) - coord(ts,ref,2);
+    candidates.emplace_back(dx*dx + dy*dy + dz*dz, marker);
+  }
+  if (candidates.size() < neighbours)
+  {
+    ++out->Unfilled;
+    return;
+  }
+  std::partial_sort(candidates.begin(), candidates.begin() + neighbours, candidates.end(), [](const std::pair<double,const ma::TimeSequence*>& lhs, const std::pair<double,const ma::TimeSequence*>& rhs) {return lhs.first < rhs.first;});
+  auto cluster = [&](unsigned sample) {
+    Eigen::Matrix<double,3,Eigen::Dynamic> pts(3, neighbours);
+    for (unsigned j = 0 ; j < neighbours ; ++j)
+      for (unsigned c = 0 ; c < 3 ; ++c)
+        pts.coeffRef(c,j) = coord(candidates[j].second,sample,c);
+    return pts;
+  };
+  Eigen::Matrix<double,3,Eigen::Dynamic> clusterPrev, clusterNext;
+  Eigen::Vector3d markerPrev, markerNext;
+  if (hasPrev)
+  {
+    clusterPrev = cluster(prev);
+    markerPrev << coord(ts,prev,0), coord(ts,prev,1), coord(ts,prev,2);
+  }
+  if (hasNext)
+  {
+    clusterNext = cluster(next);
+    markerNext << coord(ts,next,0), coord(ts,next,1), coord(ts,next,2);
+  }
+  for (unsigned k = 0 ; k < gap[1] ; ++k)
+  {
+    const unsigned sample = gap[0] + k;
+    const Eigen::Matrix<double,3,Eigen::Dynamic> current = cluster(sample);
+    Eigen::Vector3d pos;
+    if (hasPrev && hasNext)
+    {
+      // Both estimations are blended to avoid any discontinuity at the end of the gap
+      const double t = static_cast<double>(k + 1) / static_cast<double>(gap[1] + 1);
+      pos = (1.0 - t) * _ma_processing_rigid_transform(clusterPrev, current, markerPrev) + t * _ma_processing_rigid_transform(clusterNext, current, markerNext);
+    }
+    else if (hasPrev)
+      pos = _ma_processing_rigid_transform(clusterPrev, current, markerPrev);
+    else
+      pos = _ma_processing_rigid_transform(clusterNext, current, markerNext);
+    out->Indices.push_back(sample);
+    out->Values.insert(out->Values.end(), pos.data(), pos.data() + 3);
+  }
+};
+
+// Prepare the linear interpolation of a time sequence (uniform knots) at @a points samples regularly spaced between @a start and @a end.
+// The interpolation is shared by all the time sequences with the same sampling (rate, start time, number of samples).
+void _ma_processing_prepare_resampling(Eigen::Interp1Batch<double>* interp, const ma::TimeSequence* ts, double start, double end, unsigned points)
+{
+  interp->prepare(ts->startTime(), 1.0 / ts->sampleRate(), ts->samples(), Eigen::Matrix<double,Eigen::Dynamic,1>::LinSpaced(points, start, end));
+};
+
+void _ma_processing_apply_resampling(ma::TimeSequence* out, const ma::TimeSequence* ts, const Eigen::Interp1Batch<double>& interp)
+{
+  typedef Eigen::Map<const Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>,0,Eigen::OuterStride<>> ConstMap;
+  typedef Eigen::Map<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>,0,Eigen::OuterStride<>> Map;
+  const unsigned points = out->samples(), stride = ts->stride(), outstride = out->stride();
+  const bool reconstructed = ((ts->type() & ma::TimeSequence::Reconstructed) == ma::TimeSequence::Reconstructed);
+  const unsigned cpts = ts->components() - (reconstructed ? 1 : 0);
+  Map y(out->data(), points, cpts, Eigen::OuterStride<>(outstride));
+  interp.apply(&y, ConstMap(ts->data(), ts->samples(), cpts, Eigen::OuterStride<>(stride)));
+  if (reconstructed)
+  {
+    // A resampled value is valid only if the samples used are valid
+    const double* r = ts->data() + cpts * stride;
+    double* res = out->data() + cpts * outstride;
+    for (unsigned k = 0 ; k < points ; ++k)
+    {
+      const Eigen::DenseIndex idx = interp.index(k);
+      res[k] = ((r[idx] < 0.) || ((interp.weight(k) != 0.) && (r[idx+1] < 0.))) ? -1.0 : 0.0;
+    }
+  }
+};
+
 namespace ma
 {
 namespace processing
@@ -74,6 +297,7 @@ namespace processing
    * Convenient function to simplify the data filtering of time sequences with a zero-lag Butterworth filter
    * Internally, this function does two filtering passes (one forward followed by one backward). To respect the given final cut-off frequency (@a fc) and the final order (@a fn), these ones are adapted in consequence (see Robertson & Dowling [1] and Winter [2]).
    * This function manage each component independently. In case the type of a time sequence is tagged ma::TimeSequence::Reconstructed, the filtering is managed in consequence and realized by window.
+   * Time sequences storing compact elements (see TimeSequence::setStorage()) are filtered using double values and the result is converted back to their storage.
    *
    * @important This is the responsability of the developer to use correctly this function. It is not intended to verify if the passed time sequence(s) is(are) physically adapted to this filter. For example, the filter is adapted for time sequence with the types TimeSequence::Position and TimeSequence::Analog but might not with the types TimeSequence::Pose and TimeSequence::Wrench. 
    *
@@ -120,17 +344,225 @@ namespace processing
         error("The time sequence '%s' has a null sample rate.", ts->name().c_str());
         continue;
       }
+      // Compact elements are filtered in a widened copy
+      std::unique_ptr<TimeSequence> widened((ts->storage() != TimeSequence::Storage::Double) ? _ma_processing_widen(ts) : nullptr);
+      TimeSequence* target = widened ? widened.get() : ts;
       double wn = fc / (ts->sampleRate() / 2.0);
       int n = fn;
       Eigen::adjustZeroLagButterworth(n, wn);
       Eigen::Matrix<double, Eigen::Dynamic, 1> a, b;
       Eigen::butter(&b, &a, n, wn, t);
       if ((ts->type() & TimeSequence::Reconstructed) == TimeSequence::Reconstructed)
-        _ma_processing_butterworth_zero_lag_filter_windowed(ts,b,a);
+        _ma_processing_butterworth_zero_lag_filter_windowed(target,b,a);
       else
-        _ma_processing_butterworth_zero_lag_filter(ts,b,a);
+        _ma_processing_butterworth_zero_lag_filter(target,b,a);
+      if (widened)
+        _ma_processing_narrow(widened.get(), ts);
     }
     return true;
   };
+  
+  /**
+   * Fill the gaps (samples with a negative residual) of reconstructed time sequences (e.g. markers' trajectories).
+   * The @a method used to fill the gaps can be:
+   *  - GapFilling::Linear: the gap is filled with a straight line between the samples surrounding the gap.
+   *  - GapFilling::Cubic: the gap is filled with a piecewise cubic Hermite interpolating polynomial (PCHIP, see Eigen::Interp1::cubic()) using up to three valid samples on each side of the gap. If less than three valid samples are available, a linear interpolation is used.
+   *  - GapFilling::RigidBody: the gap is filled by assuming that the time sequence and its three closest neighbours (found in @a tss and valid during the whole gap) form a rigid body. The estimations computed from the samples before and after the gap are blended. This method can also fill the gaps at the beginning and the end of the time sequences.
+   *
+   * Gaps longer than @a maxGapLength samples are not filled. By default (value set to 0), there is no limit.
+   * The filled samples have their residual set to 0. The other samples are never modified.
+   * The time sequences are processed in parallel using the given number of @a threads (by default, the number of hardware threads). 
+   *
+   * @important Only the time sequences tagged as ma::TimeSequence::Reconstructed, with their residual as last component are processed. The rigid body method requires 3D positions (i.e. 4 components).
+   * Time sequences storing compact elements (see TimeSequence::setStorage()) are processed using double values and the filled samples are converted back to their storage.
+   *
+   * @ingroup openma_processing
+   */
+  bool fill_gaps(const std::vector<TimeSequence*>& tss, GapFilling method, unsigned maxGapLength, unsigned threads)
+  {
+    if ((method != GapFilling::Linear) && (method != GapFilling::Cubic) && (method != GapFilling::RigidBody))
+    {
+      error("Unknown method to fill gaps. Gap filling aborted.");
+      return false;
+    }
+    std::vector<TimeSequence*> valids, sources;
+    std::vector<std::unique_ptr<TimeSequence>> widened;
+    for (const auto& ts : tss)
+    {
+      if ((ts == nullptr) || ((ts->type() & TimeSequence::Reconstructed) != TimeSequence::Reconstructed) || (ts->components() < 2))
+      {
+        error("The time sequence '%s' is not a reconstructed time sequence with residuals. Its gaps are not filled.", (ts != nullptr) ? ts->name().c_str() : "");
+        continue;
+      }
+      if ((method == GapFilling::RigidBody) && (ts->components() != 4))
+      {
+        error("The time sequence '%s' is not a 3D position. Its gaps are not filled.", ts->name().c_str());
+        continue;
+      }
+      // Compact elements are processed in a widened copy
+      widened.emplace_back((ts->storage() != TimeSequence::Storage::Double) ? _ma_processing_widen(ts) : nullptr);
+      if (!widened.back())
+        ts->linearize();
+      valids.push_back(widened.back() ? widened.back().get() : ts);
+      sources.push_back(ts);
+    }
+    const std::vector<const TimeSequence*> markers(valids.cbegin(), valids.cend());
+    std::vector<_ma_processing_filled_samples> filled(valids.size());
+    // First pass: the gaps are computed without modifying the time sequences
+    parallel_for(valids.size(), [&](size_t idx) {
+      const TimeSequence* ts = valids[idx];
+      const unsigned samples = ts->samples();
+      const auto gaps = _ma_processing_find_gaps(ts->data() + (ts->components() - 1) * ts->stride(), samples);
+      for (const auto& gap : gaps)
+      {
+        if ((maxGapLength != 0) && (gap[1] > maxGapLength))
+          continue;
+        if (method == GapFilling::RigidBody)
+          _ma_processing_fill_gap_rigid(&filled[idx], ts, gap, markers);
+        else if ((gap[0] == 0) || ((gap[0] + gap[1]) == samples))
+          ++filled[idx].Unfilled; // Not possible to interpolate the beginning or the end of a time sequence.
+        else if (method == GapFilling::Cubic)
+          _ma_processing_fill_gap_cubic(&filled[idx], ts, gap);
+        else
+          _ma_processing_fill_gap_linear(&filled[idx], ts, gap);
+      }
+    }, threads);
+    // Second pass: the computed samples are written
+    parallel_for(valids.size(), [&](size_t idx) {
+      TimeSequence* ts = valids[idx];
+      const auto& fs = filled[idx];
+      double* data = ts->data();
+      const unsigned stride = ts->stride(), coords = ts->components() - 1;
+      for (size_t i = 0, len = fs.Indices.size() ; i < len ; ++i)
+      {
+        for (unsigned c = 0 ; c < coords ; ++c)
+          data[c*stride+fs.Indices[i]] = fs.Values[i*coords+c];
+        data[coords*stride+fs.Indices[i]] = 0.0;
+      }
+    }, threads);
+    for (size_t idx = 0 ; idx < valids.size() ; ++idx)
+    {
+      if (!filled[idx].Indices.empty())
+      {
+        if (widened[idx])
+          _ma_processing_narrow(widened[idx].get(), sources[idx]);
+        else
+          sources[idx]->modified();
+      }
+      if (filled[idx].Unfilled != 0)
+        warning("%u gap(s) of the time sequence '%s' could not be filled.", filled[idx].Unfilled, sources[idx]->name().c_str());
+    }
+    return true;
+  };
+  
+  /**
+   * Time-normalize the time sequences @a tss for each cycle defined by the @a events having the given @a label and @a context (e.g. "Foot Strike" and "Left" for the left gait cycles).
+   * A cycle is delimited by two consecutive events (sorted by time). If the @a context is empty, the context of the events is not checked.
+   * Each cycle is resampled linearly with the given number of @a points (by default 101, i.e. one sample for each percent of the cycle).
+   *
+   * The sample positions and the interpolation weights are computed once per cycle for all the time sequences sharing the same sampling (sample rate, start time and number of samples). They are then applied to every component of these time sequences.
+   * The cycles are processed in parallel using the given number of @a threads (by default, the number of hardware threads). 
+   *
+   * One node is returned for each cycle (named "Cycle" followed by its number, and having the properties "start" and "end" with the time of the events). It contains one time sequence per given time sequence with the same name, dimensions, type and unit, but with @a points samples.
+   * The sample rate of the normalized time sequences is set so that their time corresponds to a percentage of the cycle.
+   * For reconstructed time sequences, the residual of a resampled value is set to -1 if one of the samples used is invalid, 0 otherwise.
+   * Time sequences storing compact elements (see TimeSequence::setStorage()) are read using double values. The normalized time sequences always store double values.
+   * The created nodes are attached to the given @a parent, otherwise it is the responsability of the developer to delete them.
+   *
+   * @note A cycle which is not covered by all the time sequences is discarded.
+   * @ingroup openma_processing
+   */
+  std::vector<Node*> normalize_cycles(const std::vector<TimeSequence*>& tss, const std::vector<Event*>& events, const std::string& label, const std::string& context, unsigned points, Node* parent, unsigned threads)
+  {
+    std::vector<Node*> cycles;
+    if (points < 2)
+    {
+      error("Impossible to normalize cycles with less than 2 points.");
+      return cycles;
+    }
+    std::vector<TimeSequence*> valids;
+    std::vector<std::unique_ptr<TimeSequence>> widened;
+    for (const auto& ts : tss)
+    {
+      if ((ts == nullptr) || (ts->samples() < 2) || (ts->sampleRate() <= 0.0))
+      {
+        error("The time sequence '%s' cannot be resampled (at least 2 samples and a positive sample rate are required).", (ts != nullptr) ? ts->name().c_str() : "");
+        continue;
+      }
+      // Compact elements are read from a widened copy
+      if (ts->storage() != TimeSequence::Storage::Double)
+      {
+        widened.emplace_back(_ma_processing_widen(ts));
+        valids.push_back(widened.back().get());
+        continue;
+      }
+      ts->linearize();
+      valids.push_back(ts);
+    }
+    // Cycles
+    std::vector<double> times;
+    for (const auto& evt : events)
+    {
+      if ((evt != nullptr) && (evt->name() == label) && (context.empty() || (evt->context() == context)))
+        times.push_back(evt->time());
+    }
+    std::sort(times.begin(), times.end());
+    std::vector<std::array<double,2>> bounds;
+    const double tolerance = 1e-9;
+    for (size_t i = 1 ; i < times.size() ; ++i)
+    {
+      if (times[i] <= times[i-1])
+        continue;
+      bool covered = true;
+      for (const auto& ts : valids)
+      {
+        const double first = ts->startTime(), last = first + static_cast<double>(ts->samples() - 1) / ts->sampleRate();
+        if ((times[i-1] < first - tolerance) || (times[i] > last + tolerance))
+        {
+          covered = false;
+          break;
+        }
+      }
+      if (covered)
+        bounds.push_back({{times[i-1], times[i]}});
+      else
+        warning("The cycle between %f s and %f s is not covered by all the time sequences. It is discarded.", times[i-1], times[i]);
+    }
+    // Groups of time sequences with the same sampling
+    std::vector<unsigned> groups(valids.size());
+    std::vector<const TimeSequence*> references;
+    for (size_t i = 0 ; i < valids.size() ; ++i)
+    {
+      size_t g = 0;
+      for ( ; g < references.size() ; ++g)
+      {
+        if ((references[g]->sampleRate() == valids[i]->sampleRate()) && (references[g]->startTime() == valids[i]->startTime()) && (references[g]->samples() == valids[i]->samples()))
+          break;
+      }
+      if (g == references.size())
+        references.push_back(valids[i]);
+      groups[i] = g;
+    }
+    // The nodes are created sequentially (the attachment to a parent is not thread safe)
+    std::vector<std::vector<TimeSequence*>> outputs(bounds.size());
+    const double rate = static_cast<double>(points - 1) / 100.0;
+    for (size_t i = 0 ; i < bounds.size() ; ++i)
+    {
+      Node* cycle = new Node("Cycle" + std::to_string(i + 1), parent);
+      cycle->setProperty("start", bounds[i][0]);
+      cycle->setProperty("end", bounds[i][1]);
+      for (const auto& ts : valids)
+        outputs[i].push_back(new TimeSequence(ts->name(), ts->dimensions(), points, rate, 0.0, ts->type(), ts->unit(), ts->scale(), ts->offset(), ts->range(), cycle));
+      cycles.push_back(cycle);
+    }
+    parallel_for(bounds.size(), [&](size_t i) {
+      std::vector<Eigen::Interp1Batch<double>> tables(references.size());
+      for (size_t g = 0 ; g < references.size() ; ++g)
+        _ma_processing_prepare_resampling(&tables[g], references[g], bounds[i][0], bounds[i][1], points);
+      for (size_t j = 0 ; j < valids.size() ; ++j)
+        _ma_processing_apply_resampling(outputs[i][j], valids[j], tables[groups[j]]);
+    }, threads);
+    return cycles;
+  };
+};
 };
-};
\ No newline at end of file
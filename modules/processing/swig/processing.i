@@ -65,5 +65,7 @@ namespace ma
 namespace processing
 {
   bool filter_butterworth_zero_lag(const std::vector<TimeSequence*>& tss, Response type, double fc, int fn);
+  bool fill_gaps(const std::vector<TimeSequence*>& tss, GapFilling method, unsigned maxGapLength = 0, unsigned threads = 0);
+  std::vector<Node*> normalize_cycles(const std::vector<TimeSequence*>& tss, const std::vector<Event*>& events, const std::string& label, const std::string& context, unsigned points = 101, Node* parent = nullptr, unsigned threads = 0);
 };
 };
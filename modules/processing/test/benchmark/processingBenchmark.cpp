@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <openma/processing.h>
+#include <openma/base/event.h>
+
+// Benchmarks of the processing module on long trials:
+//  - Zero-lag Butterworth filters (filtfilt) of markers and analog channels
+//  - Gap filling of markers (linear, cubic)
+//  - Time normalization of cycles
+// The original data are restored (not timed) before each repetition.
+
+int main(int argc, char* argv[])
+{
+  ma::benchmark::Harness bench("processing", argc, argv);
+  const unsigned samples = bench.samples();
+
+  ma::Node root("root");
+  auto trial = new ma::Trial("trial", &root);
+  const auto markers = ma::benchmark::generate_markers(trial, 50, samples);
+  const auto analogs = ma::benchmark::generate_analogs(trial, 16, samples * 10);
+  std::vector<ma::TimeSequence*> all(markers);
+  all.insert(all.end(), analogs.begin(), analogs.end());
+  std::vector<std::vector<double>> originals;
+  for (const auto& ts : all)
+    originals.emplace_back(ts->data(), ts->data() + ts->elements());
+  auto restore = [&]() {
+    for (size_t i = 0 ; i < all.size() ; ++i)
+      std::copy(originals[i].begin(), originals[i].end(), all[i]->data());
+  };
+
+  using ma::processing::Response;
+  bench.run("filter_butterworth_zero_lag.markers.lowpass", samples * markers.size(), restore, [&]() {
+    ma::processing::filter_butterworth_zero_lag(markers, Response::LowPass, 6.0, 4);
+  });
+  bench.run("filter_butterworth_zero_lag.analogs.lowpass", samples * 10 * analogs.size(), restore, [&]() {
+    ma::processing::filter_butterworth_zero_lag(analogs, Response::LowPass, 20.0, 2);
+  });
+  bench.run("filter_butterworth_zero_lag.analogs.highpass", samples * 10 * analogs.size(), restore, [&]() {
+    ma::processing::filter_butterworth_zero_lag(analogs, Response::HighPass, 20.0, 2);
+  });
+
+  // Gaps of 5 to 15 samples every 100 samples (the residual is set to -1)
+  auto occlude = [&]() {
+    restore();
+    for (auto marker : markers)
+    {
+      double* residuals = marker->data() + 3 * samples;
+      for (unsigned i = 50 ; i + 15 < samples ; i += 100)
+        std::fill_n(residuals + i, 5 + (i / 100) % 11, -1.0);
+    }
+  };
+  bench.run("fill_gaps.markers.linear", samples * markers.size(), occlude, [&]() {
+    ma::processing::fill_gaps(markers, ma::processing::GapFilling::Linear);
+  });
+  bench.run("fill_gaps.markers.cubic", samples * markers.size(), occlude, [&]() {
+    ma::processing::fill_gaps(markers, ma::processing::GapFilling::Cubic);
+  });
+
+  // One cycle per second
+  restore();
+  std::vector<ma::Event*> events;
+  for (unsigned i = 0 ; i < samples / 100 ; ++i)
+    events.push_back(new ma::Event("Foot Strike", static_cast<double>(i), "Left", "", trial->events()));
+  ma::Node cycles("cycles");
+  bench.run("normalize_cycles.markers", samples * markers.size(), [&]() {cycles.clear();}, [&]() {
+    ma::processing::normalize_cycles(markers, events, "Foot Strike", "Left", 101, &cycles);
+  });
+
+  return bench.report();
+};
@@ -3,6 +3,9 @@
 #include <openma/processing.h>
 #include <openma/base.h>
 
+#include <algorithm> // std::max
+#include <cmath> // std::fabs
+
 static const double in[81] = {0.269798891254315, 0.548893273936043, 0.859470031283581, 1.083314451319253, 1.181526336501076, 1.257304313666979, 1.276759551809656, 1.068465704696009, 0.685668156305006, 0.372268495814636, 0.157220415283078,-0.104162709960200,-0.411133031729557,-0.666435823989357,-0.821984136929495,-0.833236901328857,-0.709580252798482,-0.542015408017795,-0.372916081515782,-0.174340534581690, 0.072920410968047, 0.380822922154266, 0.767727734946687, 1.120370101251430, 1.245206330432570, 1.175867152632213, 1.092613558545766, 1.006391390249807, 0.809008427785796, 0.500882870473192,0.177427442323182,-0.115265050765107,-0.399394457537441,-0.683974764754652,-0.867972546429597,-0.841912916291380,-0.686986990511049,-0.548614709893092,-0.431855109908579,-0.225316251342442,0.149990554410562, 0.548991274928445, 0.766603662161258, 0.897492808926710, 1.119235616431332, 1.308820691731916, 1.244650590294634, 0.982001470310733, 0.740054381757683, 0.537145589228529,0.241231226499049,-0.153720986008040,-0.506910201501367,-0.663739279012461,-0.656372165803181,-0.667496462570363,-0.676804487342212,-0.520053642587747,-0.227506579633197, 0.073377651136435, 0.334500818135176, 0.537846810887783, 0.716580939359015, 0.908624646571194, 1.038847705160293, 1.081244298319416, 1.110278804941418, 1.053114775703411, 0.816052544461935, 0.519935281836539,0.261179617911776,-0.018178988662816,-0.328756149855888,-0.622570989208225,-0.849673221482816,-0.901019340312481,-0.760265237435191,-0.571478064861968,-0.381544623107748,-0.141512050095412,0.126109968176025};
 
 CXXTEST_SUITE(ButterZeroLagLowPassTest)
@@ -41,8 +44,26 @@ CXXTEST_SUITE(ButterZeroLagLowPassTest)
       TS_ASSERT_DELTA(*(tss[0]->data()+i+81*3), *(out+i+81), 1e-15);
     }
   };
+  
+  CXXTEST_TEST(compactStorage)
+  {
+    ma::Node root("root");
+    auto tss = ma::make_nodes<ma::TimeSequence*>(2,1,81,100.0,0.0,ma::TimeSequence::Analog,"V",&root);
+    std::copy_n(in, 81, tss[0]->data());
+    std::copy_n(in, 81, tss[1]->data());
+    tss[1]->setStorage(ma::TimeSequence::Storage::Float);
+    filter_butterworth_zero_lag(tss,ma::processing::Response::LowPass,20.0,2);
+    // The compact elements are filtered with double values and converted back to their storage
+    TS_ASSERT_EQUALS(tss[1]->storage(), ma::TimeSequence::Storage::Float);
+    TS_ASSERT_DELTA(tss[0]->data()[1], 0.556750494481059, 5e-8);
+    double values[81];
+    tss[1]->read(0, 0, 81, values);
+    for (int i = 0 ; i < 81 ; ++i)
+      TS_ASSERT_DELTA(values[i], tss[0]->data()[i], 1e-5 * std::max(1.0, std::fabs(tss[0]->data()[i])));
+  };
 };
 
 CXXTEST_SUITE_REGISTRATION(ButterZeroLagLowPassTest)
 CXXTEST_TEST_REGISTRATION(ButterZeroLagLowPassTest, analog)
 CXXTEST_TEST_REGISTRATION(ButterZeroLagLowPassTest, reconstructed)
+CXXTEST_TEST_REGISTRATION(ButterZeroLagLowPassTest, compactStorage)
@@ -0,0 +1,169 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/processing.h>
+#include <openma/base.h>
+
+#include <cmath>
+
+CXXTEST_SUITE(FillGapsTest)
+{
+  CXXTEST_TEST(linear)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("M", 4, 20, 100.0, 0.0, ma::TimeSequence::Position, "mm", &root);
+    for (unsigned i = 0 ; i < 20 ; ++i)
+    {
+      ts->data(i,0) = 2.0 * i;
+      ts->data(i,1) = -1.0 * i;
+      ts->data(i,2) = 10.0;
+      ts->data(i,3) = 0.5;
+    }
+    for (unsigned i = 5 ; i < 9 ; ++i)
+    {
+      ts->data(i,0) = ts->data(i,1) = ts->data(i,2) = 0.0;
+      ts->data(i,3) = -1.0;
+    }
+    // Gaps at the beginning and the end cannot be interpolated
+    ts->data(0,3) = -1.0;
+    ts->data(19,3) = -1.0;
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps({ts}, ma::processing::GapFilling::Linear), true);
+    for (unsigned i = 5 ; i < 9 ; ++i)
+    {
+      TS_ASSERT_DELTA(ts->data(i,0), 2.0 * i, 1e-12);
+      TS_ASSERT_DELTA(ts->data(i,1), -1.0 * i, 1e-12);
+      TS_ASSERT_DELTA(ts->data(i,2), 10.0, 1e-12);
+      TS_ASSERT_EQUALS(ts->data(i,3), 0.0);
+    }
+    TS_ASSERT_EQUALS(ts->data(4,3), 0.5);
+    TS_ASSERT_EQUALS(ts->data(0,3), -1.0);
+    TS_ASSERT_EQUALS(ts->data(19,3), -1.0);
+  };
+  
+  CXXTEST_TEST(cubic)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("M", 4, 100, 100.0, 0.0, ma::TimeSequence::Position, "mm", &root);
+    for (unsigned i = 0 ; i < 100 ; ++i)
+    {
+      ts->data(i,0) = 100.0 * std::sin(i * 0.05);
+      ts->data(i,1) = 50.0 * std::cos(i * 0.05);
+      ts->data(i,2) = static_cast<double>(i);
+      ts->data(i,3) = (i >= 40) && (i < 46) ? -1.0 : 0.0;
+    }
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps({ts}, ma::processing::GapFilling::Cubic), true);
+    for (unsigned i = 40 ; i < 46 ; ++i)
+    {
+      TS_ASSERT_DELTA(ts->data(i,0), 100.0 * std::sin(i * 0.05), 0.5);
+      TS_ASSERT_DELTA(ts->data(i,1), 50.0 * std::cos(i * 0.05), 0.5);
+      TS_ASSERT_DELTA(ts->data(i,2), static_cast<double>(i), 1e-9);
+      TS_ASSERT_EQUALS(ts->data(i,3), 0.0);
+    }
+  };
+  
+  CXXTEST_TEST(maxGapLength)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("M", 4, 30, 100.0, 0.0, ma::TimeSequence::Position, "mm", &root);
+    for (unsigned i = 0 ; i < 30 ; ++i)
+    {
+      ts->data(i,0) = ts->data(i,1) = ts->data(i,2) = static_cast<double>(i);
+      ts->data(i,3) = 0.0;
+    }
+    for (unsigned i = 3 ; i < 5 ; ++i)
+      ts->data(i,3) = -1.0;
+    for (unsigned i = 10 ; i < 20 ; ++i)
+      ts->data(i,3) = -1.0;
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps({ts}, ma::processing::GapFilling::Linear, 5), true);
+    TS_ASSERT_EQUALS(ts->data(3,3), 0.0);
+    TS_ASSERT_EQUALS(ts->data(4,3), 0.0);
+    for (unsigned i = 10 ; i < 20 ; ++i)
+      TS_ASSERT_EQUALS(ts->data(i,3), -1.0);
+  };
+  
+  CXXTEST_TEST(rigidBody)
+  {
+    // Four markers fixed on a rotating and translating segment
+    const double local[4][3] = {{0.0, 0.0, 0.0}, {100.0, 0.0, 0.0}, {0.0, 80.0, 0.0}, {30.0, 40.0, 60.0}};
+    const unsigned samples = 50;
+    ma::Node root("root");
+    std::vector<ma::TimeSequence*> markers;
+    for (unsigned j = 0 ; j < 4 ; ++j)
+      markers.push_back(new ma::TimeSequence("M" + std::to_string(j), 4, samples, 100.0, 0.0, ma::TimeSequence::Position, "mm", &root));
+    auto expected = [&](unsigned i, unsigned j, unsigned c) {
+      const double a = 0.03 * i, ca = std::cos(a), sa = std::sin(a);
+      const double p[3] = {ca * local[j][0] - sa * local[j][1], sa * local[j][0] + ca * local[j][1], local[j][2]};
+      const double t[3] = {2.0 * i, 50.0, -1.0 * i};
+      return p[c] + t[c];
+    };
+    for (unsigned j = 0 ; j < 4 ; ++j)
+    {
+      for (unsigned i = 0 ; i < samples ; ++i)
+      {
+        for (unsigned c = 0 ; c < 3 ; ++c)
+          markers[j]->data(i,c) = expected(i,j,c);
+        markers[j]->data(i,3) = 0.0;
+      }
+    }
+    // A gap in the middle and another one at the beginning
+    for (unsigned i = 20 ; i < 35 ; ++i)
+      markers[3]->data(i,3) = -1.0;
+    for (unsigned i = 0 ; i < 5 ; ++i)
+      markers[1]->data(i,3) = -1.0;
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps(markers, ma::processing::GapFilling::RigidBody, 0, 2), true);
+    for (unsigned i = 20 ; i < 35 ; ++i)
+    {
+      for (unsigned c = 0 ; c < 3 ; ++c)
+        TS_ASSERT_DELTA(markers[3]->data(i,c), expected(i,3,c), 1e-6);
+      TS_ASSERT_EQUALS(markers[3]->data(i,3), 0.0);
+    }
+    for (unsigned i = 0 ; i < 5 ; ++i)
+    {
+      for (unsigned c = 0 ; c < 3 ; ++c)
+        TS_ASSERT_DELTA(markers[1]->data(i,c), expected(i,1,c), 1e-6);
+      TS_ASSERT_EQUALS(markers[1]->data(i,3), 0.0);
+    }
+  };
+  
+  CXXTEST_TEST(compactStorage)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("M", 4, 20, 100.0, 0.0, ma::TimeSequence::Position, "mm", &root);
+    for (unsigned i = 0 ; i < 20 ; ++i)
+    {
+      ts->data(i,0) = 2.0 * i;
+      ts->data(i,1) = -1.0 * i;
+      ts->data(i,2) = 10.0;
+      ts->data(i,3) = (i >= 5) && (i < 9) ? -1.0 : 0.5;
+    }
+    ts->setStorage(ma::TimeSequence::Storage::Float);
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps({ts}, ma::processing::GapFilling::Linear), true);
+    // The filled samples are converted back to the storage of the time sequence
+    TS_ASSERT_EQUALS(ts->storage(), ma::TimeSequence::Storage::Float);
+    const ma::TimeSequence* cts = ts;
+    for (unsigned i = 5 ; i < 9 ; ++i)
+    {
+      TS_ASSERT_DELTA(cts->data(i,0), 2.0 * i, 1e-6);
+      TS_ASSERT_DELTA(cts->data(i,1), -1.0 * i, 1e-6);
+      TS_ASSERT_DELTA(cts->data(i,2), 10.0, 1e-6);
+      TS_ASSERT_EQUALS(cts->data(i,3), 0.0);
+    }
+    TS_ASSERT_EQUALS(cts->data(4,3), 0.5);
+  };
+  
+  CXXTEST_TEST(unsupported)
+  {
+    ma::Node root("root");
+    auto analog = new ma::TimeSequence("A", 1, 10, 100.0, 0.0, ma::TimeSequence::Analog, "V", &root);
+    analog->data(5,0) = -1.0;
+    TS_ASSERT_EQUALS(ma::processing::fill_gaps({analog}, ma::processing::GapFilling::Linear), true);
+    TS_ASSERT_EQUALS(analog->data(5,0), -1.0);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(FillGapsTest)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, linear)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, cubic)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, maxGapLength)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, rigidBody)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, compactStorage)
+CXXTEST_TEST_REGISTRATION(FillGapsTest, unsupported)
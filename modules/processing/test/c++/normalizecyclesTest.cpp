@@ -0,0 +1,114 @@
+#include <cxxtest/TestDrive.h>
+
+#include <openma/processing.h>
+#include <openma/base.h>
+
+CXXTEST_SUITE(NormalizeCyclesTest)
+{
+  CXXTEST_TEST(linear)
+  {
+    ma::Node root("root");
+    auto angle = new ma::TimeSequence("LKneeAngles", 4, 201, 100.0, 0.0, ma::TimeSequence::Angle, "deg", &root);
+    auto analog = new ma::TimeSequence("Fz", 1, 2001, 1000.0, 0.0, ma::TimeSequence::Analog, "N", &root);
+    for (unsigned i = 0 ; i < 201 ; ++i)
+    {
+      const double t = i / 100.0;
+      angle->data(i,0) = 10.0 * t;
+      angle->data(i,1) = -5.0 * t + 1.0;
+      angle->data(i,2) = 3.0;
+      angle->data(i,3) = ((i == 120) ? -1.0 : 0.0);
+    }
+    for (unsigned i = 0 ; i < 2001 ; ++i)
+      analog->data(i,0) = 100.0 * (i / 1000.0);
+    std::vector<ma::Event*> events{
+      new ma::Event("Foot Strike", 0.2, "Left", "", &root),
+      new ma::Event("Foot Strike", 0.7, "Right", "", &root),
+      new ma::Event("Foot Strike", 1.3, "Left", "", &root),
+      new ma::Event("Foot Off", 0.8, "Left", "", &root),
+      new ma::Event("Foot Strike", 1.9, "Left", "", &root),
+      new ma::Event("Foot Strike", 2.5, "Left", "", &root) // Outside of the time sequences
+    };
+    ma::Node output("output");
+    auto cycles = ma::processing::normalize_cycles({angle, analog}, events, "Foot Strike", "Left", 101, &output, 2);
+    TS_ASSERT_EQUALS(cycles.size(), 2ul);
+    TS_ASSERT_EQUALS(output.children().size(), 2ul);
+    if (cycles.size() != 2ul)
+      return;
+    TS_ASSERT_EQUALS(cycles[0]->name(), "Cycle1");
+    TS_ASSERT_DELTA(cycles[1]->property("start").cast<double>(), 1.3, 1e-12);
+    TS_ASSERT_DELTA(cycles[1]->property("end").cast<double>(), 1.9, 1e-12);
+    for (unsigned c = 0 ; c < 2 ; ++c)
+    {
+      const double start = (c == 0) ? 0.2 : 1.3, end = (c == 0) ? 1.3 : 1.9;
+      auto nangle = cycles[c]->findChild<ma::TimeSequence*>("LKneeAngles");
+      auto nanalog = cycles[c]->findChild<ma::TimeSequence*>("Fz");
+      TS_ASSERT_DIFFERS(nangle, nullptr);
+      TS_ASSERT_DIFFERS(nanalog, nullptr);
+      if ((nangle == nullptr) || (nanalog == nullptr))
+        return;
+      TS_ASSERT_EQUALS(nangle->samples(), 101u);
+      TS_ASSERT_EQUALS(nangle->components(), 4u);
+      TS_ASSERT_EQUALS(nangle->type(), ma::TimeSequence::Angle);
+      TS_ASSERT_EQUALS(nangle->unit(), "deg");
+      TS_ASSERT_EQUALS(nanalog->samples(), 101u);
+      for (unsigned k = 0 ; k < 101 ; ++k)
+      {
+        const double t = start + (end - start) * k / 100.0;
+        TS_ASSERT_DELTA(nangle->data(k,0), 10.0 * t, 1e-9);
+        TS_ASSERT_DELTA(nangle->data(k,1), -5.0 * t + 1.0, 1e-9);
+        TS_ASSERT_DELTA(nangle->data(k,2), 3.0, 1e-9);
+        TS_ASSERT_DELTA(nanalog->data(k,0), 100.0 * t, 1e-9);
+      }
+    }
+    // The sample 120 (1.2 s) is invalid and used in the first cycle only
+    auto first = cycles[0]->findChild<ma::TimeSequence*>("LKneeAngles");
+    unsigned invalids = 0;
+    for (unsigned k = 0 ; k < 101 ; ++k)
+      invalids += (first->data(k,3) < 0.0) ? 1 : 0;
+    TS_ASSERT_EQUALS(invalids, 2u);
+    auto second = cycles[1]->findChild<ma::TimeSequence*>("LKneeAngles");
+    for (unsigned k = 0 ; k < 101 ; ++k)
+      TS_ASSERT_EQUALS(second->data(k,3), 0.0);
+  };
+  
+  CXXTEST_TEST(dimensions)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("Matrix", std::vector<unsigned>{2,3}, 101, 100.0, 0.0, ma::TimeSequence::Other, "", &root);
+    for (unsigned i = 0 ; i < 101 ; ++i)
+      for (unsigned j = 0 ; j < 6 ; ++j)
+        ts->data()[j*101+i] = static_cast<double>(j) * i / 100.0;
+    std::vector<ma::Event*> events{
+      new ma::Event("Foot Strike", 0.0, "Left", "", &root),
+      new ma::Event("Foot Strike", 1.0, "Left", "", &root)
+    };
+    ma::Node output("output");
+    auto cycles = ma::processing::normalize_cycles({ts}, events, "Foot Strike", "Left", 11, &output, 1);
+    TS_ASSERT_EQUALS(cycles.size(), 1ul);
+    if (cycles.size() != 1ul)
+      return;
+    auto nts = cycles[0]->findChild<ma::TimeSequence*>("Matrix");
+    TS_ASSERT_DIFFERS(nts, nullptr);
+    if (nts == nullptr)
+      return;
+    TS_ASSERT_EQUALS(nts->dimensions(), ts->dimensions());
+    TS_ASSERT_EQUALS(nts->components(), 6u);
+    TS_ASSERT_EQUALS(nts->samples(), 11u);
+    for (unsigned k = 0 ; k < 11 ; ++k)
+      TS_ASSERT_DELTA(nts->data()[5*11+k], 5.0 * k / 10.0, 1e-9);
+  };
+  
+  CXXTEST_TEST(noCycle)
+  {
+    ma::Node root("root");
+    auto ts = new ma::TimeSequence("Fz", 1, 100, 100.0, 0.0, ma::TimeSequence::Analog, "N", &root);
+    std::vector<ma::Event*> events{new ma::Event("Foot Strike", 0.2, "Left", "", &root)};
+    TS_ASSERT_EQUALS(ma::processing::normalize_cycles({ts}, events, "Foot Strike", "Left").size(), 0ul);
+    TS_ASSERT_EQUALS(ma::processing::normalize_cycles({ts}, events, "Foot Strike", "Left", 1).size(), 0ul);
+  };
+};
+
+CXXTEST_SUITE_REGISTRATION(NormalizeCyclesTest)
+CXXTEST_TEST_REGISTRATION(NormalizeCyclesTest, linear)
+CXXTEST_TEST_REGISTRATION(NormalizeCyclesTest, dimensions)
+CXXTEST_TEST_REGISTRATION(NormalizeCyclesTest, noCycle)